@@ -4,5 +4,6 @@
 /* //////////////////////////////////////////////////////////////////////////////////////
  * includes
  */
+#include <png.h>
 
 #endif
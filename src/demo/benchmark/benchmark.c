@@ -0,0 +1,546 @@
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "benchmark.h"
+#if defined(TB_CONFIG_OS_LINUX) || defined(TB_CONFIG_OS_ANDROID) || defined(TB_CONFIG_OS_MACOSX) || defined(TB_CONFIG_OS_IOS)
+#   include <sys/resource.h>
+#   define GB_BENCHMARK_HAVE_RUSAGE
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the tessellator modes count
+#define GB_BENCHMARK_MODE_MAXN              (GB_TESSELLATOR_MODE_STRIP + 1)
+
+// the default bitmap size for rasterizing
+#define GB_BENCHMARK_BITMAP_SIZE            (512)
+
+// the default maximum vertices of the random polygons for scaling
+#define GB_BENCHMARK_SCALING_MAXN           (1000000)
+
+// the vertices per measurement of the random polygons, the small polygons will be repeated
+#define GB_BENCHMARK_SCALING_VERTICES       (100000)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the benchmark format enum
+typedef enum __gb_benchmark_format_e
+{
+    GB_BENCHMARK_FORMAT_CSV     = 0
+,   GB_BENCHMARK_FORMAT_JSON    = 1
+
+}gb_benchmark_format_e;
+
+// the benchmark result type
+typedef struct __gb_benchmark_result_t
+{
+    // the name
+    tb_char_t const*        name;
+
+    // the paths count
+    tb_size_t               paths;
+
+    // the vertices count of the flattened polygons
+    tb_size_t               vertices;
+
+    // the iterations count
+    tb_size_t               iterations;
+
+    // the tessellated time (us) of all modes
+    tb_hong_t               tess_time[GB_BENCHMARK_MODE_MAXN];
+
+    // the tessellated points count of all modes
+    tb_size_t               tess_points[GB_BENCHMARK_MODE_MAXN];
+
+    // the rasterized time (us)
+    tb_hong_t               raster_time;
+
+    // the peak memory (kb) of the process
+    tb_size_t               peak_memory;
+
+}gb_benchmark_result_t, *gb_benchmark_result_ref_t;
+
+// the benchmark type
+typedef struct __gb_benchmark_t
+{
+    // the output format
+    tb_size_t               format;
+
+    // the iterations count
+    tb_size_t               iterations;
+
+    // the results count
+    tb_size_t               count;
+
+    // the tessellator
+    gb_tessellator_ref_t    tessellator;
+
+    // the bitmap
+    gb_bitmap_ref_t         bitmap;
+
+    // the canvas
+    gb_canvas_ref_t         canvas;
+
+}gb_benchmark_t, *gb_benchmark_ref_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * globals
+ */
+
+// the tessellator mode names
+static tb_char_t const* g_benchmark_modes[GB_BENCHMARK_MODE_MAXN] =
+{
+    "convex"
+,   "monotone"
+,   "triangulation"
+,   "strip"
+};
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static tb_size_t gb_benchmark_peak_memory(tb_noarg_t)
+{
+#ifdef GB_BENCHMARK_HAVE_RUSAGE
+    // get the maximum resident set size
+    struct rusage usage;
+    if (!getrusage(RUSAGE_SELF, &usage))
+    {
+#   if defined(TB_CONFIG_OS_MACOSX) || defined(TB_CONFIG_OS_IOS)
+        // bytes => kb
+        return (tb_size_t)(usage.ru_maxrss >> 10);
+#   else
+        return (tb_size_t)usage.ru_maxrss;
+#   endif
+    }
+#endif
+    return 0;
+}
+static tb_hize_t gb_benchmark_vertices_per_second(tb_size_t vertices, tb_size_t iterations, tb_hong_t time)
+{
+    return time > 0? (tb_hize_t)vertices * iterations * 1000000 / (tb_hize_t)time : 0;
+}
+static tb_void_t gb_benchmark_tessellator_func(gb_point_ref_t points, tb_uint16_t count, tb_cpointer_t priv)
+{
+    // count the tessellated points
+    tb_size_t* pcount = (tb_size_t*)priv;
+    if (pcount) *pcount += count;
+}
+static tb_void_t gb_benchmark_path_exit(tb_element_ref_t element, tb_pointer_t buff)
+{
+    // check
+    tb_assert_and_check_return(buff);
+
+    // exit path
+    gb_path_ref_t path = (gb_path_ref_t)*((tb_pointer_t*)buff);
+    if (path) gb_path_exit(path);
+}
+static tb_bool_t gb_benchmark_file_walk(tb_char_t const* path, tb_file_info_t const* info, tb_cpointer_t priv)
+{
+    // check
+    tb_vector_ref_t files = (tb_vector_ref_t)priv;
+    tb_assert_and_check_return_val(path && info && files, tb_false);
+
+    // save the .svg file
+    tb_size_t n = tb_strlen(path);
+    if (info->type == TB_FILE_TYPE_FILE && n > 4 && !tb_stricmp(path + n - 4, ".svg"))
+        tb_vector_insert_tail(files, path);
+
+    // continue
+    return tb_true;
+}
+static tb_void_t gb_benchmark_report_head(gb_benchmark_ref_t benchmark)
+{
+    // json?
+    if (benchmark->format == GB_BENCHMARK_FORMAT_JSON)
+    {
+        tb_printf("[\n");
+        return ;
+    }
+
+    // csv
+    tb_size_t mode = 0;
+    tb_printf("file,paths,vertices,iterations");
+    for (mode = 0; mode < GB_BENCHMARK_MODE_MAXN; mode++)
+        tb_printf(",%s_us,%s_vps,%s_points", g_benchmark_modes[mode], g_benchmark_modes[mode], g_benchmark_modes[mode]);
+    tb_printf(",raster_us,raster_vps,peak_kb\n");
+}
+static tb_void_t gb_benchmark_report_tail(gb_benchmark_ref_t benchmark)
+{
+    // json?
+    if (benchmark->format == GB_BENCHMARK_FORMAT_JSON) tb_printf("%s]\n", benchmark->count? "\n" : "");
+}
+static tb_void_t gb_benchmark_report(gb_benchmark_ref_t benchmark, gb_benchmark_result_ref_t result)
+{
+    // done
+    tb_size_t mode = 0;
+    if (benchmark->format == GB_BENCHMARK_FORMAT_JSON)
+    {
+        // the separator
+        if (benchmark->count) tb_printf(",\n");
+
+        // the result
+        tb_printf("  {\"file\": \"%s\", \"paths\": %lu, \"vertices\": %lu, \"iterations\": %lu", result->name, result->paths, result->vertices, result->iterations);
+        for (mode = 0; mode < GB_BENCHMARK_MODE_MAXN; mode++)
+        {
+            tb_printf(", \"%s\": {\"us\": %lld, \"vps\": %llu, \"points\": %lu}"
+                    , g_benchmark_modes[mode]
+                    , result->tess_time[mode]
+                    , gb_benchmark_vertices_per_second(result->vertices, result->iterations, result->tess_time[mode])
+                    , result->tess_points[mode]);
+        }
+        tb_printf(", \"raster\": {\"us\": %lld, \"vps\": %llu}, \"peak_kb\": %lu}"
+                , result->raster_time
+                , gb_benchmark_vertices_per_second(result->vertices, result->iterations, result->raster_time)
+                , result->peak_memory);
+    }
+    else
+    {
+        // the result
+        tb_printf("%s,%lu,%lu,%lu", result->name, result->paths, result->vertices, result->iterations);
+        for (mode = 0; mode < GB_BENCHMARK_MODE_MAXN; mode++)
+        {
+            tb_printf(",%lld,%llu,%lu"
+                    , result->tess_time[mode]
+                    , gb_benchmark_vertices_per_second(result->vertices, result->iterations, result->tess_time[mode])
+                    , result->tess_points[mode]);
+        }
+        tb_printf(",%lld,%llu,%lu\n"
+                , result->raster_time
+                , gb_benchmark_vertices_per_second(result->vertices, result->iterations, result->raster_time)
+                , result->peak_memory);
+    }
+
+    // update count
+    benchmark->count++;
+}
+static tb_void_t gb_benchmark_done(gb_benchmark_ref_t benchmark, tb_char_t const* name, tb_vector_ref_t paths, tb_size_t iterations)
+{
+    // check
+    tb_assert_and_check_return(benchmark && name && paths && iterations);
+
+    // init result
+    gb_benchmark_result_t result = {0};
+    result.name         = name;
+    result.paths        = tb_vector_size(paths);
+    result.iterations   = iterations;
+
+    // compute the vertices count and the bounds
+    gb_rect_t   bounds = {0};
+    tb_bool_t   bounds_init = tb_false;
+    tb_for_all_if (gb_path_ref_t, path, paths, path)
+    {
+        // the polygon
+        gb_polygon_ref_t polygon = gb_path_polygon(path);
+        if (polygon && polygon->counts)
+        {
+            tb_uint16_t const* counts = polygon->counts;
+            while (*counts) result.vertices += *counts++;
+        }
+
+        // merge bounds
+        gb_rect_ref_t rect = gb_path_bounds(path);
+        if (rect)
+        {
+            if (bounds_init)
+            {
+                gb_float_t x1 = tb_max(bounds.x + bounds.w, rect->x + rect->w);
+                gb_float_t y1 = tb_max(bounds.y + bounds.h, rect->y + rect->h);
+                bounds.x = tb_min(bounds.x, rect->x);
+                bounds.y = tb_min(bounds.y, rect->y);
+                bounds.w = x1 - bounds.x;
+                bounds.h = y1 - bounds.y;
+            }
+            else bounds = *rect;
+            bounds_init = tb_true;
+        }
+    }
+
+    // tessellate paths for all modes
+    tb_size_t mode = 0;
+    for (mode = 0; mode < GB_BENCHMARK_MODE_MAXN; mode++)
+    {
+        // init tessellator
+        gb_tessellator_mode_set(benchmark->tessellator, mode);
+        gb_tessellator_func_set(benchmark->tessellator, gb_benchmark_tessellator_func, &result.tess_points[mode]);
+
+        // done
+        tb_size_t i = 0;
+        tb_hong_t time = tb_uclock();
+        for (i = 0; i < iterations; i++)
+        {
+            tb_for_all_if (gb_path_ref_t, path, paths, path)
+            {
+                gb_polygon_ref_t    polygon = gb_path_polygon(path);
+                gb_rect_ref_t       rect = gb_path_bounds(path);
+                if (polygon && rect) gb_tessellator_done(benchmark->tessellator, polygon, rect);
+            }
+        }
+        result.tess_time[mode] = tb_uclock() - time;
+
+        // the points count of one iteration
+        result.tess_points[mode] /= iterations;
+    }
+
+    // rasterize paths into the offscreen bitmap
+    if (benchmark->canvas && bounds_init && bounds.w > 0 && bounds.h > 0)
+    {
+        // fit the bounds into the bitmap
+        gb_float_t size = gb_long_to_float(gb_bitmap_width(benchmark->bitmap));
+        gb_float_t scale = gb_div(size, tb_max(bounds.w, bounds.h));
+        gb_canvas_clear_matrix(benchmark->canvas);
+        gb_canvas_scale(benchmark->canvas, scale, scale);
+        gb_canvas_translate(benchmark->canvas, -bounds.x, -bounds.y);
+
+        // done
+        tb_size_t i = 0;
+        tb_hong_t time = 0;
+        for (i = 0; i < iterations; i++)
+        {
+            // clear it
+            gb_canvas_draw_clear(benchmark->canvas, GB_COLOR_WHITE);
+
+            // fill paths
+            tb_hong_t t = tb_uclock();
+            tb_for_all_if (gb_path_ref_t, path, paths, path)
+            {
+                gb_canvas_draw_path(benchmark->canvas, path);
+            }
+            time += tb_uclock() - t;
+        }
+        result.raster_time = time;
+    }
+
+    // the peak memory
+    result.peak_memory = gb_benchmark_peak_memory();
+
+    // report it
+    gb_benchmark_report(benchmark, &result);
+}
+static tb_void_t gb_benchmark_done_file(gb_benchmark_ref_t benchmark, tb_char_t const* url)
+{
+    // init paths
+    tb_vector_ref_t paths = tb_vector_init(256, tb_element_ptr(gb_benchmark_path_exit, tb_null));
+    tb_assert_and_check_return(paths);
+
+    // load shapes and done it
+    if (gb_benchmark_shape_load(url, paths)) gb_benchmark_done(benchmark, url, paths, benchmark->iterations);
+    else
+    {
+        // trace
+        tb_trace_e("no shapes: %s", url);
+    }
+
+    // exit paths
+    tb_vector_exit(paths);
+}
+static tb_void_t gb_benchmark_done_path(gb_benchmark_ref_t benchmark, tb_char_t const* url)
+{
+    // the file info
+    tb_file_info_t info;
+    if (!tb_file_info(url, &info))
+    {
+        tb_trace_e("not found: %s", url);
+        return ;
+    }
+
+    // is directory? done all .svg files in it
+    if (info.type == TB_FILE_TYPE_DIRECTORY)
+    {
+        // init files
+        tb_vector_ref_t files = tb_vector_init(256, tb_element_str(tb_true));
+        tb_assert_and_check_return(files);
+
+        // find files and sort them for the stable order
+        tb_directory_walk(url, tb_false, tb_true, gb_benchmark_file_walk, files);
+        tb_sort_all(files, tb_null);
+
+        // done files
+        tb_for_all_if (tb_char_t const*, file, files, file)
+        {
+            gb_benchmark_done_file(benchmark, file);
+        }
+
+        // exit files
+        tb_vector_exit(files);
+    }
+    else gb_benchmark_done_file(benchmark, url);
+}
+static tb_void_t gb_benchmark_done_scaling(gb_benchmark_ref_t benchmark, tb_size_t maxn)
+{
+    // init paths
+    tb_vector_ref_t paths = tb_vector_init(8, tb_element_ptr(gb_benchmark_path_exit, tb_null));
+    tb_assert_and_check_return(paths);
+
+    // done: 10, 100, 1000, ..., maxn vertices
+    tb_size_t count = 10;
+    for (count = 10; count <= maxn; count *= 10)
+    {
+        // make the random polygon
+        gb_path_ref_t path = gb_benchmark_shape_random(count, count);
+        tb_assert_and_check_break(path);
+        tb_vector_insert_tail(paths, path);
+
+        // the name
+        tb_char_t name[64];
+        tb_snprintf(name, sizeof(name), "random-%lu", count);
+
+        // done it, repeat the small polygons for the measurable time
+        gb_benchmark_done(benchmark, name, paths, tb_max(benchmark->iterations, GB_BENCHMARK_SCALING_VERTICES / count));
+
+        // clear paths
+        tb_vector_clear(paths);
+    }
+
+    // exit paths
+    tb_vector_exit(paths);
+}
+static tb_void_t gb_benchmark_help(tb_char_t const* name)
+{
+    tb_trace_i("usage: %s [options] [file|directory] ...", name);
+    tb_trace_i("");
+    tb_trace_i("  the .svg files and the tiger data are loaded, e.g. res/svg src/demo/core/tiger.g");
+    tb_trace_i("");
+    tb_trace_i("options:");
+    tb_trace_i("  --json                output the json format, the default format is csv");
+    tb_trace_i("  --iterations n        repeat each file n times, default: 1");
+    tb_trace_i("  --size n              the offscreen bitmap size, default: %d", GB_BENCHMARK_BITMAP_SIZE);
+    tb_trace_i("  --no-raster           only tessellate the shapes");
+    tb_trace_i("  --scaling [n]         measure the random self-intersecting polygons from 10 to n vertices, default: %d", GB_BENCHMARK_SCALING_MAXN);
+    tb_trace_i("  --help                show this help");
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * main
+ */
+tb_int_t main(tb_int_t argc, tb_char_t** argv)
+{
+    // init tbox
+    if (!tb_init(tb_null, tb_null)) return 0;
+
+    // init gbox
+    if (!gb_init()) return 0;
+
+    // init benchmark
+    gb_benchmark_t  benchmark = {0};
+    benchmark.format        = GB_BENCHMARK_FORMAT_CSV;
+    benchmark.iterations    = 1;
+
+    // init options
+    tb_int_t        ok = 0;
+    tb_int_t        i = 0;
+    tb_size_t       size = GB_BENCHMARK_BITMAP_SIZE;
+    tb_size_t       scaling = 0;
+    tb_bool_t       raster = tb_true;
+    tb_int_t        inputs = 0;
+    for (i = 1; i < argc; i++)
+    {
+        if (!tb_strcmp(argv[i], "--json")) benchmark.format = GB_BENCHMARK_FORMAT_JSON;
+        else if (!tb_strcmp(argv[i], "--csv")) benchmark.format = GB_BENCHMARK_FORMAT_CSV;
+        else if (!tb_strcmp(argv[i], "--no-raster")) raster = tb_false;
+        else if (!tb_strcmp(argv[i], "--iterations") && i + 1 < argc)
+        {
+            tb_long_t value = tb_atoi(argv[++i]);
+            benchmark.iterations = value > 0? (tb_size_t)value : 1;
+        }
+        else if (!tb_strcmp(argv[i], "--size") && i + 1 < argc)
+        {
+            tb_long_t value = tb_atoi(argv[++i]);
+            size = value > 0? (tb_size_t)value : GB_BENCHMARK_BITMAP_SIZE;
+        }
+        else if (!tb_strcmp(argv[i], "--scaling"))
+        {
+            // the maximum vertices
+            scaling = GB_BENCHMARK_SCALING_MAXN;
+            if (i + 1 < argc && tb_isdigit10(argv[i + 1][0]))
+            {
+                tb_long_t value = tb_atoi(argv[++i]);
+                scaling = value > 10? (tb_size_t)value : 10;
+            }
+        }
+        else if (!tb_strncmp(argv[i], "--", 2))
+        {
+            gb_benchmark_help(argv[0]);
+            ok = -1;
+            break;
+        }
+        else inputs++;
+    }
+
+    // done
+    do
+    {
+        // check
+        tb_check_break(!ok);
+        if (!inputs && !scaling)
+        {
+            gb_benchmark_help(argv[0]);
+            break;
+        }
+
+        // init tessellator, the svg uses the non-zero rule by default
+        benchmark.tessellator = gb_tessellator_init();
+        tb_assert_and_check_break(benchmark.tessellator);
+        gb_tessellator_rule_set(benchmark.tessellator, GB_TESSELLATOR_RULE_NONZERO);
+
+        // init the offscreen bitmap and canvas
+        if (raster)
+        {
+            benchmark.bitmap = gb_bitmap_init(tb_null, GB_PIXFMT_XRGB8888, size, size, 0, tb_false);
+            tb_assert_and_check_break(benchmark.bitmap);
+
+            benchmark.canvas = gb_canvas_init_from_bitmap(benchmark.bitmap);
+            tb_assert_and_check_break(benchmark.canvas);
+
+            gb_canvas_mode_set(benchmark.canvas, GB_PAINT_MODE_FILL);
+            gb_canvas_fill_rule_set(benchmark.canvas, GB_PAINT_FILL_RULE_NONZERO);
+            gb_canvas_color_set(benchmark.canvas, GB_COLOR_BLACK);
+        }
+
+        // done files
+        gb_benchmark_report_head(&benchmark);
+        for (i = 1; i < argc; i++)
+        {
+            // skip options
+            if (!tb_strncmp(argv[i], "--", 2))
+            {
+                if ((!tb_strcmp(argv[i], "--iterations") || !tb_strcmp(argv[i], "--size")) && i + 1 < argc) i++;
+                else if (!tb_strcmp(argv[i], "--scaling") && i + 1 < argc && tb_isdigit10(argv[i + 1][0])) i++;
+                continue;
+            }
+
+            // done path
+            gb_benchmark_done_path(&benchmark, argv[i]);
+        }
+
+        // done scaling
+        if (scaling) gb_benchmark_done_scaling(&benchmark, scaling);
+        gb_benchmark_report_tail(&benchmark);
+
+    } while (0);
+
+    // exit canvas
+    if (benchmark.canvas) gb_canvas_exit(benchmark.canvas);
+    benchmark.canvas = tb_null;
+
+    // exit bitmap
+    if (benchmark.bitmap) gb_bitmap_exit(benchmark.bitmap);
+    benchmark.bitmap = tb_null;
+
+    // exit tessellator
+    if (benchmark.tessellator) gb_tessellator_exit(benchmark.tessellator);
+    benchmark.tessellator = tb_null;
+
+    // exit gbox
+    gb_exit();
+
+    // exit tbox
+    tb_exit();
+
+    // ok?
+    return ok;
+}
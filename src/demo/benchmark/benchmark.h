@@ -0,0 +1,63 @@
+/*!The Graphic Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        benchmark.h
+ *
+ */
+#ifndef GB_BENCHMARK_H
+#define GB_BENCHMARK_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "gbox/gbox.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/*! load the shapes from the given file
+ *
+ * the .svg files are parsed for <path>, <polygon>, <polyline>, <rect>, <circle> and <ellipse>,
+ * the other files are scanned for the path data of the string literals, e.g. the tiger data: tiger.g
+ *
+ * @param url           the file url
+ * @param paths         the paths vector, each loaded shape will be appended as gb_path_ref_t
+ *
+ * @return              the loaded shapes count
+ */
+tb_size_t               gb_benchmark_shape_load(tb_char_t const* url, tb_vector_ref_t paths);
+
+/*! make a random self-intersecting polygon
+ *
+ * the vertices are distributed over jittered rings, 
+ * so the intersections grow linearly with the vertices count
+ *
+ * @param count         the vertices count
+ * @param seed          the random seed
+ *
+ * @return              the path
+ */
+gb_path_ref_t           gb_benchmark_shape_random(tb_size_t count, tb_size_t seed);
+
+#endif
+
+
@@ -0,0 +1,494 @@
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME            "shape"
+#define TB_TRACE_MODULE_DEBUG           (0)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "benchmark.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the maximum points count of the random ring, the contour counts of the polygon are 16-bits
+#define GB_BENCHMARK_SHAPE_RING_MAXN        (50000)
+
+// the radius of the random ring
+#define GB_BENCHMARK_SHAPE_RING_RADIUS      (1000)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static __tb_inline__ tb_char_t const* gb_benchmark_shape_skip_separator(tb_char_t const* p, tb_char_t const* e)
+{
+    while (p < e && (tb_isspace(*p) || *p == ',')) p++;
+    return p;
+}
+static tb_char_t const* gb_benchmark_shape_float(tb_char_t const* p, tb_char_t const* e, gb_float_t* value)
+{
+    // skip separator
+    p = gb_benchmark_shape_skip_separator(p, e);
+
+    // has sign?
+    tb_bool_t sign = tb_false;
+    if (p < e && (*p == '-' || *p == '+')) sign = (*p++ == '-');
+
+    // parse the mantissa and the decimal exponent, only keep 9 significant digits
+    tb_uint32_t mantissa    = 0;
+    tb_long_t   exponent    = 0;
+    tb_size_t   digits      = 0;
+    tb_size_t   significant = 0;
+    tb_bool_t   decimal     = tb_false;
+    while (p < e)
+    {
+        tb_char_t ch = *p;
+        if (tb_isdigit10(ch))
+        {
+            if (significant < 9)
+            {
+                mantissa = mantissa * 10 + (ch - '0');
+                if (mantissa) significant++;
+                if (decimal) exponent--;
+            }
+            else if (!decimal) exponent++;
+            digits++;
+        }
+        else if (ch == '.' && !decimal) decimal = tb_true;
+        else break;
+        p++;
+    }
+
+    // no digits? failed
+    tb_check_return_val(digits, tb_null);
+
+    // has exponent? e.g. 1e-5, but not the following command, e.g. 1e
+    if (p + 1 < e && (*p == 'e' || *p == 'E') && (tb_isdigit10(p[1]) || p[1] == '-' || p[1] == '+'))
+    {
+        p++;
+        tb_bool_t esign = tb_false;
+        if (*p == '-' || *p == '+') esign = (*p++ == '-');
+
+        tb_long_t evalue = 0;
+        while (p < e && tb_isdigit10(*p)) evalue = evalue * 10 + (*p++ - '0');
+        exponent += esign? -evalue : evalue;
+    }
+
+    // compute value
+    gb_float_t v = gb_long_to_float(mantissa);
+    for (; exponent > 0; exponent--) v = gb_imul(v, 10);
+    for (; exponent < 0 && v; exponent++) v = gb_idiv(v, 10);
+
+    // save value
+    *value = sign? -v : v;
+
+    // ok
+    return p;
+}
+static tb_void_t gb_benchmark_shape_path_data(gb_path_ref_t path, tb_char_t const* p, tb_char_t const* e)
+{
+    // check
+    tb_assert_and_check_return(path && p && e);
+
+    // done
+    tb_char_t   cmd     = '\0';
+    tb_char_t   last    = '\0';
+    gb_point_t  pt      = {0};
+    gb_point_t  start   = {0};
+    gb_point_t  ctrl    = {0};
+    gb_float_t  v[7];
+    while (1)
+    {
+        // skip separator
+        p = gb_benchmark_shape_skip_separator(p, e);
+        tb_check_break(p < e);
+
+        // the command? otherwise the repeated arguments of the last command
+        if (tb_isalpha(*p)) cmd = *p++;
+        else tb_check_break(cmd);
+
+        // the arguments count
+        tb_size_t n = 0;
+        tb_char_t c = tb_tolower(cmd);
+        switch (c)
+        {
+        case 'z':                       n = 0; break;
+        case 'h': case 'v':             n = 1; break;
+        case 'm': case 'l': case 't':   n = 2; break;
+        case 's': case 'q':             n = 4; break;
+        case 'c':                       n = 6; break;
+        case 'a':                       n = 7; break;
+        default:
+            // trace
+            tb_trace_d("unknown command: %c", cmd);
+            return ;
+        }
+
+        // read arguments
+        tb_size_t i = 0;
+        for (i = 0; i < n && p; i++) p = gb_benchmark_shape_float(p, e, &v[i]);
+        tb_check_break(p);
+
+        // relative? offset the points
+        gb_float_t dx = 0;
+        gb_float_t dy = 0;
+        if (cmd != c)
+        {
+            dx = pt.x;
+            dy = pt.y;
+        }
+
+        // done
+        switch (c)
+        {
+        case 'm':
+            gb_point_make(&pt, v[0] + dx, v[1] + dy);
+            gb_path_move_to(path, &pt);
+            start = pt;
+
+            // the repeated arguments of the move-to are line-to
+            cmd = (cmd == 'm')? 'l' : 'L';
+            break;
+        case 'l':
+            gb_point_make(&pt, v[0] + dx, v[1] + dy);
+            gb_path_line_to(path, &pt);
+            break;
+        case 'h':
+            pt.x = v[0] + dx;
+            gb_path_line_to(path, &pt);
+            break;
+        case 'v':
+            pt.y = v[0] + dy;
+            gb_path_line_to(path, &pt);
+            break;
+        case 'c':
+            gb_path_cubic2_to(path, v[0] + dx, v[1] + dy, v[2] + dx, v[3] + dy, v[4] + dx, v[5] + dy);
+            gb_point_make(&ctrl, v[2] + dx, v[3] + dy);
+            gb_point_make(&pt, v[4] + dx, v[5] + dy);
+            break;
+        case 's':
+            {
+                // reflect the last control point of the cubic curve
+                gb_point_t ctrl0 = pt;
+                if (last == 'c' || last == 's') gb_point_make(&ctrl0, pt.x + pt.x - ctrl.x, pt.y + pt.y - ctrl.y);
+
+                gb_path_cubic2_to(path, ctrl0.x, ctrl0.y, v[0] + dx, v[1] + dy, v[2] + dx, v[3] + dy);
+                gb_point_make(&ctrl, v[0] + dx, v[1] + dy);
+                gb_point_make(&pt, v[2] + dx, v[3] + dy);
+            }
+            break;
+        case 'q':
+            gb_path_quad2_to(path, v[0] + dx, v[1] + dy, v[2] + dx, v[3] + dy);
+            gb_point_make(&ctrl, v[0] + dx, v[1] + dy);
+            gb_point_make(&pt, v[2] + dx, v[3] + dy);
+            break;
+        case 't':
+            {
+                // reflect the last control point of the quad curve
+                gb_point_t ctrl0 = pt;
+                if (last == 'q' || last == 't') gb_point_make(&ctrl0, pt.x + pt.x - ctrl.x, pt.y + pt.y - ctrl.y);
+
+                gb_path_quad2_to(path, ctrl0.x, ctrl0.y, v[0] + dx, v[1] + dy);
+                ctrl = ctrl0;
+                gb_point_make(&pt, v[0] + dx, v[1] + dy);
+            }
+            break;
+        case 'a':
+            // the elliptical arc is approximated as the line to its end point, it is enough for benchmarking
+            gb_point_make(&pt, v[5] + dx, v[6] + dy);
+            gb_path_line_to(path, &pt);
+            break;
+        case 'z':
+            gb_path_clos(path);
+            pt = start;
+
+            // no repeated arguments for the close command
+            cmd = '\0';
+            break;
+        default:
+            break;
+        }
+
+        // save the last command
+        last = c;
+    }
+}
+static tb_void_t gb_benchmark_shape_points_data(gb_path_ref_t path, tb_char_t const* p, tb_char_t const* e, tb_bool_t closed)
+{
+    // done
+    gb_point_t  pt = {0};
+    tb_bool_t   first = tb_true;
+    while (p < e)
+    {
+        // read point
+        p = gb_benchmark_shape_float(p, e, &pt.x);
+        tb_check_break(p);
+        p = gb_benchmark_shape_float(p, e, &pt.y);
+        tb_check_break(p);
+
+        // add point
+        if (first) gb_path_move_to(path, &pt);
+        else gb_path_line_to(path, &pt);
+        first = tb_false;
+    }
+
+    // close it
+    if (closed && !first) gb_path_clos(path);
+}
+static tb_bool_t gb_benchmark_shape_attr(tb_char_t const* p, tb_char_t const* e, tb_char_t const* name, tb_char_t const** pb, tb_char_t const** pe)
+{
+    // find the attribute: name="value" or name='value'
+    tb_size_t n = tb_strlen(name);
+    for (; p + n + 2 < e; p++)
+    {
+        // find the attribute name
+        if (!tb_isspace(*p) || tb_strncmp(p + 1, name, n)) continue;
+
+        // find '='
+        tb_char_t const* q = p + n + 1;
+        while (q < e && tb_isspace(*q)) q++;
+        if (q >= e || *q != '=') continue;
+        q++;
+        while (q < e && tb_isspace(*q)) q++;
+        if (q >= e || (*q != '\"' && *q != '\'')) continue;
+
+        // find the end quote
+        tb_char_t const* b = q + 1;
+        tb_char_t const* t = b;
+        while (t < e && *t != *q) t++;
+        tb_check_return_val(t < e, tb_false);
+
+        // ok
+        *pb = b;
+        *pe = t;
+        return tb_true;
+    }
+    return tb_false;
+}
+static gb_float_t gb_benchmark_shape_attr_float(tb_char_t const* p, tb_char_t const* e, tb_char_t const* name)
+{
+    // find the attribute
+    tb_char_t const* b = tb_null;
+    tb_char_t const* t = tb_null;
+    tb_check_return_val(gb_benchmark_shape_attr(p, e, name, &b, &t), 0);
+
+    // read value
+    gb_float_t value = 0;
+    return gb_benchmark_shape_float(b, t, &value)? value : 0;
+}
+static tb_bool_t gb_benchmark_shape_tag(tb_char_t const* p, tb_char_t const* e, tb_char_t const* name)
+{
+    // is this tag? <name ...
+    tb_size_t n = tb_strlen(name);
+    return (p + n < e && !tb_strnicmp(p, name, n) && (tb_isspace(p[n]) || p[n] == '/' || p[n] == '>'))? tb_true : tb_false;
+}
+static tb_void_t gb_benchmark_shape_load_svg(tb_char_t const* data, tb_size_t size, tb_vector_ref_t paths)
+{
+    // done
+    tb_char_t const* p = data;
+    tb_char_t const* e = data + size;
+    while (p < e)
+    {
+        // find the tag
+        while (p < e && *p != '<') p++;
+        tb_check_break(++p < e);
+
+        // find the tag end
+        tb_char_t const* t = p;
+        while (t < e && *t != '>') t++;
+
+        // init path
+        gb_path_ref_t path = gb_path_init();
+        tb_assert_and_check_break(path);
+
+        // done tag, the transform attributes are ignored
+        tb_char_t const* b = tb_null;
+        tb_char_t const* q = tb_null;
+        if (gb_benchmark_shape_tag(p, t, "path") || gb_benchmark_shape_tag(p, t, "glyph") || gb_benchmark_shape_tag(p, t, "missing-glyph"))
+        {
+            if (gb_benchmark_shape_attr(p, t, "d", &b, &q)) gb_benchmark_shape_path_data(path, b, q);
+        }
+        else if (gb_benchmark_shape_tag(p, t, "polygon") || gb_benchmark_shape_tag(p, t, "polyline"))
+        {
+            if (gb_benchmark_shape_attr(p, t, "points", &b, &q)) gb_benchmark_shape_points_data(path, b, q, gb_benchmark_shape_tag(p, t, "polygon"));
+        }
+        else if (gb_benchmark_shape_tag(p, t, "rect"))
+        {
+            gb_rect_t rect;
+            rect.x = gb_benchmark_shape_attr_float(p, t, "x");
+            rect.y = gb_benchmark_shape_attr_float(p, t, "y");
+            rect.w = gb_benchmark_shape_attr_float(p, t, "width");
+            rect.h = gb_benchmark_shape_attr_float(p, t, "height");
+            if (rect.w > 0 && rect.h > 0) gb_path_add_rect(path, &rect, GB_ROTATE_DIRECTION_CW);
+        }
+        else if (gb_benchmark_shape_tag(p, t, "circle"))
+        {
+            gb_float_t r = gb_benchmark_shape_attr_float(p, t, "r");
+            if (r > 0) gb_path_add_circle2(path, gb_benchmark_shape_attr_float(p, t, "cx"), gb_benchmark_shape_attr_float(p, t, "cy"), r, GB_ROTATE_DIRECTION_CW);
+        }
+        else if (gb_benchmark_shape_tag(p, t, "ellipse"))
+        {
+            gb_float_t rx = gb_benchmark_shape_attr_float(p, t, "rx");
+            gb_float_t ry = gb_benchmark_shape_attr_float(p, t, "ry");
+            if (rx > 0 && ry > 0) gb_path_add_ellipse2(path, gb_benchmark_shape_attr_float(p, t, "cx"), gb_benchmark_shape_attr_float(p, t, "cy"), rx, ry, GB_ROTATE_DIRECTION_CW);
+        }
+
+        // save or exit path
+        if (!gb_path_null(path)) tb_vector_insert_tail(paths, path);
+        else gb_path_exit(path);
+
+        // next tag
+        p = t;
+    }
+}
+static tb_void_t gb_benchmark_shape_load_literal(tb_char_t const* data, tb_size_t size, tb_vector_ref_t paths)
+{
+    // done
+    tb_char_t const* p = data;
+    tb_char_t const* e = data + size;
+    while (p < e)
+    {
+        // find the string literal
+        while (p < e && *p != '\"') p++;
+        tb_check_break(++p < e);
+
+        // find the literal end
+        tb_char_t const* t = p;
+        while (t < e && *t != '\"') t++;
+
+        // is the path data? e.g. "M77.696 284.285C..."
+        if (*p == 'M' || *p == 'm')
+        {
+            // init path
+            gb_path_ref_t path = gb_path_init();
+            tb_assert_and_check_break(path);
+
+            // make path
+            gb_benchmark_shape_path_data(path, p, t);
+
+            // save or exit path
+            if (!gb_path_null(path)) tb_vector_insert_tail(paths, path);
+            else gb_path_exit(path);
+        }
+
+        // next literal
+        p = t + 1;
+    }
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_size_t gb_benchmark_shape_load(tb_char_t const* url, tb_vector_ref_t paths)
+{
+    // check
+    tb_assert_and_check_return_val(url && paths, 0);
+
+    // done
+    tb_size_t       count = tb_vector_size(paths);
+    tb_file_ref_t   file = tb_null;
+    tb_char_t*      data = tb_null;
+    do
+    {
+        // init file
+        file = tb_file_init(url, TB_FILE_MODE_RO);
+        tb_check_break(file);
+
+        // the file size
+        tb_size_t size = (tb_size_t)tb_file_size(file);
+        tb_check_break(size);
+
+        // read data
+        data = tb_malloc_cstr(size + 1);
+        tb_assert_and_check_break(data);
+        tb_size_t read = 0;
+        while (read < size)
+        {
+            tb_long_t real = tb_file_read(file, (tb_byte_t*)data + read, size - read);
+            tb_check_break(real > 0);
+            read += real;
+        }
+        tb_check_break(read == size);
+        data[size] = '\0';
+
+        // load shapes
+        tb_size_t n = tb_strlen(url);
+        if (n > 4 && !tb_stricmp(url + n - 4, ".svg")) gb_benchmark_shape_load_svg(data, size, paths);
+        else gb_benchmark_shape_load_literal(data, size, paths);
+
+    } while (0);
+
+    // exit data
+    if (data) tb_free(data);
+    data = tb_null;
+
+    // exit file
+    if (file) tb_file_exit(file);
+    file = tb_null;
+
+    // ok?
+    return tb_vector_size(paths) - count;
+}
+gb_path_ref_t gb_benchmark_shape_random(tb_size_t count, tb_size_t seed)
+{
+    // check
+    tb_assert_and_check_return_val(count >= 3, tb_null);
+
+    // init path
+    gb_path_ref_t path = gb_path_init();
+    tb_assert_and_check_return_val(path, tb_null);
+
+    // init random
+    tb_random_seed(tb_null, seed);
+
+    // the rings count and the grid columns
+    tb_size_t rings = (count + GB_BENCHMARK_SHAPE_RING_MAXN - 1) / GB_BENCHMARK_SHAPE_RING_MAXN;
+    tb_size_t cols  = 1;
+    while (cols * cols < rings) cols++;
+
+    // make rings
+    tb_size_t ring = 0;
+    tb_size_t left = count;
+    for (ring = 0; ring < rings; ring++)
+    {
+        // the points count of this ring
+        tb_size_t n = left / (rings - ring);
+        left -= n;
+
+        // the ring center
+        gb_float_t cx = gb_long_to_float((tb_long_t)(ring % cols) * GB_BENCHMARK_SHAPE_RING_RADIUS * 2);
+        gb_float_t cy = gb_long_to_float((tb_long_t)(ring / cols) * GB_BENCHMARK_SHAPE_RING_RADIUS * 2);
+
+        /* make the ring points
+         *
+         * the angle is jittered by +-1.5 step and the radius is jittered by +-2 edges,
+         * so the nearby edges cross each other frequently, but the spikes are short 
+         * and the sweep line only crosses a few edges at the same time
+         */
+        tb_size_t   i = 0;
+        gb_float_t  step = gb_idiv(gb_mul(GB_TWO, GB_PI), n);
+        gb_float_t  radius = gb_long_to_float(GB_BENCHMARK_SHAPE_RING_RADIUS);
+        gb_float_t  jitter = tb_min(gb_imul(gb_mul(step, radius), 2), radius / 2);
+        for (i = 0; i < n; i++)
+        {
+            // the jittered angle and radius
+            gb_float_t a = gb_imul(step, i) + gb_idiv(gb_imul(step, tb_random_range(tb_null, -150, 150)), 100);
+            gb_float_t r = radius + gb_idiv(gb_imul(jitter, tb_random_range(tb_null, -100, 100)), 100);
+
+            // the point
+            gb_float_t s;
+            gb_float_t c;
+            gb_sincos(a, &s, &c);
+            if (!i) gb_path_move2_to(path, cx + gb_mul(r, c), cy + gb_mul(r, s));
+            else gb_path_line2_to(path, cx + gb_mul(r, c), cy + gb_mul(r, s));
+        }
+
+        // close ring
+        gb_path_clos(path);
+    }
+
+    // ok
+    return path;
+}
@@ -557,6 +557,50 @@ static tb_void_t gb_demo_utils_mesh_tetrahedron()
     }
 }
 
+static tb_void_t gb_demo_utils_mesh_perf()
+{
+    // trace
+    tb_trace_i("==========================================================================");
+
+    // init mesh
+    gb_mesh_ref_t mesh = gb_mesh_init(tb_element_null(), tb_element_null(), tb_element_null());
+    if (mesh)
+    {
+        // done
+        tb_size_t i = 0;
+        tb_size_t n = 0;
+        tb_hong_t t = tb_mclock();
+        for (n = 0; n < 10; n++)
+        {
+            /* make a polygon with 65536 vertices
+             *
+             *  e0: v0 -> v1, e1: v1 -> v2, ..., en: vn -> v0
+             */
+            gb_mesh_edge_ref_t edge = gb_mesh_edge_make_loop(mesh, tb_true);
+            for (i = 1; i < 65536; i++) edge = gb_mesh_edge_split(mesh, edge);
+
+            /* triangulate it by cutting the ears
+             *
+             * edge: a -> b, edge.lnext: b -> c => connect: c -> a, the remaining polygon: a -> c -> ...
+             */
+            for (i = 3; i < 65536; i++) edge = gb_mesh_edge_sym(gb_mesh_edge_connect(mesh, gb_mesh_edge_lnext(edge), edge));
+
+            // check
+            tb_assert(gb_mesh_edge_lnext(gb_mesh_edge_lnext(gb_mesh_edge_lnext(edge))) == edge);
+
+            // clear it and reuse it
+            gb_mesh_clear(mesh);
+        }
+        t = tb_mclock() - t;
+
+        // trace
+        tb_trace_i("perf: make and triangulate a polygon with 65536 vertices x %lu: %lld ms", n, t);
+
+        // exit mesh
+        gb_mesh_exit(mesh);
+    }
+}
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * main
  */
@@ -577,5 +621,8 @@ tb_int_t gb_demo_utils_mesh_main(tb_int_t argc, tb_char_t** argv)
     // test tetrahedron
     gb_demo_utils_mesh_tetrahedron();
 
+    // test perf
+    gb_demo_utils_mesh_perf();
+
     return 0;
 }
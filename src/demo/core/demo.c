@@ -20,6 +20,7 @@
 #include "points.h"
 #include "circle.h"
 #include "ellipse.h"
+#include "polygon.h"
 #include "triangle.h"
 #include "round_rect.h"
  
@@ -66,6 +67,7 @@ static gb_demo_entry_t  g_entries[] =
 ,   {gb_demo_circle_init,       gb_demo_circle_exit,        gb_demo_circle_draw,        gb_demo_circle_event        }
 ,   {gb_demo_ellipse_init,      gb_demo_ellipse_exit,       gb_demo_ellipse_draw,       gb_demo_ellipse_event       }
 ,   {gb_demo_triangle_init,     gb_demo_triangle_exit,      gb_demo_triangle_draw,      gb_demo_triangle_event      }
+,   {gb_demo_polygon_init,      gb_demo_polygon_exit,       gb_demo_polygon_draw,       gb_demo_polygon_event       }
 ,   {gb_demo_arc_init,          gb_demo_arc_exit,           gb_demo_arc_draw,           gb_demo_arc_event           }
 ,   {gb_demo_tiger_init,        gb_demo_tiger_exit,         gb_demo_tiger_draw,         gb_demo_tiger_event         }
 };
@@ -91,6 +93,12 @@ static tb_byte_t        g_alpha = 255;
 // transform it?
 static tb_bool_t        g_transform = tb_false;
 
+// the canvas
+static gb_canvas_ref_t  g_canvas = tb_null;
+
+// the allocation count of each memory tag at the last info trace
+static tb_size_t        g_allocs[GB_MEMORY_TAG_MAXN];
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * private implementation
  */
@@ -105,6 +113,36 @@ static tb_void_t gb_demo_info(tb_bool_t killed, tb_cpointer_t priv)
 
     // trace
     tb_trace_i("framerate: %{float}", &framerate);
+
+    // the stats of the last frame
+    gb_device_stats_t stats;
+    if (g_canvas && gb_canvas_stats(g_canvas, &stats))
+    {
+        // trace
+        tb_trace_i("draws: clear: %lu, path: %lu, lines: %lu, points: %lu, polygon: %lu"
+                    , stats.draws[GB_DEVICE_DRAW_CLEAR]
+                    , stats.draws[GB_DEVICE_DRAW_PATH]
+                    , stats.draws[GB_DEVICE_DRAW_LINES]
+                    , stats.draws[GB_DEVICE_DRAW_POINTS]
+                    , stats.draws[GB_DEVICE_DRAW_POLYGON]);
+        tb_trace_i("points: %lu, flattened: %lu, strokes: %lu, tessellations: %lu", stats.points, stats.flattened, stats.strokes, stats.tessellations);
+        tb_trace_i("edges: %lu, scanlines: %lu, spans: %lu, pixels: written %lu, blended %lu", stats.edges, stats.scanlines, stats.spans, stats.pixels_written, stats.pixels_blended);
+        tb_trace_i("time: draw %lld us, flatten %lld us, stroke %lld us, raster %lld us, tessellate %lld us", stats.draw_time, stats.flatten_time, stats.stroke_time, stats.raster_time, stats.tessellate_time);
+    }
+
+    // the memory stats of all tags, the allocations per second will keep non-zero if a scene causes the heap churn
+    tb_size_t tag = 0;
+    for (tag = 0; tag < GB_MEMORY_TAG_MAXN; tag++)
+    {
+        gb_memory_stats_t memory;
+        if (!gb_memory_stats(tag, &memory)) break;
+
+        // trace
+        tb_trace_i("memory: %s: size %lu, peak %lu, count %lu, allocs %lu/s", gb_memory_name(tag), memory.size, memory.peak, memory.count, memory.allocs - g_allocs[tag]);
+
+        // save the allocation count
+        g_allocs[tag] = memory.allocs;
+    }
 }
 
 /* //////////////////////////////////////////////////////////////////////////////////////
@@ -121,6 +159,9 @@ tb_bool_t gb_demo_init(gb_window_ref_t window, gb_canvas_ref_t canvas, tb_cpoint
     // init quality
     gb_quality_set(g_quality);
 
+    // save canvas for the info trace
+    g_canvas = canvas;
+
     // the x0 and y0
     gb_float_t x0 = gb_long_to_float(gb_window_width(window) >> 1);
     gb_float_t y0 = gb_long_to_float(gb_window_height(window) >> 1);
@@ -252,6 +293,7 @@ tb_void_t gb_demo_event(gb_window_ref_t window, gb_event_ref_t event, tb_cpointe
             g_transform = !g_transform;
             break;
         case 'i':
+            if (g_canvas) gb_canvas_stats_enable(g_canvas, tb_true);
             tb_timer_task_post(gb_window_timer(window), 1000, tb_true, gb_demo_info, (tb_cpointer_t)window);
             break;
         default:
@@ -0,0 +1,69 @@
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME            "polygon"
+#define TB_TRACE_MODULE_DEBUG           (0)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */ 
+#include "polygon.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+/* the vertices count of the star polygon
+ *
+ * it is a large concave polygon without bounds, so the gl device will fill it by stencil-then-cover
+ */
+#define GB_DEMO_POLYGON_POINTS          (4096)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * globals
+ */
+
+// the points, the last point closes the contour
+static gb_point_t       g_points[GB_DEMO_POLYGON_POINTS + 1];
+
+// the counts
+static tb_uint16_t      g_counts[] = {GB_DEMO_POLYGON_POINTS + 1, 0};
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_void_t gb_demo_polygon_init(gb_window_ref_t window)
+{
+    // make the star points with the inner and outer radius
+    tb_size_t i;
+    for (i = 0; i < GB_DEMO_POLYGON_POINTS; i++)
+    {
+        gb_float_t s;
+        gb_float_t c;
+        gb_float_t r = gb_long_to_float((i & 1)? 150 : 200);
+        gb_sincos(gb_mul(GB_PI, gb_long_to_float(i << 1)) / GB_DEMO_POLYGON_POINTS, &s, &c);
+        gb_point_make(&g_points[i], gb_mul(r, c), gb_mul(r, s));
+    }
+    g_points[GB_DEMO_POLYGON_POINTS] = g_points[0];
+}
+tb_void_t gb_demo_polygon_exit(gb_window_ref_t window)
+{
+}
+tb_void_t gb_demo_polygon_draw(gb_window_ref_t window, gb_canvas_ref_t canvas)
+{
+    // polygon
+    gb_polygon_t polygon = {g_points, g_counts, tb_false};
+
+    // fill
+    gb_canvas_color_set(canvas, GB_COLOR_RED);
+    gb_canvas_mode_set(canvas, GB_PAINT_MODE_FILL);
+    gb_canvas_draw_polygon(canvas, &polygon);
+
+    // stroke
+    gb_canvas_color_set(canvas, GB_COLOR_BLUE);
+    gb_canvas_mode_set(canvas, GB_PAINT_MODE_STROKE);
+    gb_canvas_draw_polygon(canvas, &polygon);
+}
+tb_void_t gb_demo_polygon_event(gb_window_ref_t window, gb_event_ref_t event)
+{
+}
@@ -1,2 +1,2 @@
 -- add projects
-add_subdirs("console", "core") 
+add_subdirs("console", "core", "benchmark") 
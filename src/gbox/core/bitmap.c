@@ -40,15 +40,27 @@ typedef struct __gb_bitmap_impl_t
 	// the data
 	tb_pointer_t 		data;
 
+	// the reference count
+	tb_atomic_t 		refn;
+
 	// the size
 	tb_size_t 			size;
 
+	// the release func of the external data
+	gb_bitmap_release_func_t release;
+
+	// the release private data
+	tb_cpointer_t       release_priv;
+
 	// is owner?
 	tb_uint8_t 			is_owner    : 1;
 
 	// has alpha?
 	tb_uint8_t 			has_alpha   : 1;
 
+	// is bottom-up? the data is the top row and the rows go up in memory
+	tb_uint8_t 			bottom_up   : 1;
+
 	// the pixfmt
 	tb_uint16_t         pixfmt;
 
@@ -61,8 +73,57 @@ typedef struct __gb_bitmap_impl_t
 	// the lpitch
 	tb_uint16_t         row_bytes;
 
+    // the content version
+    tb_size_t           version;
+
+    // the version since which only the dirty rows have been modified
+    tb_size_t           dirty_version;
+
+    // the top of the dirty rows
+    tb_uint16_t         dirty_top;
+
+    // the bottom of the dirty rows, no dirty rows if be equal to the top
+    tb_uint16_t         dirty_bottom;
+
 }gb_bitmap_impl_t;
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * globals
+ */
+
+// the content version, it is unique for all bitmaps
+static tb_atomic_t      g_version = 0;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static tb_void_t gb_bitmap_changed(gb_bitmap_impl_t* impl)
+{
+    // check
+    tb_assert(impl);
+
+    // all rows have been changed
+    impl->version       = (tb_size_t)tb_atomic_fetch_and_inc(&g_version) + 1;
+    impl->dirty_version = impl->version;
+    impl->dirty_top     = 0;
+    impl->dirty_bottom  = 0;
+}
+static tb_void_t gb_bitmap_data_exit(gb_bitmap_impl_t* impl)
+{
+    // check
+    tb_assert(impl);
+
+    // exit data
+    if (impl->data)
+    {
+        if (impl->is_owner) tb_free(impl->data);
+        else if (impl->release) impl->release(impl->data, impl->release_priv);
+    }
+    impl->data          = tb_null;
+    impl->release       = tb_null;
+    impl->release_priv  = tb_null;
+}
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
  */
@@ -98,8 +159,12 @@ gb_bitmap_ref_t gb_bitmap_init(tb_pointer_t data, tb_size_t pixfmt, tb_size_t wi
         impl->data          = data? data : tb_malloc0(impl->size);
         impl->has_alpha     = !!has_alpha;
         impl->is_owner      = !data;
+        impl->refn          = 1;
         tb_assert_and_check_break(impl->data);
 
+        // init version
+        gb_bitmap_changed(impl);
+
         // ok
         ok = tb_true;
 
@@ -116,6 +181,21 @@ gb_bitmap_ref_t gb_bitmap_init(tb_pointer_t data, tb_size_t pixfmt, tb_size_t wi
     // ok?
     return (gb_bitmap_ref_t)impl;
 }
+gb_bitmap_ref_t gb_bitmap_init_with_stride(tb_pointer_t data, tb_size_t pixfmt, tb_size_t width, tb_size_t height, tb_long_t row_stride, tb_bool_t has_alpha)
+{
+    // check
+    tb_assert_and_check_return_val(data && row_stride, tb_null);
+
+    // init bitmap
+    gb_bitmap_impl_t* impl = (gb_bitmap_impl_t*)gb_bitmap_init(data, pixfmt, width, height, (tb_size_t)tb_abs(row_stride), has_alpha);
+    tb_check_return_val(impl, tb_null);
+
+    // bottom-up?
+    impl->bottom_up = row_stride < 0;
+
+    // ok
+    return (gb_bitmap_ref_t)impl;
+}
 gb_bitmap_ref_t gb_bitmap_init_from_url(tb_size_t pixfmt, tb_char_t const* url)
 {
     // check
@@ -160,13 +240,34 @@ tb_void_t gb_bitmap_exit(gb_bitmap_ref_t bitmap)
 	gb_bitmap_impl_t* impl = (gb_bitmap_impl_t*)bitmap;
     tb_assert_and_check_return(impl);
 
+    // referenced by others?
+    if (tb_atomic_fetch_and_dec(&impl->refn) > 1) return ;
+
     // exit data
-    if (impl->is_owner && impl->data) tb_free(impl->data);
-    impl->data = tb_null;
+    gb_bitmap_data_exit(impl);
 
     // exit it
     tb_free(impl);
 }
+gb_bitmap_ref_t gb_bitmap_retain(gb_bitmap_ref_t bitmap)
+{
+    // check
+	gb_bitmap_impl_t* impl = (gb_bitmap_impl_t*)bitmap;
+	tb_assert_and_check_return_val(impl, tb_null);
+
+    // retain it
+    tb_atomic_fetch_and_inc(&impl->refn);
+	return bitmap;
+}
+tb_size_t gb_bitmap_refn(gb_bitmap_ref_t bitmap)
+{
+    // check
+	gb_bitmap_impl_t* impl = (gb_bitmap_impl_t*)bitmap;
+	tb_assert_and_check_return_val(impl, 0);
+
+    // the reference count
+	return (tb_size_t)tb_atomic_get(&impl->refn);
+}
 tb_size_t gb_bitmap_size(gb_bitmap_ref_t bitmap)
 {
     // check
@@ -207,7 +308,7 @@ tb_bool_t gb_bitmap_data_set(gb_bitmap_ref_t bitmap, tb_pointer_t data, tb_size_
         tb_assert_and_check_break(row_bytes && row_bytes >= width * pixmap->btp);
 
         // exit it first
-        if (impl->data && impl->data != data && impl->is_owner) tb_free(impl->data);
+        if (impl->data != data) gb_bitmap_data_exit(impl);
 
         // update bitmap 
         impl->pixfmt        = (tb_uint16_t)pixfmt;
@@ -217,8 +318,12 @@ tb_bool_t gb_bitmap_data_set(gb_bitmap_ref_t bitmap, tb_pointer_t data, tb_size_
         impl->size          = row_bytes * height;
         impl->row_bytes 	= (tb_uint16_t)row_bytes;
         impl->is_owner      = 1;
+        impl->bottom_up     = 0;
         impl->has_alpha     = !!has_alpha;
 
+        // all rows have been changed
+        gb_bitmap_changed(impl);
+
         // ok
         ok = tb_true;
 
@@ -227,6 +332,16 @@ tb_bool_t gb_bitmap_data_set(gb_bitmap_ref_t bitmap, tb_pointer_t data, tb_size_
     // ok?
     return ok;
 }
+tb_void_t gb_bitmap_release_set(gb_bitmap_ref_t bitmap, gb_bitmap_release_func_t release, tb_cpointer_t priv)
+{
+    // check
+	gb_bitmap_impl_t* impl = (gb_bitmap_impl_t*)bitmap;
+	tb_assert_and_check_return(impl && !impl->is_owner);
+
+    // done
+    impl->release       = release;
+    impl->release_priv  = priv;
+}
 tb_bool_t gb_bitmap_resize(gb_bitmap_ref_t bitmap, tb_size_t width, tb_size_t height)
 {
     // check
@@ -265,6 +380,9 @@ tb_bool_t gb_bitmap_resize(gb_bitmap_ref_t bitmap, tb_size_t width, tb_size_t he
         tb_assert_and_check_return_val(impl->data, tb_false);
     }
 
+    // all rows have been changed
+    gb_bitmap_changed(impl);
+
 	// ok
 	return tb_true;
 }
@@ -322,3 +440,76 @@ tb_size_t gb_bitmap_row_bytes(gb_bitmap_ref_t bitmap)
     // the row bytes
 	return impl->row_bytes;
 }
+tb_long_t gb_bitmap_row_stride(gb_bitmap_ref_t bitmap)
+{
+    // check
+	gb_bitmap_impl_t* impl = (gb_bitmap_impl_t*)bitmap;
+	tb_assert_and_check_return_val(impl, 0);
+
+    // the row stride
+	return impl->bottom_up? -(tb_long_t)impl->row_bytes : (tb_long_t)impl->row_bytes;
+}
+tb_size_t gb_bitmap_version(gb_bitmap_ref_t bitmap)
+{
+    // check
+	gb_bitmap_impl_t* impl = (gb_bitmap_impl_t*)bitmap;
+	tb_assert_and_check_return_val(impl, 0);
+
+    // the version
+	return impl->version;
+}
+tb_void_t gb_bitmap_modified(gb_bitmap_ref_t bitmap, tb_size_t y, tb_size_t h)
+{
+    // check
+	gb_bitmap_impl_t* impl = (gb_bitmap_impl_t*)bitmap;
+	tb_assert_and_check_return(impl);
+
+    // all rows?
+    if (!h || (!y && h >= impl->height))
+    {
+        gb_bitmap_changed(impl);
+        return ;
+    }
+
+    // the modified rows
+    tb_size_t top = tb_min(y, impl->height);
+    tb_size_t bottom = tb_min(y + h, impl->height);
+    tb_check_return(top < bottom);
+
+    // merge them to the dirty rows
+    if (impl->dirty_top < impl->dirty_bottom)
+    {
+        if (top < impl->dirty_top) impl->dirty_top = (tb_uint16_t)top;
+        if (bottom > impl->dirty_bottom) impl->dirty_bottom = (tb_uint16_t)bottom;
+    }
+    else
+    {
+        impl->dirty_top     = (tb_uint16_t)top;
+        impl->dirty_bottom  = (tb_uint16_t)bottom;
+    }
+
+    // update version
+    impl->version = (tb_size_t)tb_atomic_fetch_and_inc(&g_version) + 1;
+}
+tb_bool_t gb_bitmap_modified_rows(gb_bitmap_ref_t bitmap, tb_size_t version, tb_size_t* y, tb_size_t* h)
+{
+    // check
+	gb_bitmap_impl_t* impl = (gb_bitmap_impl_t*)bitmap;
+	tb_assert_and_check_return_val(impl && y && h, tb_false);
+
+    // not modified?
+    if (version == impl->version)
+    {
+        *y = 0;
+        *h = 0;
+        return tb_true;
+    }
+
+    // all rows have been changed since this version?
+    tb_check_return_val(version >= impl->dirty_version && version < impl->version, tb_false);
+
+    // only the dirty rows have been modified
+    *y = impl->dirty_top;
+    *h = impl->dirty_bottom - impl->dirty_top;
+    return tb_true;
+}
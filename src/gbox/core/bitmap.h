@@ -36,6 +36,17 @@
  */
 __tb_extern_c_enter__
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+/*! the bitmap data release func type
+ *
+ * @param data      the bitmap data
+ * @param priv      the user private data
+ */
+typedef tb_void_t   (*gb_bitmap_release_func_t)(tb_pointer_t data, tb_cpointer_t priv);
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * interfaces
  */
@@ -53,6 +64,22 @@ __tb_extern_c_enter__
  */
 gb_bitmap_ref_t     gb_bitmap_init(tb_pointer_t data, tb_size_t pixfmt, tb_size_t width, tb_size_t height, tb_size_t row_bytes, tb_bool_t has_alpha);
 
+/*! init bitmap with the external data and the signed row stride
+ *
+ * the row y is at data + y * row_stride, so the bottom-up data (e.g. bmp) can be wrapped 
+ * without copying it by passing the last row in memory and a negative row stride
+ *
+ * @param data      the data of the top row, cannot be null and will not be freed
+ * @param pixfmt    the pixfmt 
+ * @param width     the width 
+ * @param height    the height 
+ * @param row_stride the signed row stride
+ * @param has_alpha has alpha?
+ *
+ * @return          the bitmap
+ */
+gb_bitmap_ref_t     gb_bitmap_init_with_stride(tb_pointer_t data, tb_size_t pixfmt, tb_size_t width, tb_size_t height, tb_long_t row_stride, tb_bool_t has_alpha);
+
 /*! init bitmap from url
  *
  * @param pixfmt    the pixfmt 
@@ -72,11 +99,31 @@ gb_bitmap_ref_t     gb_bitmap_init_from_url(tb_size_t pixfmt, tb_char_t const* u
 gb_bitmap_ref_t     gb_bitmap_init_from_stream(tb_size_t pixfmt, tb_stream_ref_t stream);
 
 /*! exit bitmap 
+ *
+ * release one reference and free it if the reference count becomes zero
  *
  * @param bitmap    the bitmap
  */
 tb_void_t           gb_bitmap_exit(gb_bitmap_ref_t bitmap);
 
+/*! retain bitmap 
+ *
+ * the new reference need be released by gb_bitmap_exit()
+ *
+ * @param bitmap    the bitmap
+ *
+ * @return          the bitmap
+ */
+gb_bitmap_ref_t     gb_bitmap_retain(gb_bitmap_ref_t bitmap);
+
+/*! the reference count of bitmap 
+ *
+ * @param bitmap    the bitmap
+ *
+ * @return          the reference count
+ */
+tb_size_t           gb_bitmap_refn(gb_bitmap_ref_t bitmap);
+
 /*! the bitmap data size
  *
  * @param bitmap    the bitmap
@@ -89,7 +136,7 @@ tb_size_t           gb_bitmap_size(gb_bitmap_ref_t bitmap);
  *
  * @param bitmap    the bitmap
  *
- * @return          the bitmap data 
+ * @return          the bitmap data of the top row
  */
 tb_pointer_t        gb_bitmap_data(gb_bitmap_ref_t bitmap);
 
@@ -107,6 +154,17 @@ tb_pointer_t        gb_bitmap_data(gb_bitmap_ref_t bitmap);
  */
 tb_bool_t           gb_bitmap_data_set(gb_bitmap_ref_t bitmap, tb_pointer_t data, tb_size_t pixfmt, tb_size_t width, tb_size_t height, tb_size_t row_bytes, tb_bool_t has_alpha);
 
+/*! set the release func of the external bitmap data
+ *
+ * it will be called when the bitmap is exited or the data is replaced, 
+ * e.g. unmapping the file mapping of the wrapped data
+ *
+ * @param bitmap    the bitmap
+ * @param release   the release func
+ * @param priv      the user private data
+ */
+tb_void_t           gb_bitmap_release_set(gb_bitmap_ref_t bitmap, gb_bitmap_release_func_t release, tb_cpointer_t priv);
+
 /*! resize the bitmap
  *
  * @param bitmap    the bitmap
@@ -164,6 +222,47 @@ tb_void_t           gb_bitmap_set_alpha(gb_bitmap_ref_t bitmap, tb_bool_t has_al
  */
 tb_size_t           gb_bitmap_row_bytes(gb_bitmap_ref_t bitmap);
 
+/*! the bitmap row stride
+ *
+ * @param bitmap    the bitmap
+ *
+ * @return          the signed row stride, negative for the bottom-up data
+ */
+tb_long_t           gb_bitmap_row_stride(gb_bitmap_ref_t bitmap);
+
+/*! the bitmap content version
+ *
+ * the version is unique for all bitmaps and will be changed after modifying the pixels,
+ * so the bitmap and its version can identify the content, e.g. for caching the uploaded texture.
+ *
+ * @param bitmap    the bitmap
+ *
+ * @return          the content version
+ */
+tb_size_t           gb_bitmap_version(gb_bitmap_ref_t bitmap);
+
+/*! mark the rows of the bitmap as modified
+ *
+ * it need be called after modifying the pixels of the bitmap data directly,
+ * and the content version will be changed.
+ *
+ * @param bitmap    the bitmap
+ * @param y         the top row
+ * @param h         the row count, all rows will be marked if be zero
+ */
+tb_void_t           gb_bitmap_modified(gb_bitmap_ref_t bitmap, tb_size_t y, tb_size_t h);
+
+/*! the modified rows since the given content version
+ *
+ * @param bitmap    the bitmap
+ * @param version   the old content version
+ * @param y         the top row of the modified rows
+ * @param h         the modified row count, zero if not modified
+ *
+ * @return          tb_true if only these rows have been modified, tb_false if all rows have been changed
+ */
+tb_bool_t           gb_bitmap_modified_rows(gb_bitmap_ref_t bitmap, tb_size_t version, tb_size_t* y, tb_size_t* h);
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
  */
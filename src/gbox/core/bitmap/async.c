@@ -0,0 +1,520 @@
+/*!The Graphic Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        async.c
+ * @ingroup     core
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME            "bitmap_async"
+#define TB_TRACE_MODULE_DEBUG           (0)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "async.h"
+#include "decoder.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the bitmap decode task impl type
+typedef struct __gb_bitmap_decode_task_impl_t
+{
+    // the reference count, the pending queue and the user handle
+    tb_atomic_t                 refn;
+
+    // the sequence number for keeping the order of the same priority
+    tb_size_t                   seqn;
+
+    // the priority
+    tb_uint8_t                  priority;
+
+    // is killed?
+    tb_uint8_t                  killed      : 1;
+
+    // is finished?
+    tb_uint8_t                  finished    : 1;
+
+    // the pixfmt
+    tb_uint16_t                 pixfmt;
+
+    // the target width
+    tb_uint16_t                 width;
+
+    // the target height
+    tb_uint16_t                 height;
+
+    // the user stream
+    tb_stream_ref_t             stream;
+
+    // the url stream which is being decoded, will be killed if cancelled
+    tb_stream_ref_t             decoding;
+
+    // the func
+    gb_bitmap_decode_func_t     func;
+
+    // the user private data
+    tb_cpointer_t               priv;
+
+    // the url, it is stored after the task
+    tb_char_t const*            url;
+
+}gb_bitmap_decode_task_impl_t;
+
+// the bitmap decode scheduler type
+typedef struct __gb_bitmap_decode_scheduler_t
+{
+    // the lock
+    tb_spinlock_t               lock;
+
+    // the thread pool
+    tb_thread_pool_ref_t        pool;
+
+    // the pending tasks, the highest priority is at top
+    tb_priority_queue_ref_t     tasks;
+
+    // the sequence number
+    tb_size_t                   seqn;
+
+}gb_bitmap_decode_scheduler_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * globals
+ */
+
+/* the decoding scheduler
+ *
+ * it is a private static instance instead of a tbox singleton,
+ * so it will not occupy the TB_SINGLETON_TYPE_USER slots of the application
+ */
+static tb_atomic_t                      g_scheduler_inited = 0;
+static gb_bitmap_decode_scheduler_t*    g_scheduler = tb_null;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * declaration
+ */
+static tb_void_t gb_bitmap_decode_task_done(gb_bitmap_decode_task_impl_t* task, tb_size_t state, gb_bitmap_ref_t bitmap);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static tb_long_t gb_bitmap_decode_task_comp(tb_element_ref_t element, tb_cpointer_t ldata, tb_cpointer_t rdata)
+{
+    // check
+    gb_bitmap_decode_task_impl_t const* ltask = (gb_bitmap_decode_task_impl_t const*)ldata;
+    gb_bitmap_decode_task_impl_t const* rtask = (gb_bitmap_decode_task_impl_t const*)rdata;
+    tb_assert(ltask && rtask);
+
+    // the higher priority first and the earlier task first
+    if (ltask->priority != rtask->priority) return ltask->priority > rtask->priority? -1 : 1;
+    return ltask->seqn < rtask->seqn? -1 : (ltask->seqn > rtask->seqn);
+}
+static tb_void_t gb_bitmap_decode_task_release(gb_bitmap_decode_task_impl_t* task)
+{
+    // check
+    tb_assert_and_check_return(task);
+
+    // referenced by others?
+    if (tb_atomic_fetch_and_dec(&task->refn) > 1) return ;
+
+    // exit it
+    tb_free(task);
+}
+static gb_bitmap_ref_t gb_bitmap_decode_task_decode(gb_bitmap_decode_scheduler_t* scheduler, gb_bitmap_decode_task_impl_t* task)
+{
+    // init the url stream
+    tb_stream_ref_t stream = task->stream;
+    if (!stream)
+    {
+        // init it
+        stream = tb_stream_init_from_url(task->url);
+        tb_assert_and_check_return_val(stream, tb_null);
+
+        // attach it for killing it if cancelled
+        tb_spinlock_enter(&scheduler->lock);
+        tb_bool_t killed = task->killed;
+        if (!killed) task->decoding = stream;
+        tb_spinlock_leave(&scheduler->lock);
+
+        // killed?
+        if (killed)
+        {
+            tb_stream_exit(stream);
+            return tb_null;
+        }
+    }
+
+    // done
+    gb_bitmap_ref_t         bitmap = tb_null;
+    gb_bitmap_decoder_ref_t decoder = tb_null;
+    do
+    {
+        // open stream
+        if (!tb_stream_is_opened(stream) && !tb_stream_open(stream)) break;
+
+        // init bitmap decoder
+        decoder = gb_bitmap_decoder_init(task->pixfmt, stream);
+        tb_check_break(decoder);
+
+        // set the target size
+        if (task->width || task->height) gb_bitmap_decoder_size_set(decoder, task->width, task->height);
+
+        // done bitmap decoder
+        bitmap = gb_bitmap_decoder_done(decoder);
+
+    } while (0);
+
+    // exit bitmap decoder
+    if (decoder) gb_bitmap_decoder_exit(decoder);
+    decoder = tb_null;
+
+    // exit the url stream
+    if (stream != task->stream)
+    {
+        // detach it
+        tb_spinlock_enter(&scheduler->lock);
+        task->decoding = tb_null;
+        tb_spinlock_leave(&scheduler->lock);
+
+        // exit it
+        tb_stream_exit(stream);
+    }
+
+    // ok?
+    return bitmap;
+}
+static tb_void_t gb_bitmap_decode_worker_done(tb_thread_pool_worker_ref_t worker, tb_cpointer_t priv)
+{
+    // check
+    gb_bitmap_decode_scheduler_t* scheduler = (gb_bitmap_decode_scheduler_t*)priv;
+    tb_assert_and_check_return(scheduler);
+
+    /* pop the task with the highest priority
+     *
+     * one pool task is posted for each decode task, so we need not keep the pool task for it
+     */
+    tb_spinlock_enter(&scheduler->lock);
+    gb_bitmap_decode_task_impl_t* task = tb_null;
+    if (tb_priority_queue_size(scheduler->tasks))
+    {
+        task = (gb_bitmap_decode_task_impl_t*)tb_priority_queue_get(scheduler->tasks);
+        tb_priority_queue_pop(scheduler->tasks);
+    }
+    tb_bool_t killed = task? task->killed : tb_false;
+    tb_spinlock_leave(&scheduler->lock);
+    tb_check_return(task);
+
+    // decode it if not killed
+    gb_bitmap_ref_t bitmap = killed? tb_null : gb_bitmap_decode_task_decode(scheduler, task);
+
+    // killed after decoding? it cannot be cancelled after finished
+    tb_spinlock_enter(&scheduler->lock);
+    killed = task->killed;
+    task->finished = 1;
+    tb_spinlock_leave(&scheduler->lock);
+    if (killed && bitmap)
+    {
+        gb_bitmap_exit(bitmap);
+        bitmap = tb_null;
+    }
+
+    // done it
+    gb_bitmap_decode_task_done(task, killed? TB_STATE_KILLED : (bitmap? TB_STATE_OK : TB_STATE_FAILED), bitmap);
+
+    // release it
+    gb_bitmap_decode_task_release(task);
+}
+static gb_bitmap_decode_scheduler_t* gb_bitmap_decode_scheduler_init()
+{
+    // done
+    tb_bool_t                       ok = tb_false;
+    gb_bitmap_decode_scheduler_t*   scheduler = tb_null;
+    do
+    {
+        // make scheduler
+        scheduler = tb_malloc0_type(gb_bitmap_decode_scheduler_t);
+        tb_assert_and_check_break(scheduler);
+
+        // init lock
+        if (!tb_spinlock_init(&scheduler->lock)) break;
+
+        // init tasks
+        tb_element_t element = tb_element_ptr(tb_null, tb_null);
+        element.comp = gb_bitmap_decode_task_comp;
+        scheduler->tasks = tb_priority_queue_init(0, element);
+        tb_assert_and_check_break(scheduler->tasks);
+
+        // init the bounded thread pool
+        tb_size_t worker_maxn = tb_min(tb_processor_count(), GB_BITMAP_DECODE_WORKER_MAXN);
+        scheduler->pool = tb_thread_pool_init(tb_max(worker_maxn, 1), 0);
+        tb_assert_and_check_break(scheduler->pool);
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // failed?
+    if (!ok && scheduler)
+    {
+        if (scheduler->tasks) tb_priority_queue_exit(scheduler->tasks);
+        tb_spinlock_exit(&scheduler->lock);
+        tb_free(scheduler);
+        scheduler = tb_null;
+    }
+
+    // ok?
+    return scheduler;
+}
+static tb_void_t gb_bitmap_decode_scheduler_kill(gb_bitmap_decode_scheduler_t* scheduler)
+{
+    // check
+    tb_assert_and_check_return(scheduler);
+
+    // kill the thread pool
+    if (scheduler->pool) tb_thread_pool_kill(scheduler->pool);
+}
+static tb_void_t gb_bitmap_decode_scheduler_exit(gb_bitmap_decode_scheduler_t* scheduler)
+{
+    // check
+    tb_assert_and_check_return(scheduler);
+
+    // exit the thread pool
+    if (scheduler->pool && !tb_thread_pool_exit(scheduler->pool))
+    {
+        // trace
+        tb_trace_e("exit the decoding thread pool failed!");
+    }
+    scheduler->pool = tb_null;
+
+    // the pending tasks have not been done? kill them
+    while (tb_priority_queue_size(scheduler->tasks))
+    {
+        gb_bitmap_decode_task_impl_t* task = (gb_bitmap_decode_task_impl_t*)tb_priority_queue_get(scheduler->tasks);
+        tb_priority_queue_pop(scheduler->tasks);
+        if (task)
+        {
+            gb_bitmap_decode_task_done(task, TB_STATE_KILLED, tb_null);
+            gb_bitmap_decode_task_release(task);
+        }
+    }
+
+    // exit tasks
+    tb_priority_queue_exit(scheduler->tasks);
+    scheduler->tasks = tb_null;
+
+    // exit lock
+    tb_spinlock_exit(&scheduler->lock);
+
+    // exit it
+    tb_free(scheduler);
+}
+static tb_bool_t gb_bitmap_decode_scheduler_instance_init(tb_handle_t instance, tb_cpointer_t priv)
+{
+    // check
+    gb_bitmap_decode_scheduler_t** pscheduler = (gb_bitmap_decode_scheduler_t**)instance;
+    tb_assert_and_check_return_val(pscheduler, tb_false);
+
+    // init it
+    *pscheduler = gb_bitmap_decode_scheduler_init();
+
+    // ok?
+    return *pscheduler != tb_null;
+}
+static gb_bitmap_decode_scheduler_t* gb_bitmap_decode_scheduler()
+{
+    // init the static instance
+    tb_bool_t ok = tb_singleton_static_init(&g_scheduler_inited, &g_scheduler, gb_bitmap_decode_scheduler_instance_init, tb_null);
+    tb_assert_and_check_return_val(ok, tb_null);
+
+    // ok
+    return g_scheduler;
+}
+static tb_void_t gb_bitmap_decode_task_done(gb_bitmap_decode_task_impl_t* task, tb_size_t state, gb_bitmap_ref_t bitmap)
+{
+    // trace
+    tb_trace_d("done: %s, state: %s", task->url? task->url : "stream", tb_state_cstr(state));
+
+    // done func
+    if (task->func) task->func(state, bitmap, task->priv);
+    else if (bitmap) gb_bitmap_exit(bitmap);
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_bool_t gb_bitmap_decode_async(tb_char_t const* url, tb_size_t pixfmt, tb_size_t priority, gb_bitmap_decode_func_t func, tb_cpointer_t priv)
+{
+    // check
+    tb_assert_and_check_return_val(url, tb_false);
+
+    // init task
+    gb_bitmap_decode_task_ref_t task = gb_bitmap_decode_task_init(url, tb_null, pixfmt, 0, 0, priority, func, priv);
+    tb_check_return_val(task, tb_false);
+
+    // exit the task handle
+    gb_bitmap_decode_task_exit(task);
+
+    // ok
+    return tb_true;
+}
+tb_bool_t gb_bitmap_decode_async_from_stream(tb_stream_ref_t stream, tb_size_t pixfmt, tb_size_t priority, gb_bitmap_decode_func_t func, tb_cpointer_t priv)
+{
+    // check
+    tb_assert_and_check_return_val(stream, tb_false);
+
+    // init task
+    gb_bitmap_decode_task_ref_t task = gb_bitmap_decode_task_init(tb_null, stream, pixfmt, 0, 0, priority, func, priv);
+    tb_check_return_val(task, tb_false);
+
+    // exit the task handle
+    gb_bitmap_decode_task_exit(task);
+
+    // ok
+    return tb_true;
+}
+gb_bitmap_decode_task_ref_t gb_bitmap_decode_task_init(tb_char_t const* url, tb_stream_ref_t stream, tb_size_t pixfmt, tb_size_t width, tb_size_t height, tb_size_t priority, gb_bitmap_decode_func_t func, tb_cpointer_t priv)
+{
+    // check
+    tb_assert_and_check_return_val((url || stream) && GB_PIXFMT_OK(pixfmt) && priority <= GB_BITMAP_DECODE_PRIORITY_HIGH, tb_null);
+
+    // the scheduler
+    gb_bitmap_decode_scheduler_t* scheduler = gb_bitmap_decode_scheduler();
+    tb_assert_and_check_return_val(scheduler, tb_null);
+
+    // done
+    tb_bool_t                       ok = tb_false;
+    gb_bitmap_decode_task_impl_t*   task = tb_null;
+    do
+    {
+        // make task with the url
+        tb_size_t url_size = url? tb_strlen(url) + 1 : 0;
+        task = (gb_bitmap_decode_task_impl_t*)tb_malloc0_bytes(sizeof(gb_bitmap_decode_task_impl_t) + url_size);
+        tb_assert_and_check_break(task);
+
+        // init task, referenced by the pending queue and the user handle
+        task->refn      = 2;
+        task->priority  = (tb_uint8_t)priority;
+        task->pixfmt    = (tb_uint16_t)pixfmt;
+        task->width     = (tb_uint16_t)width;
+        task->height    = (tb_uint16_t)height;
+        task->stream    = url? tb_null : stream;
+        task->func      = func;
+        task->priv      = priv;
+        if (url)
+        {
+            task->url = (tb_char_t const*)(task + 1);
+            tb_memcpy((tb_pointer_t)(task + 1), url, url_size);
+        }
+
+        /* put it to the pending queue and post a pool task for it, the urgent pool task will be done first
+         *
+         * the lock is held until it has been posted, so no worker can pop it before it is removed if the post failed
+         */
+        tb_spinlock_enter(&scheduler->lock);
+        task->seqn = scheduler->seqn++;
+        tb_priority_queue_put(scheduler->tasks, task);
+        tb_bool_t posted = tb_thread_pool_task_post(scheduler->pool, "bitmap_decode", gb_bitmap_decode_worker_done, tb_null, scheduler, priority == GB_BITMAP_DECODE_PRIORITY_HIGH);
+        if (!posted)
+        {
+            // each pool task pops one pending task, so remove it from the pending queue
+            tb_size_t itor = tb_find_all(scheduler->tasks, task);
+            if (itor != tb_iterator_tail(scheduler->tasks)) tb_priority_queue_remove(scheduler->tasks, itor);
+        }
+        tb_spinlock_leave(&scheduler->lock);
+
+        // post failed?
+        if (!posted)
+        {
+            // trace
+            tb_trace_e("post decoding task failed!");
+
+            // release the reference of the pending queue
+            gb_bitmap_decode_task_release(task);
+            break;
+        }
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // failed?
+    if (!ok && task)
+    {
+        // release the user handle and exit it
+        gb_bitmap_decode_task_release(task);
+        task = tb_null;
+    }
+
+    // ok?
+    return (gb_bitmap_decode_task_ref_t)task;
+}
+tb_void_t gb_bitmap_decode_task_cancel(gb_bitmap_decode_task_ref_t task)
+{
+    // check
+    gb_bitmap_decode_task_impl_t* impl = (gb_bitmap_decode_task_impl_t*)task;
+    tb_assert_and_check_return(impl);
+
+    // the scheduler
+    gb_bitmap_decode_scheduler_t* scheduler = gb_bitmap_decode_scheduler();
+    tb_assert_and_check_return(scheduler);
+
+    // kill it and the decoding url stream
+    tb_spinlock_enter(&scheduler->lock);
+    if (!impl->finished)
+    {
+        impl->killed = 1;
+        if (impl->decoding) tb_stream_kill(impl->decoding);
+    }
+    tb_spinlock_leave(&scheduler->lock);
+}
+tb_void_t gb_bitmap_decode_task_exit(gb_bitmap_decode_task_ref_t task)
+{
+    // release the user handle
+    gb_bitmap_decode_task_release((gb_bitmap_decode_task_impl_t*)task);
+}
+tb_long_t gb_bitmap_decode_wait_all(tb_long_t timeout)
+{
+    // the scheduler
+    gb_bitmap_decode_scheduler_t* scheduler = gb_bitmap_decode_scheduler();
+    tb_assert_and_check_return_val(scheduler && scheduler->pool, -1);
+
+    // wait all
+    return tb_thread_pool_task_wait_all(scheduler->pool, timeout);
+}
+tb_void_t gb_bitmap_decode_exit()
+{
+    // kill and exit the scheduler, the pending tasks will be done with TB_STATE_KILLED
+    if (g_scheduler)
+    {
+        gb_bitmap_decode_scheduler_kill(g_scheduler);
+        gb_bitmap_decode_scheduler_exit(g_scheduler);
+    }
+    g_scheduler = tb_null;
+
+    // reset it and it can be inited again
+    tb_atomic_set0(&g_scheduler_inited);
+}
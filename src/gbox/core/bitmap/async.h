@@ -0,0 +1,181 @@
+/*!The Graphic Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        async.h
+ * @ingroup     core
+ *
+ */
+#ifndef GB_CORE_BITMAP_ASYNC_H
+#define GB_CORE_BITMAP_ASYNC_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+/// the maximum worker count of the decoding thread pool
+#ifdef __gb_small__
+#   define GB_BITMAP_DECODE_WORKER_MAXN         (2)
+#else
+#   define GB_BITMAP_DECODE_WORKER_MAXN         (4)
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+/// the bitmap decode priority enum
+typedef enum __gb_bitmap_decode_priority_e
+{
+    GB_BITMAP_DECODE_PRIORITY_LOW       = 0     //!< e.g. prefetching thumbnails
+,   GB_BITMAP_DECODE_PRIORITY_NORMAL    = 1
+,   GB_BITMAP_DECODE_PRIORITY_HIGH      = 2     //!< e.g. the visible images
+
+}gb_bitmap_decode_priority_e;
+
+/// the bitmap decode task ref type
+typedef struct{}*       gb_bitmap_decode_task_ref_t;
+
+/*! the bitmap decode func type
+ *
+ * it will be called only once on the worker thread
+ *
+ * @param state         the state, TB_STATE_OK, TB_STATE_FAILED or TB_STATE_KILLED
+ * @param bitmap        the decoded bitmap if ok, the callee owns it and need exit it
+ * @param priv          the user private data
+ */
+typedef tb_void_t       (*gb_bitmap_decode_func_t)(tb_size_t state, gb_bitmap_ref_t bitmap, tb_cpointer_t priv);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/*! decode bitmap from url asynchronously
+ *
+ * @param url           the bitmap url
+ * @param pixfmt        the pixfmt
+ * @param priority      the priority
+ * @param func          the decode func
+ * @param priv          the user private data
+ *
+ * @return              tb_true or tb_false
+ */
+tb_bool_t                   gb_bitmap_decode_async(tb_char_t const* url, tb_size_t pixfmt, tb_size_t priority, gb_bitmap_decode_func_t func, tb_cpointer_t priv);
+
+/*! decode bitmap from stream asynchronously
+ *
+ * @param stream        the stream, it must be valid until the decode func is called
+ * @param pixfmt        the pixfmt
+ * @param priority      the priority
+ * @param func          the decode func
+ * @param priv          the user private data
+ *
+ * @return              tb_true or tb_false
+ */
+tb_bool_t                   gb_bitmap_decode_async_from_stream(tb_stream_ref_t stream, tb_size_t pixfmt, tb_size_t priority, gb_bitmap_decode_func_t func, tb_cpointer_t priv);
+
+/*! init an asynchronous decode task which can be cancelled
+ *
+ * @code
+    static tb_void_t on_decoded(tb_size_t state, gb_bitmap_ref_t bitmap, tb_cpointer_t priv)
+    {
+        // ok?
+        if (state == TB_STATE_OK)
+        {
+            // ...
+
+            // exit it
+            gb_bitmap_exit(bitmap);
+        }
+    }
+
+    gb_bitmap_decode_task_ref_t task = gb_bitmap_decode_task_init("/home/thumb.jpg", tb_null, GB_PIXFMT_XRGB8888, 64, 64, GB_BITMAP_DECODE_PRIORITY_LOW, on_decoded, tb_null);
+    if (task)
+    {
+        // ...
+
+        // cancel it if not needed
+        gb_bitmap_decode_task_cancel(task);
+
+        // exit it
+        gb_bitmap_decode_task_exit(task);
+    }
+ * @endcode
+ *
+ * @param url           the bitmap url, using the stream if be null
+ * @param stream        the stream, it must be valid until the decode func is called
+ * @param pixfmt        the pixfmt
+ * @param width         the target width hint for decoder, zero: the source width
+ * @param height        the target height hint for decoder, zero: the source height
+ * @param priority      the priority
+ * @param func          the decode func
+ * @param priv          the user private data
+ *
+ * @return              the task, null if failed and the decode func will never be called
+ */
+gb_bitmap_decode_task_ref_t gb_bitmap_decode_task_init(tb_char_t const* url, tb_stream_ref_t stream, tb_size_t pixfmt, tb_size_t width, tb_size_t height, tb_size_t priority, gb_bitmap_decode_func_t func, tb_cpointer_t priv);
+
+/*! cancel the decode task
+ *
+ * the decode func will be called with TB_STATE_KILLED if the task has not been finished
+ *
+ * @param task          the task
+ */
+tb_void_t                   gb_bitmap_decode_task_cancel(gb_bitmap_decode_task_ref_t task);
+
+/*! exit the decode task handle
+ *
+ * the task will continue to be done if it is not cancelled
+ *
+ * @param task          the task
+ */
+tb_void_t                   gb_bitmap_decode_task_exit(gb_bitmap_decode_task_ref_t task);
+
+/*! wait all decode tasks
+ *
+ * @param timeout       the timeout
+ *
+ * @return              ok: 1, timeout: 0, error: -1
+ */
+tb_long_t                   gb_bitmap_decode_wait_all(tb_long_t timeout);
+
+/*! exit the decoding threads and kill the pending tasks
+ *
+ * it will be called by gb_exit(), and the threads will be started again if decoding the next bitmap
+ */
+tb_void_t                   gb_bitmap_decode_exit(tb_noarg_t);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+#endif
+
+
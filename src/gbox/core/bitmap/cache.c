@@ -0,0 +1,423 @@
+/*!The Graphic Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        cache.c
+ * @ingroup     core
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME            "bitmap_cache"
+#define TB_TRACE_MODULE_DEBUG           (0)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "cache.h"
+#include "decoder.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the key maxn
+#define GB_BITMAP_CACHE_KEY_MAXN        (TB_PATH_MAXN + 64)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the bitmap cache entry type
+typedef struct __gb_bitmap_cache_entry_t
+{
+    // the list entry
+    tb_list_entry_t             entry;
+
+    // the bitmap
+    gb_bitmap_ref_t             bitmap;
+
+    // the bitmap size
+    tb_size_t                   size;
+
+    // the key
+    tb_char_t                   key[1];
+
+}gb_bitmap_cache_entry_t, *gb_bitmap_cache_entry_ref_t;
+
+// the bitmap cache impl type
+typedef struct __gb_bitmap_cache_impl_t
+{
+    // the lock
+    tb_spinlock_t               lock;
+
+    // the entries, key => entry
+    tb_hash_map_ref_t           entries;
+
+    // the lru list, the most recently used entry is at head
+    tb_list_entry_head_t        lru;
+
+    // the stats
+    gb_bitmap_cache_stats_t     stats;
+
+}gb_bitmap_cache_impl_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * globals
+ */
+
+/* the process-wide bitmap cache
+ *
+ * it is a private static instance instead of a tbox singleton,
+ * so it will not occupy the TB_SINGLETON_TYPE_USER slots of the application
+ */
+static tb_atomic_t              g_cache_inited = 0;
+static gb_bitmap_cache_ref_t    g_cache = tb_null;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static tb_void_t gb_bitmap_cache_entry_free(gb_bitmap_cache_impl_t* impl, gb_bitmap_cache_entry_ref_t entry)
+{
+    // remove it from the lru list
+    tb_list_entry_remove(&impl->lru, &entry->entry);
+
+    // update stats
+    impl->stats.count--;
+    impl->stats.size -= entry->size;
+
+    /* remove it from the entries and free it
+     *
+     * @note the key is in the entry, so we cannot remove it by the key
+     */
+    tb_size_t itor = tb_hash_map_find(impl->entries, entry->key);
+    if (itor != tb_iterator_tail(impl->entries)) tb_iterator_remove(impl->entries, itor);
+}
+static tb_void_t gb_bitmap_cache_entry_exit(tb_element_ref_t element, tb_pointer_t buff)
+{
+    // check
+    tb_assert_and_check_return(buff);
+
+    // the entry
+    gb_bitmap_cache_entry_ref_t entry = (gb_bitmap_cache_entry_ref_t)*((tb_pointer_t*)buff);
+    tb_check_return(entry);
+
+    // release the bitmap, it is still valid if be referenced by others
+    if (entry->bitmap) gb_bitmap_exit(entry->bitmap);
+    entry->bitmap = tb_null;
+
+    // exit it
+    tb_free(entry);
+}
+static tb_void_t gb_bitmap_cache_evict(gb_bitmap_cache_impl_t* impl, tb_size_t need)
+{
+    // evict the least recently used entries until the budget is enough
+    while (tb_list_entry_size(&impl->lru) && impl->stats.size + need > impl->stats.maxn)
+    {
+        // the last entry
+        gb_bitmap_cache_entry_ref_t entry = (gb_bitmap_cache_entry_ref_t)tb_list_entry(&impl->lru, tb_list_entry_last(&impl->lru));
+        tb_assert_and_check_break(entry);
+
+        // trace
+        tb_trace_d("evict: %s, %lu bytes", entry->key, entry->size);
+
+        // free it
+        gb_bitmap_cache_entry_free(impl, entry);
+
+        // update stats
+        impl->stats.evictions++;
+    }
+}
+static gb_bitmap_ref_t gb_bitmap_cache_decode(tb_char_t const* url, tb_size_t pixfmt, tb_size_t width, tb_size_t height)
+{
+    // init stream
+    tb_stream_ref_t stream = tb_stream_init_from_url(url);
+    tb_assert_and_check_return_val(stream, tb_null);
+
+    // done
+    gb_bitmap_ref_t         bitmap = tb_null;
+    gb_bitmap_decoder_ref_t decoder = tb_null;
+    do
+    {
+        // open stream
+        if (!tb_stream_open(stream)) break;
+
+        // init bitmap decoder
+        decoder = gb_bitmap_decoder_init(pixfmt, stream);
+        tb_check_break(decoder);
+
+        // set the target size
+        if (width || height) gb_bitmap_decoder_size_set(decoder, width, height);
+
+        // done bitmap decoder
+        bitmap = gb_bitmap_decoder_done(decoder);
+
+    } while (0);
+
+    // exit bitmap decoder
+    if (decoder) gb_bitmap_decoder_exit(decoder);
+    decoder = tb_null;
+
+    // exit stream
+    tb_stream_exit(stream);
+
+    // ok?
+    return bitmap;
+}
+static tb_bool_t gb_bitmap_cache_instance_init(tb_handle_t instance, tb_cpointer_t priv)
+{
+    // check
+    gb_bitmap_cache_ref_t* pcache = (gb_bitmap_cache_ref_t*)instance;
+    tb_assert_and_check_return_val(pcache, tb_false);
+
+    // init it
+    *pcache = gb_bitmap_cache_init(0);
+
+    // ok?
+    return *pcache != tb_null;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+gb_bitmap_cache_ref_t gb_bitmap_cache()
+{
+    // init the static instance
+    tb_bool_t ok = tb_singleton_static_init(&g_cache_inited, &g_cache, gb_bitmap_cache_instance_init, tb_null);
+    tb_assert_and_check_return_val(ok, tb_null);
+
+    // ok
+    return g_cache;
+}
+tb_void_t gb_bitmap_cache_instance_exit()
+{
+    // exit it
+    if (g_cache) gb_bitmap_cache_exit(g_cache);
+    g_cache = tb_null;
+
+    // reset it and it can be inited again
+    tb_atomic_set0(&g_cache_inited);
+}
+gb_bitmap_cache_ref_t gb_bitmap_cache_init(tb_size_t maxn)
+{
+    // done
+    tb_bool_t               ok = tb_false;
+    gb_bitmap_cache_impl_t* impl = tb_null;
+    do
+    {
+        // make cache
+        impl = tb_malloc0_type(gb_bitmap_cache_impl_t);
+        tb_assert_and_check_break(impl);
+
+        // init lock
+        if (!tb_spinlock_init(&impl->lock)) break;
+
+        // init entries
+        impl->entries = tb_hash_map_init(TB_HASH_MAP_BUCKET_SIZE_MICRO, tb_element_str(tb_true), tb_element_ptr(gb_bitmap_cache_entry_exit, tb_null));
+        tb_assert_and_check_break(impl->entries);
+
+        // init lru list
+        tb_list_entry_init_(&impl->lru, tb_offsetof(gb_bitmap_cache_entry_t, entry), sizeof(gb_bitmap_cache_entry_t), tb_null);
+
+        // init stats
+        impl->stats.maxn = maxn? maxn : GB_BITMAP_CACHE_MAXN;
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // failed?
+    if (!ok)
+    {
+        // exit it
+        if (impl) gb_bitmap_cache_exit((gb_bitmap_cache_ref_t)impl);
+        impl = tb_null;
+    }
+
+    // ok?
+    return (gb_bitmap_cache_ref_t)impl;
+}
+tb_void_t gb_bitmap_cache_exit(gb_bitmap_cache_ref_t cache)
+{
+    // check
+    gb_bitmap_cache_impl_t* impl = (gb_bitmap_cache_impl_t*)cache;
+    tb_assert_and_check_return(impl);
+
+    // exit entries
+    if (impl->entries) tb_hash_map_exit(impl->entries);
+    impl->entries = tb_null;
+
+    // exit lru list
+    tb_list_entry_exit(&impl->lru);
+
+    // exit lock
+    tb_spinlock_exit(&impl->lock);
+
+    // exit it
+    tb_free(impl);
+}
+tb_void_t gb_bitmap_cache_clear(gb_bitmap_cache_ref_t cache)
+{
+    // check
+    gb_bitmap_cache_impl_t* impl = (gb_bitmap_cache_impl_t*)cache;
+    tb_assert_and_check_return(impl && impl->entries);
+
+    // enter
+    tb_spinlock_enter(&impl->lock);
+
+    // clear entries
+    tb_list_entry_clear(&impl->lru);
+    tb_hash_map_clear(impl->entries);
+
+    // clear stats
+    impl->stats.count   = 0;
+    impl->stats.size    = 0;
+
+    // leave
+    tb_spinlock_leave(&impl->lock);
+}
+tb_void_t gb_bitmap_cache_maxn_set(gb_bitmap_cache_ref_t cache, tb_size_t maxn)
+{
+    // check
+    gb_bitmap_cache_impl_t* impl = (gb_bitmap_cache_impl_t*)cache;
+    tb_assert_and_check_return(impl);
+
+    // enter
+    tb_spinlock_enter(&impl->lock);
+
+    // set the memory budget
+    impl->stats.maxn = maxn;
+
+    // evict the exceeded entries
+    gb_bitmap_cache_evict(impl, 0);
+
+    // leave
+    tb_spinlock_leave(&impl->lock);
+}
+gb_bitmap_ref_t gb_bitmap_cache_load(gb_bitmap_cache_ref_t cache, tb_char_t const* url, tb_size_t pixfmt, tb_size_t width, tb_size_t height)
+{
+    // check
+    gb_bitmap_cache_impl_t* impl = (gb_bitmap_cache_impl_t*)cache;
+    tb_assert_and_check_return_val(impl && impl->entries && url && GB_PIXFMT_OK(pixfmt), tb_null);
+
+    // make key
+    tb_char_t key[GB_BITMAP_CACHE_KEY_MAXN];
+    tb_long_t size = tb_snprintf(key, sizeof(key) - 1, "%s|%lx|%lux%lu", url, pixfmt, width, height);
+    tb_assert_and_check_return_val(size > 0 && size < (tb_long_t)sizeof(key) - 1, tb_null);
+    key[size] = '\0';
+
+    // enter
+    tb_spinlock_enter(&impl->lock);
+
+    // hit? move it to the lru head and retain it
+    gb_bitmap_ref_t             bitmap = tb_null;
+    gb_bitmap_cache_entry_ref_t entry = (gb_bitmap_cache_entry_ref_t)tb_hash_map_get(impl->entries, key);
+    if (entry)
+    {
+        tb_list_entry_remove(&impl->lru, &entry->entry);
+        tb_list_entry_insert_head(&impl->lru, &entry->entry);
+        bitmap = gb_bitmap_retain(entry->bitmap);
+        impl->stats.hits++;
+    }
+    else impl->stats.misses++;
+
+    // leave
+    tb_spinlock_leave(&impl->lock);
+
+    // ok?
+    tb_check_return_val(!bitmap, bitmap);
+
+    // trace
+    tb_trace_d("miss: %s", key);
+
+    // decode it without lock
+    bitmap = gb_bitmap_cache_decode(url, pixfmt, width, height);
+    tb_check_return_val(bitmap, tb_null);
+
+    // too large to cache it?
+    tb_size_t bitmap_size = gb_bitmap_size(bitmap);
+    tb_check_return_val(bitmap_size <= impl->stats.maxn, bitmap);
+
+    // make entry
+    entry = (gb_bitmap_cache_entry_ref_t)tb_malloc_bytes(sizeof(gb_bitmap_cache_entry_t) + size);
+    tb_assert_and_check_return_val(entry, bitmap);
+
+    // init entry, the cache holds one reference
+    entry->bitmap   = gb_bitmap_retain(bitmap);
+    entry->size     = bitmap_size;
+    tb_memcpy(entry->key, key, size + 1);
+
+    // enter
+    tb_spinlock_enter(&impl->lock);
+
+    // has been cached by the other thread? using the cached bitmap
+    gb_bitmap_cache_entry_ref_t cached = (gb_bitmap_cache_entry_ref_t)tb_hash_map_get(impl->entries, key);
+    if (cached)
+    {
+        tb_list_entry_remove(&impl->lru, &cached->entry);
+        tb_list_entry_insert_head(&impl->lru, &cached->entry);
+        gb_bitmap_exit(bitmap);
+        bitmap = gb_bitmap_retain(cached->bitmap);
+    }
+    else
+    {
+        // evict the least recently used entries
+        gb_bitmap_cache_evict(impl, bitmap_size);
+
+        // insert it
+        if (tb_hash_map_insert(impl->entries, key, entry) != tb_iterator_tail(impl->entries))
+        {
+            tb_list_entry_insert_head(&impl->lru, &entry->entry);
+            impl->stats.count++;
+            impl->stats.size += bitmap_size;
+            entry = tb_null;
+        }
+    }
+
+    // leave
+    tb_spinlock_leave(&impl->lock);
+
+    // the entry has not been cached? exit it
+    if (entry)
+    {
+        gb_bitmap_exit(entry->bitmap);
+        tb_free(entry);
+    }
+
+    // ok
+    return bitmap;
+}
+tb_void_t gb_bitmap_cache_stats(gb_bitmap_cache_ref_t cache, gb_bitmap_cache_stats_ref_t stats)
+{
+    // check
+    gb_bitmap_cache_impl_t* impl = (gb_bitmap_cache_impl_t*)cache;
+    tb_assert_and_check_return(impl && stats);
+
+    // enter
+    tb_spinlock_enter(&impl->lock);
+
+    // get stats
+    *stats = impl->stats;
+
+    // leave
+    tb_spinlock_leave(&impl->lock);
+}
@@ -0,0 +1,167 @@
+/*!The Graphic Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        cache.h
+ * @ingroup     core
+ *
+ */
+#ifndef GB_CORE_BITMAP_CACHE_H
+#define GB_CORE_BITMAP_CACHE_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+/// the default memory budget of the bitmap cache
+#ifdef __gb_small__
+#   define GB_BITMAP_CACHE_MAXN     (8 << 20)
+#else
+#   define GB_BITMAP_CACHE_MAXN     (32 << 20)
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+/// the bitmap cache ref type
+typedef struct{}*       gb_bitmap_cache_ref_t;
+
+/// the bitmap cache stats type
+typedef struct __gb_bitmap_cache_stats_t
+{
+    /// the hit count
+    tb_size_t           hits;
+
+    /// the miss count
+    tb_size_t           misses;
+
+    /// the eviction count
+    tb_size_t           evictions;
+
+    /// the cached bitmap count
+    tb_size_t           count;
+
+    /// the cached bitmap bytes
+    tb_size_t           size;
+
+    /// the memory budget
+    tb_size_t           maxn;
+
+}gb_bitmap_cache_stats_t, *gb_bitmap_cache_stats_ref_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/*! the process-wide bitmap cache
+ *
+ * @return              the bitmap cache with the GB_BITMAP_CACHE_MAXN budget
+ */
+gb_bitmap_cache_ref_t   gb_bitmap_cache(tb_noarg_t);
+
+/*! exit the process-wide bitmap cache
+ *
+ * it will be called by gb_exit(), and the cache will be inited again if calling gb_bitmap_cache()
+ */
+tb_void_t               gb_bitmap_cache_instance_exit(tb_noarg_t);
+
+/*! init bitmap cache
+ *
+ * @param maxn          the memory budget in bytes, using GB_BITMAP_CACHE_MAXN if be zero
+ *
+ * @return              the bitmap cache
+ */
+gb_bitmap_cache_ref_t   gb_bitmap_cache_init(tb_size_t maxn);
+
+/*! exit bitmap cache
+ *
+ * the loaded bitmaps are still valid until they are exited
+ *
+ * @param cache         the bitmap cache
+ */
+tb_void_t               gb_bitmap_cache_exit(gb_bitmap_cache_ref_t cache);
+
+/*! clear bitmap cache
+ *
+ * @param cache         the bitmap cache
+ */
+tb_void_t               gb_bitmap_cache_clear(gb_bitmap_cache_ref_t cache);
+
+/*! set the memory budget and evict the least recently used bitmaps if exceeded
+ *
+ * @param cache         the bitmap cache
+ * @param maxn          the memory budget in bytes
+ */
+tb_void_t               gb_bitmap_cache_maxn_set(gb_bitmap_cache_ref_t cache, tb_size_t maxn);
+
+/*! load bitmap from the cache or decode it from url if not cached
+ *
+ * the cached bitmap is reference-counted and shared by all callers loading the same url and pixfmt,
+ * so it is read-only: do not draw to it, modify its pixels or change its flags.
+ * please copy it into a new bitmap with gb_bitmap_init() if it need be modified.
+ *
+ * it should be released by gb_bitmap_exit()
+ *
+ * @code
+    gb_bitmap_ref_t bitmap = gb_bitmap_cache_load(gb_bitmap_cache(), "/home/file.png", GB_PIXFMT_XRGB8888, 0, 0);
+    if (bitmap)
+    {
+        // ...
+
+        // exit it
+        gb_bitmap_exit(bitmap);
+    }
+ * @endcode
+ *
+ * @param cache         the bitmap cache
+ * @param url           the bitmap url
+ * @param pixfmt        the pixfmt
+ * @param width         the target width hint for decoder, zero: the source width
+ * @param height        the target height hint for decoder, zero: the source height
+ *
+ * @return              the bitmap
+ */
+gb_bitmap_ref_t         gb_bitmap_cache_load(gb_bitmap_cache_ref_t cache, tb_char_t const* url, tb_size_t pixfmt, tb_size_t width, tb_size_t height);
+
+/*! the bitmap cache stats
+ *
+ * @param cache         the bitmap cache
+ * @param stats         the stats
+ */
+tb_void_t               gb_bitmap_cache_stats(gb_bitmap_cache_ref_t cache, gb_bitmap_cache_stats_ref_t stats);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+#endif
+
+
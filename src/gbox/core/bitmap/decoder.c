@@ -28,10 +28,7 @@
  */
 #include "decoder.h"
 #include "decoder/prefix.h"
-//#include "bmp.h"
-//#include "jpg.h"
-//#include "png.h"
-//#include "gif.h"
+#include "../trace.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
@@ -43,6 +40,12 @@ gb_bitmap_decoder_ref_t gb_bitmap_decoder_init(tb_size_t pixfmt, tb_stream_ref_t
     {
         tb_null
     ,   gb_bitmap_decoder_bmp_probe
+#ifdef GB_CONFIG_PACKAGE_HAVE_JPEG
+    ,   gb_bitmap_decoder_jpg_probe
+#endif
+#ifdef GB_CONFIG_PACKAGE_HAVE_PNG
+    ,   gb_bitmap_decoder_png_probe
+#endif
     };
 
     // the bitmap decoder init list
@@ -50,6 +53,12 @@ gb_bitmap_decoder_ref_t gb_bitmap_decoder_init(tb_size_t pixfmt, tb_stream_ref_t
     {
         tb_null
     ,   gb_bitmap_decoder_bmp_init
+#ifdef GB_CONFIG_PACKAGE_HAVE_JPEG
+    ,   gb_bitmap_decoder_jpg_init
+#endif
+#ifdef GB_CONFIG_PACKAGE_HAVE_PNG
+    ,   gb_bitmap_decoder_png_init
+#endif
     };
     tb_assert_static(tb_arrayn(probe) == tb_arrayn(init));
 
@@ -85,12 +94,49 @@ tb_void_t gb_bitmap_decoder_exit(gb_bitmap_decoder_ref_t decoder)
     // exit it
     tb_free(decoder);
 }
+tb_size_t gb_bitmap_decoder_width(gb_bitmap_decoder_ref_t decoder)
+{
+    // check
+    gb_bitmap_decoder_impl_t* impl = (gb_bitmap_decoder_impl_t*)decoder;
+    tb_assert_and_check_return_val(impl, 0);
+
+    // the width
+    return impl->width;
+}
+tb_size_t gb_bitmap_decoder_height(gb_bitmap_decoder_ref_t decoder)
+{
+    // check
+    gb_bitmap_decoder_impl_t* impl = (gb_bitmap_decoder_impl_t*)decoder;
+    tb_assert_and_check_return_val(impl, 0);
+
+    // the height
+    return impl->height;
+}
+tb_void_t gb_bitmap_decoder_size_set(gb_bitmap_decoder_ref_t decoder, tb_size_t width, tb_size_t height)
+{
+    // check
+    gb_bitmap_decoder_impl_t* impl = (gb_bitmap_decoder_impl_t*)decoder;
+    tb_assert_and_check_return(impl);
+
+    // set the target size
+    impl->target_width  = (tb_uint16_t)tb_min(width, impl->width);
+    impl->target_height = (tb_uint16_t)tb_min(height, impl->height);
+}
 gb_bitmap_ref_t gb_bitmap_decoder_done(gb_bitmap_decoder_ref_t decoder)
 {
     // check
     gb_bitmap_decoder_impl_t* impl = (gb_bitmap_decoder_impl_t*)decoder;
     tb_assert_and_check_return_val(impl && impl->done, tb_null);
 
+    // trace enter
+    gb_trace_enter(span);
+
     // done
-    return impl->done(impl);
+    gb_bitmap_ref_t bitmap = impl->done(impl);
+
+    // trace leave
+    gb_trace_leave(span, "gb_bitmap_decoder_done");
+
+    // ok
+    return bitmap;
 }
@@ -62,6 +62,34 @@ gb_bitmap_decoder_ref_t  gb_bitmap_decoder_init(tb_size_t pixfmt, tb_stream_ref_
  */
 tb_void_t               gb_bitmap_decoder_exit(gb_bitmap_decoder_ref_t decoder);
 
+/*! the source width of the bitmap
+ *
+ * @param decoder       decoder 
+ *
+ * @return              the width
+ */
+tb_size_t               gb_bitmap_decoder_width(gb_bitmap_decoder_ref_t decoder);
+
+/*! the source height of the bitmap
+ *
+ * @param decoder       decoder 
+ *
+ * @return              the height
+ */
+tb_size_t               gb_bitmap_decoder_height(gb_bitmap_decoder_ref_t decoder);
+
+/*! set the target size of the decoded bitmap
+ *
+ * only a hint, the decoder may decode a smaller bitmap if the format supports it,
+ * e.g. the jpeg decoder scales it by 1/2, 1/4 or 1/8 in the DCT domain,
+ * but the decoded bitmap will never be smaller than the target size.
+ *
+ * @param decoder       decoder 
+ * @param width         the target width, zero: the source width
+ * @param height        the target height, zero: the source height
+ */
+tb_void_t               gb_bitmap_decoder_size_set(gb_bitmap_decoder_ref_t decoder, tb_size_t width, tb_size_t height);
+
 /*! done bitmap decoder 
  *
  * @param decoder       decoder 
@@ -33,11 +33,18 @@
  * includes
  */
 #include "prefix.h"
+#if defined(TB_CONFIG_POSIX_HAVE_OPEN) && !defined(TB_CONFIG_OS_WINDOWS)
+#   include <sys/mman.h>
+#   define GB_BMP_MAP_ENABLE
+#endif
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * macros
  */
 
+// the minimum data size for mapping the bmp file instead of copying it
+#define GB_BMP_MAP_MINN                 (64 * 1024)
+
 // the bpp offset
 #define GB_BMP_OFFSET_BPP               (28)
 
@@ -109,17 +116,136 @@
  * @endcode
  */
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the bmp bitmap decoder impl type
+typedef struct __gb_bitmap_decoder_bmp_impl_t
+{
+    // the base
+    gb_bitmap_decoder_impl_t    base;
+
+    // the data offset
+    tb_uint32_t                 offset;
+
+    // is top-down? the height is negative
+    tb_bool_t                   top_down;
+
+}gb_bitmap_decoder_bmp_impl_t;
+
+#ifdef GB_BMP_MAP_ENABLE
+// the bmp file mapping type
+typedef struct __gb_bitmap_decoder_bmp_map_t
+{
+    // the mapped base
+    tb_pointer_t                base;
+
+    // the mapped size
+    tb_size_t                   size;
+
+}gb_bitmap_decoder_bmp_map_t;
+#endif
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * private implementation
  */
+#ifdef GB_BMP_MAP_ENABLE
+static tb_void_t gb_bitmap_decoder_bmp_unmap(tb_pointer_t data, tb_cpointer_t priv)
+{
+    // check
+    gb_bitmap_decoder_bmp_map_t* map = (gb_bitmap_decoder_bmp_map_t*)priv;
+    tb_assert_and_check_return(map);
+
+    // unmap it
+    if (map->base) munmap(map->base, map->size);
+
+    // exit it
+    tb_free(map);
+}
+static gb_bitmap_ref_t gb_bitmap_decoder_bmp_map(tb_stream_ref_t stream, tb_hize_t filesize, tb_size_t offset, tb_size_t pixfmt, tb_size_t width, tb_size_t height, tb_size_t row_bytes, tb_bool_t top_down)
+{
+    // check
+    tb_assert_and_check_return_val(stream && row_bytes, tb_null);
+
+    // only for the file stream
+    tb_check_return_val(tb_stream_type(stream) == TB_STREAM_TYPE_FILE, tb_null);
+
+    // the file path
+    tb_char_t const* path = tb_null;
+    if (!tb_stream_ctrl(stream, TB_STREAM_CTRL_GET_PATH, &path) || !path) return tb_null;
+
+    // done
+    tb_file_ref_t                   file = tb_null;
+    gb_bitmap_decoder_bmp_map_t*    map = tb_null;
+    gb_bitmap_ref_t                 bitmap = tb_null;
+    do
+    {
+        // open file
+        file = tb_file_init(path, TB_FILE_MODE_RO);
+        tb_check_break(file);
+
+        // the file size has been changed?
+        tb_check_break(tb_file_size(file) == filesize);
+
+        // make map
+        map = tb_malloc0_type(gb_bitmap_decoder_bmp_map_t);
+        tb_assert_and_check_break(map);
+
+        /* map the whole file with the private copy-on-write pages
+         *
+         * the bitmap may be drawn as the target of the bitmap device,
+         * but the file will not be modified
+         */
+        map->size = (tb_size_t)filesize;
+        map->base = mmap(tb_null, map->size, PROT_READ | PROT_WRITE, MAP_PRIVATE, tb_file2fd(file), 0);
+        if (map->base == MAP_FAILED)
+        {
+            map->base = tb_null;
+            break;
+        }
+
+        // the top row and the row stride
+        tb_byte_t*  data = (tb_byte_t*)map->base + offset;
+        tb_long_t   row_stride = (tb_long_t)row_bytes;
+        if (!top_down)
+        {
+            data        += (height - 1) * row_bytes;
+            row_stride  = -row_stride;
+        }
+
+        // init bitmap, the mapped formats have no alpha
+        bitmap = gb_bitmap_init_with_stride(data, pixfmt, width, height, row_stride, tb_false);
+        tb_assert_and_check_break(bitmap);
+
+        // unmap it when the bitmap is exited
+        gb_bitmap_release_set(bitmap, gb_bitmap_decoder_bmp_unmap, map);
+        map = tb_null;
+
+    } while (0);
+
+    // exit map if failed
+    if (map) gb_bitmap_decoder_bmp_unmap(tb_null, map);
+    map = tb_null;
+
+    // exit file, the mapping is still valid
+    if (file) tb_file_exit(file);
+    file = tb_null;
+
+    // ok?
+    return bitmap;
+}
+#endif
 static gb_bitmap_ref_t gb_bitmap_decoder_bmp_done(gb_bitmap_decoder_impl_t* decoder)
 {
     // check
-    tb_assert_and_check_return_val(decoder && decoder->type == GB_BITMAP_TYPE_BMP, tb_null);
+    gb_bitmap_decoder_bmp_impl_t* impl = (gb_bitmap_decoder_bmp_impl_t*)decoder;
+    tb_assert_and_check_return_val(impl && decoder->type == GB_BITMAP_TYPE_BMP, tb_null);
 
     // done
     tb_bool_t       ok = tb_false;
     gb_bitmap_ref_t bitmap = tb_null;
+    tb_byte_t*      row_data = tb_null;
     do
     {
         // the pixfmt
@@ -164,7 +290,7 @@ static gb_bitmap_ref_t gb_bitmap_decoder_bmp_done(gb_bitmap_decoder_impl_t* deco
 
         // has palette?
         gb_color_t  pals[256];
-        tb_size_t   paln = 1 << bpp;
+        tb_size_t   paln = bpp <= 8? (1 << bpp) : 0;
         if (bpp <= 8)
         {
 #if 0
@@ -259,8 +385,46 @@ static gb_bitmap_ref_t gb_bitmap_decoder_bmp_done(gb_bitmap_decoder_impl_t* deco
         // trace
         tb_trace_d("pixfmt: %s => %s", sp->name, dp->name);
 
+        // the bmp data position
+        tb_size_t offset = impl->offset;
+        if (!offset || offset + datasize > filesize) offset = (tb_size_t)(filesize - datasize);
+
+        // the row bytes
+        tb_size_t row_bytes_align4 = tb_align4(linesize);
+
+#ifdef GB_BMP_MAP_ENABLE
+        /* map the bmp data directly if the layout is same as the given pixfmt
+         *
+         * the argb8888 source is only mapped as xrgb8888 for keeping the alpha semantics,
+         * the padded rows and the bottom-up order are described by the row stride
+         *
+         * the file is mapped from zero, so the data offset must be aligned by the pixel size,
+         * e.g. the common offset 54 is misaligned for the 16/32-bits pixmap and need be copied
+         */
+        tb_bool_t mappable =    datasize >= GB_BMP_MAP_MINN
+                            &&  bpp > 8
+                            &&  sp->btp && !(offset % sp->btp)
+                            &&  !GB_PIXFMT_HAS_ALPHA(pixfmt)
+                            &&  row_bytes_align4 * height <= datasize
+                            &&  (   pixfmt == sp->pixfmt
+                                ||  (pixfmt == GB_PIXFMT_XRGB8888 && sp->pixfmt == GB_PIXFMT_ARGB8888));
+        if (mappable)
+        {
+            bitmap = gb_bitmap_decoder_bmp_map(stream, filesize, offset, pixfmt, width, height, row_bytes_align4, impl->top_down);
+            if (bitmap)
+            {
+                // trace
+                tb_trace_d("mapped: %lu bytes", datasize);
+
+                // ok
+                ok = tb_true;
+                break;
+            }
+        }
+#endif
+
         // seek to the bmp data position
-        if (!tb_stream_seek(stream, filesize - datasize)) break;
+        if (!tb_stream_seek(stream, offset)) break;
 
         // init bitmap, default: no alpha
         bitmap = gb_bitmap_init(tb_null, pixfmt, width, height, 0, tb_false);
@@ -270,94 +434,87 @@ static gb_bitmap_ref_t gb_bitmap_decoder_bmp_done(gb_bitmap_decoder_impl_t* deco
         tb_byte_t*  data = (tb_byte_t*)gb_bitmap_data(bitmap);
         tb_assert_and_check_break(data);
         
+        // init the row converter
+        gb_pixmap_converter_t converter;
+        if (!gb_pixmap_converter_init(&converter, pixfmt, bpp > 8? sp->pixfmt : (GB_PIXFMT_ARGB8888 | GB_PIXFMT_NENDIAN))) break;
+
+        // make the row data
+        row_data = tb_malloc_bytes(row_bytes_align4 + (bpp > 8? 0 : (width << 2)));
+        tb_assert_and_check_break(row_data);
+
+        /* has alpha? only the argb8888 source has the alpha channel
+         *
+         * the palette and other sources are opaque
+         */
+        tb_byte_t   alpha_maxn = GB_ALPHA_MAXN;
+        tb_bool_t   has_alpha = 0xff <= alpha_maxn;
+        tb_bool_t   alpha_check = !has_alpha && bpp == 32 && GB_PIXFMT_HAS_ALPHA(sp->pixfmt);
+
         // done
-        gb_color_t  c;
-        tb_byte_t   row_data[8192];
-        tb_size_t   btp_dst = dp->btp;
-        tb_size_t   btp_src = sp->btp;
-        tb_size_t   has_alpha = 0;
-        tb_size_t   row_bytes = gb_bitmap_row_bytes(bitmap);
-        tb_size_t   row_bytes_align4 = tb_align4(linesize);
-        tb_byte_t*  p = data + (height - 1) * row_bytes;
-        tb_assert_and_check_break(row_bytes_align4 <= sizeof(row_data));
-        if (bpp > 8)
+        tb_long_t   row_bytes = (tb_long_t)gb_bitmap_row_bytes(bitmap);
+        tb_byte_t*  p = data;
+        if (!impl->top_down)
         {
-            while (height--)
-            {
-                // read line
-                if (!tb_stream_bread(stream, row_data, row_bytes_align4)) break;
-                
-                // save bitmap data
-                tb_byte_t*  d = p;
-                tb_size_t   i = 0;
-                for (i = 0; i < linesize; i += btp_src, d += btp_dst)
-                {
-                    // load color
-                    c = sp->color_get(row_data + i);
-
-                    // save color
-                    dp->color_set(d, c);
-
-                    // has alpha?
-                    if (!has_alpha) has_alpha = c.a <= GB_ALPHA_MAXN;
-                }
-
-                // next line
-                p -= row_bytes;
-            }
+            // the bottom-up rows
+            p           += (height - 1) * row_bytes;
+            row_bytes   = -row_bytes;
         }
-        else if (bpp == 8)
+        if (bpp > 8)
         {
             while (height--)
             {
                 // read line
                 if (!tb_stream_bread(stream, row_data, row_bytes_align4)) break;
-                
-                // save bitmap data
-                tb_byte_t*  d = p;
-                tb_size_t   i = 0;
-                for (i = 0; i < linesize; i++, d += btp_dst)
-                {
-                    // load color
-                    c = pals[row_data[i]];
 
-                    // save color
-                    dp->color_set(d, c);
+                // save bitmap data
+                gb_pixmap_converter_done(&converter, p, row_data, width);
 
-                    // has alpha?
-                    if (!has_alpha) has_alpha = c.a <= GB_ALPHA_MAXN;
+                // has alpha?
+                if (alpha_check)
+                {
+                    tb_size_t i = 0;
+                    for (i = 3; i < linesize && row_data[i] > alpha_maxn; i += 4) ;
+                    if (i < linesize) 
+                    {
+                        has_alpha   = tb_true;
+                        alpha_check = tb_false;
+                    }
                 }
 
                 // next line
-                p -= row_bytes;
+                p += row_bytes;
             }
         }
-        // bpp < 8?
         else
         {
+            // make the argb palette
+            tb_size_t   i = 0;
+            tb_uint32_t argb_pals[256];
+            for (i = 0; i < paln; i++) argb_pals[i] = GB_ARGB_8888(pals[i].a, pals[i].r, pals[i].g, pals[i].b);
+
+            // the argb row data
+            tb_uint32_t* argb = (tb_uint32_t*)(row_data + row_bytes_align4);
             while (height--)
             {
                 // read line
                 if (!tb_stream_bread(stream, row_data, row_bytes_align4)) break;
-                
-                // save bitmap data
-                tb_byte_t*  d = p;
-                tb_size_t   i = 0;
-                tb_size_t   m = linesize << 3;
-                for (i = 0; i < m; i += bpp, d += btp_dst)
-                {
-                    // load color
-                    c = pals[tb_bits_get_ubits32(&row_data[i / 8], i & 7, bpp)];
-
-                    // save color
-                    dp->color_set(d, c);
 
-                    // has alpha?
-                    if (!has_alpha) has_alpha = c.a <= GB_ALPHA_MAXN;
+                // load colors from the palette
+                if (bpp == 8)
+                {
+                    for (i = 0; i < width; i++) argb[i] = argb_pals[row_data[i]];
+                }
+                else
+                {
+                    tb_size_t b = 0;
+                    for (i = 0; i < width; i++, b += bpp) argb[i] = argb_pals[tb_bits_get_ubits32(&row_data[b >> 3], b & 7, bpp)];
                 }
 
+                // save bitmap data
+                gb_pixmap_converter_done(&converter, p, argb, width);
+
                 // next line
-                p -= row_bytes;
+                p += row_bytes;
             }
         }
 
@@ -372,6 +529,10 @@ static gb_bitmap_ref_t gb_bitmap_decoder_bmp_done(gb_bitmap_decoder_impl_t* deco
 
     } while (0);
 
+    // exit the row data
+    if (row_data) tb_free(row_data);
+    row_data = tb_null;
+
     // failed?
     if (!ok)
     {
@@ -406,29 +567,38 @@ gb_bitmap_decoder_ref_t gb_bitmap_decoder_bmp_init(tb_size_t pixfmt, tb_stream_r
     tb_assert_and_check_return_val(GB_PIXFMT_OK(pixfmt) && stream, tb_null);
 
     // done
-    tb_bool_t                   ok = tb_false;
-    gb_bitmap_decoder_impl_t*    impl = tb_null;
+    tb_bool_t                       ok = tb_false;
+    gb_bitmap_decoder_bmp_impl_t*   impl = tb_null;
     do
     {
+        // seek to the data offset position
+        if (!tb_stream_skip(stream, 10)) break;
+
+        // read the data offset
+        tb_uint32_t offset  = tb_stream_bread_u32_le(stream);
+
         // seek to the width and height position
-        if (!tb_stream_skip(stream, 18)) break;
+        if (!tb_stream_skip(stream, 4)) break;
 
-        // read width and height
-        tb_size_t width     = tb_stream_bread_u32_le(stream);
-        tb_size_t height    = tb_stream_bread_u32_le(stream);
+        // read width and height, the rows are top-down if the height is negative
+        tb_size_t   width       = tb_stream_bread_u32_le(stream);
+        tb_sint32_t height_s    = tb_stream_bread_s32_le(stream);
+        tb_size_t   height      = (tb_size_t)(height_s < 0? -(tb_long_t)height_s : height_s);
         tb_assert_and_check_break(width && height && width <= GB_WIDTH_MAXN && height <= GB_HEIGHT_MAXN);
 
         // make decoder
-        impl = tb_malloc0_type(gb_bitmap_decoder_impl_t);
+        impl = tb_malloc0_type(gb_bitmap_decoder_bmp_impl_t);
         tb_assert_and_check_break(impl);
 
         // init decoder
-        impl->type          = GB_BITMAP_TYPE_BMP;
-        impl->stream        = stream;
-        impl->pixfmt        = (tb_uint16_t)pixfmt;
-        impl->width         = (tb_uint16_t)width;
-        impl->height        = (tb_uint16_t)height;
-        impl->done          = gb_bitmap_decoder_bmp_done;
+        impl->base.type     = GB_BITMAP_TYPE_BMP;
+        impl->base.stream   = stream;
+        impl->base.pixfmt   = (tb_uint16_t)pixfmt;
+        impl->base.width    = (tb_uint16_t)width;
+        impl->base.height   = (tb_uint16_t)height;
+        impl->base.done     = gb_bitmap_decoder_bmp_done;
+        impl->offset        = offset;
+        impl->top_down      = height_s < 0;
 
         // ok
         ok = tb_true;
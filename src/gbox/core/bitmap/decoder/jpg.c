@@ -0,0 +1,437 @@
+/*!The Graphic Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        jpg.c
+ * @ingroup     core
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME            "jpg_decoder"
+#define TB_TRACE_MODULE_DEBUG           (1)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+#include "jpeg/jpeg.h"
+#include <setjmp.h>
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the input buffer size
+#define GB_JPG_INPUT_MAXN               (8192)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the jpg error type
+typedef struct __gb_bitmap_decoder_jpg_error_t
+{
+    // the base
+    struct jpeg_error_mgr       base;
+
+    // the jump buffer
+    jmp_buf                     jmpbuf;
+
+}gb_bitmap_decoder_jpg_error_t;
+
+// the jpg source type
+typedef struct __gb_bitmap_decoder_jpg_source_t
+{
+    // the base
+    struct jpeg_source_mgr      base;
+
+    // the stream
+    tb_stream_ref_t             stream;
+
+    // the input data
+    JOCTET                      data[GB_JPG_INPUT_MAXN];
+
+}gb_bitmap_decoder_jpg_source_t;
+
+// the jpg decoder impl type
+typedef struct __gb_bitmap_decoder_jpg_impl_t
+{
+    // the base
+    gb_bitmap_decoder_impl_t        base;
+
+    // the jpeg
+    struct jpeg_decompress_struct   jpeg;
+
+    // the jpeg error
+    gb_bitmap_decoder_jpg_error_t   error;
+
+    // the jpeg source
+    gb_bitmap_decoder_jpg_source_t  source;
+
+    // the jpeg have been inited?
+    tb_bool_t                       inited;
+
+}gb_bitmap_decoder_jpg_impl_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static tb_void_t gb_bitmap_decoder_jpg_error_exit(j_common_ptr jpeg)
+{
+    // the error
+    gb_bitmap_decoder_jpg_error_t* error = (gb_bitmap_decoder_jpg_error_t*)jpeg->err;
+
+    // trace
+    tb_char_t info[JMSG_LENGTH_MAX];
+    (*jpeg->err->format_message)(jpeg, info);
+    tb_trace_e("%s", info);
+
+    // jump to the caller
+    longjmp(error->jmpbuf, 1);
+}
+static tb_void_t gb_bitmap_decoder_jpg_output_message(j_common_ptr jpeg)
+{
+    // trace
+    tb_char_t info[JMSG_LENGTH_MAX];
+    (*jpeg->err->format_message)(jpeg, info);
+    tb_trace_w("%s", info);
+}
+static tb_void_t gb_bitmap_decoder_jpg_source_init(j_decompress_ptr jpeg)
+{
+}
+static boolean gb_bitmap_decoder_jpg_source_fill(j_decompress_ptr jpeg)
+{
+    // the source
+    gb_bitmap_decoder_jpg_source_t* source = (gb_bitmap_decoder_jpg_source_t*)jpeg->src;
+
+    // read data
+    tb_long_t real = 0;
+    while (!(real = tb_stream_read(source->stream, source->data, sizeof(source->data))))
+    {
+        // wait
+        if (tb_stream_wait(source->stream, TB_STREAM_WAIT_READ, tb_stream_timeout(source->stream)) <= 0) break;
+    }
+
+    // end? insert a fake eoi marker
+    if (real <= 0)
+    {
+        tb_trace_w("premature end of the jpeg stream");
+        source->data[0] = (JOCTET)0xff;
+        source->data[1] = (JOCTET)JPEG_EOI;
+        real = 2;
+    }
+
+    // update the input buffer
+    source->base.next_input_byte    = source->data;
+    source->base.bytes_in_buffer    = real;
+    return TRUE;
+}
+static tb_void_t gb_bitmap_decoder_jpg_source_skip(j_decompress_ptr jpeg, long size)
+{
+    // the source
+    struct jpeg_source_mgr* source = jpeg->src;
+    tb_check_return(size > 0);
+
+    // skip the input buffer
+    while (size > (long)source->bytes_in_buffer)
+    {
+        size -= (long)source->bytes_in_buffer;
+        (tb_void_t)(*source->fill_input_buffer)(jpeg);
+    }
+    source->next_input_byte += size;
+    source->bytes_in_buffer -= size;
+}
+static tb_void_t gb_bitmap_decoder_jpg_source_term(j_decompress_ptr jpeg)
+{
+}
+static tb_size_t gb_bitmap_decoder_jpg_scale(gb_bitmap_decoder_impl_t* decoder)
+{
+    // no target size?
+    tb_size_t target_width  = decoder->target_width? decoder->target_width : decoder->width;
+    tb_size_t target_height = decoder->target_height? decoder->target_height : decoder->height;
+
+    /* the largest scale denominator: 1, 2, 4, 8
+     *
+     * the output size is ceil(size / denom) and it should not be smaller than the target size
+     */
+    tb_size_t denom = 8;
+    while (denom > 1)
+    {
+        if (    ((decoder->width + denom - 1) / denom) >= target_width
+            &&  ((decoder->height + denom - 1) / denom) >= target_height)
+            break;
+        denom >>= 1;
+    }
+    return denom;
+}
+static gb_bitmap_ref_t gb_bitmap_decoder_jpg_done(gb_bitmap_decoder_impl_t* decoder)
+{
+    // check
+    gb_bitmap_decoder_jpg_impl_t* impl = (gb_bitmap_decoder_jpg_impl_t*)decoder;
+    tb_assert_and_check_return_val(impl && impl->inited && decoder->type == GB_BITMAP_TYPE_JPG, tb_null);
+
+    /* done
+     *
+     * the variables modified after setjmp need be volatile,
+     * because the error_exit() will longjmp to here if failed
+     */
+    tb_bool_t                       ok = tb_false;
+    gb_bitmap_ref_t volatile        bitmap = tb_null;
+    tb_byte_t* volatile             row_data = tb_null;
+    j_decompress_ptr                jpeg = &impl->jpeg;
+    do
+    {
+        // failed?
+        if (setjmp(impl->error.jmpbuf)) break;
+
+        // the pixfmt
+        tb_size_t pixfmt = decoder->pixfmt;
+        tb_assert_and_check_break(GB_PIXFMT_OK(pixfmt));
+
+        /* the output color space
+         *
+         * gray and cmyk will be expanded to argb8888 by ourself,
+         * because the old libjpeg does not support converting them to rgb
+         */
+        switch (jpeg->jpeg_color_space)
+        {
+        case JCS_GRAYSCALE:
+            jpeg->out_color_space = JCS_GRAYSCALE;
+            break;
+        case JCS_CMYK:
+        case JCS_YCCK:
+            jpeg->out_color_space = JCS_CMYK;
+            break;
+        default:
+            jpeg->out_color_space = JCS_RGB;
+            break;
+        }
+
+        // scale it in the DCT domain
+        jpeg->scale_num     = 1;
+        jpeg->scale_denom   = (tb_uint_t)gb_bitmap_decoder_jpg_scale(decoder);
+
+        // start decompress
+        if (!jpeg_start_decompress(jpeg)) break;
+
+        // the output width and height
+        tb_size_t width     = jpeg->output_width;
+        tb_size_t height    = jpeg->output_height;
+        tb_size_t channels  = jpeg->output_components;
+        tb_assert_and_check_break(width && height && width <= decoder->width && height <= decoder->height);
+
+        // trace
+        tb_trace_d("size: %lux%lu => %lux%lu, scale: 1/%u, channels: %lu", (tb_size_t)decoder->width, (tb_size_t)decoder->height, width, height, jpeg->scale_denom, channels);
+
+        // the source pixfmt
+        tb_bool_t is_rgb = jpeg->out_color_space == JCS_RGB;
+        tb_assert_and_check_break(is_rgb? channels == 3 : (channels == (jpeg->out_color_space == JCS_CMYK? 4 : 1)));
+        tb_size_t pixfmt_src = is_rgb? (GB_PIXFMT_RGB888 | GB_PIXFMT_BENDIAN) : (GB_PIXFMT_ARGB8888 | GB_PIXFMT_NENDIAN);
+
+        // init the row converter
+        gb_pixmap_converter_t converter;
+        if (!gb_pixmap_converter_init(&converter, pixfmt, pixfmt_src)) break;
+
+        // init bitmap, no alpha
+        bitmap = gb_bitmap_init(tb_null, pixfmt, width, height, 0, tb_false);
+        tb_assert_and_check_break(bitmap);
+
+        // the bitmap data
+        tb_byte_t*  data = (tb_byte_t*)gb_bitmap_data(bitmap);
+        tb_assert_and_check_break(data);
+
+        // make the row data and the argb row data
+        tb_size_t   linesize = tb_align4(width * channels);
+        row_data = tb_malloc_bytes(linesize + (is_rgb? 0 : (width << 2)));
+        tb_assert_and_check_break(row_data);
+
+        // done
+        tb_size_t       i = 0;
+        tb_size_t       row_bytes = gb_bitmap_row_bytes(bitmap);
+        tb_byte_t*      p = data;
+        tb_uint32_t*    argb = (tb_uint32_t*)(row_data + linesize);
+        JSAMPROW        rows[1];
+        rows[0] = (JSAMPROW)row_data;
+        while (jpeg->output_scanline < height)
+        {
+            // read line
+            if (jpeg_read_scanlines(jpeg, rows, 1) != 1) break;
+
+            // save bitmap data
+            if (is_rgb) gb_pixmap_converter_done(&converter, p, row_data, width);
+            else
+            {
+                // gray?
+                tb_byte_t const* q = row_data;
+                if (channels == 1)
+                {
+                    for (i = 0; i < width; i++, q++) argb[i] = GB_ARGB_8888(0xff, q[0], q[0], q[0]);
+                }
+                /* cmyk
+                 *
+                 * the adobe jpeg stores the inverted cmyk
+                 */
+                else if (jpeg->saw_Adobe_marker)
+                {
+                    for (i = 0; i < width; i++, q += 4)
+                        argb[i] = GB_ARGB_8888(0xff, (q[0] * q[3]) / 255, (q[1] * q[3]) / 255, (q[2] * q[3]) / 255);
+                }
+                else
+                {
+                    for (i = 0; i < width; i++, q += 4)
+                        argb[i] = GB_ARGB_8888(0xff, ((255 - q[0]) * (255 - q[3])) / 255, ((255 - q[1]) * (255 - q[3])) / 255, ((255 - q[2]) * (255 - q[3])) / 255);
+                }
+                gb_pixmap_converter_done(&converter, p, argb, width);
+            }
+
+            // next line
+            p += row_bytes;
+        }
+
+        // check
+        tb_assert_and_check_break(jpeg->output_scanline == height);
+
+        // finish decompress
+        jpeg_finish_decompress(jpeg);
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // exit the row data
+    if (row_data) tb_free(row_data);
+    row_data = tb_null;
+
+    // failed?
+    if (!ok)
+    {
+        // abort decompress
+        jpeg_abort_decompress(jpeg);
+
+        // exit it
+        if (bitmap) gb_bitmap_exit(bitmap);
+        bitmap = tb_null;
+    }
+
+    // ok?
+    return bitmap;
+}
+static tb_void_t gb_bitmap_decoder_jpg_exit(gb_bitmap_decoder_impl_t* decoder)
+{
+    // check
+    gb_bitmap_decoder_jpg_impl_t* impl = (gb_bitmap_decoder_jpg_impl_t*)decoder;
+    tb_assert_and_check_return(impl);
+
+    // exit jpeg
+    if (impl->inited) jpeg_destroy_decompress(&impl->jpeg);
+    impl->inited = tb_false;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_size_t gb_bitmap_decoder_jpg_probe(tb_stream_ref_t stream)
+{
+    // check
+    tb_assert_and_check_return_val(stream, 0);
+
+    // need
+    tb_byte_t* p = tb_null;
+    if (!tb_stream_need(stream, &p, 3)) return 0;
+    tb_assert_and_check_return_val(p, 0);
+
+    // ok? the soi marker and the next marker
+    return (p[0] == 0xff && p[1] == 0xd8 && p[2] == 0xff)? 90 : 0;
+}
+gb_bitmap_decoder_ref_t gb_bitmap_decoder_jpg_init(tb_size_t pixfmt, tb_stream_ref_t stream)
+{
+    // check
+    tb_assert_and_check_return_val(GB_PIXFMT_OK(pixfmt) && stream, tb_null);
+
+    // done
+    tb_bool_t                               ok = tb_false;
+    gb_bitmap_decoder_jpg_impl_t* volatile  impl = tb_null;
+    do
+    {
+        // make decoder
+        impl = tb_malloc0_type(gb_bitmap_decoder_jpg_impl_t);
+        tb_assert_and_check_break(impl);
+
+        // init exit first for releasing the jpeg if failed
+        impl->base.exit = gb_bitmap_decoder_jpg_exit;
+
+        // init jpeg error
+        impl->jpeg.err                  = jpeg_std_error(&impl->error.base);
+        impl->error.base.error_exit     = gb_bitmap_decoder_jpg_error_exit;
+        impl->error.base.output_message = gb_bitmap_decoder_jpg_output_message;
+
+        // failed?
+        if (setjmp(impl->error.jmpbuf)) break;
+
+        // init jpeg
+        jpeg_create_decompress(&impl->jpeg);
+        impl->inited = tb_true;
+
+        // init jpeg source
+        impl->source.stream                     = stream;
+        impl->source.base.init_source           = gb_bitmap_decoder_jpg_source_init;
+        impl->source.base.fill_input_buffer     = gb_bitmap_decoder_jpg_source_fill;
+        impl->source.base.skip_input_data       = gb_bitmap_decoder_jpg_source_skip;
+        impl->source.base.resync_to_restart     = jpeg_resync_to_restart;
+        impl->source.base.term_source           = gb_bitmap_decoder_jpg_source_term;
+        impl->source.base.next_input_byte       = tb_null;
+        impl->source.base.bytes_in_buffer       = 0;
+        impl->jpeg.src                          = &impl->source.base;
+
+        // read the jpeg header
+        if (jpeg_read_header(&impl->jpeg, TRUE) != JPEG_HEADER_OK) break;
+
+        // the width and height
+        tb_size_t width     = impl->jpeg.image_width;
+        tb_size_t height    = impl->jpeg.image_height;
+        tb_assert_and_check_break(width && height && width <= GB_WIDTH_MAXN && height <= GB_HEIGHT_MAXN);
+
+        // init decoder
+        impl->base.type     = GB_BITMAP_TYPE_JPG;
+        impl->base.stream   = stream;
+        impl->base.pixfmt   = (tb_uint16_t)pixfmt;
+        impl->base.width    = (tb_uint16_t)width;
+        impl->base.height   = (tb_uint16_t)height;
+        impl->base.done     = gb_bitmap_decoder_jpg_done;
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // failed?
+    if (!ok)
+    {
+        // exit it
+        if (impl) gb_bitmap_decoder_exit((gb_bitmap_decoder_ref_t)impl);
+        impl = tb_null;
+    }
+
+    // ok?
+    return (gb_bitmap_decoder_ref_t)impl;
+}
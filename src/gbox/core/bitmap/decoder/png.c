@@ -0,0 +1,321 @@
+/*!The Graphic Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        png.c
+ * @ingroup     core
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME            "png_decoder"
+#define TB_TRACE_MODULE_DEBUG           (1)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+#include "png/png.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the png decoder impl type
+typedef struct __gb_bitmap_decoder_png_impl_t
+{
+    // the base
+    gb_bitmap_decoder_impl_t    base;
+
+    // the png
+    png_structp                 png;
+
+    // the png info
+    png_infop                   info;
+
+}gb_bitmap_decoder_png_impl_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static tb_void_t gb_bitmap_decoder_png_read(png_structp png, png_bytep data, png_size_t size)
+{
+    // the stream
+    tb_stream_ref_t stream = (tb_stream_ref_t)png_get_io_ptr(png);
+    tb_assert(stream);
+
+    // read it
+    if (!stream || !tb_stream_bread(stream, data, size)) png_error(png, "read data failed!");
+}
+static tb_void_t gb_bitmap_decoder_png_error(png_structp png, png_const_charp error)
+{
+    // trace
+    tb_trace_e("%s", error);
+
+    // jump to the caller
+    png_longjmp(png, 1);
+}
+static tb_void_t gb_bitmap_decoder_png_warning(png_structp png, png_const_charp warning)
+{
+    // trace
+    tb_trace_w("%s", warning);
+}
+static gb_bitmap_ref_t gb_bitmap_decoder_png_done(gb_bitmap_decoder_impl_t* decoder)
+{
+    // check
+    gb_bitmap_decoder_png_impl_t* impl = (gb_bitmap_decoder_png_impl_t*)decoder;
+    tb_assert_and_check_return_val(impl && impl->png && impl->info && decoder->type == GB_BITMAP_TYPE_PNG, tb_null);
+
+    /* done
+     *
+     * the variables modified after setjmp need be volatile,
+     * because png_error() will longjmp to here if failed
+     */
+    tb_bool_t                   ok = tb_false;
+    gb_bitmap_ref_t volatile    bitmap = tb_null;
+    tb_byte_t* volatile         row_data = tb_null;
+    png_structp                 png = impl->png;
+    png_infop                   info = impl->info;
+    do
+    {
+        // failed?
+        if (setjmp(png_jmpbuf(png))) break;
+
+        // the pixfmt
+        tb_size_t pixfmt = decoder->pixfmt;
+        tb_assert_and_check_break(GB_PIXFMT_OK(pixfmt));
+
+        // the width and height
+        tb_size_t width     = decoder->width;
+        tb_size_t height    = decoder->height;
+        tb_assert_and_check_break(width && height);
+
+        // the bit depth and color type
+        tb_int_t bit_depth  = png_get_bit_depth(png, info);
+        tb_int_t color_type = png_get_color_type(png, info);
+
+        /* expand all color types to rgb or rgba with 8-bits channel
+         *
+         * palette:         => rgb
+         * gray with < 8:   => gray8
+         * transparent:     => alpha channel
+         * 16-bits:         => 8-bits
+         * gray:            => rgb
+         */
+        if (color_type == PNG_COLOR_TYPE_PALETTE) png_set_palette_to_rgb(png);
+        if (color_type == PNG_COLOR_TYPE_GRAY && bit_depth < 8) png_set_expand_gray_1_2_4_to_8(png);
+        if (png_get_valid(png, info, PNG_INFO_tRNS)) png_set_tRNS_to_alpha(png);
+        if (bit_depth == 16) png_set_strip_16(png);
+        if (color_type == PNG_COLOR_TYPE_GRAY || color_type == PNG_COLOR_TYPE_GRAY_ALPHA) png_set_gray_to_rgb(png);
+
+        // the interlace passes
+        tb_int_t passes = png_set_interlace_handling(png);
+
+        // update info
+        png_read_update_info(png, info);
+
+        // the source pixfmt, the bytes order: r g b [a]
+        tb_size_t channels = png_get_channels(png, info);
+        tb_assert_and_check_break(channels == 3 || channels == 4);
+        tb_size_t pixfmt_src = channels == 4? (GB_PIXFMT_RGBA8888 | GB_PIXFMT_BENDIAN) : (GB_PIXFMT_RGB888 | GB_PIXFMT_BENDIAN);
+
+        // trace
+        tb_trace_d("size: %lux%lu, bit_depth: %d, color_type: %d, passes: %d", width, height, bit_depth, color_type, passes);
+
+        // init the row converter
+        gb_pixmap_converter_t converter;
+        if (!gb_pixmap_converter_init(&converter, pixfmt, pixfmt_src)) break;
+
+        // init bitmap, default: no alpha
+        bitmap = gb_bitmap_init(tb_null, pixfmt, width, height, 0, tb_false);
+        tb_assert_and_check_break(bitmap);
+
+        // the bitmap data
+        tb_byte_t*  data = (tb_byte_t*)gb_bitmap_data(bitmap);
+        tb_assert_and_check_break(data);
+
+        /* make the row data
+         *
+         * the interlaced image need keep all rows of the previous passes,
+         * so we only can decode it to the whole image data first
+         */
+        tb_size_t   linesize = png_get_rowbytes(png, info);
+        tb_assert_and_check_break(linesize >= width * channels);
+        row_data = tb_malloc_bytes(passes > 1? linesize * height : linesize);
+        tb_assert_and_check_break(row_data);
+
+        // the alpha
+        tb_byte_t   alpha_maxn = GB_ALPHA_MAXN;
+        tb_bool_t   has_alpha = tb_false;
+        tb_bool_t   alpha_check = channels == 4 && GB_PIXFMT_HAS_ALPHA(pixfmt);
+
+        // done
+        tb_size_t   i = 0;
+        tb_size_t   j = 0;
+        tb_size_t   row_bytes = gb_bitmap_row_bytes(bitmap);
+        tb_byte_t*  p = data;
+        if (passes > 1)
+        {
+            // read all passes
+            tb_int_t pass = 0;
+            for (pass = 0; pass < passes; pass++)
+            {
+                for (j = 0; j < height; j++) png_read_row(png, row_data + j * linesize, tb_null);
+            }
+        }
+        for (j = 0; j < height; j++)
+        {
+            // read line
+            tb_byte_t* line = row_data;
+            if (passes > 1) line += j * linesize;
+            else png_read_row(png, line, tb_null);
+
+            // save bitmap data
+            gb_pixmap_converter_done(&converter, p, line, width);
+
+            // has alpha?
+            if (alpha_check)
+            {
+                tb_size_t n = width << 2;
+                for (i = 3; i < n && line[i] > alpha_maxn; i += 4) ;
+                if (i < n)
+                {
+                    has_alpha   = tb_true;
+                    alpha_check = tb_false;
+                }
+            }
+
+            // next line
+            p += row_bytes;
+        }
+
+        // set alpha
+        gb_bitmap_set_alpha(bitmap, has_alpha);
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // exit the row data
+    if (row_data) tb_free(row_data);
+    row_data = tb_null;
+
+    // failed?
+    if (!ok)
+    {
+        // exit it
+        if (bitmap) gb_bitmap_exit(bitmap);
+        bitmap = tb_null;
+    }
+
+    // ok?
+    return bitmap;
+}
+static tb_void_t gb_bitmap_decoder_png_exit(gb_bitmap_decoder_impl_t* decoder)
+{
+    // check
+    gb_bitmap_decoder_png_impl_t* impl = (gb_bitmap_decoder_png_impl_t*)decoder;
+    tb_assert_and_check_return(impl);
+
+    // exit png
+    if (impl->png) png_destroy_read_struct(&impl->png, impl->info? &impl->info : tb_null, tb_null);
+    impl->png = tb_null;
+    impl->info = tb_null;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_size_t gb_bitmap_decoder_png_probe(tb_stream_ref_t stream)
+{
+    // check
+    tb_assert_and_check_return_val(stream, 0);
+
+    // need
+    tb_byte_t* p = tb_null;
+    if (!tb_stream_need(stream, &p, 8)) return 0;
+    tb_assert_and_check_return_val(p, 0);
+
+    // ok?
+    return !png_sig_cmp(p, 0, 8)? 100 : 0;
+}
+gb_bitmap_decoder_ref_t gb_bitmap_decoder_png_init(tb_size_t pixfmt, tb_stream_ref_t stream)
+{
+    // check
+    tb_assert_and_check_return_val(GB_PIXFMT_OK(pixfmt) && stream, tb_null);
+
+    // done
+    tb_bool_t                               ok = tb_false;
+    gb_bitmap_decoder_png_impl_t* volatile  impl = tb_null;
+    do
+    {
+        // make decoder
+        impl = tb_malloc0_type(gb_bitmap_decoder_png_impl_t);
+        tb_assert_and_check_break(impl);
+
+        // init exit first for releasing the png if failed
+        impl->base.exit     = gb_bitmap_decoder_png_exit;
+
+        // init png
+        impl->png = png_create_read_struct(PNG_LIBPNG_VER_STRING, tb_null, gb_bitmap_decoder_png_error, gb_bitmap_decoder_png_warning);
+        tb_assert_and_check_break(impl->png);
+
+        // init png info
+        impl->info = png_create_info_struct(impl->png);
+        tb_assert_and_check_break(impl->info);
+
+        // failed?
+        if (setjmp(png_jmpbuf(impl->png))) break;
+
+        // read the png header from the stream
+        png_set_read_fn(impl->png, (png_voidp)stream, gb_bitmap_decoder_png_read);
+        png_read_info(impl->png, impl->info);
+
+        // the width and height
+        tb_size_t width     = png_get_image_width(impl->png, impl->info);
+        tb_size_t height    = png_get_image_height(impl->png, impl->info);
+        tb_assert_and_check_break(width && height && width <= GB_WIDTH_MAXN && height <= GB_HEIGHT_MAXN);
+
+        // init decoder
+        impl->base.type     = GB_BITMAP_TYPE_PNG;
+        impl->base.stream   = stream;
+        impl->base.pixfmt   = (tb_uint16_t)pixfmt;
+        impl->base.width    = (tb_uint16_t)width;
+        impl->base.height   = (tb_uint16_t)height;
+        impl->base.done     = gb_bitmap_decoder_png_done;
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // failed?
+    if (!ok)
+    {
+        // exit it
+        if (impl) gb_bitmap_decoder_exit((gb_bitmap_decoder_ref_t)impl);
+        impl = tb_null;
+    }
+
+    // ok?
+    return (gb_bitmap_decoder_ref_t)impl;
+}
@@ -56,6 +56,12 @@ typedef struct __gb_bitmap_decoder_impl_t
     // the height
     tb_uint16_t     height;
 
+    // the target width, zero: the source width
+    tb_uint16_t     target_width;
+
+    // the target height, zero: the source height
+    tb_uint16_t     target_height;
+
     // the stream
     tb_stream_ref_t stream;
 
@@ -87,6 +93,44 @@ tb_size_t               gb_bitmap_decoder_bmp_probe(tb_stream_ref_t stream);
  */
 gb_bitmap_decoder_ref_t  gb_bitmap_decoder_bmp_init(tb_size_t pixfmt, tb_stream_ref_t stream);
 
+#ifdef GB_CONFIG_PACKAGE_HAVE_JPEG
+/* probe jpg bitmap foramt
+ *
+ * @param stream        the stream
+ *
+ * @return              the score: [0, 100]
+ */
+tb_size_t               gb_bitmap_decoder_jpg_probe(tb_stream_ref_t stream);
+
+/* init jpg bitmap decoder
+ *
+ * @param pixfmt        the pixfmt
+ * @param stream        the stream
+ *
+ * @return              the decoder
+ */
+gb_bitmap_decoder_ref_t  gb_bitmap_decoder_jpg_init(tb_size_t pixfmt, tb_stream_ref_t stream);
+#endif
+
+#ifdef GB_CONFIG_PACKAGE_HAVE_PNG
+/* probe png bitmap foramt
+ *
+ * @param stream        the stream
+ *
+ * @return              the score: [0, 100]
+ */
+tb_size_t               gb_bitmap_decoder_png_probe(tb_stream_ref_t stream);
+
+/* init png bitmap decoder
+ *
+ * @param pixfmt        the pixfmt
+ * @param stream        the stream
+ *
+ * @return              the decoder
+ */
+gb_bitmap_decoder_ref_t  gb_bitmap_decoder_png_init(tb_size_t pixfmt, tb_stream_ref_t stream);
+#endif
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
  */
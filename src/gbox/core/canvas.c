@@ -38,6 +38,7 @@
 #include "path.h"
 #include "paint.h"
 #include "clipper.h"
+#include "trace.h"
 #include "impl/bounds.h"
 #include "impl/cache_stack.h"
 
@@ -828,8 +829,14 @@ tb_void_t gb_canvas_draw_clear(gb_canvas_ref_t canvas, gb_color_t color)
     gb_canvas_impl_t* impl = (gb_canvas_impl_t*)canvas;
     tb_assert_and_check_return(impl && impl->device);
 
+    // trace enter
+    gb_trace_enter(span);
+
     // clear it
     gb_device_draw_clear(impl->device, color);
+
+    // trace leave
+    gb_trace_leave(span, "gb_canvas_draw_clear");
 }
 tb_void_t gb_canvas_draw(gb_canvas_ref_t canvas)
 {
@@ -842,8 +849,14 @@ tb_void_t gb_canvas_draw_path(gb_canvas_ref_t canvas, gb_path_ref_t path)
     gb_canvas_impl_t* impl = (gb_canvas_impl_t*)canvas;
     tb_assert_and_check_return(impl && impl->device && path);
 
+    // trace enter
+    gb_trace_enter(span);
+
     // draw path
     gb_device_draw_path(impl->device, path);
+
+    // trace leave
+    gb_trace_leave(span, "gb_canvas_draw_path");
 }
 tb_void_t gb_canvas_draw_point(gb_canvas_ref_t canvas, gb_point_ref_t point)
 {
@@ -1172,8 +1185,14 @@ tb_void_t gb_canvas_draw_polygon(gb_canvas_ref_t canvas, gb_polygon_ref_t polygo
     gb_canvas_impl_t* impl = (gb_canvas_impl_t*)canvas;
     tb_assert_and_check_return(impl && impl->device);
 
+    // trace enter
+    gb_trace_enter(span);
+
     // draw polygon
     gb_device_draw_polygon(impl->device, polygon, tb_null, tb_null);
+
+    // trace leave
+    gb_trace_leave(span, "gb_canvas_draw_polygon");
 }
 tb_void_t gb_canvas_draw_lines(gb_canvas_ref_t canvas, gb_point_ref_t points, tb_size_t count)
 {
@@ -1181,8 +1200,14 @@ tb_void_t gb_canvas_draw_lines(gb_canvas_ref_t canvas, gb_point_ref_t points, tb
     gb_canvas_impl_t* impl = (gb_canvas_impl_t*)canvas;
     tb_assert_and_check_return(impl && impl->device && count && !(count & 0x1));
  
+    // trace enter
+    gb_trace_enter(span);
+
     // draw lines
     gb_device_draw_lines(impl->device, points, count, tb_null);
+
+    // trace leave
+    gb_trace_leave(span, "gb_canvas_draw_lines");
 }
 tb_void_t gb_canvas_draw_points(gb_canvas_ref_t canvas, gb_point_ref_t points, tb_size_t count)
 {
@@ -1190,6 +1215,30 @@ tb_void_t gb_canvas_draw_points(gb_canvas_ref_t canvas, gb_point_ref_t points, t
     gb_canvas_impl_t* impl = (gb_canvas_impl_t*)canvas;
     tb_assert_and_check_return(impl && impl->device && count);
 
+    // trace enter
+    gb_trace_enter(span);
+
     // draw points
     gb_device_draw_points(impl->device, points, count, tb_null);
+
+    // trace leave
+    gb_trace_leave(span, "gb_canvas_draw_points");
+}
+tb_void_t gb_canvas_stats_enable(gb_canvas_ref_t canvas, tb_bool_t enabled)
+{
+    // check
+    gb_canvas_impl_t* impl = (gb_canvas_impl_t*)canvas;
+    tb_assert_and_check_return(impl && impl->device);
+
+    // enable stats
+    gb_device_stats_enable(impl->device, enabled);
+}
+tb_bool_t gb_canvas_stats(gb_canvas_ref_t canvas, gb_device_stats_ref_t stats)
+{
+    // check
+    gb_canvas_impl_t* impl = (gb_canvas_impl_t*)canvas;
+    tb_assert_and_check_return_val(impl && impl->device, tb_false);
+
+    // the stats
+    return gb_device_stats(impl->device, stats);
 }
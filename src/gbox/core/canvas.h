@@ -29,6 +29,7 @@
 /* //////////////////////////////////////////////////////////////////////////////////////
  * includes
  */
+#include "device.h"
 #include "../platform/window.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
@@ -1114,6 +1115,22 @@ tb_void_t           gb_canvas_draw_lines(gb_canvas_ref_t canvas, gb_point_ref_t
  */
 tb_void_t           gb_canvas_draw_points(gb_canvas_ref_t canvas, gb_point_ref_t points, tb_size_t count);
 
+/*! enable or disable the rendering stats of the canvas device
+ *
+ * @param canvas    the canvas
+ * @param enabled   is enabled?
+ */
+tb_void_t           gb_canvas_stats_enable(gb_canvas_ref_t canvas, tb_bool_t enabled);
+
+/*! the rendering stats of the last frame
+ *
+ * @param canvas    the canvas
+ * @param stats     the stats
+ *
+ * @return          tb_true or tb_false if the stats is disabled
+ */
+tb_bool_t           gb_canvas_stats(gb_canvas_ref_t canvas, gb_device_stats_ref_t stats);
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
  */
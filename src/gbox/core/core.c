@@ -41,6 +41,15 @@ tb_bool_t gb_core_init()
 }
 tb_void_t gb_core_exit()
 {
+    // exit the decoding threads first, the decode funcs may still use the bitmap cache
+    gb_bitmap_decode_exit();
+
+    // exit the bitmap cache
+    gb_bitmap_cache_instance_exit();
+
+    // exit trace
+    gb_trace_exit();
+
     // exit prefix
     gb_prefix_exit();
 }
@@ -34,9 +34,13 @@
 #include "shader.h"
 #include "pixmap.h"
 #include "bitmap.h"
+#include "bitmap/cache.h"
+#include "bitmap/async.h"
 #include "canvas.h"
 #include "device.h"
 #include "clipper.h"
+#include "trace.h"
+#include "memory.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
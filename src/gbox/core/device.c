@@ -37,6 +37,7 @@
 #include "device/prefix.h"
 #include "path.h"
 #include "paint.h"
+#include "trace.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * declaration
@@ -119,6 +120,10 @@ tb_void_t gb_device_exit(gb_device_ref_t device)
     gb_device_impl_t* impl = (gb_device_impl_t*)device;
     tb_assert_and_check_return(impl);
 
+    // exit stats
+    if (impl->stats) tb_free(impl->stats);
+    impl->stats = tb_null;
+
     // exit it
     if (impl->exit) impl->exit(impl);
 }
@@ -200,8 +205,50 @@ tb_void_t gb_device_draw_clear(gb_device_ref_t device, gb_color_t color)
     gb_device_impl_t* impl = (gb_device_impl_t*)device;
     tb_assert_and_check_return(impl && impl->draw_clear);
 
+    // trace enter
+    gb_trace_enter(span);
+
+    // the start clock
+    tb_hong_t clock = gb_device_stats_clock(impl);
+
     // clear it
     impl->draw_clear(impl, color);
+
+    // update stats
+    gb_device_stats_count_add(impl, draws[GB_DEVICE_DRAW_CLEAR], 1);
+    gb_device_stats_clock_add(impl, draw_time, clock);
+
+    // trace leave
+    gb_trace_leave(span, "gb_device_draw_clear");
+}
+tb_void_t gb_device_draw_flush(gb_device_ref_t device)
+{
+    // check
+    gb_device_impl_t* impl = (gb_device_impl_t*)device;
+    tb_assert_and_check_return(impl);
+
+    // trace enter
+    gb_trace_enter(span);
+
+    // the start clock
+    tb_hong_t clock = gb_device_stats_clock(impl);
+
+    // flush it
+    if (impl->draw_flush) impl->draw_flush(impl);
+
+    // end the frame of the stats
+    if (impl->stats)
+    {
+        // update the draw time
+        impl->stats[0].draw_time += tb_uclock() - clock;
+
+        // save the current frame as the last frame and clear it
+        impl->stats[1] = impl->stats[0];
+        tb_memset(&impl->stats[0], 0, sizeof(gb_device_stats_t));
+    }
+
+    // trace leave
+    gb_trace_leave(span, "gb_device_draw_flush");
 }
 tb_void_t gb_device_draw_path(gb_device_ref_t device, gb_path_ref_t path)
 {
@@ -212,16 +259,32 @@ tb_void_t gb_device_draw_path(gb_device_ref_t device, gb_path_ref_t path)
     // null?
     if (gb_path_null(path)) return ;
 
+    // trace enter
+    gb_trace_enter(span);
+
+    // the start clock
+    tb_hong_t clock = gb_device_stats_clock(impl);
+
     // draw path
     if (impl->draw_path) impl->draw_path(impl, path);
     else
     {
+        // check
+        tb_assert_and_check_return(impl->draw_polygon);
+
         /* draw the polygon for path
          *
          * @note the quality of drawing curve may be not higher and faster for stroking with the width > 1
          */
-        gb_device_draw_polygon(device, gb_path_polygon(path), gb_path_hint(path), gb_path_bounds(path));
+        impl->draw_polygon(impl, gb_device_impl_polygon(impl, path), gb_path_hint(path), gb_path_bounds(path));
     }
+
+    // update stats
+    gb_device_stats_count_add(impl, draws[GB_DEVICE_DRAW_PATH], 1);
+    gb_device_stats_clock_add(impl, draw_time, clock);
+
+    // trace leave
+    gb_trace_leave(span, "gb_device_draw_path");
 }
 tb_void_t gb_device_draw_lines(gb_device_ref_t device, gb_point_ref_t points, tb_size_t count, gb_rect_ref_t bounds)
 {
@@ -229,8 +292,21 @@ tb_void_t gb_device_draw_lines(gb_device_ref_t device, gb_point_ref_t points, tb
     gb_device_impl_t* impl = (gb_device_impl_t*)device;
     tb_assert_and_check_return(impl && impl->draw_lines);
 
+    // trace enter
+    gb_trace_enter(span);
+
+    // the start clock
+    tb_hong_t clock = gb_device_stats_clock(impl);
+
     // draw lines
     impl->draw_lines(impl, points, count, bounds);
+
+    // update stats
+    gb_device_stats_count_add(impl, draws[GB_DEVICE_DRAW_LINES], 1);
+    gb_device_stats_clock_add(impl, draw_time, clock);
+
+    // trace leave
+    gb_trace_leave(span, "gb_device_draw_lines");
 }
 tb_void_t gb_device_draw_points(gb_device_ref_t device, gb_point_ref_t points, tb_size_t count, gb_rect_ref_t bounds)
 {
@@ -238,8 +314,21 @@ tb_void_t gb_device_draw_points(gb_device_ref_t device, gb_point_ref_t points, t
     gb_device_impl_t* impl = (gb_device_impl_t*)device;
     tb_assert_and_check_return(impl && impl->draw_points);
 
+    // trace enter
+    gb_trace_enter(span);
+
+    // the start clock
+    tb_hong_t clock = gb_device_stats_clock(impl);
+
     // draw points
     impl->draw_points(impl, points, count, bounds);
+
+    // update stats
+    gb_device_stats_count_add(impl, draws[GB_DEVICE_DRAW_POINTS], 1);
+    gb_device_stats_clock_add(impl, draw_time, clock);
+
+    // trace leave
+    gb_trace_leave(span, "gb_device_draw_points");
 }
 tb_void_t gb_device_draw_polygon(gb_device_ref_t device, gb_polygon_ref_t polygon, gb_shape_ref_t hint, gb_rect_ref_t bounds)
 {
@@ -247,7 +336,54 @@ tb_void_t gb_device_draw_polygon(gb_device_ref_t device, gb_polygon_ref_t polygo
     gb_device_impl_t* impl = (gb_device_impl_t*)device;
     tb_assert_and_check_return(impl && impl->draw_polygon);
 
+    // trace enter
+    gb_trace_enter(span);
+
+    // the start clock
+    tb_hong_t clock = gb_device_stats_clock(impl);
+
     // draw polygon
     impl->draw_polygon(impl, polygon, hint, bounds);
+
+    // update stats
+    gb_device_stats_count_add(impl, draws[GB_DEVICE_DRAW_POLYGON], 1);
+    gb_device_stats_clock_add(impl, draw_time, clock);
+
+    // trace leave
+    gb_trace_leave(span, "gb_device_draw_polygon");
 }
 
+tb_void_t gb_device_stats_enable(gb_device_ref_t device, tb_bool_t enabled)
+{
+    // check
+    gb_device_impl_t* impl = (gb_device_impl_t*)device;
+    tb_assert_and_check_return(impl);
+
+    // enable stats?
+    if (enabled)
+    {
+        // init stats for the current and last frames
+        if (!impl->stats) impl->stats = tb_nalloc0_type(2, gb_device_stats_t);
+    }
+    else
+    {
+        // exit stats
+        if (impl->stats) tb_free(impl->stats);
+        impl->stats = tb_null;
+    }
+}
+tb_bool_t gb_device_stats(gb_device_ref_t device, gb_device_stats_ref_t stats)
+{
+    // check
+    gb_device_impl_t* impl = (gb_device_impl_t*)device;
+    tb_assert_and_check_return_val(impl && stats, tb_false);
+
+    // the stats is disabled?
+    tb_check_return_val(impl->stats, tb_false);
+
+    // save the stats of the last frame
+    *stats = impl->stats[1];
+
+    // ok
+    return tb_true;
+}
@@ -51,6 +51,68 @@ typedef enum __gb_device_type_e
 
 }gb_device_type_e;
 
+/// the device draw type enum of the stats
+typedef enum __gb_device_draw_e
+{
+    GB_DEVICE_DRAW_CLEAR    = 0
+,   GB_DEVICE_DRAW_PATH     = 1
+,   GB_DEVICE_DRAW_LINES    = 2
+,   GB_DEVICE_DRAW_POINTS   = 3
+,   GB_DEVICE_DRAW_POLYGON  = 4
+,   GB_DEVICE_DRAW_MAXN     = 5
+
+}gb_device_draw_e;
+
+/// the device stats type of one frame, all times are in microseconds
+typedef struct __gb_device_stats_t
+{
+    /// the draws count for each draw type
+    tb_size_t           draws[GB_DEVICE_DRAW_MAXN];
+
+    /// the points count transformed by the matrix on the cpu
+    tb_size_t           points;
+
+    /// the polygon points count flattened from the curves of the paths
+    tb_size_t           flattened;
+
+    /// the stroker invocations count
+    tb_size_t           strokes;
+
+    /// the edges count built by the polygon raster
+    tb_size_t           edges;
+
+    /// the scanline rows count covered by the spans of the polygon raster
+    tb_size_t           scanlines;
+
+    /// the spans count emitted by the polygon raster
+    tb_size_t           spans;
+
+    /// the written pixels count without blending
+    tb_size_t           pixels_written;
+
+    /// the blended pixels count
+    tb_size_t           pixels_blended;
+
+    /// the tessellator invocations count, the cached tessellations are not included
+    tb_size_t           tessellations;
+
+    /// the time of all draws and the flush
+    tb_hong_t           draw_time;
+
+    /// the time of flattening the curves
+    tb_hong_t           flatten_time;
+
+    /// the time of stroking
+    tb_hong_t           stroke_time;
+
+    /// the time of rasterizing the polygons, the time of writing pixels is included
+    tb_hong_t           raster_time;
+
+    /// the time of tessellating the polygons
+    tb_hong_t           tessellate_time;
+
+}gb_device_stats_t, *gb_device_stats_ref_t;
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * interfaces
  */
@@ -157,6 +219,12 @@ tb_void_t           gb_device_bind_clipper(gb_device_ref_t device, gb_clipper_re
  */
 tb_void_t           gb_device_draw_clear(gb_device_ref_t device, gb_color_t color);
 
+/*! flush all pending draws to the target
+ *
+ * @param device    the device
+ */
+tb_void_t           gb_device_draw_flush(gb_device_ref_t device);
+
 /*! draw path
  *
  * @param device    the device
@@ -191,6 +259,27 @@ tb_void_t           gb_device_draw_points(gb_device_ref_t device, gb_point_ref_t
  */
 tb_void_t           gb_device_draw_polygon(gb_device_ref_t device, gb_polygon_ref_t polygon, gb_shape_ref_t hint, gb_rect_ref_t bounds);
 
+/*! enable or disable the device stats
+ *
+ * the stats is disabled by default and it costs only one branch for each counter if disabled.
+ *
+ * the counters are accumulated for the current frame and be saved as the last frame
+ * at gb_device_draw_flush(), which is called once for each frame by the window.
+ *
+ * @param device    the device
+ * @param enabled   is enabled?
+ */
+tb_void_t           gb_device_stats_enable(gb_device_ref_t device, tb_bool_t enabled);
+
+/*! the device stats of the last flushed frame
+ *
+ * @param device    the device
+ * @param stats     the stats
+ *
+ * @return          tb_true or tb_false if the stats is disabled
+ */
+tb_bool_t           gb_device_stats(gb_device_ref_t device, gb_device_stats_ref_t stats);
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
  */
@@ -73,12 +73,29 @@ static tb_void_t gb_device_bitmap_draw_clear(gb_device_impl_t* device, gb_color_
     gb_pixmap_ref_t pixmap = impl->pixmap;
     tb_assert(pixmap && pixmap->pixel && pixmap->pixels_fill);
 
-    // the pixels count
-    tb_size_t count = gb_bitmap_size(impl->bitmap) / pixmap->btp;
-    tb_assert(count);
+    // the pixel
+    gb_pixel_t pixel = pixmap->pixel(color);
 
-    // clear it
-    pixmap->pixels_fill(pixels, pixmap->pixel(color), count, 0xff);
+    // the row stride
+    tb_size_t width         = gb_bitmap_width(impl->bitmap);
+    tb_size_t height        = gb_bitmap_height(impl->bitmap);
+    tb_long_t row_stride    = gb_bitmap_row_stride(impl->bitmap);
+
+    // the rows are contiguous? clear it at once
+    if (row_stride == (tb_long_t)(width * pixmap->btp)) pixmap->pixels_fill(pixels, pixel, width * height, 0xff);
+    else
+    {
+        // clear it row by row, e.g. the padded or bottom-up bitmap
+        tb_byte_t* row = (tb_byte_t*)pixels;
+        while (height--)
+        {
+            pixmap->pixels_fill(row, pixel, width, 0xff);
+            row += row_stride;
+        }
+    }
+
+    // the pixels of the bitmap have been modified
+    gb_bitmap_modified(impl->bitmap, 0, 0);
 }
 static tb_void_t gb_device_bitmap_draw_lines(gb_device_impl_t* device, gb_point_ref_t points, tb_size_t count, gb_rect_ref_t bounds)
 {
@@ -193,6 +210,9 @@ static tb_void_t gb_device_bitmap_exit(gb_device_impl_t* device)
     if (impl->raster) gb_polygon_raster_exit(impl->raster);
     impl->raster = tb_null;
 
+    // exit memory
+    gb_memory_sync(GB_MEMORY_TAG_DEVICE, impl->memory, 0);
+
     // exit it
     tb_free(impl);
 }
@@ -255,6 +275,9 @@ gb_device_ref_t gb_device_init_bitmap(gb_bitmap_ref_t bitmap)
         impl->counts = tb_vector_init(8, tb_element_uint16());
         tb_assert_and_check_break(impl->counts);
 
+        // sync memory
+        gb_bitmap_device_memory_sync(impl);
+
         // ok
         ok = tb_true;
 
@@ -37,6 +37,13 @@
 #include "biltter/solid.h"
 #include "biltter/shader.h"
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// add the written or blended pixels count to the device stats
+#define gb_bitmap_biltter_stats_add(biltter, n)     do { if ((biltter)->stats) { if ((biltter)->blend) (biltter)->stats->pixels_blended += (n); else (biltter)->stats->pixels_written += (n); } } while (0)
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
  */
@@ -61,6 +68,9 @@ tb_void_t gb_bitmap_biltter_done_p(gb_bitmap_biltter_ref_t biltter, tb_long_t x,
     // check
     tb_assert(biltter && biltter->done_p);
 
+    // update stats
+    gb_bitmap_biltter_stats_add(biltter, 1);
+
     // done it
     biltter->done_p(biltter, x, y);
 }
@@ -69,6 +79,9 @@ tb_void_t gb_bitmap_biltter_done_h(gb_bitmap_biltter_ref_t biltter, tb_long_t x,
     // check
     tb_assert(biltter && biltter->done_h);
 
+    // update stats
+    gb_bitmap_biltter_stats_add(biltter, w);
+
     // done it
     biltter->done_h(biltter, x, y, w);
 }
@@ -77,6 +90,9 @@ tb_void_t gb_bitmap_biltter_done_v(gb_bitmap_biltter_ref_t biltter, tb_long_t x,
     // check
     tb_assert(biltter && biltter->done_v);
 
+    // update stats
+    gb_bitmap_biltter_stats_add(biltter, h);
+
     // done it
     biltter->done_v(biltter, x, y, h);
 }
@@ -85,6 +101,9 @@ tb_void_t gb_bitmap_biltter_done_r(gb_bitmap_biltter_ref_t biltter, tb_long_t x,
     // check
     tb_assert(biltter);
 
+    // update stats
+    gb_bitmap_biltter_stats_add(biltter, w * h);
+
     // horizontal?
     if (h == 1) 
     {
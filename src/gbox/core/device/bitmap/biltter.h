@@ -69,8 +69,14 @@ typedef struct __gb_bitmap_biltter_t
     // the btp of the bitmap 
     tb_size_t                       btp;
 
-    // the row bytes of the bitmap
-    tb_size_t                       row_bytes;
+    // the signed row stride of the bitmap, negative for the bottom-up bitmap
+    tb_long_t                       row_bytes;
+
+    // blend the pixels? 
+    tb_bool_t                       blend;
+
+    // the device stats for counting the pixels, null if disabled
+    gb_device_stats_ref_t           stats;
 
     /* exit the biltter
      *
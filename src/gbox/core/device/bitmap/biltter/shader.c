@@ -52,7 +52,10 @@ tb_bool_t gb_bitmap_biltter_shader_init(gb_bitmap_biltter_ref_t biltter, gb_bitm
 
     // init btp and row_bytes
     biltter->btp        = biltter->pixmap->btp;
-    biltter->row_bytes  = gb_bitmap_row_bytes(biltter->bitmap);
+    biltter->row_bytes  = gb_bitmap_row_stride(biltter->bitmap);
+
+    // blend it
+    biltter->blend      = tb_true;
 
     // init shader
     // TODO
@@ -82,7 +82,7 @@ static tb_void_t gb_bitmap_biltter_solid_done_v(gb_bitmap_biltter_ref_t biltter,
 
     // the factors
     tb_size_t                       btp = biltter->btp;
-    tb_size_t                       row_bytes = biltter->row_bytes;
+    tb_long_t                       row_bytes = biltter->row_bytes;
     gb_pixel_t                      pixel = biltter->u.solid.pixel;
     tb_byte_t                       alpha = biltter->u.solid.alpha;
     gb_pixmap_func_pixel_set_t      pixel_set = biltter->pixmap->pixel_set;
@@ -105,16 +105,16 @@ static tb_void_t gb_bitmap_biltter_solid_done_r(gb_bitmap_biltter_ref_t biltter,
 
     // the factors
     tb_size_t                       btp = biltter->btp;
-    tb_size_t                       row_bytes = biltter->row_bytes;
+    tb_long_t                       row_bytes = biltter->row_bytes;
     gb_pixel_t                      pixel = biltter->u.solid.pixel;
     tb_byte_t                       alpha = biltter->u.solid.alpha;
     gb_pixmap_func_pixels_fill_t    pixels_fill = biltter->pixmap->pixels_fill;
 
     // done
-    if (!x && (w * btp == row_bytes)) pixels_fill(pixels, pixel, h * w, alpha);
+    if (!x && ((tb_long_t)(w * btp) == row_bytes)) pixels_fill(pixels + y * row_bytes, pixel, h * w, alpha);
     else
     {
-        pixels += y * row_bytes + x * btp;
+        pixels += y * row_bytes + (tb_long_t)(x * btp);
         while (h--) 
         {
             pixels_fill(pixels, pixel, w, alpha);
@@ -140,12 +140,15 @@ tb_bool_t gb_bitmap_biltter_solid_init(gb_bitmap_biltter_ref_t biltter, gb_bitma
 
     // init btp and row_bytes
     biltter->btp        = biltter->pixmap->btp;
-    biltter->row_bytes  = gb_bitmap_row_bytes(biltter->bitmap);
+    biltter->row_bytes  = gb_bitmap_row_stride(biltter->bitmap);
 
     // init solid
     biltter->u.solid.pixel = biltter->pixmap->pixel(gb_paint_color(paint));
     biltter->u.solid.alpha = gb_paint_alpha(paint);
 
+    // the pixels will be blended if the alpha is not opaque or transparent for the current quality
+    biltter->blend = (biltter->u.solid.alpha >= GB_ALPHA_MINN && biltter->u.solid.alpha <= GB_ALPHA_MAXN)? tb_true : tb_false;
+
     // init operations
     biltter->done_p     = gb_bitmap_biltter_solid_done_p;
     biltter->done_h     = gb_bitmap_biltter_solid_done_h;
@@ -32,6 +32,14 @@
 #include "biltter.h"
 #include "../../impl/stroker.h"
 #include "../../impl/polygon_raster.h"
+#include "../../memory.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// sync the allocated bytes of the points and counts to the memory tag
+#define gb_bitmap_device_memory_sync(device)    gb_memory_sync(GB_MEMORY_TAG_DEVICE, (device)->memory, sizeof(gb_bitmap_device_t) + gb_memory_vector((device)->points) + gb_memory_vector((device)->counts))
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * types
@@ -70,6 +78,9 @@ typedef struct __gb_bitmap_device_t
     // the stroker
     gb_stroker_ref_t                stroker;
 
+    // the accounted bytes of the memory tag
+    tb_size_t                       memory;
+
 }gb_bitmap_device_t, *gb_bitmap_device_ref_t;
 
 #endif
@@ -85,6 +85,12 @@ static tb_size_t gb_bitmap_render_apply_matrix_for_points(gb_bitmap_device_ref_t
         tb_vector_insert_tail(device->points, &point);
     }
 
+    // update stats
+    gb_device_stats_count_add(&device->base, points, count);
+
+    // sync memory
+    gb_bitmap_device_memory_sync(device);
+
     // save points
     if (output) *output = (gb_point_ref_t)tb_vector_data(device->points);
     tb_assert(*output);
@@ -126,6 +132,12 @@ static tb_size_t gb_bitmap_render_apply_matrix_for_polygon(gb_bitmap_device_ref_
         }
     }
 
+    // update stats
+    gb_device_stats_count_add(&device->base, points, tb_vector_size(device->points));
+
+    // sync memory
+    gb_bitmap_device_memory_sync(device);
+
     // save points
     if (output) *output = (gb_point_ref_t)tb_vector_data(device->points);
     tb_assert(*output);
@@ -214,6 +226,9 @@ tb_bool_t gb_bitmap_render_init(gb_bitmap_device_ref_t device)
         // init biltter
         if (!gb_bitmap_biltter_init(&device->biltter, device->bitmap, device->base.paint)) break;
 
+        // count the pixels to the device stats
+        device->biltter.stats = device->base.stats;
+
         // ok
         ok = tb_true;
 
@@ -232,6 +247,9 @@ tb_void_t gb_bitmap_render_exit(gb_bitmap_device_ref_t device)
 
     // exit biltter
     gb_bitmap_biltter_exit(&device->biltter);
+
+    // the pixels of the bitmap have been modified, the cached textures of this bitmap will be updated
+    if (device->bitmap) gb_bitmap_modified(device->bitmap, 0, 0);
 }
 tb_void_t gb_bitmap_render_draw_path(gb_bitmap_device_ref_t device, gb_path_ref_t path)
 {
@@ -244,7 +262,7 @@ tb_void_t gb_bitmap_render_draw_path(gb_bitmap_device_ref_t device, gb_path_ref_
     // fill it
     if (mode & GB_PAINT_MODE_FILL)
     {
-        gb_bitmap_render_draw_polygon(device, gb_path_polygon(path), gb_path_hint(path), gb_path_bounds(path));
+        gb_bitmap_render_draw_polygon(device, gb_device_impl_polygon(&device->base, path), gb_path_hint(path), gb_path_bounds(path));
     }
 
     // stroke it
@@ -253,10 +271,20 @@ tb_void_t gb_bitmap_render_draw_path(gb_bitmap_device_ref_t device, gb_path_ref_
         // only stroke?
         if (gb_bitmap_render_stroke_only(device))
         {
-            gb_bitmap_render_draw_polygon(device, gb_path_polygon(path), gb_path_hint(path), gb_path_bounds(path));
+            gb_bitmap_render_draw_polygon(device, gb_device_impl_polygon(&device->base, path), gb_path_hint(path), gb_path_bounds(path));
         }
         // fill the stroked path
-        else gb_bitmap_render_stroke_fill(device, gb_stroker_done_path(device->stroker, device->base.paint, path));
+        else
+        {
+            // stroke it
+            tb_hong_t       clock = gb_device_stats_clock(&device->base);
+            gb_path_ref_t   stroked_path = gb_stroker_done_path(device->stroker, device->base.paint, path);
+            gb_device_stats_count_add(&device->base, strokes, 1);
+            gb_device_stats_clock_add(&device->base, stroke_time, clock);
+
+            // fill it
+            gb_bitmap_render_stroke_fill(device, stroked_path);
+        }
     }
 }
 tb_void_t gb_bitmap_render_draw_lines(gb_bitmap_device_ref_t device, gb_point_ref_t points, tb_size_t count, gb_rect_ref_t bounds)
@@ -285,7 +313,17 @@ tb_void_t gb_bitmap_render_draw_lines(gb_bitmap_device_ref_t device, gb_point_re
         gb_bitmap_render_stroke_lines(device, stroked_points, stroked_count);
     }
     // fill the stroked lines
-    else gb_bitmap_render_stroke_fill(device, gb_stroker_done_lines(device->stroker, device->base.paint, points, count));
+    else
+    {
+        // stroke it
+        tb_hong_t       clock = gb_device_stats_clock(&device->base);
+        gb_path_ref_t   stroked_path = gb_stroker_done_lines(device->stroker, device->base.paint, points, count);
+        gb_device_stats_count_add(&device->base, strokes, 1);
+        gb_device_stats_clock_add(&device->base, stroke_time, clock);
+
+        // fill it
+        gb_bitmap_render_stroke_fill(device, stroked_path);
+    }
 }
 tb_void_t gb_bitmap_render_draw_points(gb_bitmap_device_ref_t device, gb_point_ref_t points, tb_size_t count, gb_rect_ref_t bounds)
 {
@@ -313,7 +351,17 @@ tb_void_t gb_bitmap_render_draw_points(gb_bitmap_device_ref_t device, gb_point_r
         gb_bitmap_render_stroke_points(device, stroked_points, stroked_count);
     }
     // fill the stroked points
-    else gb_bitmap_render_stroke_fill(device, gb_stroker_done_points(device->stroker, device->base.paint, points, count));
+    else
+    {
+        // stroke it
+        tb_hong_t       clock = gb_device_stats_clock(&device->base);
+        gb_path_ref_t   stroked_path = gb_stroker_done_points(device->stroker, device->base.paint, points, count);
+        gb_device_stats_count_add(&device->base, strokes, 1);
+        gb_device_stats_clock_add(&device->base, stroke_time, clock);
+
+        // fill it
+        gb_bitmap_render_stroke_fill(device, stroked_path);
+    }
 }
 tb_void_t gb_bitmap_render_draw_polygon(gb_bitmap_device_ref_t device, gb_polygon_ref_t polygon, gb_shape_ref_t hint, gb_rect_ref_t bounds)
 {
@@ -386,7 +434,17 @@ tb_void_t gb_bitmap_render_draw_polygon(gb_bitmap_device_ref_t device, gb_polygo
             if (stroked_count) gb_bitmap_render_stroke_polygon(device, &stroked_polygon);
         }
         // fill the stroked polygon
-        else gb_bitmap_render_stroke_fill(device, gb_stroker_done_polygon(device->stroker, device->base.paint, polygon, hint));
+        else
+        {
+            // stroke it
+            tb_hong_t       clock = gb_device_stats_clock(&device->base);
+            gb_path_ref_t   stroked_path = gb_stroker_done_polygon(device->stroker, device->base.paint, polygon, hint);
+            gb_device_stats_count_add(&device->base, strokes, 1);
+            gb_device_stats_clock_add(&device->base, stroke_time, clock);
+
+            // fill it
+            gb_bitmap_render_stroke_fill(device, stroked_path);
+        }
     }
 }
 
@@ -42,10 +42,18 @@
 static tb_void_t gb_bitmap_render_fill_raster(tb_long_t lx, tb_long_t rx, tb_long_t yb, tb_long_t ye, tb_cpointer_t priv)
 {
     // check
-    tb_assert(priv && rx >= lx && ye > yb);
+    gb_bitmap_biltter_ref_t biltter = (gb_bitmap_biltter_ref_t)priv;
+    tb_assert(biltter && rx >= lx && ye > yb);
+
+    // update stats
+    if (biltter->stats)
+    {
+        biltter->stats->spans++;
+        biltter->stats->scanlines += ye - yb;
+    }
 
     // done biltter
-    gb_bitmap_biltter_done_r((gb_bitmap_biltter_ref_t)priv, lx, yb, rx - lx, ye - yb);
+    gb_bitmap_biltter_done_r(biltter, lx, yb, rx - lx, ye - yb);
 }
 
 /* //////////////////////////////////////////////////////////////////////////////////////
@@ -56,8 +64,15 @@ tb_void_t gb_bitmap_render_fill_polygon(gb_bitmap_device_ref_t device, gb_polygo
     // check
     tb_assert(device && device->base.paint);
 
+    // the start clock
+    tb_hong_t clock = gb_device_stats_clock(&device->base);
+
     // done raster
-    gb_polygon_raster_done(device->raster, polygon, bounds, gb_paint_fill_rule(device->base.paint), gb_bitmap_render_fill_raster, &device->biltter);
+    tb_size_t edges = gb_polygon_raster_done(device->raster, polygon, bounds, gb_paint_fill_rule(device->base.paint), gb_bitmap_render_fill_raster, &device->biltter);
+
+    // update stats
+    gb_device_stats_count_add(&device->base, edges, edges);
+    gb_device_stats_clock_add(&device->base, raster_time, clock);
 }
 tb_void_t gb_bitmap_render_stroke_polygon(gb_bitmap_device_ref_t device, gb_polygon_ref_t polygon)
 {
@@ -86,6 +86,9 @@ static tb_void_t gb_device_gl_resize(gb_device_impl_t* device, tb_size_t width,
     gb_gl_device_ref_t impl = (gb_gl_device_ref_t)device;
     tb_assert_and_check_return(impl);
 
+    // flush the pending draws with the old viewport
+    if (impl->batch) gb_gl_batch_flush(impl->batch);
+
 	// update viewport
 	gb_glViewport(0, 0, width, height);
 
@@ -109,9 +112,28 @@ static tb_void_t gb_device_gl_resize(gb_device_impl_t* device, tb_size_t width,
 }
 static tb_void_t gb_device_gl_draw_clear(gb_device_impl_t* device, gb_color_t color)
 {
-    // clear it
+    // check
+    gb_gl_device_ref_t impl = (gb_gl_device_ref_t)device;
+    tb_assert_and_check_return(impl);
+
+    // flush the pending draws
+    if (impl->batch) gb_gl_batch_flush(impl->batch);
+
+    // clear it, the stencil buffer need be zero for the stencil-then-cover fills
 	gb_glClearColor((gb_GLfloat_t)color.r / 0xff, (gb_GLfloat_t)color.g / 0xff, (gb_GLfloat_t)color.b / 0xff, (gb_GLfloat_t)color.a / 0xff);
-	gb_glClear(GB_GL_COLOR_BUFFER_BIT);
+	gb_glClear(impl->stencil? (GB_GL_COLOR_BUFFER_BIT | GB_GL_STENCIL_BUFFER_BIT) : GB_GL_COLOR_BUFFER_BIT);
+}
+static tb_void_t gb_device_gl_draw_flush(gb_device_impl_t* device)
+{
+    // check
+    gb_gl_device_ref_t impl = (gb_gl_device_ref_t)device;
+    tb_assert_and_check_return(impl);
+
+    // flush the pending draws
+    if (impl->batch) gb_gl_batch_flush(impl->batch);
+
+    // end the frame for the gl tracer
+    gb_gl_tracer_frame();
 }
 static tb_void_t gb_device_gl_draw_path(gb_device_impl_t* device, gb_path_ref_t path)
 {
@@ -210,6 +232,18 @@ static tb_void_t gb_device_gl_exit(gb_device_impl_t* device)
     gb_gl_device_ref_t impl = (gb_gl_device_ref_t)device;
     tb_assert_and_check_return(impl);
      
+    // exit batch
+    if (impl->batch) gb_gl_batch_exit(impl->batch);
+    impl->batch = tb_null;
+
+    // exit texture cache
+    if (impl->textures) gb_gl_texture_exit(impl->textures);
+    impl->textures = tb_null;
+
+    // exit tessellation cache
+    if (impl->cache) gb_gl_cache_exit(impl->cache);
+    impl->cache = tb_null;
+
     // exit tessellator
     if (impl->tessellator) gb_tessellator_exit(impl->tessellator);
     impl->tessellator = tb_null;
@@ -256,6 +290,7 @@ gb_device_ref_t gb_device_init_gl(gb_window_ref_t window)
         impl->base.type             = GB_DEVICE_TYPE_GL;
         impl->base.resize           = gb_device_gl_resize;
         impl->base.draw_clear       = gb_device_gl_draw_clear;
+        impl->base.draw_flush       = gb_device_gl_draw_flush;
         impl->base.draw_path        = gb_device_gl_draw_path;
         impl->base.draw_lines       = gb_device_gl_draw_lines;
         impl->base.draw_points      = gb_device_gl_draw_points;
@@ -276,8 +311,12 @@ gb_device_ref_t gb_device_init_gl(gb_window_ref_t window)
         impl->tessellator = gb_tessellator_init();
         tb_assert_and_check_break(impl->tessellator);
 
-        // init tessellator mode
-        gb_tessellator_mode_set(impl->tessellator, GB_TESSELLATOR_MODE_CONVEX);
+        // init tessellator mode, the triangle strip need fewer vertices and draw calls for each path
+        gb_tessellator_mode_set(impl->tessellator, GB_TESSELLATOR_MODE_STRIP);
+
+        // init tessellation cache
+        impl->cache = gb_gl_cache_init(0);
+        tb_assert_and_check_break(impl->cache);
 
         // init version 
         if (!impl->version)
@@ -314,8 +353,21 @@ gb_device_ref_t gb_device_init_gl(gb_window_ref_t window)
             impl->programs[GB_GL_PROGRAM_TYPE_BITMAP] = gb_gl_program_init_bitmap();
             tb_assert_and_check_break(impl->programs[GB_GL_PROGRAM_TYPE_BITMAP]);
 
+            // init linear gradient program
+            impl->programs[GB_GL_PROGRAM_TYPE_LINEAR] = gb_gl_program_init_linear();
+            tb_assert_and_check_break(impl->programs[GB_GL_PROGRAM_TYPE_LINEAR]);
+
+            // init radial gradient program
+            impl->programs[GB_GL_PROGRAM_TYPE_RADIAL] = gb_gl_program_init_radial();
+            tb_assert_and_check_break(impl->programs[GB_GL_PROGRAM_TYPE_RADIAL]);
+
             // init the projection matrix
             gb_gl_matrix_orthof(impl->matrix_project, 0.0f, (gb_GLfloat_t)width, (gb_GLfloat_t)height, 0.0f, -1.0f, 1.0f);
+
+            // init stencil, the concave polygon can be filled by stencil-then-cover if the stencil buffer exists
+            gb_GLint_t stencil_bits = 0;
+            gb_glGetIntegerv(GB_GL_STENCIL_BITS, &stencil_bits);
+            impl->stencil = stencil_bits > 0;
         }
         // init gl 1.x
         else
@@ -330,6 +382,17 @@ gb_device_ref_t gb_device_init_gl(gb_window_ref_t window)
             gb_glLoadIdentity();
         }
 
+        // init the shadow state, the gl context state is unknown now
+        gb_gl_state_reset(&impl->state);
+
+        // init batch
+        impl->batch = gb_gl_batch_init(impl->version, &impl->state);
+        tb_assert_and_check_break(impl->batch);
+
+        // init texture cache
+        impl->textures = gb_gl_texture_init(impl->version, 0);
+        tb_assert_and_check_break(impl->textures);
+
         // ok
         ok = tb_true;
 
@@ -0,0 +1,433 @@
+/*!The Graphic Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        batch.c
+ * @ingroup     core
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME            "gl_batch"
+#define TB_TRACE_MODULE_DEBUG           (0)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "batch.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the vertices grow
+#ifdef __gb_small__
+#   define GB_GL_BATCH_VERTICES_GROW        (256)
+#else
+#   define GB_GL_BATCH_VERTICES_GROW        (1024)
+#endif
+
+// the default size of the streaming buffer ring
+#ifdef __gb_small__
+#   define GB_GL_BATCH_BUFFER_SIZE          (256 << 10)
+#else
+#   define GB_GL_BATCH_BUFFER_SIZE          (1 << 20)
+#endif
+
+// the buffer index
+#define GB_GL_BATCH_BUFFER_VERTICES         (0)
+#define GB_GL_BATCH_BUFFER_INDICES          (1)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the gl batch vertex type
+typedef struct __gb_gl_batch_vertex_t
+{
+    // the point
+    gb_point_t                  point;
+
+    // the color: r, g, b, a
+    tb_byte_t                   color[4];
+
+}gb_gl_batch_vertex_t;
+
+// the gl batch impl type
+typedef struct __gb_gl_batch_impl_t
+{
+    // the gl version
+    tb_size_t                   version;
+
+    // the shadow state of the gl context
+    gb_gl_state_ref_t           context;
+
+    // the state of the pending draws
+    gb_gl_batch_state_t         state;
+
+    // the vertices
+    gb_gl_batch_vertex_t*       vertices;
+
+    // the vertices count
+    tb_size_t                   vertices_count;
+
+    // the vertices maxn
+    tb_size_t                   vertices_maxn;
+
+    // the indices
+    tb_uint16_t*                indices;
+
+    // the indices count
+    tb_size_t                   indices_count;
+
+    // the indices maxn
+    tb_size_t                   indices_maxn;
+
+    /* the streaming vertex and index buffers for gl >= 2.0
+     *
+     * the data will be appended at the current offset of the buffer ring,
+     * and the buffer will be orphaned and rewound if it is full,
+     * so we need not wait for the previous draw calls which are still using it.
+     */
+    gb_GLuint_t                 buffers[2];
+
+    // the buffer sizes
+    tb_size_t                   buffers_size[2];
+
+    // the buffer offsets
+    tb_size_t                   buffers_offset[2];
+
+    // the stats
+    gb_gl_batch_stats_t         stats;
+
+}gb_gl_batch_impl_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static __tb_inline__ tb_bool_t gb_gl_batch_state_eq(gb_gl_batch_state_ref_t state, gb_gl_batch_state_ref_t other)
+{
+    return (    state->program == other->program
+            &&  state->blend == other->blend
+            &&  state->antialiasing == other->antialiasing
+            &&  !tb_memcmp(state->matrix_vertex, other->matrix_vertex, sizeof(gb_gl_matrix_t))
+            &&  !tb_memcmp(state->matrix_project, other->matrix_project, sizeof(gb_gl_matrix_t)))? tb_true : tb_false;
+}
+static tb_bool_t gb_gl_batch_grow(gb_gl_batch_impl_t* impl, tb_size_t vertices_count, tb_size_t indices_count)
+{
+    // check
+    tb_assert(impl);
+
+    // grow vertices
+    if (impl->vertices_count + vertices_count > impl->vertices_maxn)
+    {
+        impl->vertices_maxn = impl->vertices_count + vertices_count + GB_GL_BATCH_VERTICES_GROW;
+        impl->vertices = tb_ralloc_type(impl->vertices, impl->vertices_maxn, gb_gl_batch_vertex_t);
+        tb_assert_and_check_return_val(impl->vertices, tb_false);
+    }
+
+    // grow indices
+    if (impl->indices_count + indices_count > impl->indices_maxn)
+    {
+        impl->indices_maxn = impl->indices_count + indices_count + GB_GL_BATCH_VERTICES_GROW * 3;
+        impl->indices = tb_ralloc_type(impl->indices, impl->indices_maxn, tb_uint16_t);
+        tb_assert_and_check_return_val(impl->indices, tb_false);
+    }
+
+    // ok
+    return tb_true;
+}
+static tb_size_t gb_gl_batch_stream(gb_gl_batch_impl_t* impl, tb_size_t index, gb_GLenum_t target, tb_cpointer_t data, tb_size_t size)
+{
+    // check
+    tb_assert(impl && impl->context && index < tb_arrayn(impl->buffers) && impl->buffers[index] && data && size);
+
+    // bind buffer
+    gb_gl_state_buffer(impl->context, target, impl->buffers[index]);
+
+    // the buffer is full? orphan it and rewind the buffer ring
+    if (impl->buffers_offset[index] + size > impl->buffers_size[index])
+    {
+        // the buffer size, grow it if the data is too large
+        if (!impl->buffers_size[index]) impl->buffers_size[index] = GB_GL_BATCH_BUFFER_SIZE;
+        if (impl->buffers_size[index] < size) impl->buffers_size[index] = size;
+
+        // orphan it, the old storage will be released after all pending draw calls are finished
+        gb_glBufferData(target, (gb_GLsizeiptr_t)impl->buffers_size[index], tb_null, GB_GL_STREAM_DRAW);
+
+        // rewind it
+        impl->buffers_offset[index] = 0;
+
+        // update stats
+        impl->stats.orphans++;
+    }
+
+    // upload data to the free range
+    tb_size_t offset = impl->buffers_offset[index];
+    gb_glBufferSubData(target, (gb_GLintptr_t)offset, (gb_GLsizeiptr_t)size, data);
+
+    // update the offset
+    impl->buffers_offset[index] = offset + size;
+
+    // ok
+    return offset;
+}
+static tb_void_t gb_gl_batch_flush_v2(gb_gl_batch_impl_t* impl)
+{
+    // check
+    tb_assert(impl && impl->state.program);
+
+    // the program
+    gb_gl_program_ref_t program = impl->state.program;
+
+    // stream vertices and indices
+    tb_size_t vertices_offset   = gb_gl_batch_stream(impl, GB_GL_BATCH_BUFFER_VERTICES, GB_GL_ARRAY_BUFFER, impl->vertices, impl->vertices_count * sizeof(gb_gl_batch_vertex_t));
+    tb_size_t indices_offset    = gb_gl_batch_stream(impl, GB_GL_BATCH_BUFFER_INDICES, GB_GL_ELEMENT_ARRAY_BUFFER, impl->indices, impl->indices_count * sizeof(tb_uint16_t));
+
+    // bind program
+    gb_gl_state_program(impl->context, program);
+
+    // apply projection and vertex matrix
+    gb_gl_state_matrix(impl->context, GB_GL_PROGRAM_LOCATION_MATRIX_PROJECT, impl->state.matrix_project);
+    gb_gl_state_matrix(impl->context, GB_GL_PROGRAM_LOCATION_MATRIX_MODEL, impl->state.matrix_vertex);
+
+    // apply vertices and colors
+    gb_GLint_t vertices     = gb_gl_program_location(program, GB_GL_PROGRAM_LOCATION_VERTICES);
+    gb_GLint_t colors       = gb_gl_program_location(program, GB_GL_PROGRAM_LOCATION_COLORS);
+    gb_gl_state_attrib(impl->context, vertices, tb_true);
+    gb_gl_state_attrib(impl->context, colors, tb_true);
+    gb_glVertexAttribPointer(vertices, 2, GB_GL_VERTEX_TYPE, GB_GL_FALSE, sizeof(gb_gl_batch_vertex_t), (gb_GLvoid_t const*)(vertices_offset + tb_offsetof(gb_gl_batch_vertex_t, point)));
+    gb_glVertexAttribPointer(colors, 4, GB_GL_UNSIGNED_BYTE, GB_GL_TRUE, sizeof(gb_gl_batch_vertex_t), (gb_GLvoid_t const*)(vertices_offset + tb_offsetof(gb_gl_batch_vertex_t, color)));
+
+    /* draw all triangles
+     *
+     * the buffers and the vertex attribute arrays are kept for the next flush,
+     * the direct draws will unbind and disable them if necessary
+     */
+    gb_glDrawElements(GB_GL_TRIANGLES, (gb_GLsizei_t)impl->indices_count, GB_GL_UNSIGNED_SHORT, (gb_GLvoid_t const*)indices_offset);
+}
+static tb_void_t gb_gl_batch_flush_v1(gb_gl_batch_impl_t* impl)
+{
+    // check
+    tb_assert(impl);
+
+    // apply vertices and colors
+    gb_gl_state_client(impl->context, GB_GL_VERTEX_ARRAY, tb_true);
+    gb_gl_state_client(impl->context, GB_GL_COLOR_ARRAY, tb_true);
+    gb_glVertexPointer(2, GB_GL_VERTEX_TYPE, sizeof(gb_gl_batch_vertex_t), &impl->vertices->point);
+    gb_glColorPointer(4, GB_GL_UNSIGNED_BYTE, sizeof(gb_gl_batch_vertex_t), impl->vertices->color);
+
+    // apply vertex matrix
+    gb_glMatrixMode(GB_GL_MODELVIEW);
+    gb_glPushMatrix();
+    gb_glLoadIdentity();
+    gb_glMultMatrixf(impl->state.matrix_vertex);
+
+    // draw all triangles
+    gb_glDrawElements(GB_GL_TRIANGLES, (gb_GLsizei_t)impl->indices_count, GB_GL_UNSIGNED_SHORT, impl->indices);
+
+    // restore vertex matrix
+    gb_glPopMatrix();
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+gb_gl_batch_ref_t gb_gl_batch_init(tb_size_t version, gb_gl_state_ref_t state)
+{
+    // check
+    tb_assert_and_check_return_val(state, tb_null);
+
+    // done
+    tb_bool_t           ok = tb_false;
+    gb_gl_batch_impl_t* impl = tb_null;
+    do
+    {
+        // make batch
+        impl = tb_malloc0_type(gb_gl_batch_impl_t);
+        tb_assert_and_check_break(impl);
+
+        // init version
+        impl->version = version;
+
+        // init the shadow state
+        impl->context = state;
+
+        // init vertices and indices
+        if (!gb_gl_batch_grow(impl, GB_GL_BATCH_VERTICES_GROW, GB_GL_BATCH_VERTICES_GROW * 3)) break;
+
+        // init the streaming buffers for gl >= 2.0
+        if (version >= 0x20)
+        {
+            gb_glGenBuffers(tb_arrayn(impl->buffers), impl->buffers);
+            tb_assert_and_check_break(impl->buffers[GB_GL_BATCH_BUFFER_VERTICES] && impl->buffers[GB_GL_BATCH_BUFFER_INDICES]);
+        }
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // failed?
+    if (!ok)
+    {
+        // exit it
+        if (impl) gb_gl_batch_exit((gb_gl_batch_ref_t)impl);
+        impl = tb_null;
+    }
+
+    // ok?
+    return (gb_gl_batch_ref_t)impl;
+}
+tb_void_t gb_gl_batch_exit(gb_gl_batch_ref_t batch)
+{
+    // check
+    gb_gl_batch_impl_t* impl = (gb_gl_batch_impl_t*)batch;
+    tb_assert_and_check_return(impl);
+
+    // exit buffers
+    if (impl->buffers[GB_GL_BATCH_BUFFER_VERTICES] || impl->buffers[GB_GL_BATCH_BUFFER_INDICES])
+        gb_glDeleteBuffers(tb_arrayn(impl->buffers), impl->buffers);
+
+    // exit vertices
+    if (impl->vertices) tb_free(impl->vertices);
+    impl->vertices = tb_null;
+
+    // exit indices
+    if (impl->indices) tb_free(impl->indices);
+    impl->indices = tb_null;
+
+    // exit it
+    tb_free(impl);
+}
+tb_void_t gb_gl_batch_draw_strips(gb_gl_batch_ref_t batch, gb_gl_batch_state_ref_t state, gb_color_t color, gb_point_ref_t points, tb_uint16_t const* counts)
+{
+    // check
+    gb_gl_batch_impl_t* impl = (gb_gl_batch_impl_t*)batch;
+    tb_assert_and_check_return(impl && state && points && counts);
+
+    // the state has been changed? flush the pending draws
+    if (impl->vertices_count && !gb_gl_batch_state_eq(&impl->state, state)) gb_gl_batch_flush(batch);
+
+    // save the state
+    if (!impl->vertices_count) impl->state = *state;
+
+    // update stats
+    impl->stats.draws++;
+
+    // append all strips
+    tb_uint16_t count;
+    while ((count = *counts++))
+    {
+        // is triangle strip?
+        if (count > 2)
+        {
+            // the batch is full? flush it
+            tb_size_t indices_count = (count - 2) * 3;
+            if (    impl->vertices_count + count > GB_GL_BATCH_VERTICES_MAXN
+                ||  impl->indices_count + indices_count > GB_GL_BATCH_INDICES_MAXN)
+            {
+                gb_gl_batch_flush(batch);
+            }
+
+            // grow vertices and indices
+            if (!gb_gl_batch_grow(impl, count, indices_count)) break;
+
+            // append vertices
+            tb_size_t               i;
+            gb_gl_batch_vertex_t*   vertex = impl->vertices + impl->vertices_count;
+            for (i = 0; i < count; i++, vertex++)
+            {
+                vertex->point       = points[i];
+                vertex->color[0]    = color.r;
+                vertex->color[1]    = color.g;
+                vertex->color[2]    = color.b;
+                vertex->color[3]    = color.a;
+            }
+
+            // append indices, (v0, v1, v2), (v1, v2, v3), ...
+            tb_uint16_t  base = (tb_uint16_t)impl->vertices_count;
+            tb_uint16_t* index = impl->indices + impl->indices_count;
+            for (i = 2; i < count; i++)
+            {
+                *index++ = base + i - 2;
+                *index++ = base + i - 1;
+                *index++ = base + i;
+            }
+
+            // update count
+            impl->vertices_count += count;
+            impl->indices_count += indices_count;
+        }
+
+        // the next strip
+        points += count;
+    }
+}
+tb_void_t gb_gl_batch_flush(gb_gl_batch_ref_t batch)
+{
+    // check
+    gb_gl_batch_impl_t* impl = (gb_gl_batch_impl_t*)batch;
+    tb_assert_and_check_return(impl);
+
+    // no pending draws?
+    tb_check_return(impl->vertices_count && impl->indices_count);
+
+    // trace
+    tb_trace_d("flush: vertices: %lu, indices: %lu", impl->vertices_count, impl->indices_count);
+
+    // apply blend
+    if (impl->state.blend)
+    {
+        gb_gl_state_enable(impl->context, GB_GL_BLEND);
+        gb_gl_state_blend_func(impl->context, GB_GL_SRC_ALPHA, GB_GL_ONE_MINUS_SRC_ALPHA);
+    }
+    else gb_gl_state_disable(impl->context, GB_GL_BLEND);
+
+    // apply antialiasing
+    if (impl->state.antialiasing) gb_gl_state_enable(impl->context, GB_GL_MULTISAMPLE);
+    else gb_gl_state_disable(impl->context, GB_GL_MULTISAMPLE);
+
+    // disable texture
+    gb_gl_state_disable(impl->context, GB_GL_TEXTURE_2D);
+
+    // draw it
+    if (impl->version >= 0x20) gb_gl_batch_flush_v2(impl);
+    else gb_gl_batch_flush_v1(impl);
+
+    // update stats
+    impl->stats.flushes++;
+    impl->stats.vertices += impl->vertices_count;
+    impl->stats.indices += impl->indices_count;
+
+    // clear the pending draws
+    impl->vertices_count    = 0;
+    impl->indices_count     = 0;
+}
+tb_void_t gb_gl_batch_stats(gb_gl_batch_ref_t batch, gb_gl_batch_stats_ref_t stats)
+{
+    // check
+    gb_gl_batch_impl_t* impl = (gb_gl_batch_impl_t*)batch;
+    tb_assert_and_check_return(impl && stats);
+
+    // get stats
+    *stats = impl->stats;
+}
@@ -0,0 +1,153 @@
+/*!The Graphic Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        batch.h
+ * @ingroup     core
+ *
+ */
+#ifndef GB_CORE_DEVICE_GL_BATCH_H
+#define GB_CORE_DEVICE_GL_BATCH_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+#include "matrix.h"
+#include "program.h"
+#include "state.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the maximum vertex count of one batch, all vertices must be indexed by tb_uint16_t
+#define GB_GL_BATCH_VERTICES_MAXN       (TB_MAXU16)
+
+// the maximum index count of one batch
+#define GB_GL_BATCH_INDICES_MAXN        (GB_GL_BATCH_VERTICES_MAXN * 3)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the gl batch ref type
+typedef struct{}*       gb_gl_batch_ref_t;
+
+/* the gl batch state type
+ *
+ * the consecutive draws with the same state will be merged into one draw call
+ */
+typedef struct __gb_gl_batch_state_t
+{
+    // the program for gl >= 2.0
+    gb_gl_program_ref_t program;
+
+    // the projection matrix for gl >= 2.0
+    gb_gl_matrix_t      matrix_project;
+
+    // the vertex matrix
+    gb_gl_matrix_t      matrix_vertex;
+
+    // enable blend?
+    tb_uint8_t          blend;
+
+    // enable antialiasing?
+    tb_uint8_t          antialiasing;
+
+}gb_gl_batch_state_t, *gb_gl_batch_state_ref_t;
+
+// the gl batch stats type
+typedef struct __gb_gl_batch_stats_t
+{
+    // the appended draw count
+    tb_size_t           draws;
+
+    // the flushed draw call count
+    tb_size_t           flushes;
+
+    // the flushed vertex count
+    tb_size_t           vertices;
+
+    // the flushed index count
+    tb_size_t           indices;
+
+    // the orphaned count of the streaming buffers
+    tb_size_t           orphans;
+
+}gb_gl_batch_stats_t, *gb_gl_batch_stats_ref_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interface
+ */
+
+/* init the batch
+ *
+ * the vertices will be streamed to the vertex buffer objects for gl >= 2.0,
+ * and be drawn from the client arrays for gl 1.x
+ *
+ * @param version       the gl version
+ * @param state         the shadow state of the gl context
+ *
+ * @return              the batch
+ */
+gb_gl_batch_ref_t       gb_gl_batch_init(tb_size_t version, gb_gl_state_ref_t state);
+
+/* exit the batch
+ *
+ * @param batch         the batch
+ */
+tb_void_t               gb_gl_batch_exit(gb_gl_batch_ref_t batch);
+
+/* append the triangle strips with the solid color to the batch
+ *
+ * the pending draws will be flushed first if the state has been changed or the batch is full
+ *
+ * @param batch         the batch
+ * @param state         the state
+ * @param color         the color
+ * @param points        the points of all strips
+ * @param counts        the point counts of all strips, end with zero
+ */
+tb_void_t               gb_gl_batch_draw_strips(gb_gl_batch_ref_t batch, gb_gl_batch_state_ref_t state, gb_color_t color, gb_point_ref_t points, tb_uint16_t const* counts);
+
+/* flush all pending draws with one indexed draw call
+ *
+ * @param batch         the batch
+ */
+tb_void_t               gb_gl_batch_flush(gb_gl_batch_ref_t batch);
+
+/* the batch stats
+ *
+ * @param batch         the batch
+ * @param stats         the stats
+ */
+tb_void_t               gb_gl_batch_stats(gb_gl_batch_ref_t batch, gb_gl_batch_stats_ref_t stats);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+#endif
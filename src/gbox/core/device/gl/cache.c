@@ -0,0 +1,334 @@
+/*!The Graphic Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        cache.c
+ * @ingroup     core
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME            "gl_cache"
+#define TB_TRACE_MODULE_DEBUG           (0)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "cache.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the points grow
+#ifdef __gb_small__
+#   define GB_GL_CACHE_POINTS_GROW          (256)
+#else
+#   define GB_GL_CACHE_POINTS_GROW          (1024)
+#endif
+
+// make the cache key from the path version and fill rule
+#define gb_gl_cache_key(version, rule)      (((version) << 1) | ((rule) & 1))
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the gl tessellation cache entry type
+typedef struct __gb_gl_cache_entry_t
+{
+    // the list entry
+    tb_list_entry_t             entry;
+
+    // the key
+    tb_size_t                   key;
+
+    // the entry size
+    tb_size_t                   size;
+
+    // the triangle strips, the points and counts are stored after this entry
+    gb_polygon_t                polygon;
+
+}gb_gl_cache_entry_t, *gb_gl_cache_entry_ref_t;
+
+// the gl tessellation cache impl type
+typedef struct __gb_gl_cache_impl_t
+{
+    // the entries, key => entry
+    tb_hash_map_ref_t           entries;
+
+    // the lru list, the most recently used entry is at head
+    tb_list_entry_head_t        lru;
+
+    // the tessellated points, gb_point_t[]
+    tb_vector_ref_t             points;
+
+    // the tessellated counts, tb_uint16_t[]
+    tb_vector_ref_t             counts;
+
+    // the tessellated strips
+    gb_polygon_t                polygon;
+
+    // the stats
+    gb_gl_cache_stats_t         stats;
+
+}gb_gl_cache_impl_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static tb_void_t gb_gl_cache_entry_exit(tb_element_ref_t element, tb_pointer_t buff)
+{
+    // check
+    tb_assert_and_check_return(buff);
+
+    // exit it
+    tb_pointer_t entry = *((tb_pointer_t*)buff);
+    if (entry) tb_free(entry);
+}
+static tb_void_t gb_gl_cache_entry_free(gb_gl_cache_impl_t* impl, gb_gl_cache_entry_ref_t entry)
+{
+    // remove it from the lru list
+    tb_list_entry_remove(&impl->lru, &entry->entry);
+
+    // update stats
+    impl->stats.count--;
+    impl->stats.size -= entry->size;
+
+    // remove it from the entries and free it
+    tb_hash_map_remove(impl->entries, (tb_cpointer_t)entry->key);
+}
+static tb_void_t gb_gl_cache_evict(gb_gl_cache_impl_t* impl, tb_size_t need)
+{
+    // evict the least recently used entries until the budget is enough
+    while (tb_list_entry_size(&impl->lru) && impl->stats.size + need > impl->stats.maxn)
+    {
+        // the last entry
+        gb_gl_cache_entry_ref_t entry = (gb_gl_cache_entry_ref_t)tb_list_entry(&impl->lru, tb_list_entry_last(&impl->lru));
+        tb_assert_and_check_break(entry);
+
+        // free it
+        gb_gl_cache_entry_free(impl, entry);
+
+        // update stats
+        impl->stats.evictions++;
+    }
+}
+static tb_void_t gb_gl_cache_tessellate_func(gb_point_ref_t points, tb_uint16_t count, tb_cpointer_t priv)
+{
+    // check
+    gb_gl_cache_impl_t* impl = (gb_gl_cache_impl_t*)priv;
+    tb_assert(impl && impl->points && impl->counts && points && count);
+
+    // append the points count
+    tb_vector_insert_tail(impl->counts, (tb_cpointer_t)(tb_size_t)count);
+
+    // append the points
+    tb_size_t size = tb_vector_size(impl->points);
+    if (tb_vector_resize(impl->points, size + count))
+        tb_memcpy((gb_point_ref_t)tb_vector_data(impl->points) + size, points, count * sizeof(gb_point_t));
+}
+static gb_polygon_ref_t gb_gl_cache_tessellate(gb_gl_cache_impl_t* impl, gb_tessellator_ref_t tessellator, gb_polygon_ref_t polygon, gb_rect_ref_t bounds, tb_size_t rule)
+{
+    // check
+    tb_assert(impl && impl->points && impl->counts && tessellator);
+
+    // clear the tessellated strips
+    tb_vector_clear(impl->points);
+    tb_vector_clear(impl->counts);
+
+    // update stats
+    impl->stats.tessellations++;
+
+    // tessellate it to the triangle strips
+    gb_tessellator_rule_set(tessellator, rule);
+    gb_tessellator_func_set(tessellator, gb_gl_cache_tessellate_func, impl);
+    gb_tessellator_done(tessellator, polygon, bounds);
+
+    // end the counts
+    tb_vector_insert_tail(impl->counts, (tb_cpointer_t)0);
+
+    // ok
+    impl->polygon.points = (gb_point_ref_t)tb_vector_data(impl->points);
+    impl->polygon.counts = (tb_uint16_t*)tb_vector_data(impl->counts);
+    impl->polygon.convex = tb_false;
+    return &impl->polygon;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+gb_gl_cache_ref_t gb_gl_cache_init(tb_size_t maxn)
+{
+    // done
+    tb_bool_t           ok = tb_false;
+    gb_gl_cache_impl_t* impl = tb_null;
+    do
+    {
+        // make cache
+        impl = tb_malloc0_type(gb_gl_cache_impl_t);
+        tb_assert_and_check_break(impl);
+
+        // init entries
+        impl->entries = tb_hash_map_init(TB_HASH_MAP_BUCKET_SIZE_SMALL, tb_element_size(), tb_element_ptr(gb_gl_cache_entry_exit, tb_null));
+        tb_assert_and_check_break(impl->entries);
+
+        // init lru list
+        tb_list_entry_init_(&impl->lru, tb_offsetof(gb_gl_cache_entry_t, entry), sizeof(gb_gl_cache_entry_t), tb_null);
+
+        // init points
+        impl->points = tb_vector_init(GB_GL_CACHE_POINTS_GROW, tb_element_mem(sizeof(gb_point_t), tb_null, tb_null));
+        tb_assert_and_check_break(impl->points);
+
+        // init counts
+        impl->counts = tb_vector_init(GB_GL_CACHE_POINTS_GROW >> 4, tb_element_uint16());
+        tb_assert_and_check_break(impl->counts);
+
+        // init stats
+        impl->stats.maxn = maxn? maxn : GB_GL_CACHE_MAXN;
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // failed?
+    if (!ok)
+    {
+        // exit it
+        if (impl) gb_gl_cache_exit((gb_gl_cache_ref_t)impl);
+        impl = tb_null;
+    }
+
+    // ok?
+    return (gb_gl_cache_ref_t)impl;
+}
+tb_void_t gb_gl_cache_exit(gb_gl_cache_ref_t cache)
+{
+    // check
+    gb_gl_cache_impl_t* impl = (gb_gl_cache_impl_t*)cache;
+    tb_assert_and_check_return(impl);
+
+    // exit entries
+    if (impl->entries) tb_hash_map_exit(impl->entries);
+    impl->entries = tb_null;
+
+    // exit lru list
+    tb_list_entry_exit(&impl->lru);
+
+    // exit points
+    if (impl->points) tb_vector_exit(impl->points);
+    impl->points = tb_null;
+
+    // exit counts
+    if (impl->counts) tb_vector_exit(impl->counts);
+    impl->counts = tb_null;
+
+    // exit it
+    tb_free(impl);
+}
+tb_void_t gb_gl_cache_clear(gb_gl_cache_ref_t cache)
+{
+    // check
+    gb_gl_cache_impl_t* impl = (gb_gl_cache_impl_t*)cache;
+    tb_assert_and_check_return(impl && impl->entries);
+
+    // clear entries
+    tb_list_entry_clear(&impl->lru);
+    tb_hash_map_clear(impl->entries);
+
+    // clear stats
+    impl->stats.count   = 0;
+    impl->stats.size    = 0;
+}
+gb_polygon_ref_t gb_gl_cache_load(gb_gl_cache_ref_t cache, gb_tessellator_ref_t tessellator, gb_polygon_ref_t polygon, gb_rect_ref_t bounds, tb_size_t rule, tb_size_t version)
+{
+    // check
+    gb_gl_cache_impl_t* impl = (gb_gl_cache_impl_t*)cache;
+    tb_assert_and_check_return_val(impl && impl->entries && tessellator && polygon && bounds, tb_null);
+
+    // not cacheable? tessellate it directly
+    if (!version) return gb_gl_cache_tessellate(impl, tessellator, polygon, bounds, rule);
+
+    // hit? move it to the lru head
+    tb_size_t               key = gb_gl_cache_key(version, rule);
+    gb_gl_cache_entry_ref_t entry = (gb_gl_cache_entry_ref_t)tb_hash_map_get(impl->entries, (tb_cpointer_t)key);
+    if (entry)
+    {
+        tb_list_entry_remove(&impl->lru, &entry->entry);
+        tb_list_entry_insert_head(&impl->lru, &entry->entry);
+        impl->stats.hits++;
+        return &entry->polygon;
+    }
+    impl->stats.misses++;
+
+    // tessellate it
+    gb_polygon_ref_t strips = gb_gl_cache_tessellate(impl, tessellator, polygon, bounds, rule);
+    tb_assert_and_check_return_val(strips, tb_null);
+
+    // the entry size
+    tb_size_t points_size   = tb_vector_size(impl->points) * sizeof(gb_point_t);
+    tb_size_t counts_size   = tb_vector_size(impl->counts) * sizeof(tb_uint16_t);
+    tb_size_t size          = sizeof(gb_gl_cache_entry_t) + points_size + counts_size;
+
+    // too large to cache it?
+    tb_check_return_val(size <= impl->stats.maxn, strips);
+
+    // evict the least recently used entries
+    gb_gl_cache_evict(impl, size);
+
+    // make entry
+    entry = (gb_gl_cache_entry_ref_t)tb_malloc_bytes(size);
+    tb_assert_and_check_return_val(entry, strips);
+
+    // init entry
+    entry->key              = key;
+    entry->size             = size;
+    entry->polygon.points   = (gb_point_ref_t)(entry + 1);
+    entry->polygon.counts   = (tb_uint16_t*)((tb_byte_t*)entry->polygon.points + points_size);
+    entry->polygon.convex   = tb_false;
+    if (points_size) tb_memcpy(entry->polygon.points, strips->points, points_size);
+    tb_memcpy(entry->polygon.counts, strips->counts, counts_size);
+
+    // insert it
+    if (tb_hash_map_insert(impl->entries, (tb_cpointer_t)key, entry) == tb_iterator_tail(impl->entries))
+    {
+        tb_free(entry);
+        return strips;
+    }
+    tb_list_entry_insert_head(&impl->lru, &entry->entry);
+
+    // update stats
+    impl->stats.count++;
+    impl->stats.size += size;
+
+    // ok
+    return &entry->polygon;
+}
+tb_void_t gb_gl_cache_stats(gb_gl_cache_ref_t cache, gb_gl_cache_stats_ref_t stats)
+{
+    // check
+    gb_gl_cache_impl_t* impl = (gb_gl_cache_impl_t*)cache;
+    tb_assert_and_check_return(impl && stats);
+
+    // get stats
+    *stats = impl->stats;
+}
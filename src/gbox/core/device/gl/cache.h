@@ -0,0 +1,135 @@
+/*!The Graphic Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        cache.h
+ * @ingroup     core
+ *
+ */
+#ifndef GB_CORE_DEVICE_GL_CACHE_H
+#define GB_CORE_DEVICE_GL_CACHE_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+#include "../../../utils/tessellator.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the default memory budget of the tessellation cache
+#ifdef __gb_small__
+#   define GB_GL_CACHE_MAXN         (1 << 20)
+#else
+#   define GB_GL_CACHE_MAXN         (4 << 20)
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the gl tessellation cache ref type
+typedef struct{}*       gb_gl_cache_ref_t;
+
+// the gl tessellation cache stats type
+typedef struct __gb_gl_cache_stats_t
+{
+    // the hit count
+    tb_size_t           hits;
+
+    // the miss count
+    tb_size_t           misses;
+
+    // the tessellation count, the uncacheable polygons are included
+    tb_size_t           tessellations;
+
+    // the eviction count
+    tb_size_t           evictions;
+
+    // the cached polygon count
+    tb_size_t           count;
+
+    // the cached bytes
+    tb_size_t           size;
+
+    // the memory budget
+    tb_size_t           maxn;
+
+}gb_gl_cache_stats_t, *gb_gl_cache_stats_ref_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interface
+ */
+
+/* init the tessellation cache
+ *
+ * @param maxn          the memory budget in bytes, using GB_GL_CACHE_MAXN if be zero
+ *
+ * @return              the cache
+ */
+gb_gl_cache_ref_t       gb_gl_cache_init(tb_size_t maxn);
+
+/* exit the tessellation cache
+ *
+ * @param cache         the cache
+ */
+tb_void_t               gb_gl_cache_exit(gb_gl_cache_ref_t cache);
+
+/* clear the tessellation cache
+ *
+ * @param cache         the cache
+ */
+tb_void_t               gb_gl_cache_clear(gb_gl_cache_ref_t cache);
+
+/* load the triangle strips of the polygon from the cache or tessellate it if not cached
+ *
+ * the strips are returned as the polygon, each contour is one triangle strip, 
+ * and it is valid until the next loading.
+ *
+ * @param cache         the cache
+ * @param tessellator   the tessellator for the strip mode
+ * @param polygon       the polygon
+ * @param bounds        the polygon bounds
+ * @param rule          the fill rule
+ * @param version       the path version, only tessellate it without caching if be zero
+ *
+ * @return              the triangle strips
+ */
+gb_polygon_ref_t        gb_gl_cache_load(gb_gl_cache_ref_t cache, gb_tessellator_ref_t tessellator, gb_polygon_ref_t polygon, gb_rect_ref_t bounds, tb_size_t rule, tb_size_t version);
+
+/* the tessellation cache stats
+ *
+ * @param cache         the cache
+ * @param stats         the stats
+ */
+tb_void_t               gb_gl_cache_stats(gb_gl_cache_ref_t cache, gb_gl_cache_stats_ref_t stats);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+#endif
@@ -28,9 +28,13 @@
 /* //////////////////////////////////////////////////////////////////////////////////////
  * includes
  */
+#include "batch.h"
+#include "cache.h"
 #include "interface.h"
 #include "program.h"
 #include "matrix.h"
+#include "state.h"
+#include "texture.h"
 #include "../../impl/stroker.h"
 #include "../../../utils/tessellator.h"
 
@@ -51,7 +55,7 @@ typedef struct __gb_gl_device_t
     tb_size_t                   version;
 
     // the programs
-    gb_gl_program_ref_t         programs[GB_GL_PROGRAM_LOCATION_MAXN];
+    gb_gl_program_ref_t         programs[GB_GL_PROGRAM_TYPE_MAXN];
 
 	// the projection matrix for gl >= 2.0
 	gb_gl_matrix_t              matrix_project;
@@ -71,6 +75,24 @@ typedef struct __gb_gl_device_t
     // the tessellator
     gb_tessellator_ref_t        tessellator;
 
+    // the tessellation cache
+    gb_gl_cache_ref_t           cache;
+
+    // the batch of the solid fills
+    gb_gl_batch_ref_t           batch;
+
+    // the texture cache of the bitmaps
+    gb_gl_texture_ref_t         textures;
+
+    // the state of the direct draws has been applied?
+    tb_bool_t                   direct;
+
+    // the stencil buffer is available for filling the concave polygon by stencil-then-cover?
+    tb_bool_t                   stencil;
+
+    // the shadow state of the gl context
+    gb_gl_state_t               state;
+
 }gb_gl_device_t, *gb_gl_device_ref_t;
 
 #endif
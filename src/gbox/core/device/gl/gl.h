@@ -34,6 +34,7 @@
 #include "matrix.h"
 #include "render.h"
 #include "shader.h"
+#include "tracer.h"
 
 #endif
 
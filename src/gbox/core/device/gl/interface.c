@@ -34,6 +34,7 @@
  * includes
  */
 #include "interface.h"
+#include "tracer.h"
 #include "opengl/opengl.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
@@ -49,8 +50,11 @@
 GB_GL_INTERFACE_DEFINE(glActiveTexture);
 GB_GL_INTERFACE_DEFINE(glAlphaFunc);
 GB_GL_INTERFACE_DEFINE(glAttachShader);
+GB_GL_INTERFACE_DEFINE(glBindBuffer);
 GB_GL_INTERFACE_DEFINE(glBindTexture);
 GB_GL_INTERFACE_DEFINE(glBlendFunc);
+GB_GL_INTERFACE_DEFINE(glBufferData);
+GB_GL_INTERFACE_DEFINE(glBufferSubData);
 GB_GL_INTERFACE_DEFINE(glClear);
 GB_GL_INTERFACE_DEFINE(glClearColor);
 GB_GL_INTERFACE_DEFINE(glClearStencil);
@@ -60,6 +64,7 @@ GB_GL_INTERFACE_DEFINE(glColorPointer);
 GB_GL_INTERFACE_DEFINE(glCompileShader);
 GB_GL_INTERFACE_DEFINE(glCreateProgram);
 GB_GL_INTERFACE_DEFINE(glCreateShader);
+GB_GL_INTERFACE_DEFINE(glDeleteBuffers);
 GB_GL_INTERFACE_DEFINE(glDeleteProgram);
 GB_GL_INTERFACE_DEFINE(glDeleteShader);
 GB_GL_INTERFACE_DEFINE(glDeleteTextures);
@@ -67,11 +72,15 @@ GB_GL_INTERFACE_DEFINE(glDisable);
 GB_GL_INTERFACE_DEFINE(glDisableClientState);
 GB_GL_INTERFACE_DEFINE(glDisableVertexAttribArray);
 GB_GL_INTERFACE_DEFINE(glDrawArrays);
+GB_GL_INTERFACE_DEFINE(glDrawElements);
 GB_GL_INTERFACE_DEFINE(glEnable);
 GB_GL_INTERFACE_DEFINE(glEnableClientState);
 GB_GL_INTERFACE_DEFINE(glEnableVertexAttribArray);
+GB_GL_INTERFACE_DEFINE(glGenBuffers);
 GB_GL_INTERFACE_DEFINE(glGenTextures);
 GB_GL_INTERFACE_DEFINE(glGetAttribLocation);
+GB_GL_INTERFACE_DEFINE(glGetIntegerv);
+GB_GL_INTERFACE_DEFINE(glGetProgramBinary);
 GB_GL_INTERFACE_DEFINE(glGetProgramiv);
 GB_GL_INTERFACE_DEFINE(glGetProgramInfoLog);
 GB_GL_INTERFACE_DEFINE(glGetShaderiv);
@@ -90,6 +99,8 @@ GB_GL_INTERFACE_DEFINE(glOrtho);
 GB_GL_INTERFACE_DEFINE(glOrthof);
 GB_GL_INTERFACE_DEFINE(glPixelStorei);
 GB_GL_INTERFACE_DEFINE(glPopMatrix);
+GB_GL_INTERFACE_DEFINE(glProgramBinary);
+GB_GL_INTERFACE_DEFINE(glProgramParameteri);
 GB_GL_INTERFACE_DEFINE(glPushMatrix);
 GB_GL_INTERFACE_DEFINE(glRotatef);
 GB_GL_INTERFACE_DEFINE(glScalef);
@@ -98,13 +109,16 @@ GB_GL_INTERFACE_DEFINE(glShaderSource);
 GB_GL_INTERFACE_DEFINE(glStencilFunc);
 GB_GL_INTERFACE_DEFINE(glStencilMask);
 GB_GL_INTERFACE_DEFINE(glStencilOp);
+GB_GL_INTERFACE_DEFINE(glStencilOpSeparate);
 GB_GL_INTERFACE_DEFINE(glTexCoordPointer);
 GB_GL_INTERFACE_DEFINE(glTexEnvi);
 GB_GL_INTERFACE_DEFINE(glTexImage2D);
 GB_GL_INTERFACE_DEFINE(glTexParameterf);
 GB_GL_INTERFACE_DEFINE(glTexParameteri);
+GB_GL_INTERFACE_DEFINE(glTexSubImage2D);
 GB_GL_INTERFACE_DEFINE(glTranslatef);
 GB_GL_INTERFACE_DEFINE(glUniform1i);
+GB_GL_INTERFACE_DEFINE(glUniform4f);
 GB_GL_INTERFACE_DEFINE(glUniformMatrix4fv);
 GB_GL_INTERFACE_DEFINE(glUseProgram);
 GB_GL_INTERFACE_DEFINE(glVertexAttrib4f);
@@ -129,6 +143,13 @@ tb_bool_t gb_gl_interface_load()
     tb_bool_t ok = tb_false;
     do
     {
+        // only wrap the interfaces for the stub tracer, it need not any gl context
+        if (gb_gl_tracer_mode() == GB_GL_TRACER_MODE_STUB)
+        {
+            ok = gb_gl_tracer_hook();
+            break;
+        }
+
 #ifdef TB_CONFIG_OS_ANDROID
 
         // load v2 library first
@@ -147,8 +168,10 @@ tb_bool_t gb_gl_interface_load()
             GB_GL_INTERFACE_LOAD_D(library, glDeleteTextures);
             GB_GL_INTERFACE_LOAD_D(library, glDisable);
             GB_GL_INTERFACE_LOAD_D(library, glDrawArrays);
+            GB_GL_INTERFACE_LOAD_D(library, glDrawElements);
             GB_GL_INTERFACE_LOAD_D(library, glEnable);
             GB_GL_INTERFACE_LOAD_D(library, glGenTextures);
+            GB_GL_INTERFACE_LOAD_D(library, glGetIntegerv);
             GB_GL_INTERFACE_LOAD_D(library, glGetString);
             GB_GL_INTERFACE_LOAD_D(library, glIsTexture);
             GB_GL_INTERFACE_LOAD_D(library, glPixelStorei);
@@ -159,17 +182,23 @@ tb_bool_t gb_gl_interface_load()
             GB_GL_INTERFACE_LOAD_D(library, glTexImage2D);
             GB_GL_INTERFACE_LOAD_D(library, glTexParameterf);
             GB_GL_INTERFACE_LOAD_D(library, glTexParameteri);
+            GB_GL_INTERFACE_LOAD_D(library, glTexSubImage2D);
             GB_GL_INTERFACE_LOAD_D(library, glViewport);
 
             // load interfaces for gl >= 2.0
             GB_GL_INTERFACE_LOAD_D(library, glAttachShader);
+            GB_GL_INTERFACE_LOAD_D(library, glBindBuffer);
+            GB_GL_INTERFACE_LOAD_D(library, glBufferData);
+            GB_GL_INTERFACE_LOAD_D(library, glBufferSubData);
             GB_GL_INTERFACE_LOAD_D(library, glCompileShader);
             GB_GL_INTERFACE_LOAD_D(library, glCreateProgram);
             GB_GL_INTERFACE_LOAD_D(library, glCreateShader);
+            GB_GL_INTERFACE_LOAD_D(library, glDeleteBuffers);
             GB_GL_INTERFACE_LOAD_D(library, glDeleteProgram);
             GB_GL_INTERFACE_LOAD_D(library, glDeleteShader);
             GB_GL_INTERFACE_LOAD_D(library, glDisableVertexAttribArray);
             GB_GL_INTERFACE_LOAD_D(library, glEnableVertexAttribArray);
+            GB_GL_INTERFACE_LOAD_D(library, glGenBuffers);
             GB_GL_INTERFACE_LOAD_D(library, glGetAttribLocation);
             GB_GL_INTERFACE_LOAD_D(library, glGetProgramiv);
             GB_GL_INTERFACE_LOAD_D(library, glGetProgramInfoLog);
@@ -178,11 +207,17 @@ tb_bool_t gb_gl_interface_load()
             GB_GL_INTERFACE_LOAD_D(library, glGetUniformLocation);
             GB_GL_INTERFACE_LOAD_D(library, glLinkProgram);
             GB_GL_INTERFACE_LOAD_D(library, glShaderSource);
+            GB_GL_INTERFACE_LOAD_D(library, glStencilOpSeparate);
             GB_GL_INTERFACE_LOAD_D(library, glUniform1i);
+            GB_GL_INTERFACE_LOAD_D(library, glUniform4f);
             GB_GL_INTERFACE_LOAD_D(library, glUniformMatrix4fv);
             GB_GL_INTERFACE_LOAD_D(library, glUseProgram);
             GB_GL_INTERFACE_LOAD_D(library, glVertexAttrib4f);
             GB_GL_INTERFACE_LOAD_D(library, glVertexAttribPointer);
+
+            // load the optional interfaces for GL_OES_get_program_binary
+            GB_GL_INTERFACE_LOAD_D_(library, glGetProgramBinary, glGetProgramBinaryOES);
+            GB_GL_INTERFACE_LOAD_D_(library, glProgramBinary, glProgramBinaryOES);
         }
         // load v1 library
         else if ((library = tb_dynamic_init("libGLESv1_CM.so")))
@@ -199,8 +234,10 @@ tb_bool_t gb_gl_interface_load()
             GB_GL_INTERFACE_LOAD_D(library, glDeleteTextures);
             GB_GL_INTERFACE_LOAD_D(library, glDisable);
             GB_GL_INTERFACE_LOAD_D(library, glDrawArrays);
+            GB_GL_INTERFACE_LOAD_D(library, glDrawElements);
             GB_GL_INTERFACE_LOAD_D(library, glEnable);
             GB_GL_INTERFACE_LOAD_D(library, glGenTextures);
+            GB_GL_INTERFACE_LOAD_D(library, glGetIntegerv);
             GB_GL_INTERFACE_LOAD_D(library, glGetString);
             GB_GL_INTERFACE_LOAD_D(library, glIsTexture);
             GB_GL_INTERFACE_LOAD_D(library, glPixelStorei);
@@ -211,6 +248,7 @@ tb_bool_t gb_gl_interface_load()
             GB_GL_INTERFACE_LOAD_D(library, glTexImage2D);
             GB_GL_INTERFACE_LOAD_D(library, glTexParameterf);
             GB_GL_INTERFACE_LOAD_D(library, glTexParameteri);
+            GB_GL_INTERFACE_LOAD_D(library, glTexSubImage2D);
             GB_GL_INTERFACE_LOAD_D(library, glViewport);
 
             // load interfaces for gl 1.x
@@ -248,8 +286,10 @@ tb_bool_t gb_gl_interface_load()
         GB_GL_INTERFACE_LOAD_S(glDeleteTextures);
         GB_GL_INTERFACE_LOAD_S(glDisable);
         GB_GL_INTERFACE_LOAD_S(glDrawArrays);
+        GB_GL_INTERFACE_LOAD_S(glDrawElements);
         GB_GL_INTERFACE_LOAD_S(glEnable);
         GB_GL_INTERFACE_LOAD_S(glGenTextures);
+        GB_GL_INTERFACE_LOAD_S(glGetIntegerv);
         GB_GL_INTERFACE_LOAD_S(glGetString);
         GB_GL_INTERFACE_LOAD_S(glHint);
         GB_GL_INTERFACE_LOAD_S(glIsTexture);
@@ -262,6 +302,7 @@ tb_bool_t gb_gl_interface_load()
         GB_GL_INTERFACE_LOAD_S(glTexImage2D);
         GB_GL_INTERFACE_LOAD_S(glTexParameterf);
         GB_GL_INTERFACE_LOAD_S(glTexParameteri);
+        GB_GL_INTERFACE_LOAD_S(glTexSubImage2D);
         GB_GL_INTERFACE_LOAD_S(glViewport);
 
         // load interfaces for gl 1.x
@@ -291,13 +332,18 @@ tb_bool_t gb_gl_interface_load()
 #   ifndef TB_CONFIG_OS_WINDOWS
         // load interfaces for gl >= 2.0
         GB_GL_INTERFACE_LOAD_S(glAttachShader);
+        GB_GL_INTERFACE_LOAD_S(glBindBuffer);
+        GB_GL_INTERFACE_LOAD_S(glBufferData);
+        GB_GL_INTERFACE_LOAD_S(glBufferSubData);
         GB_GL_INTERFACE_LOAD_S(glCompileShader);
         GB_GL_INTERFACE_LOAD_S(glCreateProgram);
         GB_GL_INTERFACE_LOAD_S(glCreateShader);
+        GB_GL_INTERFACE_LOAD_S(glDeleteBuffers);
         GB_GL_INTERFACE_LOAD_S(glDeleteProgram);
         GB_GL_INTERFACE_LOAD_S(glDeleteShader);
         GB_GL_INTERFACE_LOAD_S(glDisableVertexAttribArray);
         GB_GL_INTERFACE_LOAD_S(glEnableVertexAttribArray);
+        GB_GL_INTERFACE_LOAD_S(glGenBuffers);
         GB_GL_INTERFACE_LOAD_S(glGetAttribLocation);
         GB_GL_INTERFACE_LOAD_S(glGetProgramiv);
         GB_GL_INTERFACE_LOAD_S(glGetProgramInfoLog);
@@ -306,14 +352,26 @@ tb_bool_t gb_gl_interface_load()
         GB_GL_INTERFACE_LOAD_S(glGetUniformLocation);
         GB_GL_INTERFACE_LOAD_S(glLinkProgram);
         GB_GL_INTERFACE_LOAD_S(glShaderSource);
+        GB_GL_INTERFACE_LOAD_S(glStencilOpSeparate);
         GB_GL_INTERFACE_LOAD_S(glUniform1i);
+        GB_GL_INTERFACE_LOAD_S(glUniform4f);
         GB_GL_INTERFACE_LOAD_S(glUniformMatrix4fv);
         GB_GL_INTERFACE_LOAD_S(glUseProgram);
         GB_GL_INTERFACE_LOAD_S(glVertexAttrib4f);
         GB_GL_INTERFACE_LOAD_S(glVertexAttribPointer);
+
+        // load interfaces for GL_ARB_get_program_binary
+#       ifdef GL_ARB_get_program_binary
+        GB_GL_INTERFACE_LOAD_S(glGetProgramBinary);
+        GB_GL_INTERFACE_LOAD_S(glProgramBinary);
+        GB_GL_INTERFACE_LOAD_S(glProgramParameteri);
+#       endif
 #   endif
 #endif
 
+        // wrap the loaded interfaces for the tracer
+        if (gb_gl_tracer_mode() && !gb_gl_tracer_hook()) break;
+
         // ok
         ok = tb_true;
 
@@ -53,6 +53,9 @@
 // load the dynamic function
 #define GB_GL_INTERFACE_LOAD_D(library, func)               gb_##func = (gb_##func##_t)tb_dynamic_func(library, #func); tb_assert_and_check_break(gb_##func)
 
+// load the optional dynamic function, it may be null
+#define GB_GL_INTERFACE_LOAD_D_(library, name, func)        gb_##name = (gb_##name##_t)tb_dynamic_func(library, #func)
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * macros for gl
  */
@@ -162,6 +165,14 @@
 #define GB_GL_GEQUAL                    (0x0206)
 #define GB_GL_ALWAYS                    (0x0207)
 
+// stencil face
+#define GB_GL_FRONT                     (0x0404)
+#define GB_GL_BACK                      (0x0405)
+#define GB_GL_FRONT_AND_BACK            (0x0408)
+
+// stencil parameter
+#define GB_GL_STENCIL_BITS              (0x0D57)
+
 // enable cap
 #define GB_GL_TEXTURE_2D                (0x0DE1)
 #define GB_GL_BLEND                     (0x0BE2)
@@ -218,6 +229,12 @@
 #define GB_GL_VALIDATE_STATUS           (0x8B83)
 #define GB_GL_ATTACHED_SHADERS          (0x8B85)
 
+// program binary
+#define GB_GL_PROGRAM_BINARY_RETRIEVABLE_HINT   (0x8257)
+#define GB_GL_PROGRAM_BINARY_LENGTH     (0x8741)
+#define GB_GL_NUM_PROGRAM_BINARY_FORMATS (0x87FE)
+#define GB_GL_PROGRAM_BINARY_FORMATS    (0x87FF)
+
 // shader source
 #define GB_GL_COMPILE_STATUS            (0x8B81)
 #define GB_GL_INFO_LOG_LENGTH           (0x8B84)
@@ -259,6 +276,14 @@
 #define GB_GL_TEXTURE31                 (0x84DF)
 #define GB_GL_ACTIVE_TEXTURE            (0x84E0)
 
+// buffer objects
+#define GB_GL_ARRAY_BUFFER              (0x8892)
+#define GB_GL_ELEMENT_ARRAY_BUFFER      (0x8893)
+#define GB_GL_ARRAY_BUFFER_BINDING      (0x8894)
+#define GB_GL_STREAM_DRAW               (0x88E0)
+#define GB_GL_STATIC_DRAW               (0x88E4)
+#define GB_GL_DYNAMIC_DRAW              (0x88E8)
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
  */
@@ -284,6 +309,8 @@ typedef tb_float_t      gb_GLfloat_t;
 typedef tb_float_t      gb_GLclampf_t;
 typedef tb_double_t     gb_GLdouble_t;
 typedef tb_double_t     gb_GLclampd_t;
+typedef tb_long_t       gb_GLintptr_t;
+typedef tb_long_t       gb_GLsizeiptr_t;
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * interface types
@@ -291,8 +318,11 @@ typedef tb_double_t     gb_GLclampd_t;
 typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glActiveTexture))             (gb_GLenum_t texture);
 typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glAlphaFunc))                 (gb_GLenum_t func, gb_GLclampf_t ref);
 typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glAttachShader))              (gb_GLuint_t program, gb_GLuint_t shader);
+typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glBindBuffer))                (gb_GLenum_t target, gb_GLuint_t buffer);
 typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glBindTexture))               (gb_GLenum_t target, gb_GLuint_t texture);
 typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glBlendFunc))                 (gb_GLenum_t sfactor, gb_GLenum_t dfactor);
+typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glBufferData))                (gb_GLenum_t target, gb_GLsizeiptr_t size, gb_GLvoid_t const* data, gb_GLenum_t usage);
+typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glBufferSubData))             (gb_GLenum_t target, gb_GLintptr_t offset, gb_GLsizeiptr_t size, gb_GLvoid_t const* data);
 typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glClear))                     (gb_GLbitfield_t mask);
 typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glClearColor))                (gb_GLclampf_t red, gb_GLclampf_t green, gb_GLclampf_t blue, gb_GLclampf_t alpha);
 typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glClearStencil))              (gb_GLint_t s);
@@ -302,6 +332,7 @@ typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glColorPointer))
 typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glCompileShader))             (gb_GLuint_t shader);
 typedef gb_GLuint_t             (GB_GL_INTERFACE_TYPE(glCreateProgram))             (gb_GLvoid_t);
 typedef gb_GLuint_t             (GB_GL_INTERFACE_TYPE(glCreateShader))              (gb_GLenum_t type);
+typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glDeleteBuffers))             (gb_GLsizei_t n, gb_GLuint_t const* buffers);
 typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glDeleteProgram))             (gb_GLuint_t program);
 typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glDeleteShader))              (gb_GLuint_t shader);
 typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glDeleteTextures))            (gb_GLsizei_t n, gb_GLuint_t const* textures);
@@ -309,11 +340,15 @@ typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glDisable))
 typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glDisableClientState))        (gb_GLenum_t cap);
 typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glDisableVertexAttribArray))  (gb_GLuint_t index);
 typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glDrawArrays))                (gb_GLenum_t mode, gb_GLint_t first, gb_GLsizei_t count);
+typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glDrawElements))              (gb_GLenum_t mode, gb_GLsizei_t count, gb_GLenum_t type, gb_GLvoid_t const* indices);
 typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glEnable))                    (gb_GLenum_t cap);
 typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glEnableClientState))         (gb_GLenum_t cap);
 typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glEnableVertexAttribArray))   (gb_GLuint_t index);
+typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glGenBuffers))                (gb_GLsizei_t n, gb_GLuint_t* buffers);
 typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glGenTextures))               (gb_GLsizei_t n, gb_GLuint_t* textures);
 typedef gb_GLint_t              (GB_GL_INTERFACE_TYPE(glGetAttribLocation))         (gb_GLuint_t program, gb_GLchar_t const* name);
+typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glGetIntegerv))               (gb_GLenum_t pname, gb_GLint_t* params);
+typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glGetProgramBinary))          (gb_GLuint_t program, gb_GLsizei_t bufsize, gb_GLsizei_t* length, gb_GLenum_t* format, gb_GLvoid_t* binary);
 typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glGetProgramiv))              (gb_GLuint_t program, gb_GLenum_t pname, gb_GLint_t* params);
 typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glGetProgramInfoLog))         (gb_GLuint_t program, gb_GLsizei_t bufsize, gb_GLsizei_t* length, gb_GLchar_t* infolog);
 typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glGetShaderiv))               (gb_GLuint_t shader, gb_GLenum_t pname, gb_GLint_t* params);
@@ -332,6 +367,8 @@ typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glOrtho))
 typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glOrthof))                    (gb_GLfloat_t left, gb_GLfloat_t right, gb_GLfloat_t bottom, gb_GLfloat_t top, gb_GLfloat_t near, gb_GLfloat_t far);
 typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glPixelStorei))               (gb_GLenum_t pname, gb_GLint_t param);
 typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glPopMatrix))                 (gb_GLvoid_t);
+typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glProgramBinary))             (gb_GLuint_t program, gb_GLenum_t format, gb_GLvoid_t const* binary, gb_GLsizei_t length);
+typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glProgramParameteri))         (gb_GLuint_t program, gb_GLenum_t pname, gb_GLint_t value);
 typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glPushMatrix))                (gb_GLvoid_t);
 typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glRotatef))                   (gb_GLfloat_t angle, gb_GLfloat_t x, gb_GLfloat_t y, gb_GLfloat_t z);
 typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glScalef))                    (gb_GLfloat_t x, gb_GLfloat_t y, gb_GLfloat_t z);
@@ -340,13 +377,16 @@ typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glShaderSource))
 typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glStencilFunc))               (gb_GLenum_t func, gb_GLint_t ref, gb_GLuint_t mask);
 typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glStencilMask))               (gb_GLuint_t mask);
 typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glStencilOp))                 (gb_GLenum_t fail, gb_GLenum_t zfail, gb_GLenum_t zpass);
+typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glStencilOpSeparate))         (gb_GLenum_t face, gb_GLenum_t fail, gb_GLenum_t zfail, gb_GLenum_t zpass);
 typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glTexCoordPointer))           (gb_GLint_t size, gb_GLenum_t type, gb_GLsizei_t stride, gb_GLvoid_t const* ptr);
 typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glTexEnvi))                   (gb_GLenum_t target, gb_GLenum_t pname, gb_GLint_t param);
 typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glTexImage2D))                (gb_GLenum_t target, gb_GLint_t level, gb_GLint_t internalFormat, gb_GLsizei_t width, gb_GLsizei_t height, gb_GLint_t border, gb_GLenum_t format, gb_GLenum_t type, gb_GLvoid_t const* pixels);
 typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glTexParameterf))             (gb_GLenum_t target, gb_GLenum_t pname, gb_GLfloat_t param);
 typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glTexParameteri))             (gb_GLenum_t target, gb_GLenum_t pname, gb_GLint_t param);
+typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glTexSubImage2D))             (gb_GLenum_t target, gb_GLint_t level, gb_GLint_t xoffset, gb_GLint_t yoffset, gb_GLsizei_t width, gb_GLsizei_t height, gb_GLenum_t format, gb_GLenum_t type, gb_GLvoid_t const* pixels);
 typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glTranslatef))                (gb_GLfloat_t x, gb_GLfloat_t y, gb_GLfloat_t z);
 typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glUniform1i))                 (gb_GLint_t location, gb_GLint_t x);
+typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glUniform4f))                 (gb_GLint_t location, gb_GLfloat_t x, gb_GLfloat_t y, gb_GLfloat_t z, gb_GLfloat_t w);
 typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glUniformMatrix4fv))          (gb_GLint_t location, gb_GLsizei_t count, gb_GLboolean_t transpose, gb_GLfloat_t const* value);
 typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glUseProgram))                (gb_GLuint_t program);
 typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glVertexAttrib4f))            (gb_GLuint_t indx, gb_GLfloat_t x, gb_GLfloat_t y, gb_GLfloat_t z, gb_GLfloat_t w);
@@ -360,8 +400,11 @@ typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glViewport))
 GB_GL_INTERFACE_EXTERN(glActiveTexture);
 GB_GL_INTERFACE_EXTERN(glAlphaFunc);
 GB_GL_INTERFACE_EXTERN(glAttachShader);
+GB_GL_INTERFACE_EXTERN(glBindBuffer);
 GB_GL_INTERFACE_EXTERN(glBindTexture);
 GB_GL_INTERFACE_EXTERN(glBlendFunc);
+GB_GL_INTERFACE_EXTERN(glBufferData);
+GB_GL_INTERFACE_EXTERN(glBufferSubData);
 GB_GL_INTERFACE_EXTERN(glClear);
 GB_GL_INTERFACE_EXTERN(glClearColor);
 GB_GL_INTERFACE_EXTERN(glClearStencil);
@@ -371,6 +414,7 @@ GB_GL_INTERFACE_EXTERN(glColorPointer);
 GB_GL_INTERFACE_EXTERN(glCompileShader);
 GB_GL_INTERFACE_EXTERN(glCreateProgram);
 GB_GL_INTERFACE_EXTERN(glCreateShader);
+GB_GL_INTERFACE_EXTERN(glDeleteBuffers);
 GB_GL_INTERFACE_EXTERN(glDeleteProgram);
 GB_GL_INTERFACE_EXTERN(glDeleteShader);
 GB_GL_INTERFACE_EXTERN(glDeleteTextures);
@@ -378,11 +422,15 @@ GB_GL_INTERFACE_EXTERN(glDisable);
 GB_GL_INTERFACE_EXTERN(glDisableClientState);
 GB_GL_INTERFACE_EXTERN(glDisableVertexAttribArray);
 GB_GL_INTERFACE_EXTERN(glDrawArrays);
+GB_GL_INTERFACE_EXTERN(glDrawElements);
 GB_GL_INTERFACE_EXTERN(glEnable);
 GB_GL_INTERFACE_EXTERN(glEnableClientState);
 GB_GL_INTERFACE_EXTERN(glEnableVertexAttribArray);
+GB_GL_INTERFACE_EXTERN(glGenBuffers);
 GB_GL_INTERFACE_EXTERN(glGenTextures);
 GB_GL_INTERFACE_EXTERN(glGetAttribLocation);
+GB_GL_INTERFACE_EXTERN(glGetIntegerv);
+GB_GL_INTERFACE_EXTERN(glGetProgramBinary);
 GB_GL_INTERFACE_EXTERN(glGetProgramiv);
 GB_GL_INTERFACE_EXTERN(glGetProgramInfoLog);
 GB_GL_INTERFACE_EXTERN(glGetShaderiv);
@@ -401,6 +449,8 @@ GB_GL_INTERFACE_EXTERN(glOrtho);
 GB_GL_INTERFACE_EXTERN(glOrthof);
 GB_GL_INTERFACE_EXTERN(glPixelStorei);
 GB_GL_INTERFACE_EXTERN(glPopMatrix);
+GB_GL_INTERFACE_EXTERN(glProgramBinary);
+GB_GL_INTERFACE_EXTERN(glProgramParameteri);
 GB_GL_INTERFACE_EXTERN(glPushMatrix);
 GB_GL_INTERFACE_EXTERN(glRotatef);
 GB_GL_INTERFACE_EXTERN(glScalef);
@@ -409,13 +459,16 @@ GB_GL_INTERFACE_EXTERN(glShaderSource);
 GB_GL_INTERFACE_EXTERN(glStencilFunc);
 GB_GL_INTERFACE_EXTERN(glStencilMask);
 GB_GL_INTERFACE_EXTERN(glStencilOp);
+GB_GL_INTERFACE_EXTERN(glStencilOpSeparate);
 GB_GL_INTERFACE_EXTERN(glTexCoordPointer);
 GB_GL_INTERFACE_EXTERN(glTexEnvi);
 GB_GL_INTERFACE_EXTERN(glTexImage2D);
 GB_GL_INTERFACE_EXTERN(glTexParameterf);
 GB_GL_INTERFACE_EXTERN(glTexParameteri);
+GB_GL_INTERFACE_EXTERN(glTexSubImage2D);
 GB_GL_INTERFACE_EXTERN(glTranslatef);
 GB_GL_INTERFACE_EXTERN(glUniform1i);
+GB_GL_INTERFACE_EXTERN(glUniform4f);
 GB_GL_INTERFACE_EXTERN(glUniformMatrix4fv);
 GB_GL_INTERFACE_EXTERN(glUseProgram);
 GB_GL_INTERFACE_EXTERN(glVertexAttrib4f);
@@ -34,6 +34,16 @@
  */
 #include "program.h"
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the magic of the program binary file: "gbpb"
+#define GB_GL_PROGRAM_BINARY_MAGIC      (0x62706267)
+
+// the maximum size of the program binary
+#define GB_GL_PROGRAM_BINARY_MAXN       (1 << 24)
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * types
  */
@@ -58,6 +68,33 @@ typedef struct __gb_gl_program_impl_t
 
 }gb_gl_program_impl_t;
 
+// the gl program binary head type
+typedef struct __gb_gl_program_binary_head_t
+{
+    // the magic
+    tb_uint32_t         magic;
+
+    // the binary format
+    tb_uint32_t         format;
+
+    // the binary size
+    tb_uint32_t         size;
+
+    // the crc32 of the binary
+    tb_uint32_t         crc32;
+
+}gb_gl_program_binary_head_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * globals
+ */
+
+// the directory of the program binary cache, use the default directory if be empty
+static tb_char_t        g_cache_directory[TB_PATH_MAXN] = {0};
+
+// the program binary cache has been disabled?
+static tb_bool_t        g_cache_disabled = tb_false;
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * private implementation
  */
@@ -94,9 +131,227 @@ static gb_GLuint_t gb_gl_program_shader(tb_char_t const* data, tb_size_t type)
     return shader;
 }
 
+static tb_bool_t gb_gl_program_binary_able()
+{
+    // the binary interfaces have been loaded?
+    tb_check_return_val(gb_glGetProgramBinary && gb_glProgramBinary, tb_false);
+
+    // supports GL_ARB_get_program_binary or GL_OES_get_program_binary?
+    tb_char_t const* extensions = (tb_char_t const*)gb_glGetString(GB_GL_EXTENSIONS);
+    tb_check_return_val(extensions && tb_strstr(extensions, "_get_program_binary"), tb_false);
+
+    // some drivers support the extension without any binary format
+    gb_GLint_t formats = 0;
+    gb_glGetIntegerv(GB_GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+    return formats > 0;
+}
+static tb_uint32_t gb_gl_program_binary_hash(tb_uint32_t hash, tb_char_t const* cstr)
+{
+    return cstr? tb_crc_encode_cstr(TB_CRC_MODE_32_IEEE_LE, hash, cstr) : hash;
+}
+static tb_char_t const* gb_gl_program_binary_path(tb_char_t* path, tb_size_t maxn, tb_char_t const* vshader, tb_char_t const* fshader)
+{
+    // check
+    tb_assert_and_check_return_val(path && maxn && vshader && fshader, tb_null);
+
+    // disabled?
+    tb_check_return_val(!g_cache_disabled, tb_null);
+
+    // the directory
+    tb_char_t directory[TB_PATH_MAXN];
+    if (g_cache_directory[0]) tb_strlcpy(directory, g_cache_directory, sizeof(directory));
+    else
+    {
+        tb_size_t size = tb_directory_temporary(directory, sizeof(directory));
+        tb_check_return_val(size && size < sizeof(directory), tb_null);
+        tb_snprintf(directory + size, sizeof(directory) - size, "/gbox/program");
+    }
+
+    // make the directory
+    if (!tb_file_info(directory, tb_null) && !tb_directory_create(directory)) return tb_null;
+
+    /* the key of the shader sources and the driver, the binary need be rebuilt if the driver has been updated
+     *
+     * two different seeds are used to reduce the collision of the 32-bit hash
+     */
+    tb_char_t const*    sources[] = { vshader
+                                    , fshader
+                                    , (tb_char_t const*)gb_glGetString(GB_GL_VENDOR)
+                                    , (tb_char_t const*)gb_glGetString(GB_GL_RENDERER)
+                                    , (tb_char_t const*)gb_glGetString(GB_GL_VERSION)};
+    tb_uint32_t         hash0 = 0xffffffff;
+    tb_uint32_t         hash1 = 0x12345678;
+    tb_size_t           i = 0;
+    for (i = 0; i < tb_arrayn(sources); i++)
+    {
+        hash0 = gb_gl_program_binary_hash(hash0, sources[i]);
+        hash1 = gb_gl_program_binary_hash(hash1 ^ (tb_uint32_t)i, sources[i]);
+    }
+
+    // the path
+    tb_snprintf(path, maxn, "%s/%08x%08x.bin", directory, hash0, hash1);
+    return path;
+}
+static tb_bool_t gb_gl_program_binary_load(gb_gl_program_impl_t* impl, tb_char_t const* path)
+{
+    // check
+    tb_assert_and_check_return_val(impl && !impl->program && path, tb_false);
+
+    // no cached binary?
+    tb_file_info_t info;
+    if (!tb_file_info(path, &info) || info.type != TB_FILE_TYPE_FILE) return tb_false;
+
+    // done
+    tb_bool_t           ok = tb_false;
+    tb_byte_t*          data = tb_null;
+    tb_stream_ref_t     stream = tb_null;
+    do
+    {
+        // init stream
+        stream = tb_stream_init_from_file(path, TB_FILE_MODE_RO);
+        tb_assert_and_check_break(stream);
+
+        // open stream
+        if (!tb_stream_open(stream)) break;
+
+        // read head
+        gb_gl_program_binary_head_t head;
+        if (!tb_stream_bread(stream, (tb_byte_t*)&head, sizeof(head))) break;
+        tb_check_break(head.magic == GB_GL_PROGRAM_BINARY_MAGIC && head.size && head.size <= GB_GL_PROGRAM_BINARY_MAXN);
+
+        // read binary
+        data = tb_malloc_bytes(head.size);
+        tb_assert_and_check_break(data);
+        if (!tb_stream_bread(stream, data, head.size)) break;
+
+        // the binary has been broken?
+        tb_check_break(head.crc32 == tb_crc_encode(TB_CRC_MODE_32_IEEE_LE, 0xffffffff, data, head.size));
+
+        // init program
+        impl->program = gb_glCreateProgram();
+        tb_assert_and_check_break(impl->program);
+
+        // load binary
+        gb_glProgramBinary(impl->program, (gb_GLenum_t)head.format, data, (gb_GLsizei_t)head.size);
+
+        // the driver may reject the binary, e.g. the binary format has been changed
+        gb_GLint_t status = GB_GL_FALSE;
+        gb_glGetProgramiv(impl->program, GB_GL_LINK_STATUS, &status);
+        tb_check_break(status != GB_GL_FALSE);
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // trace
+    tb_trace_d("binary: load %s: %s", path, ok? "ok" : "failed");
+
+    // exit stream
+    if (stream) tb_stream_exit(stream);
+    stream = tb_null;
+
+    // exit data
+    if (data) tb_free(data);
+    data = tb_null;
+
+    // failed?
+    if (!ok)
+    {
+        // exit program
+        if (impl->program) gb_glDeleteProgram(impl->program);
+        impl->program = 0;
+
+        // remove the invalid binary, it will be rebuilt
+        tb_file_remove(path);
+    }
+
+    // ok?
+    return ok;
+}
+static tb_bool_t gb_gl_program_binary_save(gb_gl_program_impl_t* impl, tb_char_t const* path)
+{
+    // check
+    tb_assert_and_check_return_val(impl && impl->program && path, tb_false);
+
+    // done
+    tb_bool_t           ok = tb_false;
+    tb_byte_t*          data = tb_null;
+    tb_stream_ref_t     stream = tb_null;
+    tb_char_t           temp[TB_PATH_MAXN] = {0};
+    do
+    {
+        // the binary size
+        gb_GLint_t size = 0;
+        gb_glGetProgramiv(impl->program, GB_GL_PROGRAM_BINARY_LENGTH, &size);
+        tb_check_break(size > 0 && size <= GB_GL_PROGRAM_BINARY_MAXN);
+
+        // get binary
+        gb_GLsizei_t    length = 0;
+        gb_GLenum_t     format = 0;
+        data = tb_malloc_bytes(size);
+        tb_assert_and_check_break(data);
+        gb_glGetProgramBinary(impl->program, size, &length, &format, data);
+        tb_check_break(length > 0 && length <= size);
+
+        // init head
+        gb_gl_program_binary_head_t head;
+        head.magic  = GB_GL_PROGRAM_BINARY_MAGIC;
+        head.format = (tb_uint32_t)format;
+        head.size   = (tb_uint32_t)length;
+        head.crc32  = tb_crc_encode(TB_CRC_MODE_32_IEEE_LE, 0xffffffff, data, length);
+
+        // write the temporary file first, the cached binary will not be broken if the writing is interrupted
+        tb_snprintf(temp, sizeof(temp), "%s.tmp", path);
+        stream = tb_stream_init_from_file(temp, TB_FILE_MODE_RW | TB_FILE_MODE_CREAT | TB_FILE_MODE_TRUNC);
+        tb_assert_and_check_break(stream);
+
+        // open stream
+        if (!tb_stream_open(stream)) break;
+
+        // write head and binary
+        if (!tb_stream_bwrit(stream, (tb_byte_t const*)&head, sizeof(head))) break;
+        if (!tb_stream_bwrit(stream, data, length)) break;
+
+        // exit stream
+        tb_stream_exit(stream);
+        stream = tb_null;
+
+        // commit it
+        ok = tb_file_rename(temp, path);
+
+    } while (0);
+
+    // trace
+    tb_trace_d("binary: save %s: %s", path, ok? "ok" : "failed");
+
+    // exit stream
+    if (stream) tb_stream_exit(stream);
+    stream = tb_null;
+
+    // exit data
+    if (data) tb_free(data);
+    data = tb_null;
+
+    // remove the temporary file if the writing or renaming failed
+    if (!ok && temp[0]) tb_file_remove(temp);
+
+    // ok?
+    return ok;
+}
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
  */
+tb_void_t gb_gl_program_cache_set(tb_char_t const* directory)
+{
+    // disable it?
+    g_cache_disabled = directory? tb_false : tb_true;
+
+    // save directory
+    if (directory) tb_strlcpy(g_cache_directory, directory, sizeof(g_cache_directory));
+    else g_cache_directory[0] = '\0';
+}
 gb_gl_program_ref_t gb_gl_program_init(tb_size_t type, tb_char_t const* vshader, tb_char_t const* fshader)
 {
     // check
@@ -114,6 +369,15 @@ gb_gl_program_ref_t gb_gl_program_init(tb_size_t type, tb_char_t const* vshader,
         // init type
         impl->type = type;
 
+        // load program from the binary cache first
+        tb_char_t   path[TB_PATH_MAXN];
+        tb_bool_t   binary = gb_gl_program_binary_able() && gb_gl_program_binary_path(path, sizeof(path), vshader, fshader);
+        if (binary && gb_gl_program_binary_load(impl, path))
+        {
+            ok = tb_true;
+            break;
+        }
+
         // load vshader
         impl->vshader = gb_gl_program_shader(vshader, GB_GL_VERTEX_SHADER);
         tb_assert_and_check_break(impl->vshader);
@@ -132,6 +396,9 @@ gb_gl_program_ref_t gb_gl_program_init(tb_size_t type, tb_char_t const* vshader,
         // bind fshader
         gb_glAttachShader(impl->program, impl->fshader);
 
+        // the binary need be retrievable for the cache
+        if (binary && gb_glProgramParameteri) gb_glProgramParameteri(impl->program, GB_GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GB_GL_TRUE);
+
         // link program
         gb_glLinkProgram(impl->program);
 
@@ -149,6 +416,9 @@ gb_gl_program_ref_t gb_gl_program_init(tb_size_t type, tb_char_t const* vshader,
             break;
         }
 
+        // save the binary to the cache
+        if (binary) gb_gl_program_binary_save(impl, path);
+
         // ok
         ok = tb_true;
 
@@ -195,6 +465,15 @@ tb_void_t gb_gl_program_bind(gb_gl_program_ref_t program)
     // bind it
     gb_glUseProgram(impl->program);
 }
+tb_size_t gb_gl_program_type(gb_gl_program_ref_t program)
+{
+    // check
+    gb_gl_program_impl_t* impl = (gb_gl_program_impl_t*)program;
+    tb_assert_and_check_return_val(impl, GB_GL_PROGRAM_TYPE_NONE);
+
+    // the type
+    return impl->type;
+}
 gb_GLint_t gb_gl_program_attr(gb_gl_program_ref_t program, tb_char_t const* name)
 {
     // check
@@ -46,7 +46,9 @@ typedef enum __gb_gl_program_type_e
     GB_GL_PROGRAM_TYPE_NONE         = 0
 ,   GB_GL_PROGRAM_TYPE_COLOR        = 1
 ,   GB_GL_PROGRAM_TYPE_BITMAP       = 2
-,   GB_GL_PROGRAM_TYPE_MAXN         = 3
+,   GB_GL_PROGRAM_TYPE_LINEAR       = 3
+,   GB_GL_PROGRAM_TYPE_RADIAL       = 4
+,   GB_GL_PROGRAM_TYPE_MAXN         = 5
 
 }gb_gl_program_type_e;
 
@@ -60,7 +62,10 @@ typedef enum __gb_gl_program_location_e
 ,   GB_GL_PROGRAM_LOCATION_MATRIX_MODEL         = 4
 ,   GB_GL_PROGRAM_LOCATION_MATRIX_PROJECT       = 5
 ,   GB_GL_PROGRAM_LOCATION_MATRIX_TEXCOORD      = 6
-,   GB_GL_PROGRAM_LOCATION_MAXN                 = 7
+,   GB_GL_PROGRAM_LOCATION_MODE                 = 7
+,   GB_GL_PROGRAM_LOCATION_REGION               = 8
+,   GB_GL_PROGRAM_LOCATION_CLAMP                = 9
+,   GB_GL_PROGRAM_LOCATION_MAXN                 = 10
 
 }gb_gl_program_location_e;
 
@@ -71,7 +76,21 @@ typedef struct{}*   gb_gl_program_ref_t;
  * interfaces
  */
 
+/* set the directory of the program binary cache
+ *
+ * the linked program binaries will be saved to this directory and be loaded directly
+ * at the next startup if GL_ARB_get_program_binary or GL_OES_get_program_binary is supported,
+ * they are keyed by the shader sources and the vendor, renderer and version strings of the driver.
+ *
+ * the default directory is "$(tmpdir)/gbox/program"
+ *
+ * @param directory     the cache directory, disable the cache if be null
+ */
+tb_void_t               gb_gl_program_cache_set(tb_char_t const* directory);
+
 /* init gl program for gl >= 2.x
+ *
+ * the program will be loaded from the binary cache first, and be compiled from the shader sources if failed
  *
  * @param type          the program type
  * @param vshader       the vertex shader content
@@ -93,6 +112,18 @@ gb_gl_program_ref_t     gb_gl_program_init_color(tb_noarg_t);
  */
 gb_gl_program_ref_t     gb_gl_program_init_bitmap(tb_noarg_t);
 
+/* init linear gradient program
+ *
+ * @return              the program
+ */
+gb_gl_program_ref_t     gb_gl_program_init_linear(tb_noarg_t);
+
+/* init radial gradient program
+ *
+ * @return              the program
+ */
+gb_gl_program_ref_t     gb_gl_program_init_radial(tb_noarg_t);
+
 /* exit gl program
  *
  * @param program       the program
@@ -105,6 +136,14 @@ tb_void_t               gb_gl_program_exit(gb_gl_program_ref_t program);
  */
 tb_void_t               gb_gl_program_bind(gb_gl_program_ref_t program);
 
+/* the program type
+ *
+ * @param program       the program
+ *
+ * @return              the program type
+ */
+tb_size_t               gb_gl_program_type(gb_gl_program_ref_t program);
+
 /* the attribute location of the given name for the program
  *
  * @param program       the program
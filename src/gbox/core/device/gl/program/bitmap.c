@@ -66,10 +66,17 @@ gb_gl_program_ref_t gb_gl_program_init_bitmap()
         "varying vec4 vColors;                                                              \n"
         "varying vec4 vTexcoords;                                                           \n"
         "uniform sampler2D uSampler;                                                        \n"
+        "uniform vec4 uRegion;                                                              \n"
+        "uniform vec4 uClamp;                                                               \n"
+        "                                                                                   \n"
+        GB_GL_PROGRAM_WRAP_FUNCS
         "                                                                                   \n"
         "void main()                                                                        \n"
         "{                                                                                  \n"
-        "   gl_FragColor = vColors * texture2D(uSampler, vec2(vTexcoords.x, vTexcoords.y)); \n"
+        "   vec2 st = vec2(gbWrap(vTexcoords.x), gbWrap(vTexcoords.y));                     \n"
+        "   st = uRegion.xy + clamp(st, uClamp.xy, uClamp.zw) * uRegion.zw;                 \n"
+        "   float border = gbBorder(vTexcoords.x) * gbBorder(vTexcoords.y);                 \n"
+        "   gl_FragColor = vColors * texture2D(uSampler, st) * border;                      \n"
         "}                                                                                  \n";
 
     // init program
@@ -83,6 +90,10 @@ gb_gl_program_ref_t gb_gl_program_init_bitmap()
     gb_gl_program_location_set(program, GB_GL_PROGRAM_LOCATION_MATRIX_MODEL,    gb_gl_program_unif(program, "uMatrixModel"));
     gb_gl_program_location_set(program, GB_GL_PROGRAM_LOCATION_MATRIX_PROJECT,  gb_gl_program_unif(program, "uMatrixProject"));
     gb_gl_program_location_set(program, GB_GL_PROGRAM_LOCATION_MATRIX_TEXCOORD, gb_gl_program_unif(program, "uMatrixTexcoord"));
+    gb_gl_program_location_set(program, GB_GL_PROGRAM_LOCATION_SAMPLER,         gb_gl_program_unif(program, "uSampler"));
+    gb_gl_program_location_set(program, GB_GL_PROGRAM_LOCATION_MODE,            gb_gl_program_unif(program, "uMode"));
+    gb_gl_program_location_set(program, GB_GL_PROGRAM_LOCATION_REGION,          gb_gl_program_unif(program, "uRegion"));
+    gb_gl_program_location_set(program, GB_GL_PROGRAM_LOCATION_CLAMP,           gb_gl_program_unif(program, "uClamp"));
 
     // ok
     return program;
@@ -32,6 +32,30 @@
 #include "../prefix.h"
 #include "../program.h"
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+/* the wrap functions of the fragment shader for the shader programs
+ *
+ * the texcoord outside [0, 1] is wrapped by the shader mode in the fragment shader,
+ * so the texture need not be power-of-two and the gradient lut can be shared for all modes.
+ *
+ * uMode: 1: border, 2: clamp, 3: repeat, 4: mirror, the same as gb_shader_mode_e
+ */
+#define GB_GL_PROGRAM_WRAP_FUNCS \
+        "uniform int uMode;                                                                 \n" \
+        "                                                                                   \n" \
+        "float gbWrap(float t)                                                              \n" \
+        "{                                                                                  \n" \
+        "   if (uMode == 3) return fract(t);                                                \n" \
+        "   if (uMode == 4) return 1.0 - abs(mod(t, 2.0) - 1.0);                            \n" \
+        "   return clamp(t, 0.0, 1.0);                                                      \n" \
+        "}                                                                                  \n" \
+        "float gbBorder(float t)                                                            \n" \
+        "{                                                                                  \n" \
+        "   return (uMode != 1 || (t >= 0.0 && t <= 1.0))? 1.0 : 0.0;                       \n" \
+        "}                                                                                  \n"
 
 #endif
 
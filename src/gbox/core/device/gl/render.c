@@ -34,23 +34,34 @@
  * includes
  */
 #include "render.h"
+#include "shader.h"
+#include "../../impl/bounds.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * macros
  */
 
-// the vertex type
-#if defined(GB_CONFIG_FLOAT_FIXED) && defined(GB_GL_FIXED)
-#   define GB_GL_VERTEX_TYPE            GB_GL_FIXED
-#elif defined(GB_CONFIG_FLOAT_FIXED)
-#   define GB_GL_VERTEX_TYPE            GL_GL_INT
-#else
-#   define GB_GL_VERTEX_TYPE            GB_GL_FLOAT
-#endif
-
 // test tessellator
 //#define GB_GL_TESSELLATOR_TEST_ENABLE   
 
+/* the minimum vertex count of the concave polygon filled by stencil-then-cover
+ *
+ * the smaller polygons are tessellated on cpu, which is cheap and their strips can be batched
+ */
+#ifndef GB_GL_RENDER_STENCIL_POINTS_MINN
+#   define GB_GL_RENDER_STENCIL_POINTS_MINN     (2048)
+#endif
+
+/* the minimum vertex count of the cacheable concave path filled by stencil-then-cover
+ *
+ * the tessellated strips of the path will be cached and reused for the next frames,
+ * it is faster than stencil-then-cover which need two passes for each frame, 
+ * so only the very large path will skip tessellating it
+ */
+#ifndef GB_GL_RENDER_STENCIL_CACHED_MINN
+#   define GB_GL_RENDER_STENCIL_CACHED_MINN     (8192)
+#endif
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * private implementation
  */
@@ -67,45 +78,122 @@ static tb_void_t gb_gl_render_apply_vertices(gb_gl_device_ref_t device, gb_point
 
         // apply it
         gb_glVertexAttribPointer(gb_gl_program_location(device->program, GB_GL_PROGRAM_LOCATION_VERTICES), 2, GB_GL_VERTEX_TYPE, GB_GL_FALSE, 0, points);
+
+        // the texcoords are mapped from the vertices by the texcoord matrix of the shader
+        if (device->shader) gb_glVertexAttribPointer(gb_gl_program_location(device->program, GB_GL_PROGRAM_LOCATION_TEXCOORDS), 2, GB_GL_VERTEX_TYPE, GB_GL_FALSE, 0, points);
     }
     else 
     {
         // apply it
         gb_glVertexPointer(2, GB_GL_VERTEX_TYPE, 0, points);
+
+        // the texcoords are mapped from the vertices by the texture matrix
+        if (device->shader) gb_glTexCoordPointer(2, GB_GL_VERTEX_TYPE, 0, points);
     }
 }
+static tb_void_t gb_gl_render_apply_direct(gb_gl_device_ref_t device)
+{
+    // check
+    tb_assert(device && device->base.paint && device->batch);
+
+    // flush the pending draws of the batch first for keeping the draw order
+    gb_gl_batch_flush(device->batch);
+
+    /* the batch keeps its vertex buffer and color arrays after flushing,
+     * but the direct draws use the client arrays and the constant color
+     */
+    if (device->version >= 0x20)
+    {
+        // check
+        tb_assert(device->program);
+
+        // unbind the vertex buffer and disable colors
+        gb_gl_state_buffer(&device->state, GB_GL_ARRAY_BUFFER, 0);
+        gb_gl_state_attrib(&device->state, gb_gl_program_location(device->program, GB_GL_PROGRAM_LOCATION_COLORS), tb_false);
+    }
+    else gb_gl_state_client(&device->state, GB_GL_COLOR_ARRAY, tb_false);
+
+    // the state has been applied?
+    tb_check_return(!device->direct);
+
+    // init antialiasing
+    if (gb_paint_flag(device->base.paint) & GB_PAINT_FLAG_ANTIALIASING) 
+    {
+        gb_gl_state_enable(&device->state, GB_GL_MULTISAMPLE);
+#if 0
+        gb_glEnable(GB_GL_LINE_SMOOTH);
+        gb_glHint(GB_GL_LINE_SMOOTH_HINT, GB_GL_NICEST);
+#endif
+    }
+    else gb_gl_state_disable(&device->state, GB_GL_MULTISAMPLE);
+
+    // init vertex and matrix
+    if (device->version >= 0x20)
+    {   
+        // bind this program to the current gl context
+        gb_gl_state_program(&device->state, device->program);
+
+        // enable vertex
+        gb_gl_state_attrib(&device->state, gb_gl_program_location(device->program, GB_GL_PROGRAM_LOCATION_VERTICES), tb_true);
+
+        // apply projection matrix
+        gb_gl_state_matrix(&device->state, GB_GL_PROGRAM_LOCATION_MATRIX_PROJECT, device->matrix_project);
+
+        // apply vertex matrix
+        gb_gl_state_matrix(&device->state, GB_GL_PROGRAM_LOCATION_MATRIX_MODEL, device->matrix_vertex);
+    }
+    else
+    {
+        // enable vertex
+        gb_gl_state_client(&device->state, GB_GL_VERTEX_ARRAY, tb_true);
+
+        // apply vertex matrix
+        gb_glMatrixMode(GB_GL_MODELVIEW);
+        gb_glPushMatrix();
+        gb_glLoadIdentity();
+        gb_glMultMatrixf(device->matrix_vertex);
+    }
+
+    // applied
+    device->direct = tb_true;
+}
+static gb_color_t gb_gl_render_paint_color(gb_gl_device_ref_t device)
+{
+    // check
+    tb_assert(device && device->base.paint);
+
+    // the color 
+    gb_color_t color = gb_paint_color(device->base.paint);
+
+    // apply the alpha 
+    tb_byte_t alpha = gb_paint_alpha(device->base.paint);
+    if (alpha != 0xff) color.a = alpha;
+
+    // ok
+    return color;
+}
 static tb_void_t gb_gl_render_enter_solid(gb_gl_device_ref_t device)
 {
     // check
     tb_assert(device);
  
-    // the paint
-    gb_paint_ref_t paint = device->base.paint;
-    tb_assert(paint);
-
     // the color 
-    gb_color_t color = gb_paint_color(paint);
-
-    // the alpha
-    tb_byte_t alpha = gb_paint_alpha(paint);
+    gb_color_t color = gb_gl_render_paint_color(device);
 
     // disable texture
-    gb_glDisable(GB_GL_TEXTURE_2D);
+    gb_gl_state_disable(&device->state, GB_GL_TEXTURE_2D);
 
     // exists alpha?
-    if (alpha != 0xff)
+    if (gb_paint_alpha(device->base.paint) != 0xff)
     {
         // enable blend
-        gb_glEnable(GB_GL_BLEND);
-        gb_glBlendFunc(GB_GL_SRC_ALPHA, GB_GL_ONE_MINUS_SRC_ALPHA);
-
-        // apply the alpha 
-        color.a = alpha;
+        gb_gl_state_enable(&device->state, GB_GL_BLEND);
+        gb_gl_state_blend_func(&device->state, GB_GL_SRC_ALPHA, GB_GL_ONE_MINUS_SRC_ALPHA);
     }
     else
     {
         // disable blend
-        gb_glDisable(GB_GL_BLEND);
+        gb_gl_state_disable(&device->state, GB_GL_BLEND);
     }
 
     // apply color
@@ -129,32 +217,118 @@ static tb_void_t gb_gl_render_leave_solid(gb_gl_device_ref_t device)
     tb_assert(device);
  
     // disable blend
-    gb_glDisable(GB_GL_BLEND);
+    gb_gl_state_disable(&device->state, GB_GL_BLEND);
 }
 static tb_void_t gb_gl_render_enter_shader(gb_gl_device_ref_t device)
 {   
     // check
-    tb_assert(device && device->base.paint);
- 
-    // disable blend
-    gb_glDisable(GB_GL_BLEND);
+    tb_assert(device && device->base.paint && device->shader);
+
+    // the alpha
+    tb_byte_t alpha = gb_paint_alpha(device->base.paint);
+
+    // load the bitmap from the texture cache and bind its texture
+    gb_gl_texture_region_t  region;
+    gb_bitmap_ref_t         bitmap = gb_gl_shader_bitmap(device->shader);
+    if (bitmap)
+    {
+        if (!gb_gl_texture_load(device->textures, bitmap, gb_shader_mode(device->shader), (gb_paint_flag(device->base.paint) & GB_PAINT_FLAG_FILTER_BITMAP)? tb_true : tb_false, &region))
+        {
+            tb_trace_e("load bitmap texture failed!");
+        }
+    }
+    // bind the gradient texture of the shader
+    else if (!gb_gl_shader_bind(device->shader))
+    {
+        tb_trace_e("bind shader failed!");
+    }
+
+    // exists alpha?
+    if (alpha != 0xff || !gb_gl_shader_opaque(device->shader))
+    {
+        // enable blend
+        gb_gl_state_enable(&device->state, GB_GL_BLEND);
+        gb_gl_state_blend_func(&device->state, GB_GL_SRC_ALPHA, GB_GL_ONE_MINUS_SRC_ALPHA);
+    }
+    else
+    {
+        // disable blend
+        gb_gl_state_disable(&device->state, GB_GL_BLEND);
+    }
 
     // enable texture
-    gb_glEnable(GB_GL_TEXTURE_2D);
+    gb_gl_state_enable(&device->state, GB_GL_TEXTURE_2D);
+
+    // the texcoord matrix
+    gb_gl_matrix_t matrix;
+    gb_gl_shader_matrix(device->shader, matrix);
+
+    // apply matrix for the fixed texcoords if no GB_GL_FIXED macro
+#if defined(GB_CONFIG_FLOAT_FIXED) && !defined(GB_GL_FIXED)
+    matrix[0] /= 65536.0f;
+    matrix[1] /= 65536.0f;
+    matrix[4] /= 65536.0f;
+    matrix[5] /= 65536.0f;
+#endif
+
+    // apply texcoords, the texture colors are modulated by the paint alpha
+    if (device->version >= 0x20)
+    {
+        // check
+        tb_assert(device->program);
+
+        // enable texcoords
+        gb_gl_state_attrib(&device->state, gb_gl_program_location(device->program, GB_GL_PROGRAM_LOCATION_TEXCOORDS), tb_true);
+
+        // apply texcoord matrix
+        gb_gl_state_matrix(&device->state, GB_GL_PROGRAM_LOCATION_MATRIX_TEXCOORD, matrix);
+
+        // apply the wrap mode
+        gb_glUniform1i(gb_gl_program_location(device->program, GB_GL_PROGRAM_LOCATION_MODE), (gb_GLint_t)gb_shader_mode(device->shader));
+
+        // apply the region of the bitmap in the texture
+        if (bitmap)
+        {
+            gb_glUniform4f(gb_gl_program_location(device->program, GB_GL_PROGRAM_LOCATION_REGION), region.region[0], region.region[1], region.region[2], region.region[3]);
+            gb_glUniform4f(gb_gl_program_location(device->program, GB_GL_PROGRAM_LOCATION_CLAMP), region.clamp[0], region.clamp[1], region.clamp[2], region.clamp[3]);
+        }
+
+        // apply alpha
+        gb_glVertexAttrib4f(gb_gl_program_location(device->program, GB_GL_PROGRAM_LOCATION_COLORS), 1.0f, 1.0f, 1.0f, (gb_GLfloat_t)alpha / 0xff);
+    }
+    else
+    {
+        // enable texcoords
+        gb_gl_state_client(&device->state, GB_GL_TEXTURE_COORD_ARRAY, tb_true);
+
+        // apply texture matrix
+        gb_glMatrixMode(GB_GL_TEXTURE);
+        gb_glLoadMatrixf(matrix);
+        gb_glMatrixMode(GB_GL_MODELVIEW);
+
+        // apply alpha
+        gb_glColor4f(1.0f, 1.0f, 1.0f, (gb_GLfloat_t)alpha / 0xff);
+    }
 }
 static tb_void_t gb_gl_render_leave_shader(gb_gl_device_ref_t device)
 {   
     // check
     tb_assert(device);
  
+    // disable blend
+    gb_gl_state_disable(&device->state, GB_GL_BLEND);
+
     // disable texture
-    gb_glDisable(GB_GL_TEXTURE_2D);
+    gb_gl_state_disable(&device->state, GB_GL_TEXTURE_2D);
 }
 static tb_void_t gb_gl_render_enter_paint(gb_gl_device_ref_t device)
 {
     // check
     tb_assert(device);
 
+    // apply the state of the direct draws
+    gb_gl_render_apply_direct(device);
+
     // enter shader
     if (device->shader) gb_gl_render_enter_shader(device);
     // enter solid
@@ -170,6 +344,7 @@ static tb_void_t gb_gl_render_leave_paint(gb_gl_device_ref_t device)
     // leave solid
     else gb_gl_render_leave_solid(device);
 }
+#ifdef GB_GL_TESSELLATOR_TEST_ENABLE
 static tb_void_t gb_gl_render_fill_convex(gb_point_ref_t points, tb_uint16_t count, tb_cpointer_t priv)
 {
     // check
@@ -178,10 +353,6 @@ static tb_void_t gb_gl_render_fill_convex(gb_point_ref_t points, tb_uint16_t cou
     // apply it
     gb_gl_render_apply_vertices((gb_gl_device_ref_t)priv, points);
 
-#ifndef GB_GL_TESSELLATOR_TEST_ENABLE
-    // draw it
-    gb_glDrawArrays(GB_GL_TRIANGLE_FAN, 0, (gb_GLint_t)count);
-#else
     // the device 
     gb_gl_device_ref_t device = (gb_gl_device_ref_t)priv;
 
@@ -208,27 +379,207 @@ static tb_void_t gb_gl_render_fill_convex(gb_point_ref_t points, tb_uint16_t cou
 
     // disable blend
     gb_glEnable(GB_GL_BLEND);
+}
+#else
+static tb_void_t gb_gl_render_fill_strip(gb_gl_device_ref_t device, gb_point_ref_t points, tb_uint16_t count)
+{
+    // check
+    tb_assert(device && points && count);
+
+    // apply it
+    gb_gl_render_apply_vertices(device, points);
+
+    // draw it
+    gb_glDrawArrays(GB_GL_TRIANGLE_STRIP, 0, (gb_GLint_t)count);
+}
+static tb_bool_t gb_gl_render_fill_stencil_able(gb_gl_device_ref_t device, gb_polygon_ref_t polygon, gb_rect_ref_t bounds, tb_size_t version)
+{
+    // check
+    tb_assert(device && polygon && polygon->counts);
+
+    // no stencil buffer or no bounds for covering it?
+    tb_check_return_val(device->stencil && bounds, tb_false);
+
+    // the convex polygon need not be tessellated
+    tb_check_return_val(!polygon->convex, tb_false);
+
+    // the vertex count
+    tb_size_t       total = 0;
+    tb_uint16_t     count;
+    tb_uint16_t*    counts = polygon->counts;
+    while ((count = *counts++)) total += count;
+
+    // too few vertices? tessellate it 
+    return total >= (version? GB_GL_RENDER_STENCIL_CACHED_MINN : GB_GL_RENDER_STENCIL_POINTS_MINN);
+}
+static tb_void_t gb_gl_render_fill_stencil(gb_gl_device_ref_t device, gb_polygon_ref_t polygon, gb_rect_ref_t bounds, tb_size_t rule)
+{
+    // check
+    tb_assert(device && device->stencil && device->version >= 0x20 && polygon && polygon->points && polygon->counts && bounds);
+
+    // apply the state of the direct draws, the pending draws of the batch will be flushed first
+    gb_gl_render_apply_direct(device);
+
+    // only write the stencil buffer
+    gb_glColorMask(GB_GL_FALSE, GB_GL_FALSE, GB_GL_FALSE, GB_GL_FALSE);
+    gb_gl_state_enable(&device->state, GB_GL_STENCIL_TEST);
+    gb_glStencilFunc(GB_GL_ALWAYS, 0, 0xff);
+
+    /* count the winding number by the front and back faces for the non-zero rule,
+     * and only invert it for the odd rule
+     */
+    if (rule == GB_PAINT_FILL_RULE_NONZERO)
+    {
+        gb_glStencilOpSeparate(GB_GL_FRONT, GB_GL_KEEP, GB_GL_KEEP, GB_GL_INCR_WRAP);
+        gb_glStencilOpSeparate(GB_GL_BACK, GB_GL_KEEP, GB_GL_KEEP, GB_GL_DECR_WRAP);
+    }
+    else gb_glStencilOp(GB_GL_KEEP, GB_GL_KEEP, GB_GL_INVERT);
+
+    // draw the triangle fan of each contour to the stencil buffer
+    gb_gl_render_apply_vertices(device, polygon->points);
+    tb_uint16_t     count;
+    tb_size_t       index = 0;
+    tb_uint16_t*    counts = polygon->counts;
+    while ((count = *counts++))
+    {
+        if (count > 2) gb_glDrawArrays(GB_GL_TRIANGLE_FAN, (gb_GLint_t)index, (gb_GLint_t)count);
+        index += count;
+    }
+
+    // cover the bounds where the stencil value is not zero, and clear it for the next fill
+    gb_glColorMask(GB_GL_TRUE, GB_GL_TRUE, GB_GL_TRUE, GB_GL_TRUE);
+    gb_glStencilFunc(GB_GL_NOTEQUAL, 0, 0xff);
+    gb_glStencilOp(GB_GL_ZERO, GB_GL_ZERO, GB_GL_ZERO);
+
+    // make the cover rect
+    gb_point_t cover[4];
+    gb_point_make(&cover[0], bounds->x, bounds->y);
+    gb_point_make(&cover[1], bounds->x + bounds->w, bounds->y);
+    gb_point_make(&cover[2], bounds->x, bounds->y + bounds->h);
+    gb_point_make(&cover[3], bounds->x + bounds->w, bounds->y + bounds->h);
+
+    // draw the cover rect with the paint
+    gb_gl_render_enter_paint(device);
+    gb_gl_render_fill_strip(device, cover, 4);
+    gb_gl_render_leave_paint(device);
+
+    // disable stencil test
+    gb_gl_state_disable(&device->state, GB_GL_STENCIL_TEST);
+}
 #endif
+static tb_void_t gb_gl_render_fill_batch(gb_gl_device_ref_t device, gb_polygon_ref_t strips)
+{
+    // check
+    tb_assert(device && device->base.paint && device->batch && strips);
+
+    // the color
+    gb_color_t color = gb_gl_render_paint_color(device);
+
+    // init state
+    gb_gl_batch_state_t state;
+    state.program       = device->version >= 0x20? device->program : tb_null;
+    state.blend         = gb_paint_alpha(device->base.paint) != 0xff;
+    state.antialiasing  = (gb_paint_flag(device->base.paint) & GB_PAINT_FLAG_ANTIALIASING)? 1 : 0;
+    tb_memcpy(state.matrix_project, device->matrix_project, sizeof(gb_gl_matrix_t));
+    tb_memcpy(state.matrix_vertex, device->matrix_vertex, sizeof(gb_gl_matrix_t));
+
+    /* append the strips to the batch, 
+     * the consecutive solid fills with the same state will be drawn by one indexed draw call
+     */
+    gb_gl_batch_draw_strips(device->batch, &state, color, strips->points, strips->counts);
 }
-static tb_void_t gb_gl_render_fill_polygon(gb_gl_device_ref_t device, gb_polygon_ref_t polygon, gb_rect_ref_t bounds, tb_size_t rule)
+static gb_polygon_ref_t gb_gl_render_fill_load(gb_gl_device_ref_t device, gb_polygon_ref_t polygon, gb_rect_ref_t bounds, tb_size_t rule, tb_size_t version)
 {
     // check
-    tb_assert(device && device->tessellator);
+    tb_assert(device && device->tessellator && device->cache);
+
+    // the stats is disabled? load it directly
+    if (!device->base.stats) return gb_gl_cache_load(device->cache, device->tessellator, polygon, bounds, rule, version);
+
+    // the tessellations count before loading
+    gb_gl_cache_stats_t stats;
+    gb_gl_cache_stats(device->cache, &stats);
+    tb_size_t tessellations = stats.tessellations;
+
+    // load it 
+    tb_hong_t           clock = tb_uclock();
+    gb_polygon_ref_t    strips = gb_gl_cache_load(device->cache, device->tessellator, polygon, bounds, rule, version);
+
+    // update stats, the strips loaded from the cache are not counted as the tessellations
+    gb_gl_cache_stats(device->cache, &stats);
+    device->base.stats->tessellations   += stats.tessellations - tessellations;
+    device->base.stats->tessellate_time += tb_uclock() - clock;
+
+    // ok
+    return strips;
+}
+static tb_void_t gb_gl_render_fill_polygon(gb_gl_device_ref_t device, gb_polygon_ref_t polygon, gb_rect_ref_t bounds, tb_size_t rule, tb_size_t version)
+{
+    // check
+    tb_assert(device && device->tessellator && device->cache);
 
 #ifdef GB_GL_TESSELLATOR_TEST_ENABLE
+    // enter paint
+    gb_gl_render_enter_paint(device);
+
     // set mode
     gb_tessellator_mode_set(device->tessellator, GB_TESSELLATOR_MODE_TRIANGULATION);
 //    gb_tessellator_mode_set(device->tessellator, GB_TESSELLATOR_MODE_MONOTONE);
-#endif
-
-    // set rule
-    gb_tessellator_rule_set(device->tessellator, rule);
 
     // set func
     gb_tessellator_func_set(device->tessellator, gb_gl_render_fill_convex, device);
 
+    // set rule
+    gb_tessellator_rule_set(device->tessellator, rule);
+
     // done tessellator
+    tb_hong_t clock = gb_device_stats_clock(&device->base);
     gb_tessellator_done(device->tessellator, polygon, bounds);
+    gb_device_stats_count_add(&device->base, tessellations, 1);
+    gb_device_stats_clock_add(&device->base, tessellate_time, clock);
+
+    // leave paint
+    gb_gl_render_leave_paint(device);
+#else
+    // fill the large concave polygon by stencil-then-cover, the cpu tessellator will be skipped
+    if (gb_gl_render_fill_stencil_able(device, polygon, bounds, version))
+    {
+        gb_gl_render_fill_stencil(device, polygon, bounds, rule);
+        return ;
+    }
+
+    /* load the triangle strips from the cache or tessellate it, 
+     * the whole polygon will be drawn by one triangle strip mostly
+     */
+    gb_polygon_ref_t strips = gb_gl_render_fill_load(device, polygon, bounds, rule, version);
+    tb_check_return(strips);
+
+    // the solid fill? batch it
+    if (!device->shader) 
+    {
+        gb_gl_render_fill_batch(device, strips);
+        return ;
+    }
+
+    // enter paint
+    gb_gl_render_enter_paint(device);
+
+    // draw them
+    tb_uint16_t     count;
+    gb_point_ref_t  points = strips->points;
+    tb_uint16_t*    counts = strips->counts;
+    while ((count = *counts++))
+    {
+        // draw it
+        gb_gl_render_fill_strip(device, points, count);
+
+        // the next strip
+        points += count;
+    }
+
+    // leave paint
+    gb_gl_render_leave_paint(device);
+#endif
 }
 static tb_void_t gb_gl_render_stroke_lines(gb_gl_device_ref_t device, gb_point_ref_t points, tb_size_t count)
 {
@@ -289,8 +640,8 @@ static tb_void_t gb_gl_render_stroke_fill(gb_gl_device_ref_t device, gb_path_ref
     // switch to the non-zero fill rule
     gb_paint_fill_rule_set(device->base.paint, GB_PAINT_FILL_RULE_NONZERO);
 
-    // draw path
-    gb_gl_render_draw_path(device, path);
+    // draw the stroked polygon, it will be changed for each stroking and need not be cached
+    gb_gl_render_draw_polygon(device, gb_device_impl_polygon(&device->base, path), gb_path_hint(path), gb_path_bounds(path));
 
     // restore the mode
     gb_paint_mode_set(device->base.paint, mode);
@@ -309,6 +660,78 @@ static __tb_inline__ tb_bool_t gb_gl_render_stroke_only(gb_gl_device_ref_t devic
             &&  GB_ONE == gb_abs(device->base.matrix->sy) 
             &&  !device->shader)? tb_true : tb_false;
 }
+static tb_void_t gb_gl_render_draw_polygon_done(gb_gl_device_ref_t device, gb_polygon_ref_t polygon, gb_shape_ref_t hint, gb_rect_ref_t bounds, tb_size_t version)
+{
+    // check
+    tb_assert(device && device->base.paint && polygon && polygon->points && polygon->counts);
+
+    // line?
+    if (hint && hint->type == GB_SHAPE_TYPE_LINE)
+    {
+        gb_point_t points[2];
+        points[0] = hint->u.line.p0;
+        points[1] = hint->u.line.p1;
+        gb_gl_render_draw_lines(device, points, 2, bounds);
+        return ;
+    }
+    // point?
+    else if (hint && hint->type == GB_SHAPE_TYPE_POINT)
+    {
+        gb_gl_render_draw_points(device, &hint->u.point, 1, bounds);
+        return ;
+    }
+
+    // the mode
+    tb_size_t mode = gb_paint_mode(device->base.paint);
+
+    // fill it
+    if (mode & GB_PAINT_MODE_FILL)
+    {
+        /* the raw polygon has no bounds? make it from the points, 
+         * the tessellator and the covering quad of the stencil need it
+         */
+        gb_rect_t made;
+        if (!bounds)
+        {
+            tb_size_t       total = 0;
+            tb_uint16_t     count;
+            tb_uint16_t*    counts = polygon->counts;
+            while ((count = *counts++)) total += count;
+            tb_check_return(total);
+
+            // make bounds
+            gb_bounds_make(&made, polygon->points, total);
+            bounds = &made;
+        }
+
+        // fill polygon
+        gb_gl_render_fill_polygon(device, polygon, bounds, gb_paint_fill_rule(device->base.paint), version);
+    }
+
+    // stroke it
+    if ((mode & GB_PAINT_MODE_STROKE) && (gb_paint_stroke_width(device->base.paint) > 0))
+    {
+        // only stroke?
+        if (gb_gl_render_stroke_only(device)) 
+        {
+            gb_gl_render_enter_paint(device);
+            gb_gl_render_stroke_polygon(device, polygon->points, polygon->counts);
+            gb_gl_render_leave_paint(device);
+        }
+        // fill the stroked polygon
+        else
+        {
+            // stroke it
+            tb_hong_t       clock = gb_device_stats_clock(&device->base);
+            gb_path_ref_t   stroked_path = gb_stroker_done_polygon(device->stroker, device->base.paint, polygon, hint);
+            gb_device_stats_count_add(&device->base, strokes, 1);
+            gb_device_stats_clock_add(&device->base, stroke_time, clock);
+
+            // fill it
+            gb_gl_render_stroke_fill(device, stroked_path);
+        }
+    }
+}
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
@@ -325,6 +748,13 @@ tb_bool_t gb_gl_render_init(gb_gl_device_ref_t device)
         // init shader
         device->shader = gb_paint_shader(device->base.paint);
 
+        // the radial gradient need the fragment shader, so fill it with the paint color for gl 1.x
+        if (device->shader && device->version < 0x20 && gb_shader_type(device->shader) == GB_SHADER_TYPE_RADIAL)
+        {
+            tb_trace_d("the radial gradient is not supported for gl 1.x!");
+            device->shader = tb_null;
+        }
+
         // init vertex matrix
         gb_gl_matrix_convert(device->matrix_vertex, device->base.matrix);
 
@@ -336,51 +766,32 @@ tb_bool_t gb_gl_render_init(gb_gl_device_ref_t device)
         device->matrix_vertex[5] /= 65536.0f;
 #endif
 
-        // init antialiasing
-        if (gb_paint_flag(device->base.paint) & GB_PAINT_FLAG_ANTIALIASING) 
-        {
-            gb_glEnable(GB_GL_MULTISAMPLE);
-#if 0
-            gb_glEnable(GB_GL_LINE_SMOOTH);
-            gb_glHint(GB_GL_LINE_SMOOTH_HINT, GB_GL_NICEST);
-#endif
-        }
-        else gb_glDisable(GB_GL_MULTISAMPLE);
-
-        // init vertex and matrix
+        // init program
         if (device->version >= 0x20)
         {   
             // the program type
-            tb_size_t program_type = device->shader? GB_GL_PROGRAM_TYPE_BITMAP : GB_GL_PROGRAM_TYPE_COLOR;
+            tb_size_t program_type = GB_GL_PROGRAM_TYPE_COLOR;
+            if (device->shader)
+            {
+                switch (gb_shader_type(device->shader))
+                {
+                case GB_SHADER_TYPE_LINEAR: program_type = GB_GL_PROGRAM_TYPE_LINEAR;   break;
+                case GB_SHADER_TYPE_RADIAL: program_type = GB_GL_PROGRAM_TYPE_RADIAL;   break;
+                case GB_SHADER_TYPE_BITMAP: program_type = GB_GL_PROGRAM_TYPE_BITMAP;   break;
+                default: break;
+                }
+            }
 
             // program
             device->program = device->programs[program_type];
             tb_assert_and_check_break(device->program);
-
-            // bind this program to the current gl context
-            gb_gl_program_bind(device->program);
-
-            // enable vertex
-            gb_glEnableVertexAttribArray(gb_gl_program_location(device->program, GB_GL_PROGRAM_LOCATION_VERTICES));
-
-            // apply projection matrix
-            gb_glUniformMatrix4fv(gb_gl_program_location(device->program, GB_GL_PROGRAM_LOCATION_MATRIX_PROJECT), 1, GB_GL_FALSE, device->matrix_project);
-
-            // apply vertex matrix
-            gb_glUniformMatrix4fv(gb_gl_program_location(device->program, GB_GL_PROGRAM_LOCATION_MATRIX_MODEL), 1, GB_GL_FALSE, device->matrix_vertex);
-        }
-        else
-        {
-            // enable vertex
-            gb_glEnableClientState(GB_GL_VERTEX_ARRAY);
-    
-            // apply vertex matrix
-            gb_glMatrixMode(GB_GL_MODELVIEW);
-            gb_glPushMatrix();
-            gb_glLoadIdentity();
-            gb_glMultMatrixf(device->matrix_vertex);
         }
 
+        /* the gl state will be applied lazily for the direct draws only,
+         * the solid fills will be appended to the batch and be drawn with its own state
+         */
+        device->direct = tb_false;
+
         // ok
         ok = tb_true;
 
@@ -394,6 +805,9 @@ tb_void_t gb_gl_render_exit(gb_gl_device_ref_t device)
     // check
     tb_assert_and_check_return(device);
 
+    // the state of the direct draws has not been applied?
+    tb_check_return(device->direct);
+
     // exit vertex and matrix
     if (device->version >= 0x20)
     {   
@@ -401,10 +815,10 @@ tb_void_t gb_gl_render_exit(gb_gl_device_ref_t device)
         tb_assert_and_check_return(device->program);
 
         // disable vertex
-        gb_glDisableVertexAttribArray(gb_gl_program_location(device->program, GB_GL_PROGRAM_LOCATION_VERTICES));
+        gb_gl_state_attrib(&device->state, gb_gl_program_location(device->program, GB_GL_PROGRAM_LOCATION_VERTICES), tb_false);
  
         // disable texcoord
-        gb_glDisableVertexAttribArray(gb_gl_program_location(device->program, GB_GL_PROGRAM_LOCATION_TEXCOORDS));
+        gb_gl_state_attrib(&device->state, gb_gl_program_location(device->program, GB_GL_PROGRAM_LOCATION_TEXCOORDS), tb_false);
     }
     else
     {
@@ -413,14 +827,17 @@ tb_void_t gb_gl_render_exit(gb_gl_device_ref_t device)
         gb_glPopMatrix();
 
         // disable vertex
-        gb_glDisableClientState(GB_GL_VERTEX_ARRAY);
+        gb_gl_state_client(&device->state, GB_GL_VERTEX_ARRAY, tb_false);
  
         // disable texcoord
-        gb_glDisableClientState(GB_GL_TEXTURE_COORD_ARRAY);
+        gb_gl_state_client(&device->state, GB_GL_TEXTURE_COORD_ARRAY, tb_false);
     }
  
     // disable antialiasing
-    gb_glDisable(GB_GL_MULTISAMPLE);
+    gb_gl_state_disable(&device->state, GB_GL_MULTISAMPLE);
+
+    // restored
+    device->direct = tb_false;
 }
 tb_void_t gb_gl_render_draw_path(gb_gl_device_ref_t device, gb_path_ref_t path)
 {
@@ -430,19 +847,29 @@ tb_void_t gb_gl_render_draw_path(gb_gl_device_ref_t device, gb_path_ref_t path)
     // the mode
     tb_size_t mode = gb_paint_mode(device->base.paint);
 
-    // fill it
+    // fill it, the tessellated polygon will be cached for this path version if the path is not transient
     if (mode & GB_PAINT_MODE_FILL)
     {
-        gb_gl_render_draw_polygon(device, gb_path_polygon(path), gb_path_hint(path), gb_path_bounds(path));
+        gb_gl_render_draw_polygon_done(device, gb_device_impl_polygon(&device->base, path), gb_path_hint(path), gb_path_bounds(path), gb_path_version(path));
     }
 
     // stroke it
     if ((mode & GB_PAINT_MODE_STROKE) && (gb_paint_stroke_width(device->base.paint) > 0))
     {
         // only stroke?
-        if (gb_gl_render_stroke_only(device)) gb_gl_render_draw_polygon(device, gb_path_polygon(path), gb_path_hint(path), gb_path_bounds(path));
+        if (gb_gl_render_stroke_only(device)) gb_gl_render_draw_polygon_done(device, gb_device_impl_polygon(&device->base, path), gb_path_hint(path), gb_path_bounds(path), gb_path_version(path));
         // fill the stroked path
-        else gb_gl_render_stroke_fill(device, gb_stroker_done_path(device->stroker, device->base.paint, path));
+        else
+        {
+            // stroke it
+            tb_hong_t       clock = gb_device_stats_clock(&device->base);
+            gb_path_ref_t   stroked_path = gb_stroker_done_path(device->stroker, device->base.paint, path);
+            gb_device_stats_count_add(&device->base, strokes, 1);
+            gb_device_stats_clock_add(&device->base, stroke_time, clock);
+
+            // fill it
+            gb_gl_render_stroke_fill(device, stroked_path);
+        }
     }
 }
 tb_void_t gb_gl_render_draw_lines(gb_gl_device_ref_t device, gb_point_ref_t points, tb_size_t count, gb_rect_ref_t bounds)
@@ -456,16 +883,25 @@ tb_void_t gb_gl_render_draw_lines(gb_gl_device_ref_t device, gb_point_ref_t poin
     // check width
     tb_check_return((gb_paint_stroke_width(device->base.paint) > 0));
 
-    // enter paint
-    gb_gl_render_enter_paint(device);
-
     // only stroke?
-    if (gb_gl_render_stroke_only(device)) gb_gl_render_stroke_lines(device, points, count);
+    if (gb_gl_render_stroke_only(device)) 
+    {
+        gb_gl_render_enter_paint(device);
+        gb_gl_render_stroke_lines(device, points, count);
+        gb_gl_render_leave_paint(device);
+    }
     // fill the stroked lines
-    else gb_gl_render_stroke_fill(device, gb_stroker_done_lines(device->stroker, device->base.paint, points, count));
-
-    // leave paint
-    gb_gl_render_leave_paint(device);
+    else
+    {
+        // stroke it
+        tb_hong_t       clock = gb_device_stats_clock(&device->base);
+        gb_path_ref_t   stroked_path = gb_stroker_done_lines(device->stroker, device->base.paint, points, count);
+        gb_device_stats_count_add(&device->base, strokes, 1);
+        gb_device_stats_clock_add(&device->base, stroke_time, clock);
+
+        // fill it
+        gb_gl_render_stroke_fill(device, stroked_path);
+    }
 }
 tb_void_t gb_gl_render_draw_points(gb_gl_device_ref_t device, gb_point_ref_t points, tb_size_t count, gb_rect_ref_t bounds)
 {
@@ -478,61 +914,28 @@ tb_void_t gb_gl_render_draw_points(gb_gl_device_ref_t device, gb_point_ref_t poi
     // check width
     tb_check_return((gb_paint_stroke_width(device->base.paint) > 0));
 
-    // enter paint
-    gb_gl_render_enter_paint(device);
-
     // only stroke?
-    if (gb_gl_render_stroke_only(device)) gb_gl_render_stroke_points(device, points, count);
-    // fill the stroked points
-    else gb_gl_render_stroke_fill(device, gb_stroker_done_points(device->stroker, device->base.paint, points, count));
-
-    // leave paint
-    gb_gl_render_leave_paint(device);
-}
-tb_void_t gb_gl_render_draw_polygon(gb_gl_device_ref_t device, gb_polygon_ref_t polygon, gb_shape_ref_t hint, gb_rect_ref_t bounds)
-{
-    // check
-    tb_assert(device && device->base.paint && polygon && polygon->points && polygon->counts);
-
-    // line?
-    if (hint && hint->type == GB_SHAPE_TYPE_LINE)
-    {
-        gb_point_t points[2];
-        points[0] = hint->u.line.p0;
-        points[1] = hint->u.line.p1;
-        gb_gl_render_draw_lines(device, points, 2, bounds);
-        return ;
-    }
-    // point?
-    else if (hint && hint->type == GB_SHAPE_TYPE_POINT)
+    if (gb_gl_render_stroke_only(device)) 
     {
-        gb_gl_render_draw_points(device, &hint->u.point, 1, bounds);
-        return ;
+        gb_gl_render_enter_paint(device);
+        gb_gl_render_stroke_points(device, points, count);
+        gb_gl_render_leave_paint(device);
     }
-
-    // enter paint
-    gb_gl_render_enter_paint(device);
-
-    // the mode
-    tb_size_t mode = gb_paint_mode(device->base.paint);
-
-    // fill it
-    if (mode & GB_PAINT_MODE_FILL)
+    // fill the stroked points
+    else
     {
-        // fill polygon
-        gb_gl_render_fill_polygon(device, polygon, bounds, gb_paint_fill_rule(device->base.paint));
+        // stroke it
+        tb_hong_t       clock = gb_device_stats_clock(&device->base);
+        gb_path_ref_t   stroked_path = gb_stroker_done_points(device->stroker, device->base.paint, points, count);
+        gb_device_stats_count_add(&device->base, strokes, 1);
+        gb_device_stats_clock_add(&device->base, stroke_time, clock);
+
+        // fill it
+        gb_gl_render_stroke_fill(device, stroked_path);
     }
-
-    // stroke it
-    if ((mode & GB_PAINT_MODE_STROKE) && (gb_paint_stroke_width(device->base.paint) > 0))
-    {
-        // only stroke?
-        if (gb_gl_render_stroke_only(device)) gb_gl_render_stroke_polygon(device, polygon->points, polygon->counts);
-        // fill the stroked polygon
-        else gb_gl_render_stroke_fill(device, gb_stroker_done_polygon(device->stroker, device->base.paint, polygon, hint));
-    }
-
-    // leave paint
-    gb_gl_render_leave_paint(device);
 }
-
+tb_void_t gb_gl_render_draw_polygon(gb_gl_device_ref_t device, gb_polygon_ref_t polygon, gb_shape_ref_t hint, gb_rect_ref_t bounds)
+{
+    // draw it without the tessellation cache
+    gb_gl_render_draw_polygon_done(device, polygon, hint, bounds, 0);
+}
@@ -34,19 +34,380 @@
  * includes
  */
 #include "shader.h"
+#include "../../bitmap.h"
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+/* the texel count of the gradient lut
+ *
+ * @note it need be same as the lut size of the linear and radial programs
+ */
+#define GB_GL_SHADER_GRADIENT_LUTN      (256)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the gl shader type
+typedef struct __gb_gl_shader_t
+{
+    // the base
+    gb_shader_impl_t            base;
+
+    // the gl version of the device
+    tb_size_t                   version;
+
+    // the texture of the gradient lut
+    gb_GLuint_t                 texture;
+
+    // the geometry matrix which maps the shader space to the texcoords
+    gb_gl_matrix_t              geometry;
+
+    // all colors are opaque?
+    tb_bool_t                   opaque;
+
+    /* the bitmap for the bitmap shader
+     *
+     * its pixels are uploaded and cached by the texture cache of the device
+     */
+    gb_bitmap_ref_t             bitmap;
+
+}gb_gl_shader_t, *gb_gl_shader_ref_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static tb_void_t gb_gl_shader_exit(gb_shader_impl_t* shader)
+{
+    // check
+    gb_gl_shader_ref_t impl = (gb_gl_shader_ref_t)shader;
+    tb_assert_and_check_return(impl);
+
+    // exit texture
+    if (impl->texture) gb_glDeleteTextures(1, &impl->texture);
+    impl->texture = 0;
+
+    // exit bitmap
+    if (impl->bitmap) gb_bitmap_exit(impl->bitmap);
+    impl->bitmap = tb_null;
+
+    // exit it
+    tb_free(impl);
+}
+static gb_gl_shader_ref_t gb_gl_shader_init(gb_gl_device_ref_t device, tb_size_t type, tb_size_t mode)
+{
+    // check
+    tb_assert_and_check_return_val(device && mode > GB_SHADER_MODE_NONE && mode <= GB_SHADER_MODE_MIRROR, tb_null);
+
+    // done
+    tb_bool_t           ok = tb_false;
+    gb_gl_shader_ref_t  impl = tb_null;
+    do
+    {
+        // make shader
+        impl = tb_malloc0_type(gb_gl_shader_t);
+        tb_assert_and_check_break(impl);
+
+        // init base
+        impl->base.type     = (tb_uint8_t)type;
+        impl->base.mode     = (tb_uint8_t)mode;
+        impl->base.refn     = 1;
+        impl->base.exit     = gb_gl_shader_exit;
+        gb_matrix_clear(&impl->base.matrix);
+
+        // init version
+        impl->version       = device->version;
+
+        // the bitmap pixels are uploaded to the texture cache of the device
+        if (type != GB_SHADER_TYPE_BITMAP)
+        {
+            // init texture
+            gb_glGenTextures(1, &impl->texture);
+            tb_assert_and_check_break(impl->texture);
+
+            // bind texture
+            gb_glBindTexture(GB_GL_TEXTURE_2D, impl->texture);
+
+            // init filter
+            gb_glTexParameteri(GB_GL_TEXTURE_2D, GB_GL_TEXTURE_MIN_FILTER, GB_GL_LINEAR);
+            gb_glTexParameteri(GB_GL_TEXTURE_2D, GB_GL_TEXTURE_MAG_FILTER, GB_GL_LINEAR);
+
+            /* init wrap
+             *
+             * the texcoords are wrapped in the fragment shader for gl >= 2.0,
+             * so we need only clamp it
+             *
+             * the gl 1.x wraps them by the texture, but the border mode is not supported
+             */
+            gb_GLint_t wrap = GB_GL_CLAMP_TO_EDGE;
+            if (impl->version < 0x20)
+            {
+                if (mode == GB_SHADER_MODE_REPEAT) wrap = GB_GL_REPEAT;
+                else if (mode == GB_SHADER_MODE_MIRROR) wrap = GB_GL_MIRRORED_REPEAT;
+            }
+            gb_glTexParameteri(GB_GL_TEXTURE_2D, GB_GL_TEXTURE_WRAP_S, wrap);
+            gb_glTexParameteri(GB_GL_TEXTURE_2D, GB_GL_TEXTURE_WRAP_T, wrap);
+        }
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // failed?
+    if (!ok)
+    {
+        // exit it
+        if (impl) gb_gl_shader_exit((gb_shader_impl_t*)impl);
+        impl = tb_null;
+    }
+
+    // ok?
+    return impl;
+}
+static __tb_inline__ tb_float_t gb_gl_shader_gradient_radio(gb_gradient_ref_t gradient, tb_size_t index)
+{
+    // the colors are distributed evenly if no radios
+    if (gradient->radios) return gb_float_to_tb(gradient->radios[index]);
+    return gradient->count > 1? (tb_float_t)index / (gradient->count - 1) : 0.0f;
+}
+static tb_bool_t gb_gl_shader_init_gradient(gb_gl_shader_ref_t impl, gb_gradient_ref_t gradient)
+{
+    // check
+    tb_assert_and_check_return_val(impl && impl->texture && gradient && gradient->colors && gradient->count, tb_false);
+
+    // the colors
+    gb_color_t const*   colors = gradient->colors;
+    tb_size_t           count = gradient->count;
+
+    // make the lut of the gradient colors, only once for this gradient
+    tb_byte_t   lut[GB_GL_SHADER_GRADIENT_LUTN << 2];
+    tb_size_t   i = 0;
+    tb_size_t   j = 0;
+    tb_bool_t   opaque = tb_true;
+    for (i = 0; i < GB_GL_SHADER_GRADIENT_LUTN; i++)
+    {
+        // the position of this texel
+        tb_float_t t = (tb_float_t)i / (GB_GL_SHADER_GRADIENT_LUTN - 1);
+
+        // find the segment: [j, j + 1]
+        while (j + 1 < count && gb_gl_shader_gradient_radio(gradient, j + 1) <= t) j++;
+
+        // the segment colors
+        gb_color_t c0 = colors[j];
+        gb_color_t c1 = colors[j + 1 < count? j + 1 : j];
+
+        // the factor in this segment
+        tb_float_t t0 = gb_gl_shader_gradient_radio(gradient, j);
+        tb_float_t t1 = j + 1 < count? gb_gl_shader_gradient_radio(gradient, j + 1) : t0;
+        tb_float_t f = t1 > t0? (t - t0) / (t1 - t0) : 0.0f;
+        if (f < 0.0f) f = 0.0f;
+        if (f > 1.0f) f = 1.0f;
+
+        // make the texel
+        tb_byte_t* p = lut + (i << 2);
+        p[0] = (tb_byte_t)(c0.r + (c1.r - c0.r) * f + 0.5f);
+        p[1] = (tb_byte_t)(c0.g + (c1.g - c0.g) * f + 0.5f);
+        p[2] = (tb_byte_t)(c0.b + (c1.b - c0.b) * f + 0.5f);
+        p[3] = (tb_byte_t)(c0.a + (c1.a - c0.a) * f + 0.5f);
+        if (p[3] != 0xff) opaque = tb_false;
+    }
+
+    // upload the lut
+    gb_glBindTexture(GB_GL_TEXTURE_2D, impl->texture);
+    gb_glTexImage2D(GB_GL_TEXTURE_2D, 0, GB_GL_RGBA, GB_GL_SHADER_GRADIENT_LUTN, 1, 0, GB_GL_RGBA, GB_GL_UNSIGNED_BYTE, lut);
+
+    // the border mode will clear the outside of the gradient
+    impl->opaque = opaque && impl->base.mode != GB_SHADER_MODE_BORDER;
+
+    // ok
+    return tb_true;
+}
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
  */
 gb_shader_ref_t gb_gl_shader_init_linear(gb_gl_device_ref_t device, tb_size_t mode, gb_gradient_ref_t gradient, gb_line_ref_t line)
 {
-    return tb_null;
+    // check
+    tb_assert_and_check_return_val(device && gradient && line, tb_null);
+
+    // done
+    tb_bool_t           ok = tb_false;
+    gb_gl_shader_ref_t  impl = tb_null;
+    do
+    {
+        // the line vector
+        tb_float_t x0 = gb_float_to_tb(line->p0.x);
+        tb_float_t y0 = gb_float_to_tb(line->p0.y);
+        tb_float_t dx = gb_float_to_tb(line->p1.x) - x0;
+        tb_float_t dy = gb_float_to_tb(line->p1.y) - y0;
+        tb_float_t dd = dx * dx + dy * dy;
+        tb_assert_and_check_break(dd > 0.0f);
+
+        // init shader
+        impl = gb_gl_shader_init(device, GB_SHADER_TYPE_LINEAR, mode);
+        tb_assert_and_check_break(impl);
+
+        // init gradient
+        if (!gb_gl_shader_init_gradient(impl, gradient)) break;
+
+        /* init geometry, project the point to the line 
+         *
+         * x' = ((x - x0) * dx + (y - y0) * dy) / (dx * dx + dy * dy)
+         */
+        gb_gl_matrix_init(impl->geometry, dx / dd, dy / dd, 0.0f, 0.0f, -(x0 * dx + y0 * dy) / dd, 0.0f);
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // failed?
+    if (!ok)
+    {
+        // exit it
+        if (impl) gb_gl_shader_exit((gb_shader_impl_t*)impl);
+        impl = tb_null;
+    }
+
+    // ok?
+    return (gb_shader_ref_t)impl;
 }
 gb_shader_ref_t gb_gl_shader_init_radial(gb_gl_device_ref_t device, tb_size_t mode, gb_gradient_ref_t gradient, gb_circle_ref_t circle)
 {
-    return tb_null;
+    // check
+    tb_assert_and_check_return_val(device && gradient && circle, tb_null);
+
+    // done
+    tb_bool_t           ok = tb_false;
+    gb_gl_shader_ref_t  impl = tb_null;
+    do
+    {
+        // the circle
+        tb_float_t x0 = gb_float_to_tb(circle->c.x);
+        tb_float_t y0 = gb_float_to_tb(circle->c.y);
+        tb_float_t r = gb_float_to_tb(circle->r);
+        tb_assert_and_check_break(r > 0.0f);
+
+        // init shader
+        impl = gb_gl_shader_init(device, GB_SHADER_TYPE_RADIAL, mode);
+        tb_assert_and_check_break(impl);
+
+        // init gradient
+        if (!gb_gl_shader_init_gradient(impl, gradient)) break;
+
+        /* init geometry, map the circle to the unit circle
+         *
+         * x' = (x - x0) / r
+         * y' = (y - y0) / r
+         */
+        gb_gl_matrix_init(impl->geometry, 1.0f / r, 0.0f, 0.0f, 1.0f / r, -x0 / r, -y0 / r);
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // failed?
+    if (!ok)
+    {
+        // exit it
+        if (impl) gb_gl_shader_exit((gb_shader_impl_t*)impl);
+        impl = tb_null;
+    }
+
+    // ok?
+    return (gb_shader_ref_t)impl;
 }
 gb_shader_ref_t gb_gl_shader_init_bitmap(gb_gl_device_ref_t device, tb_size_t mode, gb_bitmap_ref_t bitmap)
 {
-    return tb_null;
+    // check
+    tb_assert_and_check_return_val(device && bitmap, tb_null);
+
+    // done
+    tb_bool_t           ok = tb_false;
+    gb_gl_shader_ref_t  impl = tb_null;
+    do
+    {
+        // init shader
+        impl = gb_gl_shader_init(device, GB_SHADER_TYPE_BITMAP, mode);
+        tb_assert_and_check_break(impl);
+
+        // retain the bitmap, it will be uploaded to the texture cache when drawing
+        impl->bitmap = gb_bitmap_retain(bitmap);
+        tb_assert_and_check_break(impl->bitmap);
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // failed?
+    if (!ok)
+    {
+        // exit it
+        if (impl) gb_gl_shader_exit((gb_shader_impl_t*)impl);
+        impl = tb_null;
+    }
+
+    // ok?
+    return (gb_shader_ref_t)impl;
+}
+tb_bool_t gb_gl_shader_bind(gb_shader_ref_t shader)
+{
+    // check
+    gb_gl_shader_ref_t impl = (gb_gl_shader_ref_t)shader;
+    tb_assert_and_check_return_val(impl && impl->texture, tb_false);
+
+    // bind texture
+    gb_glBindTexture(GB_GL_TEXTURE_2D, impl->texture);
+
+    // ok
+    return tb_true;
+}
+gb_bitmap_ref_t gb_gl_shader_bitmap(gb_shader_ref_t shader)
+{
+    // check
+    gb_gl_shader_ref_t impl = (gb_gl_shader_ref_t)shader;
+    tb_assert_and_check_return_val(impl, tb_null);
+
+    // the bitmap
+    return impl->bitmap;
+}
+tb_bool_t gb_gl_shader_opaque(gb_shader_ref_t shader)
+{
+    // check
+    gb_gl_shader_ref_t impl = (gb_gl_shader_ref_t)shader;
+    tb_assert_and_check_return_val(impl, tb_false);
+
+    // the border mode will clear the outside of the bitmap
+    if (impl->bitmap) return !gb_bitmap_has_alpha(impl->bitmap) && impl->base.mode != GB_SHADER_MODE_BORDER;
+
+    // opaque?
+    return impl->opaque;
+}
+tb_void_t gb_gl_shader_matrix(gb_shader_ref_t shader, gb_gl_matrix_ref_t matrix)
+{
+    // check
+    gb_gl_shader_ref_t impl = (gb_gl_shader_ref_t)shader;
+    tb_assert_and_check_return(impl && matrix);
+
+    // the geometry matrix, the bitmap texcoords are normalized by its current size
+    if (impl->bitmap) gb_gl_matrix_init_scale(matrix, 1.0f / gb_bitmap_width(impl->bitmap), 1.0f / gb_bitmap_height(impl->bitmap));
+    else tb_memcpy(matrix, impl->geometry, sizeof(gb_gl_matrix_t));
+
+    /* the shader matrix maps the shader space to the user space,
+     * so the user space need be mapped back by the inverted matrix first
+     *
+     * texcoord = geometry * invert(shader_matrix) * vertex
+     */
+    gb_matrix_t invert = impl->base.matrix;
+    if (gb_matrix_invert(&invert))
+    {
+        gb_gl_matrix_t factor;
+        gb_gl_matrix_convert(factor, &invert);
+        gb_gl_matrix_multiply(matrix, factor);
+    }
 }
@@ -76,6 +76,45 @@ gb_shader_ref_t     gb_gl_shader_init_radial(gb_gl_device_ref_t device, tb_size_
  */
 gb_shader_ref_t     gb_gl_shader_init_bitmap(gb_gl_device_ref_t device, tb_size_t mode, gb_bitmap_ref_t bitmap);
 
+/*! bind the gradient lut texture of the gl shader to the current gl context
+ *
+ * @param shader    the shader
+ *
+ * @return          tb_true or tb_false
+ */
+tb_bool_t           gb_gl_shader_bind(gb_shader_ref_t shader);
+
+/*! the bitmap of the gl shader
+ *
+ * it need be loaded from the texture cache of the device instead of binding the shader
+ *
+ * @param shader    the shader
+ *
+ * @return          the bitmap, null if it is not the bitmap shader
+ */
+gb_bitmap_ref_t     gb_gl_shader_bitmap(gb_shader_ref_t shader);
+
+/*! the gl shader is opaque?
+ *
+ * @param shader    the shader
+ *
+ * @return          tb_true if all colors of the shader are opaque and the blend can be disabled
+ */
+tb_bool_t           gb_gl_shader_opaque(gb_shader_ref_t shader);
+
+/*! the texcoord matrix of the gl shader
+ *
+ * it maps the vertices of the user space to the texcoords:
+ *
+ * - linear: x is the gradient position
+ * - radial: the length of (x, y) is the gradient position
+ * - bitmap: (x, y) is the normalized texcoord
+ *
+ * @param shader    the shader
+ * @param matrix    the texcoord matrix
+ */
+tb_void_t           gb_gl_shader_matrix(gb_shader_ref_t shader, gb_gl_matrix_ref_t matrix);
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
  */
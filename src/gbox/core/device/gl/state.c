@@ -0,0 +1,279 @@
+/*!The Graphic Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        state.c
+ * @ingroup     core
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME            "gl_state"
+#define TB_TRACE_MODULE_DEBUG           (0)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "state.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the unknown value
+#define GB_GL_STATE_UNKNOWN             (0xff)
+
+// the unknown blend factor
+#define GB_GL_STATE_BLEND_UNKNOWN       ((gb_GLenum_t)-1)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static tb_long_t gb_gl_state_cap_index(gb_GLenum_t cap)
+{
+    // the cap index
+    switch (cap)
+    {
+    case GB_GL_TEXTURE_2D:          return 0;
+    case GB_GL_BLEND:               return 1;
+    case GB_GL_MULTISAMPLE:         return 2;
+    case GB_GL_STENCIL_TEST:        return 3;
+    default:                        return -1;
+    }
+}
+static tb_long_t gb_gl_state_client_index(gb_GLenum_t array)
+{
+    // the client index
+    switch (array)
+    {
+    case GB_GL_VERTEX_ARRAY:        return 0;
+    case GB_GL_COLOR_ARRAY:         return 1;
+    case GB_GL_TEXTURE_COORD_ARRAY: return 2;
+    default:                        return -1;
+    }
+}
+static tb_long_t gb_gl_state_buffer_index(gb_GLenum_t target)
+{
+    // the buffer index
+    switch (target)
+    {
+    case GB_GL_ARRAY_BUFFER:        return 0;
+    case GB_GL_ELEMENT_ARRAY_BUFFER:return 1;
+    default:                        return -1;
+    }
+}
+static tb_void_t gb_gl_state_cap_set(gb_gl_state_ref_t state, gb_GLenum_t cap, tb_bool_t enabled)
+{
+    // check
+    tb_assert(state);
+
+    // not changed?
+    tb_long_t index = gb_gl_state_cap_index(cap);
+    if (index >= 0 && state->caps[index] == (tb_uint8_t)enabled)
+    {
+        state->stats.skipped++;
+        return ;
+    }
+
+    // update it
+    if (enabled) gb_glEnable(cap);
+    else gb_glDisable(cap);
+    if (index >= 0) state->caps[index] = (tb_uint8_t)enabled;
+    state->stats.issued++;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_void_t gb_gl_state_reset(gb_gl_state_ref_t state)
+{
+    // check
+    tb_assert_and_check_return(state);
+
+    // reset caps and client states
+    tb_memset(state->caps, GB_GL_STATE_UNKNOWN, sizeof(state->caps));
+    tb_memset(state->clients, GB_GL_STATE_UNKNOWN, sizeof(state->clients));
+
+    // reset vertex attribute arrays
+    state->attribs          = 0;
+    state->attribs_known    = 0;
+
+    // reset blend function
+    state->blend_src        = GB_GL_STATE_BLEND_UNKNOWN;
+    state->blend_dst        = GB_GL_STATE_BLEND_UNKNOWN;
+
+    // reset program
+    state->program          = tb_null;
+
+    // reset buffers and uniform matrices
+    tb_memset(state->buffers_known, 0, sizeof(state->buffers_known));
+    tb_memset(state->matrices_known, 0, sizeof(state->matrices_known));
+}
+tb_void_t gb_gl_state_enable(gb_gl_state_ref_t state, gb_GLenum_t cap)
+{
+    gb_gl_state_cap_set(state, cap, tb_true);
+}
+tb_void_t gb_gl_state_disable(gb_gl_state_ref_t state, gb_GLenum_t cap)
+{
+    gb_gl_state_cap_set(state, cap, tb_false);
+}
+tb_void_t gb_gl_state_client(gb_gl_state_ref_t state, gb_GLenum_t array, tb_bool_t enabled)
+{
+    // check
+    tb_assert(state);
+
+    // not changed?
+    tb_long_t index = gb_gl_state_client_index(array);
+    if (index >= 0 && state->clients[index] == (tb_uint8_t)enabled)
+    {
+        state->stats.skipped++;
+        return ;
+    }
+
+    // update it
+    if (enabled) gb_glEnableClientState(array);
+    else gb_glDisableClientState(array);
+    if (index >= 0) state->clients[index] = (tb_uint8_t)enabled;
+    state->stats.issued++;
+}
+tb_void_t gb_gl_state_attrib(gb_gl_state_ref_t state, gb_GLint_t location, tb_bool_t enabled)
+{
+    // check
+    tb_assert(state);
+
+    // the attribute is not used by this program?
+    tb_check_return(location >= 0);
+
+    // not changed?
+    tb_uint32_t mask = location < GB_GL_STATE_ATTRIBS_MAXN? ((tb_uint32_t)1 << location) : 0;
+    if ((state->attribs_known & mask) && ((state->attribs & mask)? tb_true : tb_false) == enabled)
+    {
+        state->stats.skipped++;
+        return ;
+    }
+
+    // update it
+    if (enabled)
+    {
+        gb_glEnableVertexAttribArray((gb_GLuint_t)location);
+        state->attribs |= mask;
+    }
+    else
+    {
+        gb_glDisableVertexAttribArray((gb_GLuint_t)location);
+        state->attribs &= ~mask;
+    }
+    state->attribs_known |= mask;
+    state->stats.issued++;
+}
+tb_void_t gb_gl_state_blend_func(gb_gl_state_ref_t state, gb_GLenum_t sfactor, gb_GLenum_t dfactor)
+{
+    // check
+    tb_assert(state);
+
+    // not changed?
+    if (state->blend_src == sfactor && state->blend_dst == dfactor)
+    {
+        state->stats.skipped++;
+        return ;
+    }
+
+    // update it
+    gb_glBlendFunc(sfactor, dfactor);
+    state->blend_src = sfactor;
+    state->blend_dst = dfactor;
+    state->stats.issued++;
+}
+tb_void_t gb_gl_state_program(gb_gl_state_ref_t state, gb_gl_program_ref_t program)
+{
+    // check
+    tb_assert(state && program);
+
+    // not changed?
+    if (state->program == program)
+    {
+        state->stats.skipped++;
+        return ;
+    }
+
+    // update it
+    gb_gl_program_bind(program);
+    state->program = program;
+    state->stats.issued++;
+}
+tb_void_t gb_gl_state_buffer(gb_gl_state_ref_t state, gb_GLenum_t target, gb_GLuint_t buffer)
+{
+    // check
+    tb_assert(state);
+
+    // not changed?
+    tb_long_t index = gb_gl_state_buffer_index(target);
+    if (index >= 0 && state->buffers_known[index] && state->buffers[index] == buffer)
+    {
+        state->stats.skipped++;
+        return ;
+    }
+
+    // update it
+    gb_glBindBuffer(target, buffer);
+    if (index >= 0)
+    {
+        state->buffers[index]       = buffer;
+        state->buffers_known[index] = 1;
+    }
+    state->stats.issued++;
+}
+tb_void_t gb_gl_state_matrix(gb_gl_state_ref_t state, tb_size_t id, gb_GLfloat_t const* matrix)
+{
+    // check
+    tb_assert(state && state->program && matrix);
+    tb_assert(id >= GB_GL_PROGRAM_LOCATION_MATRIX_MODEL && id < GB_GL_PROGRAM_LOCATION_MATRIX_MODEL + GB_GL_STATE_MATRICES_MAXN);
+
+    /* the uniform values are stored in the program object,
+     * so we cache them for each program type
+     */
+    tb_size_t       type = gb_gl_program_type(state->program);
+    tb_size_t       index = id - GB_GL_PROGRAM_LOCATION_MATRIX_MODEL;
+    tb_uint8_t      mask = (tb_uint8_t)(1 << index);
+    tb_assert(type < GB_GL_PROGRAM_TYPE_MAXN);
+
+    // not changed?
+    gb_GLfloat_t* cache = state->matrices[type][index];
+    if ((state->matrices_known[type] & mask) && !tb_memcmp(cache, matrix, sizeof(gb_gl_matrix_t)))
+    {
+        state->stats.skipped++;
+        return ;
+    }
+
+    // update it
+    gb_glUniformMatrix4fv(gb_gl_program_location(state->program, id), 1, GB_GL_FALSE, matrix);
+    tb_memcpy(cache, matrix, sizeof(gb_gl_matrix_t));
+    state->matrices_known[type] |= mask;
+    state->stats.issued++;
+}
+tb_void_t gb_gl_state_stats(gb_gl_state_ref_t state, gb_gl_state_stats_ref_t stats)
+{
+    // check
+    tb_assert_and_check_return(state && stats);
+
+    // get stats
+    *stats = state->stats;
+}
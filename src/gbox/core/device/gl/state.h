@@ -0,0 +1,206 @@
+/*!The Graphic Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        state.h
+ * @ingroup     core
+ *
+ */
+#ifndef GB_CORE_DEVICE_GL_STATE_H
+#define GB_CORE_DEVICE_GL_STATE_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+#include "matrix.h"
+#include "program.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the shadowed caps count: texture_2d, blend, multisample, stencil_test
+#define GB_GL_STATE_CAPS_MAXN           (4)
+
+// the shadowed client states count for gl 1.x: vertex, color, texcoord
+#define GB_GL_STATE_CLIENTS_MAXN        (3)
+
+// the shadowed vertex attribute arrays count for gl >= 2.0
+#define GB_GL_STATE_ATTRIBS_MAXN        (32)
+
+// the shadowed buffer targets count: array, element array
+#define GB_GL_STATE_BUFFERS_MAXN        (2)
+
+// the shadowed uniform matrices count for each program: model, project, texcoord
+#define GB_GL_STATE_MATRICES_MAXN       (3)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the gl state stats type
+typedef struct __gb_gl_state_stats_t
+{
+    // the issued gl call count
+    tb_size_t               issued;
+
+    // the skipped gl call count which is redundant
+    tb_size_t               skipped;
+
+}gb_gl_state_stats_t, *gb_gl_state_stats_ref_t;
+
+/* the gl shadow state type
+ *
+ * it mirrors the gl context state which is changed by the device,
+ * and filters the redundant gl calls if the state has not been changed.
+ *
+ * all values are unknown after resetting it, so the next calls will be issued always.
+ */
+typedef struct __gb_gl_state_t
+{
+    // the caps, 0: disabled, 1: enabled, 0xff: unknown
+    tb_uint8_t              caps[GB_GL_STATE_CAPS_MAXN];
+
+    // the client states for gl 1.x, 0: disabled, 1: enabled, 0xff: unknown
+    tb_uint8_t              clients[GB_GL_STATE_CLIENTS_MAXN];
+
+    // the enabled vertex attribute arrays for gl >= 2.0
+    tb_uint32_t             attribs;
+
+    // the known vertex attribute arrays for gl >= 2.0
+    tb_uint32_t             attribs_known;
+
+    // the blend source factor
+    gb_GLenum_t             blend_src;
+
+    // the blend destination factor
+    gb_GLenum_t             blend_dst;
+
+    // the bound program for gl >= 2.0
+    gb_gl_program_ref_t     program;
+
+    // the bound buffers for gl >= 2.0
+    gb_GLuint_t             buffers[GB_GL_STATE_BUFFERS_MAXN];
+
+    // the known buffers
+    tb_uint8_t              buffers_known[GB_GL_STATE_BUFFERS_MAXN];
+
+    // the uploaded uniform matrices of each program type
+    gb_gl_matrix_t          matrices[GB_GL_PROGRAM_TYPE_MAXN][GB_GL_STATE_MATRICES_MAXN];
+
+    // the known uniform matrices of each program type
+    tb_uint8_t              matrices_known[GB_GL_PROGRAM_TYPE_MAXN];
+
+    // the stats
+    gb_gl_state_stats_t     stats;
+
+}gb_gl_state_t, *gb_gl_state_ref_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interface
+ */
+
+/* reset the shadow state to unknown
+ *
+ * it need be called if the gl context state has been changed by others
+ *
+ * @param state         the state
+ */
+tb_void_t               gb_gl_state_reset(gb_gl_state_ref_t state);
+
+/* enable the cap
+ *
+ * @param state         the state
+ * @param cap           the cap, e.g. GB_GL_BLEND, the other uncached caps will be passed through
+ */
+tb_void_t               gb_gl_state_enable(gb_gl_state_ref_t state, gb_GLenum_t cap);
+
+/* disable the cap
+ *
+ * @param state         the state
+ * @param cap           the cap
+ */
+tb_void_t               gb_gl_state_disable(gb_gl_state_ref_t state, gb_GLenum_t cap);
+
+/* enable or disable the client state for gl 1.x
+ *
+ * @param state         the state
+ * @param array         the client array, e.g. GB_GL_VERTEX_ARRAY
+ * @param enabled       enable it?
+ */
+tb_void_t               gb_gl_state_client(gb_gl_state_ref_t state, gb_GLenum_t array, tb_bool_t enabled);
+
+/* enable or disable the vertex attribute array for gl >= 2.0
+ *
+ * @param state         the state
+ * @param location      the attribute location
+ * @param enabled       enable it?
+ */
+tb_void_t               gb_gl_state_attrib(gb_gl_state_ref_t state, gb_GLint_t location, tb_bool_t enabled);
+
+/* set the blend function
+ *
+ * @param state         the state
+ * @param sfactor       the source factor
+ * @param dfactor       the destination factor
+ */
+tb_void_t               gb_gl_state_blend_func(gb_gl_state_ref_t state, gb_GLenum_t sfactor, gb_GLenum_t dfactor);
+
+/* bind the program for gl >= 2.0
+ *
+ * @param state         the state
+ * @param program       the program
+ */
+tb_void_t               gb_gl_state_program(gb_gl_state_ref_t state, gb_gl_program_ref_t program);
+
+/* bind the buffer for gl >= 2.0
+ *
+ * @param state         the state
+ * @param target        the target, e.g. GB_GL_ARRAY_BUFFER
+ * @param buffer        the buffer, unbind it if be zero
+ */
+tb_void_t               gb_gl_state_buffer(gb_gl_state_ref_t state, gb_GLenum_t target, gb_GLuint_t buffer);
+
+/* upload the uniform matrix of the bound program for gl >= 2.0
+ *
+ * @param state         the state
+ * @param id            the location id, e.g. GB_GL_PROGRAM_LOCATION_MATRIX_MODEL
+ * @param matrix        the matrix
+ */
+tb_void_t               gb_gl_state_matrix(gb_gl_state_ref_t state, tb_size_t id, gb_GLfloat_t const* matrix);
+
+/* the state stats
+ *
+ * @param state         the state
+ * @param stats         the stats
+ */
+tb_void_t               gb_gl_state_stats(gb_gl_state_ref_t state, gb_gl_state_stats_ref_t stats);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+#endif
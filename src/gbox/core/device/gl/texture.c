@@ -0,0 +1,761 @@
+/*!The Graphic Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        texture.c
+ * @ingroup     core
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME            "gl_texture"
+#define TB_TRACE_MODULE_DEBUG           (0)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "texture.h"
+#include "../../bitmap.h"
+#include "../../pixmap.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the pixel format of the uploaded texture: r, g, b, a bytes
+#define GB_GL_TEXTURE_PIXFMT                (GB_PIXFMT_RGBA8888 | GB_PIXFMT_BENDIAN)
+
+// the atlas page size
+#ifdef __gb_small__
+#   define GB_GL_TEXTURE_PAGE_SIZE          (512)
+#else
+#   define GB_GL_TEXTURE_PAGE_SIZE          (1024)
+#endif
+
+// the maximum atlas page count
+#define GB_GL_TEXTURE_PAGE_MAXN             (16)
+
+// the vram bytes of the atlas page
+#define GB_GL_TEXTURE_PAGE_BYTES            (GB_GL_TEXTURE_PAGE_SIZE * GB_GL_TEXTURE_PAGE_SIZE << 2)
+
+// the maximum width and height of the bitmap in the atlas page
+#define GB_GL_TEXTURE_ATLAS_MAXN            (GB_GL_TEXTURE_PAGE_SIZE >> 2)
+
+// the maximum segment count of the skyline
+#define GB_GL_TEXTURE_SKYLINE_MAXN          (256)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the gl texture skyline segment type
+typedef struct __gb_gl_texture_segment_t
+{
+    // the left
+    tb_uint16_t                 x;
+
+    // the top of the free space
+    tb_uint16_t                 y;
+
+    // the width
+    tb_uint16_t                 w;
+
+}gb_gl_texture_segment_t;
+
+// the gl texture atlas page type
+typedef struct __gb_gl_texture_page_t
+{
+    // the texture, 0: unused page
+    gb_GLuint_t                 texture;
+
+    // the texture filter
+    gb_GLint_t                  filter;
+
+    // the packed bitmap count
+    tb_size_t                   count;
+
+    // the skyline segment count
+    tb_size_t                   segments_count;
+
+    /* the skyline segments, sorted by x and covering the whole page width
+     *
+     * the space freed by the evicted bitmaps is not reused until the page is empty
+     */
+    gb_gl_texture_segment_t     segments[GB_GL_TEXTURE_SKYLINE_MAXN];
+
+}gb_gl_texture_page_t, *gb_gl_texture_page_ref_t;
+
+// the gl texture entry type
+typedef struct __gb_gl_texture_entry_t
+{
+    // the list entry
+    tb_list_entry_t             entry;
+
+    // the bitmap, it is only used as the key and may be freed
+    gb_bitmap_ref_t             bitmap;
+
+    // the uploaded content version
+    tb_size_t                   version;
+
+    // the uploaded width
+    tb_uint16_t                 width;
+
+    // the uploaded height
+    tb_uint16_t                 height;
+
+    // the left in the atlas page
+    tb_uint16_t                 x;
+
+    // the top in the atlas page
+    tb_uint16_t                 y;
+
+    // the atlas page, -1: the dedicated texture
+    tb_long_t                   page;
+
+    // the dedicated texture
+    gb_GLuint_t                 texture;
+
+    // the filter of the dedicated texture
+    gb_GLint_t                  filter;
+
+    // the wrap of the dedicated texture
+    gb_GLint_t                  wrap;
+
+}gb_gl_texture_entry_t, *gb_gl_texture_entry_ref_t;
+
+// the gl texture cache impl type
+typedef struct __gb_gl_texture_impl_t
+{
+    // the gl version
+    tb_size_t                   version;
+
+    // the entries, bitmap => entry
+    tb_hash_map_ref_t           entries;
+
+    // the lru list, the most recently used entry is at head
+    tb_list_entry_head_t        lru;
+
+    // the atlas pages
+    gb_gl_texture_page_t        pages[GB_GL_TEXTURE_PAGE_MAXN];
+
+    // the converted pixels
+    tb_byte_t*                  pixels;
+
+    // the converted pixels size
+    tb_size_t                   pixels_size;
+
+    // the stats
+    gb_gl_texture_stats_t       stats;
+
+}gb_gl_texture_impl_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static tb_void_t gb_gl_texture_entry_exit(tb_element_ref_t element, tb_pointer_t buff)
+{
+    // check
+    tb_assert_and_check_return(buff);
+
+    // exit it
+    tb_pointer_t entry = *((tb_pointer_t*)buff);
+    if (entry) tb_free(entry);
+}
+static tb_void_t gb_gl_texture_page_reset(gb_gl_texture_page_ref_t page)
+{
+    // check
+    tb_assert(page);
+
+    // reset the skyline to the whole page width
+    page->count                 = 0;
+    page->segments_count        = 1;
+    page->segments[0].x         = 0;
+    page->segments[0].y         = 0;
+    page->segments[0].w         = GB_GL_TEXTURE_PAGE_SIZE;
+}
+static tb_void_t gb_gl_texture_page_exit(gb_gl_texture_impl_t* impl, gb_gl_texture_page_ref_t page)
+{
+    // check
+    tb_assert(impl && page && page->texture);
+
+    // delete the texture
+    gb_glDeleteTextures(1, &page->texture);
+    page->texture = 0;
+
+    // update stats
+    impl->stats.pages--;
+    impl->stats.size -= GB_GL_TEXTURE_PAGE_BYTES;
+}
+static tb_long_t gb_gl_texture_page_init(gb_gl_texture_impl_t* impl)
+{
+    // check
+    tb_assert(impl);
+
+    // find an unused page
+    tb_long_t i = 0;
+    for (i = 0; i < GB_GL_TEXTURE_PAGE_MAXN && impl->pages[i].texture; i++) ;
+    tb_check_return_val(i < GB_GL_TEXTURE_PAGE_MAXN, -1);
+
+    // make texture
+    gb_gl_texture_page_ref_t page = &impl->pages[i];
+    gb_glGenTextures(1, &page->texture);
+    tb_assert_and_check_return_val(page->texture, -1);
+
+    // init texture, the texcoords are clamped and wrapped in the fragment shader
+    gb_glBindTexture(GB_GL_TEXTURE_2D, page->texture);
+    gb_glTexParameteri(GB_GL_TEXTURE_2D, GB_GL_TEXTURE_MIN_FILTER, GB_GL_LINEAR);
+    gb_glTexParameteri(GB_GL_TEXTURE_2D, GB_GL_TEXTURE_MAG_FILTER, GB_GL_LINEAR);
+    gb_glTexParameteri(GB_GL_TEXTURE_2D, GB_GL_TEXTURE_WRAP_S, GB_GL_CLAMP_TO_EDGE);
+    gb_glTexParameteri(GB_GL_TEXTURE_2D, GB_GL_TEXTURE_WRAP_T, GB_GL_CLAMP_TO_EDGE);
+    gb_glTexImage2D(GB_GL_TEXTURE_2D, 0, GB_GL_RGBA, GB_GL_TEXTURE_PAGE_SIZE, GB_GL_TEXTURE_PAGE_SIZE, 0, GB_GL_RGBA, GB_GL_UNSIGNED_BYTE, tb_null);
+    page->filter = GB_GL_LINEAR;
+
+    // init skyline
+    gb_gl_texture_page_reset(page);
+
+    // update stats
+    impl->stats.pages++;
+    impl->stats.size += GB_GL_TEXTURE_PAGE_BYTES;
+
+    // ok
+    return i;
+}
+static tb_long_t gb_gl_texture_page_fit(gb_gl_texture_page_ref_t page, tb_size_t index, tb_size_t width, tb_size_t height)
+{
+    // check
+    tb_assert(page && index < page->segments_count);
+
+    // out of the page width?
+    gb_gl_texture_segment_t const* segments = page->segments;
+    tb_check_return_val(segments[index].x + width <= GB_GL_TEXTURE_PAGE_SIZE, -1);
+
+    // the top is the highest segment under this bitmap
+    tb_size_t top = 0;
+    tb_size_t left = width;
+    while (left)
+    {
+        // the top
+        if (segments[index].y > top) top = segments[index].y;
+
+        // out of the page height?
+        tb_check_return_val(top + height <= GB_GL_TEXTURE_PAGE_SIZE, -1);
+
+        // the next segment
+        if (segments[index].w >= left) break;
+        left -= segments[index].w;
+        index++;
+    }
+
+    // ok
+    return (tb_long_t)top;
+}
+static tb_bool_t gb_gl_texture_page_alloc(gb_gl_texture_page_ref_t page, tb_size_t width, tb_size_t height, tb_uint16_t* x, tb_uint16_t* y)
+{
+    // check
+    tb_assert(page && page->texture && width && height && x && y);
+
+    // the skyline is full?
+    tb_check_return_val(page->segments_count < GB_GL_TEXTURE_SKYLINE_MAXN, tb_false);
+
+    // find the lowest position, and the narrowest segment if the same
+    tb_size_t   i = 0;
+    tb_long_t   best = -1;
+    tb_size_t   best_top = GB_GL_TEXTURE_PAGE_SIZE;
+    tb_size_t   best_width = GB_GL_TEXTURE_PAGE_SIZE + 1;
+    gb_gl_texture_segment_t* segments = page->segments;
+    for (i = 0; i < page->segments_count; i++)
+    {
+        tb_long_t top = gb_gl_texture_page_fit(page, i, width, height);
+        if (top >= 0 && ((tb_size_t)top < best_top || ((tb_size_t)top == best_top && segments[i].w < best_width)))
+        {
+            best        = (tb_long_t)i;
+            best_top    = (tb_size_t)top;
+            best_width  = segments[i].w;
+        }
+    }
+    tb_check_return_val(best >= 0, tb_false);
+
+    // save the position
+    *x = segments[best].x;
+    *y = (tb_uint16_t)best_top;
+
+    // insert the new segment on this bitmap
+    tb_memmov(segments + best + 1, segments + best, (page->segments_count - best) * sizeof(gb_gl_texture_segment_t));
+    segments[best].y = (tb_uint16_t)(best_top + height);
+    segments[best].w = (tb_uint16_t)width;
+    page->segments_count++;
+
+    // shrink or remove the next segments under this bitmap
+    tb_size_t right = segments[best].x + width;
+    i = best + 1;
+    while (i < page->segments_count && segments[i].x < right)
+    {
+        // shrink it
+        tb_size_t shrink = right - segments[i].x;
+        if (segments[i].w > shrink)
+        {
+            segments[i].x = (tb_uint16_t)right;
+            segments[i].w -= (tb_uint16_t)shrink;
+            break;
+        }
+
+        // remove it
+        tb_memmov(segments + i, segments + i + 1, (page->segments_count - i - 1) * sizeof(gb_gl_texture_segment_t));
+        page->segments_count--;
+    }
+
+    // merge the neighbouring segments with the same top
+    for (i = 0; i + 1 < page->segments_count; )
+    {
+        if (segments[i].y == segments[i + 1].y)
+        {
+            segments[i].w += segments[i + 1].w;
+            tb_memmov(segments + i + 1, segments + i + 2, (page->segments_count - i - 2) * sizeof(gb_gl_texture_segment_t));
+            page->segments_count--;
+        }
+        else i++;
+    }
+
+    // ok
+    page->count++;
+    return tb_true;
+}
+static tb_void_t gb_gl_texture_entry_free(gb_gl_texture_impl_t* impl, gb_gl_texture_entry_ref_t entry)
+{
+    // check
+    tb_assert(impl && entry);
+
+    // free the space of the atlas page
+    if (entry->page >= 0)
+    {
+        // exit the page if it is empty now
+        gb_gl_texture_page_ref_t page = &impl->pages[entry->page];
+        tb_assert(page->texture && page->count);
+        if (!--page->count) gb_gl_texture_page_exit(impl, page);
+    }
+    // exit the dedicated texture
+    else if (entry->texture)
+    {
+        gb_glDeleteTextures(1, &entry->texture);
+        impl->stats.size -= (entry->width * entry->height) << 2;
+    }
+
+    // remove it from the lru list
+    tb_list_entry_remove(&impl->lru, &entry->entry);
+
+    // update stats
+    impl->stats.count--;
+
+    // remove it from the entries and free it
+    tb_hash_map_remove(impl->entries, entry->bitmap);
+}
+static tb_bool_t gb_gl_texture_evict(gb_gl_texture_impl_t* impl)
+{
+    // no entries?
+    tb_check_return_val(tb_list_entry_size(&impl->lru), tb_false);
+
+    // the last entry
+    gb_gl_texture_entry_ref_t entry = (gb_gl_texture_entry_ref_t)tb_list_entry(&impl->lru, tb_list_entry_last(&impl->lru));
+    tb_assert_and_check_return_val(entry, tb_false);
+
+    // free it
+    gb_gl_texture_entry_free(impl, entry);
+
+    // update stats
+    impl->stats.evictions++;
+
+    // ok
+    return tb_true;
+}
+static tb_bool_t gb_gl_texture_alloc_atlas(gb_gl_texture_impl_t* impl, gb_gl_texture_entry_ref_t entry)
+{
+    // check
+    tb_assert(impl && entry);
+
+    // pack it into the atlas pages
+    tb_long_t index = -1;
+    do
+    {
+        // pack it into the existing pages
+        tb_size_t i = 0;
+        for (i = 0; i < GB_GL_TEXTURE_PAGE_MAXN; i++)
+        {
+            gb_gl_texture_page_ref_t page = &impl->pages[i];
+            if (page->texture && gb_gl_texture_page_alloc(page, entry->width, entry->height, &entry->x, &entry->y))
+            {
+                entry->page = (tb_long_t)i;
+                return tb_true;
+            }
+        }
+
+        // init a new page if the budget is enough
+        if (impl->stats.size + GB_GL_TEXTURE_PAGE_BYTES <= impl->stats.maxn && impl->stats.pages < GB_GL_TEXTURE_PAGE_MAXN)
+            index = gb_gl_texture_page_init(impl);
+
+    // evict the least recently used entry and try it again
+    } while (index < 0 && gb_gl_texture_evict(impl));
+    tb_check_return_val(index >= 0, tb_false);
+
+    // pack it into the new page
+    gb_gl_texture_page_ref_t page = &impl->pages[index];
+    if (!gb_gl_texture_page_alloc(page, entry->width, entry->height, &entry->x, &entry->y))
+    {
+        gb_gl_texture_page_exit(impl, page);
+        return tb_false;
+    }
+    entry->page = index;
+
+    // ok
+    return tb_true;
+}
+static tb_bool_t gb_gl_texture_alloc_dedicated(gb_gl_texture_impl_t* impl, gb_gl_texture_entry_ref_t entry)
+{
+    // check
+    tb_assert(impl && entry);
+
+    // evict the least recently used entries until the budget is enough
+    tb_size_t size = (entry->width * entry->height) << 2;
+    while (impl->stats.size + size > impl->stats.maxn && gb_gl_texture_evict(impl)) ;
+
+    // make texture
+    gb_glGenTextures(1, &entry->texture);
+    tb_assert_and_check_return_val(entry->texture, tb_false);
+
+    // init texture
+    gb_glBindTexture(GB_GL_TEXTURE_2D, entry->texture);
+    gb_glTexParameteri(GB_GL_TEXTURE_2D, GB_GL_TEXTURE_MIN_FILTER, GB_GL_LINEAR);
+    gb_glTexParameteri(GB_GL_TEXTURE_2D, GB_GL_TEXTURE_MAG_FILTER, GB_GL_LINEAR);
+    gb_glTexParameteri(GB_GL_TEXTURE_2D, GB_GL_TEXTURE_WRAP_S, GB_GL_CLAMP_TO_EDGE);
+    gb_glTexParameteri(GB_GL_TEXTURE_2D, GB_GL_TEXTURE_WRAP_T, GB_GL_CLAMP_TO_EDGE);
+    gb_glTexImage2D(GB_GL_TEXTURE_2D, 0, GB_GL_RGBA, entry->width, entry->height, 0, GB_GL_RGBA, GB_GL_UNSIGNED_BYTE, tb_null);
+    entry->filter   = GB_GL_LINEAR;
+    entry->wrap     = GB_GL_CLAMP_TO_EDGE;
+    entry->page     = -1;
+
+    // update stats
+    impl->stats.size += size;
+
+    // ok
+    return tb_true;
+}
+static tb_bool_t gb_gl_texture_upload(gb_gl_texture_impl_t* impl, gb_gl_texture_entry_ref_t entry, gb_bitmap_ref_t bitmap, tb_size_t y, tb_size_t h)
+{
+    // check
+    tb_assert(impl && entry && bitmap && y + h <= entry->height);
+
+    // the bitmap info
+    tb_byte_t const*    data        = (tb_byte_t const*)gb_bitmap_data(bitmap);
+    tb_size_t           pixfmt      = gb_bitmap_pixfmt(bitmap);
+    tb_size_t           width       = entry->width;
+    tb_long_t           row_stride  = gb_bitmap_row_stride(bitmap);
+    tb_assert_and_check_return_val(data && row_stride, tb_false);
+
+    // the first row, the row stride is negative for the bottom-up bitmap
+    data += (tb_long_t)y * row_stride;
+
+    // the pixels can be uploaded directly?
+    tb_byte_t const* upload = data;
+    if (pixfmt != GB_GL_TEXTURE_PIXFMT || row_stride != (tb_long_t)(width << 2))
+    {
+        // init converter
+        gb_pixmap_converter_t converter;
+        if (!gb_pixmap_converter_init(&converter, GB_GL_TEXTURE_PIXFMT, pixfmt))
+        {
+            tb_trace_e("the bitmap pixfmt: %lx is not supported!", pixfmt);
+            return tb_false;
+        }
+
+        // grow pixels
+        tb_size_t size = width * h << 2;
+        if (size > impl->pixels_size)
+        {
+            impl->pixels = (tb_byte_t*)tb_ralloc(impl->pixels, size);
+            tb_assert_and_check_return_val(impl->pixels, tb_false);
+            impl->pixels_size = size;
+        }
+
+        // convert the rows
+        tb_size_t           i = 0;
+        tb_byte_t*          dst = impl->pixels;
+        tb_byte_t const*    src = data;
+        for (i = 0; i < h; i++)
+        {
+            gb_pixmap_converter_done(&converter, dst, src, width);
+            dst += width << 2;
+            src += row_stride;
+        }
+        upload = impl->pixels;
+    }
+
+    // upload the rows to the atlas page or the dedicated texture
+    gb_GLint_t x0 = entry->page >= 0? entry->x : 0;
+    gb_GLint_t y0 = entry->page >= 0? entry->y : 0;
+    gb_glTexSubImage2D(GB_GL_TEXTURE_2D, 0, x0, y0 + (gb_GLint_t)y, (gb_GLsizei_t)width, (gb_GLsizei_t)h, GB_GL_RGBA, GB_GL_UNSIGNED_BYTE, upload);
+
+    // update stats
+    impl->stats.uploaded += width * h << 2;
+
+    // ok
+    return tb_true;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+gb_gl_texture_ref_t gb_gl_texture_init(tb_size_t version, tb_size_t maxn)
+{
+    // done
+    tb_bool_t               ok = tb_false;
+    gb_gl_texture_impl_t*   impl = tb_null;
+    do
+    {
+        // make texture cache
+        impl = tb_malloc0_type(gb_gl_texture_impl_t);
+        tb_assert_and_check_break(impl);
+
+        // init version
+        impl->version = version;
+
+        // init entries
+        impl->entries = tb_hash_map_init(TB_HASH_MAP_BUCKET_SIZE_SMALL, tb_element_ptr(tb_null, tb_null), tb_element_ptr(gb_gl_texture_entry_exit, tb_null));
+        tb_assert_and_check_break(impl->entries);
+
+        // init lru list
+        tb_list_entry_init_(&impl->lru, tb_offsetof(gb_gl_texture_entry_t, entry), sizeof(gb_gl_texture_entry_t), tb_null);
+
+        // init stats
+        impl->stats.maxn = maxn? maxn : GB_GL_TEXTURE_MAXN;
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // failed?
+    if (!ok)
+    {
+        // exit it
+        if (impl) gb_gl_texture_exit((gb_gl_texture_ref_t)impl);
+        impl = tb_null;
+    }
+
+    // ok?
+    return (gb_gl_texture_ref_t)impl;
+}
+tb_void_t gb_gl_texture_exit(gb_gl_texture_ref_t texture)
+{
+    // check
+    gb_gl_texture_impl_t* impl = (gb_gl_texture_impl_t*)texture;
+    tb_assert_and_check_return(impl);
+
+    // clear all textures
+    gb_gl_texture_clear(texture);
+
+    // exit entries
+    if (impl->entries) tb_hash_map_exit(impl->entries);
+    impl->entries = tb_null;
+
+    // exit lru list
+    tb_list_entry_exit(&impl->lru);
+
+    // exit pixels
+    if (impl->pixels) tb_free(impl->pixels);
+    impl->pixels = tb_null;
+
+    // exit it
+    tb_free(impl);
+}
+tb_void_t gb_gl_texture_clear(gb_gl_texture_ref_t texture)
+{
+    // check
+    gb_gl_texture_impl_t* impl = (gb_gl_texture_impl_t*)texture;
+    tb_assert_and_check_return(impl);
+
+    // free all entries and their textures
+    while (tb_list_entry_size(&impl->lru))
+    {
+        gb_gl_texture_entry_ref_t entry = (gb_gl_texture_entry_ref_t)tb_list_entry(&impl->lru, tb_list_entry_head(&impl->lru));
+        tb_assert_and_check_break(entry);
+
+        gb_gl_texture_entry_free(impl, entry);
+    }
+
+    // exit all pages
+    tb_size_t i = 0;
+    for (i = 0; i < GB_GL_TEXTURE_PAGE_MAXN; i++)
+    {
+        if (impl->pages[i].texture) gb_gl_texture_page_exit(impl, &impl->pages[i]);
+    }
+}
+tb_bool_t gb_gl_texture_load(gb_gl_texture_ref_t texture, gb_bitmap_ref_t bitmap, tb_size_t mode, tb_bool_t filter, gb_gl_texture_region_ref_t region)
+{
+    // check
+    gb_gl_texture_impl_t* impl = (gb_gl_texture_impl_t*)texture;
+    tb_assert_and_check_return_val(impl && impl->entries && bitmap && region, tb_false);
+
+    // the bitmap info
+    tb_size_t version   = gb_bitmap_version(bitmap);
+    tb_size_t width     = gb_bitmap_width(bitmap);
+    tb_size_t height    = gb_bitmap_height(bitmap);
+    tb_assert_and_check_return_val(width && width <= TB_MAXU16 && height && height <= TB_MAXU16, tb_false);
+
+    // the cached entry has been resized? free it
+    gb_gl_texture_entry_ref_t entry = (gb_gl_texture_entry_ref_t)tb_hash_map_get(impl->entries, bitmap);
+    if (entry && (entry->width != width || entry->height != height))
+    {
+        gb_gl_texture_entry_free(impl, entry);
+        entry = tb_null;
+    }
+
+    // cached?
+    if (entry)
+    {
+        // move it to the lru head
+        tb_list_entry_remove(&impl->lru, &entry->entry);
+        tb_list_entry_insert_head(&impl->lru, &entry->entry);
+
+        // bind texture
+        gb_glBindTexture(GB_GL_TEXTURE_2D, entry->page >= 0? impl->pages[entry->page].texture : entry->texture);
+
+        // not modified? reuse it
+        tb_size_t y = 0;
+        tb_size_t h = 0;
+        if (entry->version == version) impl->stats.reuses++;
+        // only some rows have been modified? upload them again
+        else if (gb_bitmap_modified_rows(bitmap, entry->version, &y, &h))
+        {
+            if (h && !gb_gl_texture_upload(impl, entry, bitmap, y, h)) return tb_false;
+            impl->stats.updates++;
+        }
+        // upload all rows again
+        else
+        {
+            if (!gb_gl_texture_upload(impl, entry, bitmap, 0, height)) return tb_false;
+            impl->stats.uploads++;
+        }
+        entry->version = version;
+    }
+    else
+    {
+        // make entry
+        entry = tb_malloc0_type(gb_gl_texture_entry_t);
+        tb_assert_and_check_return_val(entry, tb_false);
+
+        // init entry
+        entry->bitmap   = bitmap;
+        entry->version  = version;
+        entry->width    = (tb_uint16_t)width;
+        entry->height   = (tb_uint16_t)height;
+        entry->page     = -1;
+
+        /* pack the small bitmap into the atlas pages or make the dedicated texture
+         *
+         * the atlas need clamp and wrap the texcoords in the fragment shader, so it is only used for gl >= 2.0
+         */
+        tb_bool_t ok = tb_false;
+        if (impl->version >= 0x20 && width <= GB_GL_TEXTURE_ATLAS_MAXN && height <= GB_GL_TEXTURE_ATLAS_MAXN)
+            ok = gb_gl_texture_alloc_atlas(impl, entry);
+        if (!ok) ok = gb_gl_texture_alloc_dedicated(impl, entry);
+        if (!ok)
+        {
+            tb_free(entry);
+            return tb_false;
+        }
+
+        // insert it
+        if (tb_hash_map_insert(impl->entries, bitmap, entry) == tb_iterator_tail(impl->entries))
+        {
+            tb_free(entry);
+            return tb_false;
+        }
+        tb_list_entry_insert_head(&impl->lru, &entry->entry);
+        impl->stats.count++;
+
+        // bind texture
+        gb_glBindTexture(GB_GL_TEXTURE_2D, entry->page >= 0? impl->pages[entry->page].texture : entry->texture);
+
+        // upload all rows
+        if (!gb_gl_texture_upload(impl, entry, bitmap, 0, height))
+        {
+            gb_gl_texture_entry_free(impl, entry);
+            return tb_false;
+        }
+        impl->stats.uploads++;
+    }
+
+    // update the filter
+    gb_GLint_t  filter_gl = filter? GB_GL_LINEAR : GB_GL_NEAREST;
+    gb_GLint_t* filter_cur = entry->page >= 0? &impl->pages[entry->page].filter : &entry->filter;
+    if (*filter_cur != filter_gl)
+    {
+        gb_glTexParameteri(GB_GL_TEXTURE_2D, GB_GL_TEXTURE_MIN_FILTER, filter_gl);
+        gb_glTexParameteri(GB_GL_TEXTURE_2D, GB_GL_TEXTURE_MAG_FILTER, filter_gl);
+        *filter_cur = filter_gl;
+    }
+
+    // update the wrap of the dedicated texture for gl 1.x, the border mode is not supported
+    if (impl->version < 0x20 && entry->page < 0)
+    {
+        gb_GLint_t wrap = GB_GL_CLAMP_TO_EDGE;
+        if (mode == GB_SHADER_MODE_REPEAT) wrap = GB_GL_REPEAT;
+        else if (mode == GB_SHADER_MODE_MIRROR) wrap = GB_GL_MIRRORED_REPEAT;
+        if (entry->wrap != wrap)
+        {
+            gb_glTexParameteri(GB_GL_TEXTURE_2D, GB_GL_TEXTURE_WRAP_S, wrap);
+            gb_glTexParameteri(GB_GL_TEXTURE_2D, GB_GL_TEXTURE_WRAP_T, wrap);
+            entry->wrap = wrap;
+        }
+    }
+
+    // the region in the texture
+    if (entry->page >= 0)
+    {
+        region->region[0] = (gb_GLfloat_t)entry->x / GB_GL_TEXTURE_PAGE_SIZE;
+        region->region[1] = (gb_GLfloat_t)entry->y / GB_GL_TEXTURE_PAGE_SIZE;
+        region->region[2] = (gb_GLfloat_t)width / GB_GL_TEXTURE_PAGE_SIZE;
+        region->region[3] = (gb_GLfloat_t)height / GB_GL_TEXTURE_PAGE_SIZE;
+    }
+    else
+    {
+        region->region[0] = 0.0f;
+        region->region[1] = 0.0f;
+        region->region[2] = 1.0f;
+        region->region[3] = 1.0f;
+    }
+
+    // the clamped range, inset by half texel
+    region->clamp[0] = 0.5f / width;
+    region->clamp[1] = 0.5f / height;
+    region->clamp[2] = 1.0f - region->clamp[0];
+    region->clamp[3] = 1.0f - region->clamp[1];
+
+    // ok
+    return tb_true;
+}
+tb_void_t gb_gl_texture_stats(gb_gl_texture_ref_t texture, gb_gl_texture_stats_ref_t stats)
+{
+    // check
+    gb_gl_texture_impl_t* impl = (gb_gl_texture_impl_t*)texture;
+    tb_assert_and_check_return(impl && stats);
+
+    // get stats
+    *stats = impl->stats;
+}
@@ -0,0 +1,164 @@
+/*!The Graphic Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        texture.h
+ * @ingroup     core
+ *
+ */
+#ifndef GB_CORE_DEVICE_GL_TEXTURE_H
+#define GB_CORE_DEVICE_GL_TEXTURE_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the default vram budget of the texture cache
+#ifdef __gb_small__
+#   define GB_GL_TEXTURE_MAXN           (16 << 20)
+#else
+#   define GB_GL_TEXTURE_MAXN           (64 << 20)
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the gl texture cache ref type
+typedef struct{}*       gb_gl_texture_ref_t;
+
+// the gl texture region type
+typedef struct __gb_gl_texture_region_t
+{
+    /* the region of the bitmap in the texture: x, y, w, h
+     *
+     * the texcoord in the texture = region.xy + bitmap_texcoord * region.zw
+     */
+    gb_GLfloat_t        region[4];
+
+    /* the clamped range of the bitmap texcoords: x0, y0, x1, y1
+     *
+     * it is inset by half texel, so the filtered texels will not bleed into
+     * the neighbouring bitmaps of the atlas page
+     */
+    gb_GLfloat_t        clamp[4];
+
+}gb_gl_texture_region_t, *gb_gl_texture_region_ref_t;
+
+// the gl texture cache stats type
+typedef struct __gb_gl_texture_stats_t
+{
+    // the full upload count
+    tb_size_t           uploads;
+
+    // the partial upload count of the modified rows
+    tb_size_t           updates;
+
+    // the reused count without uploading
+    tb_size_t           reuses;
+
+    // the eviction count
+    tb_size_t           evictions;
+
+    // the uploaded bytes
+    tb_size_t           uploaded;
+
+    // the atlas page count
+    tb_size_t           pages;
+
+    // the cached bitmap count
+    tb_size_t           count;
+
+    // the vram bytes of the atlas pages and the dedicated textures
+    tb_size_t           size;
+
+    // the vram budget
+    tb_size_t           maxn;
+
+}gb_gl_texture_stats_t, *gb_gl_texture_stats_ref_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interface
+ */
+
+/* init the texture cache of the bitmaps
+ *
+ * the bitmaps are keyed by the bitmap and its content version,
+ * the small bitmaps are packed into the shared atlas pages for gl >= 2.0,
+ * and the large bitmaps or all bitmaps for gl 1.x are uploaded to the dedicated textures.
+ *
+ * the least recently used bitmaps will be evicted if the vram budget is not enough.
+ *
+ * @param version       the gl version
+ * @param maxn          the vram budget in bytes, using GB_GL_TEXTURE_MAXN if be zero
+ *
+ * @return              the texture cache
+ */
+gb_gl_texture_ref_t     gb_gl_texture_init(tb_size_t version, tb_size_t maxn);
+
+/* exit the texture cache and delete all textures
+ *
+ * @param texture       the texture cache
+ */
+tb_void_t               gb_gl_texture_exit(gb_gl_texture_ref_t texture);
+
+/* clear the texture cache and delete all textures
+ *
+ * @param texture       the texture cache
+ */
+tb_void_t               gb_gl_texture_clear(gb_gl_texture_ref_t texture);
+
+/* load the bitmap and bind its texture to the current gl context
+ *
+ * the bitmap will be uploaded only if it is not cached,
+ * and only the modified rows will be uploaded again if its content version has been changed.
+ *
+ * @param texture       the texture cache
+ * @param bitmap        the bitmap
+ * @param mode          the shader mode, the dedicated texture is wrapped by it for gl 1.x
+ * @param filter        filter the bitmap?
+ * @param region        the region of the bitmap in the bound texture
+ *
+ * @return              tb_true or tb_false
+ */
+tb_bool_t               gb_gl_texture_load(gb_gl_texture_ref_t texture, gb_bitmap_ref_t bitmap, tb_size_t mode, tb_bool_t filter, gb_gl_texture_region_ref_t region);
+
+/* the texture cache stats
+ *
+ * @param texture       the texture cache
+ * @param stats         the stats
+ */
+tb_void_t               gb_gl_texture_stats(gb_gl_texture_ref_t texture, gb_gl_texture_stats_ref_t stats);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+#endif
@@ -0,0 +1,1395 @@
+/*!The Graphic Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        tracer.c
+ * @ingroup     core
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME            "gl_tracer"
+#define TB_TRACE_MODULE_DEBUG           (0)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "tracer.h"
+#include "interface.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the traced vertex attribute arrays count for gl >= 2.0
+#define GB_GL_TRACER_ATTRIBS_MAXN       (16)
+
+// the traced arrays count: attributes for gl >= 2.0 and vertex, color, texcoord for gl 1.x
+#define GB_GL_TRACER_ARRAYS_MAXN        (GB_GL_TRACER_ATTRIBS_MAXN + 3)
+
+// the stub version string
+#define GB_GL_TRACER_STUB_VERSION       "2.0 gbox stub"
+
+// the real interface
+#define GB_GL_TRACER_REAL(func)         gb_##func##_t func
+
+// call the real interface if exists
+#define GB_GL_TRACER_CALL(func, args)   do { if (g_tracer.real.func) g_tracer.real.func args; } while (0)
+
+// wrap the interface
+#define GB_GL_TRACER_HOOK(func) \
+do \
+{ \
+    if (gb_##func != gb_gl_tracer_##func) g_tracer.real.func = gb_##func; \
+    if (g_tracer.real.func || g_tracer.mode == GB_GL_TRACER_MODE_STUB) gb_##func = gb_gl_tracer_##func; \
+ \
+} while (0)
+
+// restore the interface
+#define GB_GL_TRACER_UNHOOK(func) \
+do \
+{ \
+    if (gb_##func == gb_gl_tracer_##func) gb_##func = g_tracer.real.func; \
+    g_tracer.real.func = tb_null; \
+ \
+} while (0)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the call kind enum
+typedef enum __gb_gl_tracer_kind_e
+{
+    GB_GL_TRACER_KIND_NONE      = 0
+,   GB_GL_TRACER_KIND_STATE     = 1
+,   GB_GL_TRACER_KIND_DRAW      = 2
+,   GB_GL_TRACER_KIND_UPLOAD    = 3
+
+}gb_gl_tracer_kind_e;
+
+// the traced array type
+typedef struct __gb_gl_tracer_array_t
+{
+    // the component count
+    gb_GLint_t                  size;
+
+    // the component type
+    gb_GLenum_t                 type;
+
+    // the stride
+    gb_GLsizei_t                stride;
+
+    // enabled?
+    tb_uint8_t                  enabled;
+
+    // the bound array buffer when setting the pointer
+    gb_GLuint_t                 buffer;
+
+    // the pointer or the offset into the bound buffer
+    gb_GLvoid_t const*          pointer;
+
+}gb_gl_tracer_array_t;
+
+// the tracer type
+typedef struct __gb_gl_tracer_t
+{
+    // the mode
+    tb_size_t                   mode;
+
+    // the trace stream
+    tb_stream_ref_t             stream;
+
+    // the nested call depth, only the outermost call will be traced
+    tb_size_t                   depth;
+
+    // the frame index
+    tb_size_t                   frame;
+
+    // the stats of the current frame
+    gb_gl_tracer_stats_t        stats_frame;
+
+    // the stats of the previous frames
+    gb_gl_tracer_stats_t        stats_total;
+
+    // the bound array buffer
+    gb_GLuint_t                 array_buffer;
+
+    // the bound element array buffer
+    gb_GLuint_t                 element_buffer;
+
+    // the unpack alignment
+    gb_GLint_t                  unpack_alignment;
+
+    // the arrays
+    gb_gl_tracer_array_t        arrays[GB_GL_TRACER_ARRAYS_MAXN];
+
+    // the object id for the stub mode
+    gb_GLuint_t                 object;
+
+    // the line
+    tb_char_t                   line[8192];
+
+    // the real interfaces
+    struct
+    {
+        GB_GL_TRACER_REAL(glActiveTexture);
+        GB_GL_TRACER_REAL(glAlphaFunc);
+        GB_GL_TRACER_REAL(glAttachShader);
+        GB_GL_TRACER_REAL(glBindBuffer);
+        GB_GL_TRACER_REAL(glBindTexture);
+        GB_GL_TRACER_REAL(glBlendFunc);
+        GB_GL_TRACER_REAL(glBufferData);
+        GB_GL_TRACER_REAL(glBufferSubData);
+        GB_GL_TRACER_REAL(glClear);
+        GB_GL_TRACER_REAL(glClearColor);
+        GB_GL_TRACER_REAL(glClearStencil);
+        GB_GL_TRACER_REAL(glColor4f);
+        GB_GL_TRACER_REAL(glColorMask);
+        GB_GL_TRACER_REAL(glColorPointer);
+        GB_GL_TRACER_REAL(glCompileShader);
+        GB_GL_TRACER_REAL(glCreateProgram);
+        GB_GL_TRACER_REAL(glCreateShader);
+        GB_GL_TRACER_REAL(glDeleteBuffers);
+        GB_GL_TRACER_REAL(glDeleteProgram);
+        GB_GL_TRACER_REAL(glDeleteShader);
+        GB_GL_TRACER_REAL(glDeleteTextures);
+        GB_GL_TRACER_REAL(glDisable);
+        GB_GL_TRACER_REAL(glDisableClientState);
+        GB_GL_TRACER_REAL(glDisableVertexAttribArray);
+        GB_GL_TRACER_REAL(glDrawArrays);
+        GB_GL_TRACER_REAL(glDrawElements);
+        GB_GL_TRACER_REAL(glEnable);
+        GB_GL_TRACER_REAL(glEnableClientState);
+        GB_GL_TRACER_REAL(glEnableVertexAttribArray);
+        GB_GL_TRACER_REAL(glGenBuffers);
+        GB_GL_TRACER_REAL(glGenTextures);
+        GB_GL_TRACER_REAL(glGetAttribLocation);
+        GB_GL_TRACER_REAL(glGetIntegerv);
+        GB_GL_TRACER_REAL(glGetProgramBinary);
+        GB_GL_TRACER_REAL(glGetProgramiv);
+        GB_GL_TRACER_REAL(glGetProgramInfoLog);
+        GB_GL_TRACER_REAL(glGetShaderiv);
+        GB_GL_TRACER_REAL(glGetShaderInfoLog);
+        GB_GL_TRACER_REAL(glGetString);
+        GB_GL_TRACER_REAL(glGetUniformLocation);
+        GB_GL_TRACER_REAL(glHint);
+        GB_GL_TRACER_REAL(glIsTexture);
+        GB_GL_TRACER_REAL(glLineWidth);
+        GB_GL_TRACER_REAL(glLinkProgram);
+        GB_GL_TRACER_REAL(glLoadIdentity);
+        GB_GL_TRACER_REAL(glLoadMatrixf);
+        GB_GL_TRACER_REAL(glMatrixMode);
+        GB_GL_TRACER_REAL(glMultMatrixf);
+        GB_GL_TRACER_REAL(glOrtho);
+        GB_GL_TRACER_REAL(glOrthof);
+        GB_GL_TRACER_REAL(glPixelStorei);
+        GB_GL_TRACER_REAL(glPopMatrix);
+        GB_GL_TRACER_REAL(glProgramBinary);
+        GB_GL_TRACER_REAL(glProgramParameteri);
+        GB_GL_TRACER_REAL(glPushMatrix);
+        GB_GL_TRACER_REAL(glRotatef);
+        GB_GL_TRACER_REAL(glScalef);
+        GB_GL_TRACER_REAL(glScissor);
+        GB_GL_TRACER_REAL(glShaderSource);
+        GB_GL_TRACER_REAL(glStencilFunc);
+        GB_GL_TRACER_REAL(glStencilMask);
+        GB_GL_TRACER_REAL(glStencilOp);
+        GB_GL_TRACER_REAL(glStencilOpSeparate);
+        GB_GL_TRACER_REAL(glTexCoordPointer);
+        GB_GL_TRACER_REAL(glTexEnvi);
+        GB_GL_TRACER_REAL(glTexImage2D);
+        GB_GL_TRACER_REAL(glTexParameterf);
+        GB_GL_TRACER_REAL(glTexParameteri);
+        GB_GL_TRACER_REAL(glTexSubImage2D);
+        GB_GL_TRACER_REAL(glTranslatef);
+        GB_GL_TRACER_REAL(glUniform1i);
+        GB_GL_TRACER_REAL(glUniform4f);
+        GB_GL_TRACER_REAL(glUniformMatrix4fv);
+        GB_GL_TRACER_REAL(glUseProgram);
+        GB_GL_TRACER_REAL(glVertexAttrib4f);
+        GB_GL_TRACER_REAL(glVertexAttribPointer);
+        GB_GL_TRACER_REAL(glVertexPointer);
+        GB_GL_TRACER_REAL(glViewport);
+
+    }                           real;
+
+}gb_gl_tracer_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * globals
+ */
+
+/* the tracer
+ *
+ * the gl context is used by one thread only, so it need not be locked
+ */
+static gb_gl_tracer_t           g_tracer = {0};
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static tb_bool_t gb_gl_tracer_enter(tb_size_t kind)
+{
+    // the nested call? only trace the outermost call, e.g. glOrthof => glOrtho
+    if (g_tracer.depth++) return tb_false;
+
+    // update stats
+    gb_gl_tracer_stats_ref_t stats = &g_tracer.stats_frame;
+    stats->calls++;
+    switch (kind)
+    {
+    case GB_GL_TRACER_KIND_STATE:   stats->states++;    break;
+    case GB_GL_TRACER_KIND_DRAW:    stats->draws++;     break;
+    default:                                            break;
+    }
+
+    // ok
+    return tb_true;
+}
+static tb_void_t gb_gl_tracer_leave()
+{
+    // check
+    tb_assert(g_tracer.depth);
+
+    // leave it
+    g_tracer.depth--;
+}
+static tb_void_t gb_gl_tracer_printf(tb_char_t const* format, ...)
+{
+    // no trace file?
+    tb_check_return(g_tracer.stream);
+
+    // format line
+    tb_long_t size = 0;
+    tb_vsnprintf_format(g_tracer.line, sizeof(g_tracer.line) - 1, format, &size);
+
+    // write it
+    if (size > 0) tb_stream_bwrit(g_tracer.stream, (tb_byte_t const*)g_tracer.line, size);
+}
+static tb_void_t gb_gl_tracer_data(tb_cpointer_t data, tb_size_t size)
+{
+    // no trace file?
+    tb_check_return(g_tracer.stream);
+
+    // null?
+    if (!data)
+    {
+        tb_stream_bwrit(g_tracer.stream, (tb_byte_t const*)" null", 5);
+        return ;
+    }
+
+    // write the hexadecimal data
+    static tb_char_t const  digits[] = "0123456789abcdef";
+    tb_byte_t const*        p = (tb_byte_t const*)data;
+    tb_byte_t const*        e = p + size;
+    tb_char_t*              line = g_tracer.line;
+    tb_size_t               maxn = sizeof(g_tracer.line) - 1;
+    tb_size_t               n = 0;
+    line[n++] = ' ';
+    line[n++] = '{';
+    while (p < e)
+    {
+        line[n++] = digits[*p >> 4];
+        line[n++] = digits[*p & 0xf];
+        p++;
+
+        // flush the full line
+        if (n + 2 > maxn)
+        {
+            tb_stream_bwrit(g_tracer.stream, (tb_byte_t const*)line, n);
+            n = 0;
+        }
+    }
+    line[n++] = '}';
+    tb_stream_bwrit(g_tracer.stream, (tb_byte_t const*)line, n);
+}
+static tb_void_t gb_gl_tracer_pointer(gb_GLuint_t buffer, gb_GLvoid_t const* pointer)
+{
+    // the offset into the bound buffer?
+    if (buffer) gb_gl_tracer_printf(" +%lu", (tb_size_t)pointer);
+    // the client memory, it's data will be written before drawing
+    else if (pointer) gb_gl_tracer_printf(" *");
+    // null
+    else gb_gl_tracer_printf(" null");
+}
+static tb_size_t gb_gl_tracer_type_size(gb_GLenum_t type)
+{
+    // the type size
+    switch (type)
+    {
+    case GB_GL_BYTE:
+    case GB_GL_UNSIGNED_BYTE:       return 1;
+    case GB_GL_SHORT:
+    case GB_GL_UNSIGNED_SHORT:      return 2;
+    default:                        return 4;
+    }
+}
+static tb_long_t gb_gl_tracer_array_index(gb_GLenum_t array)
+{
+    // the client array index
+    switch (array)
+    {
+    case GB_GL_VERTEX_ARRAY:        return GB_GL_TRACER_ATTRIBS_MAXN;
+    case GB_GL_COLOR_ARRAY:         return GB_GL_TRACER_ATTRIBS_MAXN + 1;
+    case GB_GL_TEXTURE_COORD_ARRAY: return GB_GL_TRACER_ATTRIBS_MAXN + 2;
+    default:                        return -1;
+    }
+}
+static tb_void_t gb_gl_tracer_array_enable(tb_long_t index, tb_bool_t enabled)
+{
+    // update it
+    if (index >= 0 && index < GB_GL_TRACER_ARRAYS_MAXN) g_tracer.arrays[index].enabled = (tb_uint8_t)enabled;
+}
+static tb_void_t gb_gl_tracer_array_pointer(tb_long_t index, gb_GLint_t size, gb_GLenum_t type, gb_GLsizei_t stride, gb_GLvoid_t const* pointer)
+{
+    // check
+    tb_check_return(index >= 0 && index < GB_GL_TRACER_ARRAYS_MAXN);
+
+    // update it
+    gb_gl_tracer_array_t* array = &g_tracer.arrays[index];
+    array->size     = size;
+    array->type     = type;
+    array->stride   = stride;
+    array->buffer   = g_tracer.array_buffer;
+    array->pointer  = pointer;
+}
+static tb_void_t gb_gl_tracer_array_data(tb_size_t count)
+{
+    // no trace file or no vertices?
+    tb_check_return(g_tracer.stream && count);
+
+    // write the data of the enabled client arrays, [0, count) vertices will be used
+    tb_size_t index = 0;
+    for (index = 0; index < GB_GL_TRACER_ARRAYS_MAXN; index++)
+    {
+        // the client array?
+        gb_gl_tracer_array_t const* array = &g_tracer.arrays[index];
+        if (!array->enabled || array->buffer || !array->pointer) continue;
+
+        // the data size
+        tb_size_t size = array->size * gb_gl_tracer_type_size(array->type);
+        tb_size_t stride = array->stride? array->stride : size;
+
+        // write it
+        if (index < GB_GL_TRACER_ATTRIBS_MAXN) gb_gl_tracer_printf("glArrayData %lu", index);
+        else
+        {
+            static gb_GLenum_t const clients[] = {GB_GL_VERTEX_ARRAY, GB_GL_COLOR_ARRAY, GB_GL_TEXTURE_COORD_ARRAY};
+            gb_gl_tracer_printf("glArrayData 0x%x", clients[index - GB_GL_TRACER_ATTRIBS_MAXN]);
+        }
+        gb_gl_tracer_data(array->pointer, (count - 1) * stride + size);
+        gb_gl_tracer_printf("\n");
+    }
+}
+static tb_bool_t gb_gl_tracer_array_client()
+{
+    // exists the enabled client array?
+    tb_size_t index = 0;
+    for (index = 0; index < GB_GL_TRACER_ARRAYS_MAXN; index++)
+    {
+        gb_gl_tracer_array_t const* array = &g_tracer.arrays[index];
+        if (array->enabled && !array->buffer && array->pointer) return tb_true;
+    }
+    return tb_false;
+}
+static tb_size_t gb_gl_tracer_texture_size(gb_GLsizei_t width, gb_GLsizei_t height, gb_GLenum_t format, gb_GLenum_t type)
+{
+    // the pixel size
+    tb_size_t pixel = 2;
+    if (type == GB_GL_UNSIGNED_BYTE)
+    {
+        switch (format)
+        {
+        case GB_GL_ALPHA:
+        case GB_GL_LUMINANCE:       pixel = 1; break;
+        case GB_GL_LUMINANCE_ALPHA: pixel = 2; break;
+        case GB_GL_RGB:             pixel = 3; break;
+        default:                    pixel = 4; break;
+        }
+    }
+
+    // the row size with the unpack alignment
+    tb_size_t align = g_tracer.unpack_alignment > 0? (tb_size_t)g_tracer.unpack_alignment : 4;
+    tb_size_t row = tb_align(width * pixel, align);
+
+    // the texture size
+    return height > 0? row * (height - 1) + width * pixel : 0;
+}
+static gb_GLuint_t gb_gl_tracer_object()
+{
+    // make a new object id for the stub mode
+    return ++g_tracer.object;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private interfaces
+ */
+static gb_GLvoid_t GB_GL_APICALL gb_gl_tracer_glActiveTexture(gb_GLenum_t texture)
+{
+    if (gb_gl_tracer_enter(GB_GL_TRACER_KIND_STATE)) gb_gl_tracer_printf("glActiveTexture 0x%x\n", texture);
+    GB_GL_TRACER_CALL(glActiveTexture, (texture));
+    gb_gl_tracer_leave();
+}
+static gb_GLvoid_t GB_GL_APICALL gb_gl_tracer_glAlphaFunc(gb_GLenum_t func, gb_GLclampf_t ref)
+{
+    if (gb_gl_tracer_enter(GB_GL_TRACER_KIND_STATE)) gb_gl_tracer_printf("glAlphaFunc 0x%x %f\n", func, ref);
+    GB_GL_TRACER_CALL(glAlphaFunc, (func, ref));
+    gb_gl_tracer_leave();
+}
+static gb_GLvoid_t GB_GL_APICALL gb_gl_tracer_glAttachShader(gb_GLuint_t program, gb_GLuint_t shader)
+{
+    if (gb_gl_tracer_enter(GB_GL_TRACER_KIND_NONE)) gb_gl_tracer_printf("glAttachShader %u %u\n", program, shader);
+    GB_GL_TRACER_CALL(glAttachShader, (program, shader));
+    gb_gl_tracer_leave();
+}
+static gb_GLvoid_t GB_GL_APICALL gb_gl_tracer_glBindBuffer(gb_GLenum_t target, gb_GLuint_t buffer)
+{
+    if (gb_gl_tracer_enter(GB_GL_TRACER_KIND_STATE)) gb_gl_tracer_printf("glBindBuffer 0x%x %u\n", target, buffer);
+    GB_GL_TRACER_CALL(glBindBuffer, (target, buffer));
+    gb_gl_tracer_leave();
+
+    // save the bound buffer
+    if (target == GB_GL_ARRAY_BUFFER) g_tracer.array_buffer = buffer;
+    else if (target == GB_GL_ELEMENT_ARRAY_BUFFER) g_tracer.element_buffer = buffer;
+}
+static gb_GLvoid_t GB_GL_APICALL gb_gl_tracer_glBindTexture(gb_GLenum_t target, gb_GLuint_t texture)
+{
+    if (gb_gl_tracer_enter(GB_GL_TRACER_KIND_STATE)) gb_gl_tracer_printf("glBindTexture 0x%x %u\n", target, texture);
+    GB_GL_TRACER_CALL(glBindTexture, (target, texture));
+    gb_gl_tracer_leave();
+}
+static gb_GLvoid_t GB_GL_APICALL gb_gl_tracer_glBlendFunc(gb_GLenum_t sfactor, gb_GLenum_t dfactor)
+{
+    if (gb_gl_tracer_enter(GB_GL_TRACER_KIND_STATE)) gb_gl_tracer_printf("glBlendFunc 0x%x 0x%x\n", sfactor, dfactor);
+    GB_GL_TRACER_CALL(glBlendFunc, (sfactor, dfactor));
+    gb_gl_tracer_leave();
+}
+static gb_GLvoid_t GB_GL_APICALL gb_gl_tracer_glBufferData(gb_GLenum_t target, gb_GLsizeiptr_t size, gb_GLvoid_t const* data, gb_GLenum_t usage)
+{
+    if (gb_gl_tracer_enter(GB_GL_TRACER_KIND_UPLOAD))
+    {
+        // only the data will be uploaded, the null data just allocates or orphans the buffer
+        if (data) g_tracer.stats_frame.uploads += size;
+
+        // trace it
+        gb_gl_tracer_printf("glBufferData 0x%x %ld", target, size);
+        gb_gl_tracer_data(data, size);
+        gb_gl_tracer_printf(" 0x%x\n", usage);
+    }
+    GB_GL_TRACER_CALL(glBufferData, (target, size, data, usage));
+    gb_gl_tracer_leave();
+}
+static gb_GLvoid_t GB_GL_APICALL gb_gl_tracer_glBufferSubData(gb_GLenum_t target, gb_GLintptr_t offset, gb_GLsizeiptr_t size, gb_GLvoid_t const* data)
+{
+    if (gb_gl_tracer_enter(GB_GL_TRACER_KIND_UPLOAD))
+    {
+        g_tracer.stats_frame.uploads += size;
+        gb_gl_tracer_printf("glBufferSubData 0x%x %ld %ld", target, offset, size);
+        gb_gl_tracer_data(data, size);
+        gb_gl_tracer_printf("\n");
+    }
+    GB_GL_TRACER_CALL(glBufferSubData, (target, offset, size, data));
+    gb_gl_tracer_leave();
+}
+static gb_GLvoid_t GB_GL_APICALL gb_gl_tracer_glClear(gb_GLbitfield_t mask)
+{
+    if (gb_gl_tracer_enter(GB_GL_TRACER_KIND_NONE)) gb_gl_tracer_printf("glClear 0x%x\n", mask);
+    GB_GL_TRACER_CALL(glClear, (mask));
+    gb_gl_tracer_leave();
+}
+static gb_GLvoid_t GB_GL_APICALL gb_gl_tracer_glClearColor(gb_GLclampf_t red, gb_GLclampf_t green, gb_GLclampf_t blue, gb_GLclampf_t alpha)
+{
+    if (gb_gl_tracer_enter(GB_GL_TRACER_KIND_STATE)) gb_gl_tracer_printf("glClearColor %f %f %f %f\n", red, green, blue, alpha);
+    GB_GL_TRACER_CALL(glClearColor, (red, green, blue, alpha));
+    gb_gl_tracer_leave();
+}
+static gb_GLvoid_t GB_GL_APICALL gb_gl_tracer_glClearStencil(gb_GLint_t s)
+{
+    if (gb_gl_tracer_enter(GB_GL_TRACER_KIND_STATE)) gb_gl_tracer_printf("glClearStencil %d\n", s);
+    GB_GL_TRACER_CALL(glClearStencil, (s));
+    gb_gl_tracer_leave();
+}
+static gb_GLvoid_t GB_GL_APICALL gb_gl_tracer_glColor4f(gb_GLfloat_t red, gb_GLfloat_t green, gb_GLfloat_t blue, gb_GLfloat_t alpha)
+{
+    if (gb_gl_tracer_enter(GB_GL_TRACER_KIND_STATE)) gb_gl_tracer_printf("glColor4f %f %f %f %f\n", red, green, blue, alpha);
+    GB_GL_TRACER_CALL(glColor4f, (red, green, blue, alpha));
+    gb_gl_tracer_leave();
+}
+static gb_GLvoid_t GB_GL_APICALL gb_gl_tracer_glColorMask(gb_GLboolean_t red, gb_GLboolean_t green, gb_GLboolean_t blue, gb_GLboolean_t alpha)
+{
+    if (gb_gl_tracer_enter(GB_GL_TRACER_KIND_STATE)) gb_gl_tracer_printf("glColorMask %u %u %u %u\n", red, green, blue, alpha);
+    GB_GL_TRACER_CALL(glColorMask, (red, green, blue, alpha));
+    gb_gl_tracer_leave();
+}
+static gb_GLvoid_t GB_GL_APICALL gb_gl_tracer_glColorPointer(gb_GLint_t size, gb_GLenum_t type, gb_GLsizei_t stride, gb_GLvoid_t const* pointer)
+{
+    if (gb_gl_tracer_enter(GB_GL_TRACER_KIND_STATE))
+    {
+        gb_gl_tracer_printf("glColorPointer %d 0x%x %d", size, type, stride);
+        gb_gl_tracer_pointer(g_tracer.array_buffer, pointer);
+        gb_gl_tracer_printf("\n");
+    }
+    GB_GL_TRACER_CALL(glColorPointer, (size, type, stride, pointer));
+    gb_gl_tracer_leave();
+    gb_gl_tracer_array_pointer(gb_gl_tracer_array_index(GB_GL_COLOR_ARRAY), size, type, stride, pointer);
+}
+static gb_GLvoid_t GB_GL_APICALL gb_gl_tracer_glCompileShader(gb_GLuint_t shader)
+{
+    if (gb_gl_tracer_enter(GB_GL_TRACER_KIND_NONE)) gb_gl_tracer_printf("glCompileShader %u\n", shader);
+    GB_GL_TRACER_CALL(glCompileShader, (shader));
+    gb_gl_tracer_leave();
+}
+static gb_GLuint_t GB_GL_APICALL gb_gl_tracer_glCreateProgram(gb_GLvoid_t)
+{
+    tb_bool_t   traced = gb_gl_tracer_enter(GB_GL_TRACER_KIND_NONE);
+    gb_GLuint_t program = g_tracer.real.glCreateProgram? g_tracer.real.glCreateProgram() : gb_gl_tracer_object();
+    if (traced) gb_gl_tracer_printf("glCreateProgram # %u\n", program);
+    gb_gl_tracer_leave();
+    return program;
+}
+static gb_GLuint_t GB_GL_APICALL gb_gl_tracer_glCreateShader(gb_GLenum_t type)
+{
+    tb_bool_t   traced = gb_gl_tracer_enter(GB_GL_TRACER_KIND_NONE);
+    gb_GLuint_t shader = g_tracer.real.glCreateShader? g_tracer.real.glCreateShader(type) : gb_gl_tracer_object();
+    if (traced) gb_gl_tracer_printf("glCreateShader 0x%x # %u\n", type, shader);
+    gb_gl_tracer_leave();
+    return shader;
+}
+static gb_GLvoid_t GB_GL_APICALL gb_gl_tracer_glDeleteBuffers(gb_GLsizei_t n, gb_GLuint_t const* buffers)
+{
+    if (gb_gl_tracer_enter(GB_GL_TRACER_KIND_NONE))
+    {
+        gb_gl_tracer_printf("glDeleteBuffers %d", n);
+        gb_gl_tracer_data(buffers, n * sizeof(gb_GLuint_t));
+        gb_gl_tracer_printf("\n");
+    }
+    GB_GL_TRACER_CALL(glDeleteBuffers, (n, buffers));
+    gb_gl_tracer_leave();
+}
+static gb_GLvoid_t GB_GL_APICALL gb_gl_tracer_glDeleteProgram(gb_GLuint_t program)
+{
+    if (gb_gl_tracer_enter(GB_GL_TRACER_KIND_NONE)) gb_gl_tracer_printf("glDeleteProgram %u\n", program);
+    GB_GL_TRACER_CALL(glDeleteProgram, (program));
+    gb_gl_tracer_leave();
+}
+static gb_GLvoid_t GB_GL_APICALL gb_gl_tracer_glDeleteShader(gb_GLuint_t shader)
+{
+    if (gb_gl_tracer_enter(GB_GL_TRACER_KIND_NONE)) gb_gl_tracer_printf("glDeleteShader %u\n", shader);
+    GB_GL_TRACER_CALL(glDeleteShader, (shader));
+    gb_gl_tracer_leave();
+}
+static gb_GLvoid_t GB_GL_APICALL gb_gl_tracer_glDeleteTextures(gb_GLsizei_t n, gb_GLuint_t const* textures)
+{
+    if (gb_gl_tracer_enter(GB_GL_TRACER_KIND_NONE))
+    {
+        gb_gl_tracer_printf("glDeleteTextures %d", n);
+        gb_gl_tracer_data(textures, n * sizeof(gb_GLuint_t));
+        gb_gl_tracer_printf("\n");
+    }
+    GB_GL_TRACER_CALL(glDeleteTextures, (n, textures));
+    gb_gl_tracer_leave();
+}
+static gb_GLvoid_t GB_GL_APICALL gb_gl_tracer_glDisable(gb_GLenum_t cap)
+{
+    if (gb_gl_tracer_enter(GB_GL_TRACER_KIND_STATE)) gb_gl_tracer_printf("glDisable 0x%x\n", cap);
+    GB_GL_TRACER_CALL(glDisable, (cap));
+    gb_gl_tracer_leave();
+}
+static gb_GLvoid_t GB_GL_APICALL gb_gl_tracer_glDisableClientState(gb_GLenum_t cap)
+{
+    if (gb_gl_tracer_enter(GB_GL_TRACER_KIND_STATE)) gb_gl_tracer_printf("glDisableClientState 0x%x\n", cap);
+    GB_GL_TRACER_CALL(glDisableClientState, (cap));
+    gb_gl_tracer_leave();
+    gb_gl_tracer_array_enable(gb_gl_tracer_array_index(cap), tb_false);
+}
+static gb_GLvoid_t GB_GL_APICALL gb_gl_tracer_glDisableVertexAttribArray(gb_GLuint_t index)
+{
+    if (gb_gl_tracer_enter(GB_GL_TRACER_KIND_STATE)) gb_gl_tracer_printf("glDisableVertexAttribArray %u\n", index);
+    GB_GL_TRACER_CALL(glDisableVertexAttribArray, (index));
+    gb_gl_tracer_leave();
+    if (index < GB_GL_TRACER_ATTRIBS_MAXN) gb_gl_tracer_array_enable(index, tb_false);
+}
+static gb_GLvoid_t GB_GL_APICALL gb_gl_tracer_glDrawArrays(gb_GLenum_t mode, gb_GLint_t first, gb_GLsizei_t count)
+{
+    if (gb_gl_tracer_enter(GB_GL_TRACER_KIND_DRAW))
+    {
+        // update the vertex count
+        if (count > 0) g_tracer.stats_frame.vertices += count;
+
+        // trace it with the data of the client arrays
+        if (count > 0) gb_gl_tracer_array_data(first + count);
+        gb_gl_tracer_printf("glDrawArrays 0x%x %d %d\n", mode, first, count);
+    }
+    GB_GL_TRACER_CALL(glDrawArrays, (mode, first, count));
+    gb_gl_tracer_leave();
+}
+static gb_GLvoid_t GB_GL_APICALL gb_gl_tracer_glDrawElements(gb_GLenum_t mode, gb_GLsizei_t count, gb_GLenum_t type, gb_GLvoid_t const* indices)
+{
+    if (gb_gl_tracer_enter(GB_GL_TRACER_KIND_DRAW))
+    {
+        // update the vertex count
+        if (count > 0) g_tracer.stats_frame.vertices += count;
+
+        // the client indices?
+        tb_size_t size = gb_gl_tracer_type_size(type);
+        if (!g_tracer.element_buffer && indices && count > 0)
+        {
+            // compute the used vertex count
+            tb_size_t           i = 0;
+            tb_size_t           maxi = 0;
+            tb_byte_t const*    p = (tb_byte_t const*)indices;
+            for (i = 0; i < (tb_size_t)count; i++)
+            {
+                tb_size_t index = size == 1? p[i] : (size == 2? ((tb_uint16_t const*)p)[i] : ((tb_uint32_t const*)p)[i]);
+                if (index > maxi) maxi = index;
+            }
+
+            // trace it with the data of the client arrays and indices
+            gb_gl_tracer_array_data(maxi + 1);
+            gb_gl_tracer_printf("glDrawElements 0x%x %d 0x%x", mode, count, type);
+            gb_gl_tracer_data(indices, count * size);
+            gb_gl_tracer_printf("\n");
+        }
+        else
+        {
+            // the used vertex count of the client arrays is unknown for the indices in the buffer
+            if (gb_gl_tracer_array_client()) gb_gl_tracer_printf("# the data of the client arrays is unknown\n");
+
+            // trace it
+            gb_gl_tracer_printf("glDrawElements 0x%x %d 0x%x", mode, count, type);
+            gb_gl_tracer_pointer(g_tracer.element_buffer, indices);
+            gb_gl_tracer_printf("\n");
+        }
+    }
+    GB_GL_TRACER_CALL(glDrawElements, (mode, count, type, indices));
+    gb_gl_tracer_leave();
+}
+static gb_GLvoid_t GB_GL_APICALL gb_gl_tracer_glEnable(gb_GLenum_t cap)
+{
+    if (gb_gl_tracer_enter(GB_GL_TRACER_KIND_STATE)) gb_gl_tracer_printf("glEnable 0x%x\n", cap);
+    GB_GL_TRACER_CALL(glEnable, (cap));
+    gb_gl_tracer_leave();
+}
+static gb_GLvoid_t GB_GL_APICALL gb_gl_tracer_glEnableClientState(gb_GLenum_t cap)
+{
+    if (gb_gl_tracer_enter(GB_GL_TRACER_KIND_STATE)) gb_gl_tracer_printf("glEnableClientState 0x%x\n", cap);
+    GB_GL_TRACER_CALL(glEnableClientState, (cap));
+    gb_gl_tracer_leave();
+    gb_gl_tracer_array_enable(gb_gl_tracer_array_index(cap), tb_true);
+}
+static gb_GLvoid_t GB_GL_APICALL gb_gl_tracer_glEnableVertexAttribArray(gb_GLuint_t index)
+{
+    if (gb_gl_tracer_enter(GB_GL_TRACER_KIND_STATE)) gb_gl_tracer_printf("glEnableVertexAttribArray %u\n", index);
+    GB_GL_TRACER_CALL(glEnableVertexAttribArray, (index));
+    gb_gl_tracer_leave();
+    if (index < GB_GL_TRACER_ATTRIBS_MAXN) gb_gl_tracer_array_enable(index, tb_true);
+}
+static gb_GLvoid_t GB_GL_APICALL gb_gl_tracer_glGenBuffers(gb_GLsizei_t n, gb_GLuint_t* buffers)
+{
+    tb_bool_t traced = gb_gl_tracer_enter(GB_GL_TRACER_KIND_NONE);
+    if (g_tracer.real.glGenBuffers) g_tracer.real.glGenBuffers(n, buffers);
+    else
+    {
+        gb_GLsizei_t i = 0;
+        for (i = 0; i < n; i++) buffers[i] = gb_gl_tracer_object();
+    }
+    if (traced)
+    {
+        gb_gl_tracer_printf("glGenBuffers %d", n);
+        gb_gl_tracer_data(buffers, n * sizeof(gb_GLuint_t));
+        gb_gl_tracer_printf("\n");
+    }
+    gb_gl_tracer_leave();
+}
+static gb_GLvoid_t GB_GL_APICALL gb_gl_tracer_glGenTextures(gb_GLsizei_t n, gb_GLuint_t* textures)
+{
+    tb_bool_t traced = gb_gl_tracer_enter(GB_GL_TRACER_KIND_NONE);
+    if (g_tracer.real.glGenTextures) g_tracer.real.glGenTextures(n, textures);
+    else
+    {
+        gb_GLsizei_t i = 0;
+        for (i = 0; i < n; i++) textures[i] = gb_gl_tracer_object();
+    }
+    if (traced)
+    {
+        gb_gl_tracer_printf("glGenTextures %d", n);
+        gb_gl_tracer_data(textures, n * sizeof(gb_GLuint_t));
+        gb_gl_tracer_printf("\n");
+    }
+    gb_gl_tracer_leave();
+}
+static gb_GLint_t GB_GL_APICALL gb_gl_tracer_glGetAttribLocation(gb_GLuint_t program, gb_GLchar_t const* name)
+{
+    tb_bool_t   traced = gb_gl_tracer_enter(GB_GL_TRACER_KIND_NONE);
+    gb_GLint_t  location = g_tracer.real.glGetAttribLocation? g_tracer.real.glGetAttribLocation(program, name) : (gb_GLint_t)(gb_gl_tracer_object() % GB_GL_TRACER_ATTRIBS_MAXN);
+    if (traced) gb_gl_tracer_printf("glGetAttribLocation %u %s # %d\n", program, name, location);
+    gb_gl_tracer_leave();
+    return location;
+}
+static gb_GLvoid_t GB_GL_APICALL gb_gl_tracer_glGetIntegerv(gb_GLenum_t pname, gb_GLint_t* params)
+{
+    tb_bool_t traced = gb_gl_tracer_enter(GB_GL_TRACER_KIND_NONE);
+    if (g_tracer.real.glGetIntegerv) g_tracer.real.glGetIntegerv(pname, params);
+    else if (params) *params = pname == GB_GL_STENCIL_BITS? 8 : 0;
+    if (traced) gb_gl_tracer_printf("glGetIntegerv 0x%x # %d\n", pname, params? *params : 0);
+    gb_gl_tracer_leave();
+}
+static gb_GLvoid_t GB_GL_APICALL gb_gl_tracer_glGetProgramiv(gb_GLuint_t program, gb_GLenum_t pname, gb_GLint_t* params)
+{
+    tb_bool_t traced = gb_gl_tracer_enter(GB_GL_TRACER_KIND_NONE);
+    if (g_tracer.real.glGetProgramiv) g_tracer.real.glGetProgramiv(program, pname, params);
+    else if (params) *params = pname == GB_GL_LINK_STATUS? GB_GL_TRUE : 0;
+    if (traced) gb_gl_tracer_printf("glGetProgramiv %u 0x%x # %d\n", program, pname, params? *params : 0);
+    gb_gl_tracer_leave();
+}
+static gb_GLvoid_t GB_GL_APICALL gb_gl_tracer_glGetProgramBinary(gb_GLuint_t program, gb_GLsizei_t bufsize, gb_GLsizei_t* length, gb_GLenum_t* format, gb_GLvoid_t* binary)
+{
+    tb_bool_t traced = gb_gl_tracer_enter(GB_GL_TRACER_KIND_NONE);
+    if (g_tracer.real.glGetProgramBinary) g_tracer.real.glGetProgramBinary(program, bufsize, length, format, binary);
+    else if (length) *length = 0;
+    if (traced) gb_gl_tracer_printf("glGetProgramBinary %u %d # %d\n", program, bufsize, length? *length : 0);
+    gb_gl_tracer_leave();
+}
+static gb_GLvoid_t GB_GL_APICALL gb_gl_tracer_glGetProgramInfoLog(gb_GLuint_t program, gb_GLsizei_t bufsize, gb_GLsizei_t* length, gb_GLchar_t* infolog)
+{
+    tb_bool_t traced = gb_gl_tracer_enter(GB_GL_TRACER_KIND_NONE);
+    if (g_tracer.real.glGetProgramInfoLog) g_tracer.real.glGetProgramInfoLog(program, bufsize, length, infolog);
+    else
+    {
+        if (length) *length = 0;
+        if (infolog && bufsize > 0) infolog[0] = '\0';
+    }
+    if (traced) gb_gl_tracer_printf("glGetProgramInfoLog %u %d\n", program, bufsize);
+    gb_gl_tracer_leave();
+}
+static gb_GLvoid_t GB_GL_APICALL gb_gl_tracer_glGetShaderiv(gb_GLuint_t shader, gb_GLenum_t pname, gb_GLint_t* params)
+{
+    tb_bool_t traced = gb_gl_tracer_enter(GB_GL_TRACER_KIND_NONE);
+    if (g_tracer.real.glGetShaderiv) g_tracer.real.glGetShaderiv(shader, pname, params);
+    else if (params) *params = pname == GB_GL_COMPILE_STATUS? GB_GL_TRUE : 0;
+    if (traced) gb_gl_tracer_printf("glGetShaderiv %u 0x%x # %d\n", shader, pname, params? *params : 0);
+    gb_gl_tracer_leave();
+}
+static gb_GLvoid_t GB_GL_APICALL gb_gl_tracer_glGetShaderInfoLog(gb_GLuint_t shader, gb_GLsizei_t bufsize, gb_GLsizei_t* length, gb_GLchar_t* infolog)
+{
+    tb_bool_t traced = gb_gl_tracer_enter(GB_GL_TRACER_KIND_NONE);
+    if (g_tracer.real.glGetShaderInfoLog) g_tracer.real.glGetShaderInfoLog(shader, bufsize, length, infolog);
+    else
+    {
+        if (length) *length = 0;
+        if (infolog && bufsize > 0) infolog[0] = '\0';
+    }
+    if (traced) gb_gl_tracer_printf("glGetShaderInfoLog %u %d\n", shader, bufsize);
+    gb_gl_tracer_leave();
+}
+static gb_GLubyte_t const* GB_GL_APICALL gb_gl_tracer_glGetString(gb_GLenum_t name)
+{
+    tb_bool_t           traced = gb_gl_tracer_enter(GB_GL_TRACER_KIND_NONE);
+    gb_GLubyte_t const* string = tb_null;
+    if (g_tracer.real.glGetString) string = g_tracer.real.glGetString(name);
+    else
+    {
+        switch (name)
+        {
+        case GB_GL_VERSION:     string = (gb_GLubyte_t const*)GB_GL_TRACER_STUB_VERSION;    break;
+        case GB_GL_EXTENSIONS:  string = (gb_GLubyte_t const*)"";                           break;
+        default:                string = (gb_GLubyte_t const*)"gbox";                       break;
+        }
+    }
+    if (traced) gb_gl_tracer_printf("glGetString 0x%x\n", name);
+    gb_gl_tracer_leave();
+    return string;
+}
+static gb_GLint_t GB_GL_APICALL gb_gl_tracer_glGetUniformLocation(gb_GLuint_t program, gb_GLchar_t const* name)
+{
+    tb_bool_t   traced = gb_gl_tracer_enter(GB_GL_TRACER_KIND_NONE);
+    gb_GLint_t  location = g_tracer.real.glGetUniformLocation? g_tracer.real.glGetUniformLocation(program, name) : (gb_GLint_t)gb_gl_tracer_object();
+    if (traced) gb_gl_tracer_printf("glGetUniformLocation %u %s # %d\n", program, name, location);
+    gb_gl_tracer_leave();
+    return location;
+}
+static gb_GLvoid_t GB_GL_APICALL gb_gl_tracer_glHint(gb_GLenum_t target, gb_GLenum_t mode)
+{
+    if (gb_gl_tracer_enter(GB_GL_TRACER_KIND_STATE)) gb_gl_tracer_printf("glHint 0x%x 0x%x\n", target, mode);
+    GB_GL_TRACER_CALL(glHint, (target, mode));
+    gb_gl_tracer_leave();
+}
+static gb_GLboolean_t GB_GL_APICALL gb_gl_tracer_glIsTexture(gb_GLuint_t texture)
+{
+    tb_bool_t       traced = gb_gl_tracer_enter(GB_GL_TRACER_KIND_NONE);
+    gb_GLboolean_t  ok = g_tracer.real.glIsTexture? g_tracer.real.glIsTexture(texture) : (texture? GB_GL_TRUE : GB_GL_FALSE);
+    if (traced) gb_gl_tracer_printf("glIsTexture %u # %u\n", texture, ok);
+    gb_gl_tracer_leave();
+    return ok;
+}
+static gb_GLvoid_t GB_GL_APICALL gb_gl_tracer_glLineWidth(gb_GLfloat_t width)
+{
+    if (gb_gl_tracer_enter(GB_GL_TRACER_KIND_STATE)) gb_gl_tracer_printf("glLineWidth %f\n", width);
+    GB_GL_TRACER_CALL(glLineWidth, (width));
+    gb_gl_tracer_leave();
+}
+static gb_GLvoid_t GB_GL_APICALL gb_gl_tracer_glLinkProgram(gb_GLuint_t program)
+{
+    if (gb_gl_tracer_enter(GB_GL_TRACER_KIND_NONE)) gb_gl_tracer_printf("glLinkProgram %u\n", program);
+    GB_GL_TRACER_CALL(glLinkProgram, (program));
+    gb_gl_tracer_leave();
+}
+static gb_GLvoid_t GB_GL_APICALL gb_gl_tracer_glLoadIdentity(gb_GLvoid_t)
+{
+    if (gb_gl_tracer_enter(GB_GL_TRACER_KIND_STATE)) gb_gl_tracer_printf("glLoadIdentity\n");
+    GB_GL_TRACER_CALL(glLoadIdentity, ());
+    gb_gl_tracer_leave();
+}
+static gb_GLvoid_t GB_GL_APICALL gb_gl_tracer_glLoadMatrixf(gb_GLfloat_t const* matrix)
+{
+    if (gb_gl_tracer_enter(GB_GL_TRACER_KIND_STATE))
+    {
+        gb_gl_tracer_printf("glLoadMatrixf");
+        gb_gl_tracer_data(matrix, 16 * sizeof(gb_GLfloat_t));
+        gb_gl_tracer_printf("\n");
+    }
+    GB_GL_TRACER_CALL(glLoadMatrixf, (matrix));
+    gb_gl_tracer_leave();
+}
+static gb_GLvoid_t GB_GL_APICALL gb_gl_tracer_glMatrixMode(gb_GLenum_t mode)
+{
+    if (gb_gl_tracer_enter(GB_GL_TRACER_KIND_STATE)) gb_gl_tracer_printf("glMatrixMode 0x%x\n", mode);
+    GB_GL_TRACER_CALL(glMatrixMode, (mode));
+    gb_gl_tracer_leave();
+}
+static gb_GLvoid_t GB_GL_APICALL gb_gl_tracer_glMultMatrixf(gb_GLfloat_t const* matrix)
+{
+    if (gb_gl_tracer_enter(GB_GL_TRACER_KIND_STATE))
+    {
+        gb_gl_tracer_printf("glMultMatrixf");
+        gb_gl_tracer_data(matrix, 16 * sizeof(gb_GLfloat_t));
+        gb_gl_tracer_printf("\n");
+    }
+    GB_GL_TRACER_CALL(glMultMatrixf, (matrix));
+    gb_gl_tracer_leave();
+}
+static gb_GLvoid_t GB_GL_APICALL gb_gl_tracer_glOrtho(gb_GLdouble_t left, gb_GLdouble_t right, gb_GLdouble_t bottom, gb_GLdouble_t top, gb_GLdouble_t nearp, gb_GLdouble_t farp)
+{
+    if (gb_gl_tracer_enter(GB_GL_TRACER_KIND_STATE)) gb_gl_tracer_printf("glOrtho %f %f %f %f %f %f\n", left, right, bottom, top, nearp, farp);
+    GB_GL_TRACER_CALL(glOrtho, (left, right, bottom, top, nearp, farp));
+    gb_gl_tracer_leave();
+}
+static gb_GLvoid_t GB_GL_APICALL gb_gl_tracer_glOrthof(gb_GLfloat_t left, gb_GLfloat_t right, gb_GLfloat_t bottom, gb_GLfloat_t top, gb_GLfloat_t nearp, gb_GLfloat_t farp)
+{
+    if (gb_gl_tracer_enter(GB_GL_TRACER_KIND_STATE)) gb_gl_tracer_printf("glOrthof %f %f %f %f %f %f\n", left, right, bottom, top, nearp, farp);
+    GB_GL_TRACER_CALL(glOrthof, (left, right, bottom, top, nearp, farp));
+    gb_gl_tracer_leave();
+}
+static gb_GLvoid_t GB_GL_APICALL gb_gl_tracer_glPixelStorei(gb_GLenum_t pname, gb_GLint_t param)
+{
+    if (gb_gl_tracer_enter(GB_GL_TRACER_KIND_STATE)) gb_gl_tracer_printf("glPixelStorei 0x%x %d\n", pname, param);
+    GB_GL_TRACER_CALL(glPixelStorei, (pname, param));
+    gb_gl_tracer_leave();
+
+    // save the unpack alignment for computing the texture size
+    if (pname == GB_GL_UNPACK_ALIGNMENT) g_tracer.unpack_alignment = param;
+}
+static gb_GLvoid_t GB_GL_APICALL gb_gl_tracer_glPopMatrix(gb_GLvoid_t)
+{
+    if (gb_gl_tracer_enter(GB_GL_TRACER_KIND_STATE)) gb_gl_tracer_printf("glPopMatrix\n");
+    GB_GL_TRACER_CALL(glPopMatrix, ());
+    gb_gl_tracer_leave();
+}
+static gb_GLvoid_t GB_GL_APICALL gb_gl_tracer_glProgramBinary(gb_GLuint_t program, gb_GLenum_t format, gb_GLvoid_t const* binary, gb_GLsizei_t length)
+{
+    if (gb_gl_tracer_enter(GB_GL_TRACER_KIND_NONE))
+    {
+        gb_gl_tracer_printf("glProgramBinary %u 0x%x", program, format);
+        gb_gl_tracer_data(binary, length);
+        gb_gl_tracer_printf(" %d\n", length);
+    }
+    GB_GL_TRACER_CALL(glProgramBinary, (program, format, binary, length));
+    gb_gl_tracer_leave();
+}
+static gb_GLvoid_t GB_GL_APICALL gb_gl_tracer_glProgramParameteri(gb_GLuint_t program, gb_GLenum_t pname, gb_GLint_t value)
+{
+    if (gb_gl_tracer_enter(GB_GL_TRACER_KIND_NONE)) gb_gl_tracer_printf("glProgramParameteri %u 0x%x %d\n", program, pname, value);
+    GB_GL_TRACER_CALL(glProgramParameteri, (program, pname, value));
+    gb_gl_tracer_leave();
+}
+static gb_GLvoid_t GB_GL_APICALL gb_gl_tracer_glPushMatrix(gb_GLvoid_t)
+{
+    if (gb_gl_tracer_enter(GB_GL_TRACER_KIND_STATE)) gb_gl_tracer_printf("glPushMatrix\n");
+    GB_GL_TRACER_CALL(glPushMatrix, ());
+    gb_gl_tracer_leave();
+}
+static gb_GLvoid_t GB_GL_APICALL gb_gl_tracer_glRotatef(gb_GLfloat_t angle, gb_GLfloat_t x, gb_GLfloat_t y, gb_GLfloat_t z)
+{
+    if (gb_gl_tracer_enter(GB_GL_TRACER_KIND_STATE)) gb_gl_tracer_printf("glRotatef %f %f %f %f\n", angle, x, y, z);
+    GB_GL_TRACER_CALL(glRotatef, (angle, x, y, z));
+    gb_gl_tracer_leave();
+}
+static gb_GLvoid_t GB_GL_APICALL gb_gl_tracer_glScalef(gb_GLfloat_t x, gb_GLfloat_t y, gb_GLfloat_t z)
+{
+    if (gb_gl_tracer_enter(GB_GL_TRACER_KIND_STATE)) gb_gl_tracer_printf("glScalef %f %f %f\n", x, y, z);
+    GB_GL_TRACER_CALL(glScalef, (x, y, z));
+    gb_gl_tracer_leave();
+}
+static gb_GLvoid_t GB_GL_APICALL gb_gl_tracer_glScissor(gb_GLint_t x, gb_GLint_t y, gb_GLsizei_t width, gb_GLsizei_t height)
+{
+    if (gb_gl_tracer_enter(GB_GL_TRACER_KIND_STATE)) gb_gl_tracer_printf("glScissor %d %d %d %d\n", x, y, width, height);
+    GB_GL_TRACER_CALL(glScissor, (x, y, width, height));
+    gb_gl_tracer_leave();
+}
+static gb_GLvoid_t GB_GL_APICALL gb_gl_tracer_glShaderSource(gb_GLuint_t shader, gb_GLsizei_t count, gb_GLchar_t const* const* string, const gb_GLint_t* length)
+{
+    if (gb_gl_tracer_enter(GB_GL_TRACER_KIND_NONE))
+    {
+        // trace it with all source strings
+        gb_GLsizei_t i = 0;
+        gb_gl_tracer_printf("glShaderSource %u %d", shader, count);
+        for (i = 0; i < count && string; i++)
+            gb_gl_tracer_data(string[i], string[i]? ((length && length[i] >= 0)? (tb_size_t)length[i] : tb_strlen(string[i])) : 0);
+        gb_gl_tracer_printf("\n");
+    }
+    GB_GL_TRACER_CALL(glShaderSource, (shader, count, string, length));
+    gb_gl_tracer_leave();
+}
+static gb_GLvoid_t GB_GL_APICALL gb_gl_tracer_glStencilFunc(gb_GLenum_t func, gb_GLint_t ref, gb_GLuint_t mask)
+{
+    if (gb_gl_tracer_enter(GB_GL_TRACER_KIND_STATE)) gb_gl_tracer_printf("glStencilFunc 0x%x %d 0x%x\n", func, ref, mask);
+    GB_GL_TRACER_CALL(glStencilFunc, (func, ref, mask));
+    gb_gl_tracer_leave();
+}
+static gb_GLvoid_t GB_GL_APICALL gb_gl_tracer_glStencilMask(gb_GLuint_t mask)
+{
+    if (gb_gl_tracer_enter(GB_GL_TRACER_KIND_STATE)) gb_gl_tracer_printf("glStencilMask 0x%x\n", mask);
+    GB_GL_TRACER_CALL(glStencilMask, (mask));
+    gb_gl_tracer_leave();
+}
+static gb_GLvoid_t GB_GL_APICALL gb_gl_tracer_glStencilOp(gb_GLenum_t fail, gb_GLenum_t zfail, gb_GLenum_t zpass)
+{
+    if (gb_gl_tracer_enter(GB_GL_TRACER_KIND_STATE)) gb_gl_tracer_printf("glStencilOp 0x%x 0x%x 0x%x\n", fail, zfail, zpass);
+    GB_GL_TRACER_CALL(glStencilOp, (fail, zfail, zpass));
+    gb_gl_tracer_leave();
+}
+static gb_GLvoid_t GB_GL_APICALL gb_gl_tracer_glStencilOpSeparate(gb_GLenum_t face, gb_GLenum_t fail, gb_GLenum_t zfail, gb_GLenum_t zpass)
+{
+    if (gb_gl_tracer_enter(GB_GL_TRACER_KIND_STATE)) gb_gl_tracer_printf("glStencilOpSeparate 0x%x 0x%x 0x%x 0x%x\n", face, fail, zfail, zpass);
+    GB_GL_TRACER_CALL(glStencilOpSeparate, (face, fail, zfail, zpass));
+    gb_gl_tracer_leave();
+}
+static gb_GLvoid_t GB_GL_APICALL gb_gl_tracer_glTexCoordPointer(gb_GLint_t size, gb_GLenum_t type, gb_GLsizei_t stride, gb_GLvoid_t const* ptr)
+{
+    if (gb_gl_tracer_enter(GB_GL_TRACER_KIND_STATE))
+    {
+        gb_gl_tracer_printf("glTexCoordPointer %d 0x%x %d", size, type, stride);
+        gb_gl_tracer_pointer(g_tracer.array_buffer, ptr);
+        gb_gl_tracer_printf("\n");
+    }
+    GB_GL_TRACER_CALL(glTexCoordPointer, (size, type, stride, ptr));
+    gb_gl_tracer_leave();
+    gb_gl_tracer_array_pointer(gb_gl_tracer_array_index(GB_GL_TEXTURE_COORD_ARRAY), size, type, stride, ptr);
+}
+static gb_GLvoid_t GB_GL_APICALL gb_gl_tracer_glTexEnvi(gb_GLenum_t target, gb_GLenum_t pname, gb_GLint_t param)
+{
+    if (gb_gl_tracer_enter(GB_GL_TRACER_KIND_STATE)) gb_gl_tracer_printf("glTexEnvi 0x%x 0x%x %d\n", target, pname, param);
+    GB_GL_TRACER_CALL(glTexEnvi, (target, pname, param));
+    gb_gl_tracer_leave();
+}
+static gb_GLvoid_t GB_GL_APICALL gb_gl_tracer_glTexImage2D(gb_GLenum_t target, gb_GLint_t level, gb_GLint_t internalFormat, gb_GLsizei_t width, gb_GLsizei_t height, gb_GLint_t border, gb_GLenum_t format, gb_GLenum_t type, gb_GLvoid_t const* pixels)
+{
+    if (gb_gl_tracer_enter(GB_GL_TRACER_KIND_UPLOAD))
+    {
+        // update the uploaded bytes
+        tb_size_t size = gb_gl_tracer_texture_size(width, height, format, type);
+        if (pixels) g_tracer.stats_frame.uploads += size;
+
+        // trace it
+        gb_gl_tracer_printf("glTexImage2D 0x%x %d 0x%x %d %d %d 0x%x 0x%x", target, level, internalFormat, width, height, border, format, type);
+        gb_gl_tracer_data(pixels, size);
+        gb_gl_tracer_printf("\n");
+    }
+    GB_GL_TRACER_CALL(glTexImage2D, (target, level, internalFormat, width, height, border, format, type, pixels));
+    gb_gl_tracer_leave();
+}
+static gb_GLvoid_t GB_GL_APICALL gb_gl_tracer_glTexParameterf(gb_GLenum_t target, gb_GLenum_t pname, gb_GLfloat_t param)
+{
+    if (gb_gl_tracer_enter(GB_GL_TRACER_KIND_STATE)) gb_gl_tracer_printf("glTexParameterf 0x%x 0x%x %f\n", target, pname, param);
+    GB_GL_TRACER_CALL(glTexParameterf, (target, pname, param));
+    gb_gl_tracer_leave();
+}
+static gb_GLvoid_t GB_GL_APICALL gb_gl_tracer_glTexParameteri(gb_GLenum_t target, gb_GLenum_t pname, gb_GLint_t param)
+{
+    if (gb_gl_tracer_enter(GB_GL_TRACER_KIND_STATE)) gb_gl_tracer_printf("glTexParameteri 0x%x 0x%x %d\n", target, pname, param);
+    GB_GL_TRACER_CALL(glTexParameteri, (target, pname, param));
+    gb_gl_tracer_leave();
+}
+static gb_GLvoid_t GB_GL_APICALL gb_gl_tracer_glTexSubImage2D(gb_GLenum_t target, gb_GLint_t level, gb_GLint_t xoffset, gb_GLint_t yoffset, gb_GLsizei_t width, gb_GLsizei_t height, gb_GLenum_t format, gb_GLenum_t type, gb_GLvoid_t const* pixels)
+{
+    if (gb_gl_tracer_enter(GB_GL_TRACER_KIND_UPLOAD))
+    {
+        // update the uploaded bytes
+        tb_size_t size = gb_gl_tracer_texture_size(width, height, format, type);
+        if (pixels) g_tracer.stats_frame.uploads += size;
+
+        // trace it
+        gb_gl_tracer_printf("glTexSubImage2D 0x%x %d %d %d %d %d 0x%x 0x%x", target, level, xoffset, yoffset, width, height, format, type);
+        gb_gl_tracer_data(pixels, size);
+        gb_gl_tracer_printf("\n");
+    }
+    GB_GL_TRACER_CALL(glTexSubImage2D, (target, level, xoffset, yoffset, width, height, format, type, pixels));
+    gb_gl_tracer_leave();
+}
+static gb_GLvoid_t GB_GL_APICALL gb_gl_tracer_glTranslatef(gb_GLfloat_t x, gb_GLfloat_t y, gb_GLfloat_t z)
+{
+    if (gb_gl_tracer_enter(GB_GL_TRACER_KIND_STATE)) gb_gl_tracer_printf("glTranslatef %f %f %f\n", x, y, z);
+    GB_GL_TRACER_CALL(glTranslatef, (x, y, z));
+    gb_gl_tracer_leave();
+}
+static gb_GLvoid_t GB_GL_APICALL gb_gl_tracer_glUniform1i(gb_GLint_t location, gb_GLint_t x)
+{
+    if (gb_gl_tracer_enter(GB_GL_TRACER_KIND_STATE)) gb_gl_tracer_printf("glUniform1i %d %d\n", location, x);
+    GB_GL_TRACER_CALL(glUniform1i, (location, x));
+    gb_gl_tracer_leave();
+}
+static gb_GLvoid_t GB_GL_APICALL gb_gl_tracer_glUniform4f(gb_GLint_t location, gb_GLfloat_t x, gb_GLfloat_t y, gb_GLfloat_t z, gb_GLfloat_t w)
+{
+    if (gb_gl_tracer_enter(GB_GL_TRACER_KIND_STATE)) gb_gl_tracer_printf("glUniform4f %d %f %f %f %f\n", location, x, y, z, w);
+    GB_GL_TRACER_CALL(glUniform4f, (location, x, y, z, w));
+    gb_gl_tracer_leave();
+}
+static gb_GLvoid_t GB_GL_APICALL gb_gl_tracer_glUniformMatrix4fv(gb_GLint_t location, gb_GLsizei_t count, gb_GLboolean_t transpose, gb_GLfloat_t const* value)
+{
+    if (gb_gl_tracer_enter(GB_GL_TRACER_KIND_STATE))
+    {
+        gb_gl_tracer_printf("glUniformMatrix4fv %d %d %u", location, count, transpose);
+        gb_gl_tracer_data(value, count * 16 * sizeof(gb_GLfloat_t));
+        gb_gl_tracer_printf("\n");
+    }
+    GB_GL_TRACER_CALL(glUniformMatrix4fv, (location, count, transpose, value));
+    gb_gl_tracer_leave();
+}
+static gb_GLvoid_t GB_GL_APICALL gb_gl_tracer_glUseProgram(gb_GLuint_t program)
+{
+    if (gb_gl_tracer_enter(GB_GL_TRACER_KIND_STATE)) gb_gl_tracer_printf("glUseProgram %u\n", program);
+    GB_GL_TRACER_CALL(glUseProgram, (program));
+    gb_gl_tracer_leave();
+}
+static gb_GLvoid_t GB_GL_APICALL gb_gl_tracer_glVertexAttrib4f(gb_GLuint_t indx, gb_GLfloat_t x, gb_GLfloat_t y, gb_GLfloat_t z, gb_GLfloat_t w)
+{
+    if (gb_gl_tracer_enter(GB_GL_TRACER_KIND_STATE)) gb_gl_tracer_printf("glVertexAttrib4f %u %f %f %f %f\n", indx, x, y, z, w);
+    GB_GL_TRACER_CALL(glVertexAttrib4f, (indx, x, y, z, w));
+    gb_gl_tracer_leave();
+}
+static gb_GLvoid_t GB_GL_APICALL gb_gl_tracer_glVertexAttribPointer(gb_GLuint_t indx, gb_GLint_t size, gb_GLenum_t type, gb_GLboolean_t normalized, gb_GLsizei_t stride, gb_GLvoid_t const* ptr)
+{
+    if (gb_gl_tracer_enter(GB_GL_TRACER_KIND_STATE))
+    {
+        gb_gl_tracer_printf("glVertexAttribPointer %u %d 0x%x %u %d", indx, size, type, normalized, stride);
+        gb_gl_tracer_pointer(g_tracer.array_buffer, ptr);
+        gb_gl_tracer_printf("\n");
+    }
+    GB_GL_TRACER_CALL(glVertexAttribPointer, (indx, size, type, normalized, stride, ptr));
+    gb_gl_tracer_leave();
+    if (indx < GB_GL_TRACER_ATTRIBS_MAXN) gb_gl_tracer_array_pointer(indx, size, type, stride, ptr);
+}
+static gb_GLvoid_t GB_GL_APICALL gb_gl_tracer_glVertexPointer(gb_GLint_t size, gb_GLenum_t type, gb_GLsizei_t stride, gb_GLvoid_t const* ptr)
+{
+    if (gb_gl_tracer_enter(GB_GL_TRACER_KIND_STATE))
+    {
+        gb_gl_tracer_printf("glVertexPointer %d 0x%x %d", size, type, stride);
+        gb_gl_tracer_pointer(g_tracer.array_buffer, ptr);
+        gb_gl_tracer_printf("\n");
+    }
+    GB_GL_TRACER_CALL(glVertexPointer, (size, type, stride, ptr));
+    gb_gl_tracer_leave();
+    gb_gl_tracer_array_pointer(gb_gl_tracer_array_index(GB_GL_VERTEX_ARRAY), size, type, stride, ptr);
+}
+static gb_GLvoid_t GB_GL_APICALL gb_gl_tracer_glViewport(gb_GLint_t x, gb_GLint_t y, gb_GLsizei_t width, gb_GLsizei_t height)
+{
+    if (gb_gl_tracer_enter(GB_GL_TRACER_KIND_STATE)) gb_gl_tracer_printf("glViewport %d %d %d %d\n", x, y, width, height);
+    GB_GL_TRACER_CALL(glViewport, (x, y, width, height));
+    gb_gl_tracer_leave();
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_bool_t gb_gl_tracer_init(tb_size_t mode, tb_char_t const* path)
+{
+    // check
+    tb_assert_and_check_return_val(mode == GB_GL_TRACER_MODE_TRACE || mode == GB_GL_TRACER_MODE_STUB, tb_false);
+
+    // exit the previous tracer first
+    gb_gl_tracer_exit();
+
+    // done
+    tb_bool_t ok = tb_false;
+    do
+    {
+        // init mode
+        g_tracer.mode = mode;
+
+        // init the trace file
+        if (path)
+        {
+            g_tracer.stream = tb_stream_init_from_file(path, TB_FILE_MODE_RW | TB_FILE_MODE_CREAT | TB_FILE_MODE_TRUNC);
+            tb_assert_and_check_break(g_tracer.stream);
+
+            // open it
+            if (!tb_stream_open(g_tracer.stream)) break;
+
+            // write head
+            gb_gl_tracer_printf("# gbox gl trace: %s\n", mode == GB_GL_TRACER_MODE_STUB? "stub" : "trace");
+        }
+
+        // the gl interfaces have been loaded? wrap them now
+        if (mode == GB_GL_TRACER_MODE_TRACE && gb_glGetString && !gb_gl_tracer_hook()) break;
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // failed?
+    if (!ok) gb_gl_tracer_exit();
+
+    // ok?
+    return ok;
+}
+tb_void_t gb_gl_tracer_exit()
+{
+    // restore the gl interfaces
+    GB_GL_TRACER_UNHOOK(glActiveTexture);
+    GB_GL_TRACER_UNHOOK(glAlphaFunc);
+    GB_GL_TRACER_UNHOOK(glAttachShader);
+    GB_GL_TRACER_UNHOOK(glBindBuffer);
+    GB_GL_TRACER_UNHOOK(glBindTexture);
+    GB_GL_TRACER_UNHOOK(glBlendFunc);
+    GB_GL_TRACER_UNHOOK(glBufferData);
+    GB_GL_TRACER_UNHOOK(glBufferSubData);
+    GB_GL_TRACER_UNHOOK(glClear);
+    GB_GL_TRACER_UNHOOK(glClearColor);
+    GB_GL_TRACER_UNHOOK(glClearStencil);
+    GB_GL_TRACER_UNHOOK(glColor4f);
+    GB_GL_TRACER_UNHOOK(glColorMask);
+    GB_GL_TRACER_UNHOOK(glColorPointer);
+    GB_GL_TRACER_UNHOOK(glCompileShader);
+    GB_GL_TRACER_UNHOOK(glCreateProgram);
+    GB_GL_TRACER_UNHOOK(glCreateShader);
+    GB_GL_TRACER_UNHOOK(glDeleteBuffers);
+    GB_GL_TRACER_UNHOOK(glDeleteProgram);
+    GB_GL_TRACER_UNHOOK(glDeleteShader);
+    GB_GL_TRACER_UNHOOK(glDeleteTextures);
+    GB_GL_TRACER_UNHOOK(glDisable);
+    GB_GL_TRACER_UNHOOK(glDisableClientState);
+    GB_GL_TRACER_UNHOOK(glDisableVertexAttribArray);
+    GB_GL_TRACER_UNHOOK(glDrawArrays);
+    GB_GL_TRACER_UNHOOK(glDrawElements);
+    GB_GL_TRACER_UNHOOK(glEnable);
+    GB_GL_TRACER_UNHOOK(glEnableClientState);
+    GB_GL_TRACER_UNHOOK(glEnableVertexAttribArray);
+    GB_GL_TRACER_UNHOOK(glGenBuffers);
+    GB_GL_TRACER_UNHOOK(glGenTextures);
+    GB_GL_TRACER_UNHOOK(glGetAttribLocation);
+    GB_GL_TRACER_UNHOOK(glGetIntegerv);
+    GB_GL_TRACER_UNHOOK(glGetProgramBinary);
+    GB_GL_TRACER_UNHOOK(glGetProgramiv);
+    GB_GL_TRACER_UNHOOK(glGetProgramInfoLog);
+    GB_GL_TRACER_UNHOOK(glGetShaderiv);
+    GB_GL_TRACER_UNHOOK(glGetShaderInfoLog);
+    GB_GL_TRACER_UNHOOK(glGetString);
+    GB_GL_TRACER_UNHOOK(glGetUniformLocation);
+    GB_GL_TRACER_UNHOOK(glHint);
+    GB_GL_TRACER_UNHOOK(glIsTexture);
+    GB_GL_TRACER_UNHOOK(glLineWidth);
+    GB_GL_TRACER_UNHOOK(glLinkProgram);
+    GB_GL_TRACER_UNHOOK(glLoadIdentity);
+    GB_GL_TRACER_UNHOOK(glLoadMatrixf);
+    GB_GL_TRACER_UNHOOK(glMatrixMode);
+    GB_GL_TRACER_UNHOOK(glMultMatrixf);
+    GB_GL_TRACER_UNHOOK(glOrtho);
+    GB_GL_TRACER_UNHOOK(glOrthof);
+    GB_GL_TRACER_UNHOOK(glPixelStorei);
+    GB_GL_TRACER_UNHOOK(glPopMatrix);
+    GB_GL_TRACER_UNHOOK(glProgramBinary);
+    GB_GL_TRACER_UNHOOK(glProgramParameteri);
+    GB_GL_TRACER_UNHOOK(glPushMatrix);
+    GB_GL_TRACER_UNHOOK(glRotatef);
+    GB_GL_TRACER_UNHOOK(glScalef);
+    GB_GL_TRACER_UNHOOK(glScissor);
+    GB_GL_TRACER_UNHOOK(glShaderSource);
+    GB_GL_TRACER_UNHOOK(glStencilFunc);
+    GB_GL_TRACER_UNHOOK(glStencilMask);
+    GB_GL_TRACER_UNHOOK(glStencilOp);
+    GB_GL_TRACER_UNHOOK(glStencilOpSeparate);
+    GB_GL_TRACER_UNHOOK(glTexCoordPointer);
+    GB_GL_TRACER_UNHOOK(glTexEnvi);
+    GB_GL_TRACER_UNHOOK(glTexImage2D);
+    GB_GL_TRACER_UNHOOK(glTexParameterf);
+    GB_GL_TRACER_UNHOOK(glTexParameteri);
+    GB_GL_TRACER_UNHOOK(glTexSubImage2D);
+    GB_GL_TRACER_UNHOOK(glTranslatef);
+    GB_GL_TRACER_UNHOOK(glUniform1i);
+    GB_GL_TRACER_UNHOOK(glUniform4f);
+    GB_GL_TRACER_UNHOOK(glUniformMatrix4fv);
+    GB_GL_TRACER_UNHOOK(glUseProgram);
+    GB_GL_TRACER_UNHOOK(glVertexAttrib4f);
+    GB_GL_TRACER_UNHOOK(glVertexAttribPointer);
+    GB_GL_TRACER_UNHOOK(glVertexPointer);
+    GB_GL_TRACER_UNHOOK(glViewport);
+
+    // exit the trace file
+    if (g_tracer.stream) tb_stream_exit(g_tracer.stream);
+
+    // clear it
+    tb_memset(&g_tracer, 0, sizeof(gb_gl_tracer_t));
+}
+tb_size_t gb_gl_tracer_mode()
+{
+    return g_tracer.mode;
+}
+tb_bool_t gb_gl_tracer_hook()
+{
+    // check
+    tb_assert_and_check_return_val(g_tracer.mode, tb_false);
+
+    // wrap the gl interfaces
+    GB_GL_TRACER_HOOK(glActiveTexture);
+    GB_GL_TRACER_HOOK(glAlphaFunc);
+    GB_GL_TRACER_HOOK(glAttachShader);
+    GB_GL_TRACER_HOOK(glBindBuffer);
+    GB_GL_TRACER_HOOK(glBindTexture);
+    GB_GL_TRACER_HOOK(glBlendFunc);
+    GB_GL_TRACER_HOOK(glBufferData);
+    GB_GL_TRACER_HOOK(glBufferSubData);
+    GB_GL_TRACER_HOOK(glClear);
+    GB_GL_TRACER_HOOK(glClearColor);
+    GB_GL_TRACER_HOOK(glClearStencil);
+    GB_GL_TRACER_HOOK(glColor4f);
+    GB_GL_TRACER_HOOK(glColorMask);
+    GB_GL_TRACER_HOOK(glColorPointer);
+    GB_GL_TRACER_HOOK(glCompileShader);
+    GB_GL_TRACER_HOOK(glCreateProgram);
+    GB_GL_TRACER_HOOK(glCreateShader);
+    GB_GL_TRACER_HOOK(glDeleteBuffers);
+    GB_GL_TRACER_HOOK(glDeleteProgram);
+    GB_GL_TRACER_HOOK(glDeleteShader);
+    GB_GL_TRACER_HOOK(glDeleteTextures);
+    GB_GL_TRACER_HOOK(glDisable);
+    GB_GL_TRACER_HOOK(glDisableClientState);
+    GB_GL_TRACER_HOOK(glDisableVertexAttribArray);
+    GB_GL_TRACER_HOOK(glDrawArrays);
+    GB_GL_TRACER_HOOK(glDrawElements);
+    GB_GL_TRACER_HOOK(glEnable);
+    GB_GL_TRACER_HOOK(glEnableClientState);
+    GB_GL_TRACER_HOOK(glEnableVertexAttribArray);
+    GB_GL_TRACER_HOOK(glGenBuffers);
+    GB_GL_TRACER_HOOK(glGenTextures);
+    GB_GL_TRACER_HOOK(glGetAttribLocation);
+    GB_GL_TRACER_HOOK(glGetIntegerv);
+    GB_GL_TRACER_HOOK(glGetProgramBinary);
+    GB_GL_TRACER_HOOK(glGetProgramiv);
+    GB_GL_TRACER_HOOK(glGetProgramInfoLog);
+    GB_GL_TRACER_HOOK(glGetShaderiv);
+    GB_GL_TRACER_HOOK(glGetShaderInfoLog);
+    GB_GL_TRACER_HOOK(glGetString);
+    GB_GL_TRACER_HOOK(glGetUniformLocation);
+    GB_GL_TRACER_HOOK(glHint);
+    GB_GL_TRACER_HOOK(glIsTexture);
+    GB_GL_TRACER_HOOK(glLineWidth);
+    GB_GL_TRACER_HOOK(glLinkProgram);
+    GB_GL_TRACER_HOOK(glLoadIdentity);
+    GB_GL_TRACER_HOOK(glLoadMatrixf);
+    GB_GL_TRACER_HOOK(glMatrixMode);
+    GB_GL_TRACER_HOOK(glMultMatrixf);
+    GB_GL_TRACER_HOOK(glOrtho);
+    GB_GL_TRACER_HOOK(glOrthof);
+    GB_GL_TRACER_HOOK(glPixelStorei);
+    GB_GL_TRACER_HOOK(glPopMatrix);
+    GB_GL_TRACER_HOOK(glProgramBinary);
+    GB_GL_TRACER_HOOK(glProgramParameteri);
+    GB_GL_TRACER_HOOK(glPushMatrix);
+    GB_GL_TRACER_HOOK(glRotatef);
+    GB_GL_TRACER_HOOK(glScalef);
+    GB_GL_TRACER_HOOK(glScissor);
+    GB_GL_TRACER_HOOK(glShaderSource);
+    GB_GL_TRACER_HOOK(glStencilFunc);
+    GB_GL_TRACER_HOOK(glStencilMask);
+    GB_GL_TRACER_HOOK(glStencilOp);
+    GB_GL_TRACER_HOOK(glStencilOpSeparate);
+    GB_GL_TRACER_HOOK(glTexCoordPointer);
+    GB_GL_TRACER_HOOK(glTexEnvi);
+    GB_GL_TRACER_HOOK(glTexImage2D);
+    GB_GL_TRACER_HOOK(glTexParameterf);
+    GB_GL_TRACER_HOOK(glTexParameteri);
+    GB_GL_TRACER_HOOK(glTexSubImage2D);
+    GB_GL_TRACER_HOOK(glTranslatef);
+    GB_GL_TRACER_HOOK(glUniform1i);
+    GB_GL_TRACER_HOOK(glUniform4f);
+    GB_GL_TRACER_HOOK(glUniformMatrix4fv);
+    GB_GL_TRACER_HOOK(glUseProgram);
+    GB_GL_TRACER_HOOK(glVertexAttrib4f);
+    GB_GL_TRACER_HOOK(glVertexAttribPointer);
+    GB_GL_TRACER_HOOK(glVertexPointer);
+    GB_GL_TRACER_HOOK(glViewport);
+
+    // ok
+    return tb_true;
+}
+tb_void_t gb_gl_tracer_frame()
+{
+    // no tracer?
+    tb_check_return(g_tracer.mode);
+
+    // trace the frame stats
+    gb_gl_tracer_stats_ref_t frame = &g_tracer.stats_frame;
+    gb_gl_tracer_printf( "# frame %lu: calls %lu, draws %lu, vertices %lu, uploads %lu, states %lu\n"
+                    ,   g_tracer.frame + 1, frame->calls, frame->draws, frame->vertices, frame->uploads, frame->states);
+
+    // trace it
+    tb_trace_d("frame %lu: calls %lu, draws %lu, vertices %lu, uploads %lu, states %lu"
+            ,   g_tracer.frame + 1, frame->calls, frame->draws, frame->vertices, frame->uploads, frame->states);
+
+    // accumulate the total stats
+    gb_gl_tracer_stats_ref_t total = &g_tracer.stats_total;
+    total->calls    += frame->calls;
+    total->draws    += frame->draws;
+    total->vertices += frame->vertices;
+    total->uploads  += frame->uploads;
+    total->states   += frame->states;
+
+    // reset the frame stats
+    tb_memset(frame, 0, sizeof(gb_gl_tracer_stats_t));
+    g_tracer.frame++;
+}
+tb_void_t gb_gl_tracer_stats(gb_gl_tracer_stats_ref_t frame, gb_gl_tracer_stats_ref_t total)
+{
+    // the stats of the current frame
+    if (frame) *frame = g_tracer.stats_frame;
+
+    // the stats of all frames, include the current frame
+    if (total)
+    {
+        total->calls    = g_tracer.stats_total.calls + g_tracer.stats_frame.calls;
+        total->draws    = g_tracer.stats_total.draws + g_tracer.stats_frame.draws;
+        total->vertices = g_tracer.stats_total.vertices + g_tracer.stats_frame.vertices;
+        total->uploads  = g_tracer.stats_total.uploads + g_tracer.stats_frame.uploads;
+        total->states   = g_tracer.stats_total.states + g_tracer.stats_frame.states;
+    }
+}
@@ -0,0 +1,137 @@
+/*!The Graphic Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        tracer.h
+ * @ingroup     core
+ *
+ */
+#ifndef GB_CORE_DEVICE_GL_TRACER_H
+#define GB_CORE_DEVICE_GL_TRACER_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the gl tracer mode enum
+typedef enum __gb_gl_tracer_mode_e
+{
+    GB_GL_TRACER_MODE_NONE      = 0     //!< disabled
+,   GB_GL_TRACER_MODE_TRACE     = 1     //!< wrap the loaded gl interfaces and pass all calls to the gl context
+,   GB_GL_TRACER_MODE_STUB      = 2     //!< wrap the gl interfaces without loading them, no gl context is needed
+
+}gb_gl_tracer_mode_e;
+
+// the gl tracer stats type
+typedef struct __gb_gl_tracer_stats_t
+{
+    // the gl call count
+    tb_size_t           calls;
+
+    // the draw call count
+    tb_size_t           draws;
+
+    // the submitted vertex count of all draw calls
+    tb_size_t           vertices;
+
+    // the uploaded bytes of the buffers and textures
+    tb_size_t           uploads;
+
+    // the state change count
+    tb_size_t           states;
+
+}gb_gl_tracer_stats_t, *gb_gl_tracer_stats_ref_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interface
+ */
+
+/* init the gl tracer
+ *
+ * it need be called before initing the gl device,
+ * and the gl interfaces will be wrapped after they are loaded by gb_gl_interface_load()
+ *
+ * the trace file is a replayable text trace, one gl call per line:
+ *
+ * <pre>
+ * glBlendFunc 0x302 0x303
+ * glBufferData 0x8892 64 {00004040...} 0x88e0
+ * glVertexAttribPointer 0 2 0x1406 0 8 +0
+ * glDrawElements 0x5 6 0x1403 +0
+ * # frame 1: calls 12, draws 1, vertices 4, uploads 76, states 7
+ * </pre>
+ *
+ * - the enums are hexadecimal and the other integers and floats are decimal
+ * - {..} is the hexadecimal data of the client memory, null is the null pointer
+ * - +n is the offset into the bound buffer object
+ * - * is the client array whose data is unknown until drawing,
+ *   the data will be written before the draw call by the pseudo call:
+ *   glArrayData <array> {..}, the array is the attribute index or the client state enum
+ * - # is the comment line, the frame stats line is written after flushing the device
+ *
+ * @param mode          the tracer mode
+ * @param path          the trace file path, only counting the stats if be null
+ *
+ * @return              tb_true or tb_false
+ */
+tb_bool_t               gb_gl_tracer_init(tb_size_t mode, tb_char_t const* path);
+
+/* exit the gl tracer and restore the gl interfaces
+ */
+tb_void_t               gb_gl_tracer_exit(tb_noarg_t);
+
+/* the gl tracer mode
+ *
+ * @return              the tracer mode
+ */
+tb_size_t               gb_gl_tracer_mode(tb_noarg_t);
+
+/* wrap the gl interfaces, it will be called by gb_gl_interface_load()
+ *
+ * @return              tb_true or tb_false
+ */
+tb_bool_t               gb_gl_tracer_hook(tb_noarg_t);
+
+/* end the current frame, write the frame stats to the trace and reset them
+ */
+tb_void_t               gb_gl_tracer_frame(tb_noarg_t);
+
+/* the gl tracer stats
+ *
+ * @param frame         the stats of the current frame, optional
+ * @param total         the stats of all frames, optional
+ */
+tb_void_t               gb_gl_tracer_stats(gb_gl_tracer_stats_ref_t frame, gb_gl_tracer_stats_ref_t total);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+#endif
@@ -38,6 +38,19 @@
 #include "../pixmap.h"
 #include "../../platform/platform.h"
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the start clock of the device stats, only get it if the stats is enabled
+#define gb_device_stats_clock(device)                   ((device)->stats? tb_uclock() : 0)
+
+// add the elapsed time since the start clock to the device stats
+#define gb_device_stats_clock_add(device, name, clock)  do { if ((device)->stats) (device)->stats->name += tb_uclock() - (clock); } while (0)
+
+// add the value to the counter of the device stats
+#define gb_device_stats_count_add(device, name, val)    do { if ((device)->stats) (device)->stats->name += (val); } while (0)
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * types
  */
@@ -66,6 +79,13 @@ typedef struct __gb_device_impl_t
     // the clipper
     gb_clipper_ref_t        clipper;
 
+    /* the stats, null if disabled
+     *
+     * stats[0]: the current frame
+     * stats[1]: the last flushed frame
+     */
+    gb_device_stats_ref_t   stats;
+
     /* resize
      *
      * @param device        the device
@@ -80,6 +100,12 @@ typedef struct __gb_device_impl_t
      * @param color         the color
      */
     tb_void_t               (*draw_clear)(struct __gb_device_impl_t* device, gb_color_t color);
+
+    /* flush the pending draws, e.g. the batched draws of the gl device
+     *
+     * @param device        the device
+     */
+    tb_void_t               (*draw_flush)(struct __gb_device_impl_t* device);
 	
     /*! draw path
      *
@@ -178,6 +204,42 @@ typedef struct __gb_shader_impl_t
 
 }gb_shader_impl_t;
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * inlines
+ */
+
+/* the polygon of the path for the device
+ *
+ * the flattened points and time will be added to the device stats 
+ * if the curves of the path need be flattened again.
+ *
+ * @param device            the device
+ * @param path              the path
+ *
+ * @return                  the polygon
+ */
+static __tb_inline__ gb_polygon_ref_t gb_device_impl_polygon(gb_device_impl_t* device, gb_path_ref_t path)
+{
+    // the stats is disabled or the polygon has been flattened? 
+    if (!device->stats || !gb_path_polygon_dirty(path)) return gb_path_polygon(path);
+
+    // flatten it
+    tb_hong_t           clock = tb_uclock();
+    gb_polygon_ref_t    polygon = gb_path_polygon(path);
+    device->stats->flatten_time += tb_uclock() - clock;
+
+    // count the flattened points
+    if (polygon && polygon->counts)
+    {
+        tb_uint16_t     count;
+        tb_uint16_t*    counts = polygon->counts;
+        while ((count = *counts++)) device->stats->flattened += count;
+    }
+
+    // ok
+    return polygon;
+}
+
 #endif
 
 
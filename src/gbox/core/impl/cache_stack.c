@@ -65,7 +65,12 @@ static tb_handle_t gb_cache_stack_object_init(tb_size_t type)
     switch (type)
     {
     case GB_CACHE_STACK_TYPE_PATH:
-        object = (tb_handle_t)gb_path_init();
+        {
+            // the paths of the stack are rebuilt for each drawing, e.g. the shapes of the canvas
+            gb_path_ref_t path = gb_path_init();
+            if (path) gb_path_transient_set(path, tb_true);
+            object = (tb_handle_t)path;
+        }
         break;
     case GB_CACHE_STACK_TYPE_PAINT:
         object = (tb_handle_t)gb_paint_init();
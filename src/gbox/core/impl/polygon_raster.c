@@ -33,6 +33,8 @@
  * includes
  */
 #include "polygon_raster.h"
+#include "../trace.h"
+#include "../memory.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * macros
@@ -45,6 +47,9 @@
 #   define GB_POLYGON_RASTER_EDGES_GROW     (2048)
 #endif
 
+// sync the allocated bytes of the edge pool and table to the memory tag
+#define gb_polygon_raster_memory_sync(impl) gb_memory_sync(GB_MEMORY_TAG_RASTER, (impl)->memory, sizeof(gb_polygon_raster_impl_t) + (impl)->edge_pool_maxn * sizeof(gb_polygon_raster_edge_t) + (impl)->edge_table_maxn * sizeof(tb_uint16_t))
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * types
  */
@@ -185,6 +190,9 @@ typedef struct __gb_polygon_raster_impl_t
     // the bottom of the polygon bounds
     tb_long_t                       bottom;
 
+    // the accounted bytes of the memory tag
+    tb_size_t                       memory;
+
 }gb_polygon_raster_impl_t;
 
 /* //////////////////////////////////////////////////////////////////////////////////////
@@ -196,8 +204,15 @@ static tb_bool_t gb_polygon_raster_edge_pool_init(gb_polygon_raster_impl_t* impl
     tb_assert(impl);
 
     // init the edge pool
-    if (!impl->edge_pool) impl->edge_pool = tb_nalloc_type(GB_POLYGON_RASTER_EDGES_GROW, gb_polygon_raster_edge_t);
-    tb_assert_and_check_return_val(impl->edge_pool, tb_false);
+    if (!impl->edge_pool) 
+    {
+        impl->edge_pool_maxn = GB_POLYGON_RASTER_EDGES_GROW;
+        impl->edge_pool = tb_nalloc_type(impl->edge_pool_maxn, gb_polygon_raster_edge_t);
+        tb_assert_and_check_return_val(impl->edge_pool, tb_false);
+
+        // sync memory
+        gb_polygon_raster_memory_sync(impl);
+    }
 
     // init the edge pool size
     impl->edge_pool_size = 0;
@@ -212,7 +227,8 @@ static tb_void_t gb_polygon_raster_edge_pool_exit(gb_polygon_raster_impl_t* impl
 
     // exit the edge pool
     if (impl->edge_pool) tb_free(impl->edge_pool);
-    impl->edge_pool = tb_null;
+    impl->edge_pool         = tb_null;
+    impl->edge_pool_maxn    = 0;
 }
 static tb_uint16_t gb_polygon_raster_edge_pool_aloc(gb_polygon_raster_impl_t* impl)
 {
@@ -229,6 +245,9 @@ static tb_uint16_t gb_polygon_raster_edge_pool_aloc(gb_polygon_raster_impl_t* im
         impl->edge_pool_maxn = index + GB_POLYGON_RASTER_EDGES_GROW;
         impl->edge_pool = tb_ralloc_type(impl->edge_pool, impl->edge_pool_maxn, gb_polygon_raster_edge_t);
         tb_assert_and_check_return_val(impl->edge_pool, 0);
+
+        // sync memory
+        gb_polygon_raster_memory_sync(impl);
     }
 
     // make a new edge from the edge pool
@@ -252,6 +271,9 @@ static tb_bool_t gb_polygon_raster_edge_table_init(gb_polygon_raster_impl_t* imp
     }
     tb_assert_and_check_return_val(impl->edge_table && table_size <= TB_MAXU16, tb_false);
 
+    // sync memory
+    gb_polygon_raster_memory_sync(impl);
+
     // clear the edge table
     tb_memset(impl->edge_table, 0, table_size * sizeof(tb_uint16_t));
 
@@ -268,7 +290,8 @@ static tb_void_t gb_polygon_raster_edge_table_exit(gb_polygon_raster_impl_t* imp
 
     // exit the edge table
     if (impl->edge_table) tb_free(impl->edge_table);
-    impl->edge_table = tb_null;
+    impl->edge_table        = tb_null;
+    impl->edge_table_maxn   = 0;
 }
 static tb_bool_t gb_polygon_raster_edge_table_make(gb_polygon_raster_impl_t* impl, gb_polygon_ref_t polygon, gb_rect_ref_t bounds)
 {
@@ -920,7 +943,7 @@ static tb_void_t gb_polygon_raster_active_sort(gb_polygon_raster_impl_t* impl)
         index = edge->next;
     }
 }
-static tb_void_t gb_polygon_raster_done_convex(gb_polygon_raster_impl_t* impl, gb_polygon_ref_t polygon, gb_rect_ref_t bounds, gb_polygon_raster_func_t func, tb_cpointer_t priv)
+static tb_size_t gb_polygon_raster_done_convex(gb_polygon_raster_impl_t* impl, gb_polygon_ref_t polygon, gb_rect_ref_t bounds, gb_polygon_raster_func_t func, tb_cpointer_t priv)
 {
     // check
     tb_assert(impl && polygon && polygon->convex && bounds);
@@ -929,7 +952,7 @@ static tb_void_t gb_polygon_raster_done_convex(gb_polygon_raster_impl_t* impl, g
     impl->active_edges = 0;
 
     // make the edge table
-    if (!gb_polygon_raster_edge_table_make(impl, polygon, bounds)) return ;
+    if (!gb_polygon_raster_edge_table_make(impl, polygon, bounds)) return 0;
 
     // done scan
     tb_long_t       y;
@@ -951,8 +974,11 @@ static tb_void_t gb_polygon_raster_done_convex(gb_polygon_raster_impl_t* impl, g
         // scan the next line from the active edges
         gb_polygon_raster_active_scan_next(impl, y, tb_null); 
     }
+
+    // the built edges count
+    return impl->edge_pool_size;
 }
-static tb_void_t gb_polygon_raster_done_concave(gb_polygon_raster_impl_t* impl, gb_polygon_ref_t polygon, gb_rect_ref_t bounds, tb_size_t rule, gb_polygon_raster_func_t func, tb_cpointer_t priv)
+static tb_size_t gb_polygon_raster_done_concave(gb_polygon_raster_impl_t* impl, gb_polygon_ref_t polygon, gb_rect_ref_t bounds, tb_size_t rule, gb_polygon_raster_func_t func, tb_cpointer_t priv)
 {
     // check
     tb_assert(impl && polygon && !polygon->convex && bounds);
@@ -961,7 +987,7 @@ static tb_void_t gb_polygon_raster_done_concave(gb_polygon_raster_impl_t* impl,
     impl->active_edges = 0;
 
     // make the edge table
-    if (!gb_polygon_raster_edge_table_make(impl, polygon, bounds)) return ;
+    if (!gb_polygon_raster_edge_table_make(impl, polygon, bounds)) return 0;
 
     // done scan
     tb_long_t       y;
@@ -992,6 +1018,9 @@ static tb_void_t gb_polygon_raster_done_concave(gb_polygon_raster_impl_t* impl,
         // scan the next line from the active edges
         gb_polygon_raster_active_scan_next(impl, y, &order); 
     }
+
+    // the built edges count
+    return impl->edge_pool_size;
 }
 
 /* //////////////////////////////////////////////////////////////////////////////////////
@@ -999,8 +1028,15 @@ static tb_void_t gb_polygon_raster_done_concave(gb_polygon_raster_impl_t* impl,
  */
 gb_polygon_raster_ref_t gb_polygon_raster_init()
 {
-    // init it
-    return (gb_polygon_raster_ref_t)tb_malloc0_type(gb_polygon_raster_impl_t);
+    // make raster
+    gb_polygon_raster_impl_t* impl = tb_malloc0_type(gb_polygon_raster_impl_t);
+    tb_assert_and_check_return_val(impl, tb_null);
+
+    // sync memory
+    gb_polygon_raster_memory_sync(impl);
+
+    // ok
+    return (gb_polygon_raster_ref_t)impl;
 }
 tb_void_t gb_polygon_raster_exit(gb_polygon_raster_ref_t raster)
 {
@@ -1014,14 +1050,23 @@ tb_void_t gb_polygon_raster_exit(gb_polygon_raster_ref_t raster)
     // exit the edge pool
     gb_polygon_raster_edge_pool_exit(impl);
 
+    // exit memory
+    gb_memory_sync(GB_MEMORY_TAG_RASTER, impl->memory, 0);
+
     // exit it
     tb_free(impl);
 }
-tb_void_t gb_polygon_raster_done(gb_polygon_raster_ref_t raster, gb_polygon_ref_t polygon, gb_rect_ref_t bounds, tb_size_t rule, gb_polygon_raster_func_t func, tb_cpointer_t priv)
+tb_size_t gb_polygon_raster_done(gb_polygon_raster_ref_t raster, gb_polygon_ref_t polygon, gb_rect_ref_t bounds, tb_size_t rule, gb_polygon_raster_func_t func, tb_cpointer_t priv)
 {
     // check
     gb_polygon_raster_impl_t* impl = (gb_polygon_raster_impl_t*)raster;
-    tb_assert_abort_and_check_return(impl && polygon && polygon->points && polygon->counts && bounds && func);
+    tb_assert_abort_and_check_return_val(impl && polygon && polygon->points && polygon->counts && bounds && func, 0);
+
+    // trace enter
+    gb_trace_enter(span);
+
+    // the built edges count
+    tb_size_t edges = 0;
 
     // is convex polygon for each contour?
     if (polygon->convex)
@@ -1038,7 +1083,7 @@ tb_void_t gb_polygon_raster_done(gb_polygon_raster_ref_t raster, gb_polygon_ref_
             contour.points = points + index;
 
             // done raster for the convex contour, will be faster
-            gb_polygon_raster_done_convex(impl, &contour, bounds, func, priv);
+            edges += gb_polygon_raster_done_convex(impl, &contour, bounds, func, priv);
 
             // update the contour index
             index += contour_counts[0];
@@ -1047,7 +1092,13 @@ tb_void_t gb_polygon_raster_done(gb_polygon_raster_ref_t raster, gb_polygon_ref_
     else
     {
         // done raster for the concave polygon
-        gb_polygon_raster_done_concave(impl, polygon, bounds, rule, func, priv);
+        edges = gb_polygon_raster_done_concave(impl, polygon, bounds, rule, func, priv);
     }
+
+    // trace leave
+    gb_trace_leave(span, "gb_polygon_raster_done");
+
+    // ok
+    return edges;
 }
 
@@ -86,8 +86,10 @@ tb_void_t               gb_polygon_raster_exit(gb_polygon_raster_ref_t raster);
  * @param rule          the raster rule
  * @param func          the raster func
  * @param priv          the private data
+ *
+ * @return              the built edges count
  */
-tb_void_t               gb_polygon_raster_done(gb_polygon_raster_ref_t raster, gb_polygon_ref_t polygon, gb_rect_ref_t bounds, tb_size_t rule, gb_polygon_raster_func_t func, tb_cpointer_t priv);
+tb_size_t               gb_polygon_raster_done(gb_polygon_raster_ref_t raster, gb_polygon_ref_t polygon, gb_rect_ref_t bounds, tb_size_t rule, gb_polygon_raster_func_t func, tb_cpointer_t priv);
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
@@ -32,6 +32,8 @@
 #include "cubic.h"
 #include "../path.h"
 #include "../paint.h"
+#include "../trace.h"
+#include "../memory.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * types
@@ -145,6 +147,9 @@ typedef struct __gb_stroker_impl_t
     // the joiner
     gb_stroker_joiner_t     joiner;
 
+    // the accounted bytes of the memory tag
+    tb_size_t               memory;
+
 }gb_stroker_impl_t;
 
 /* //////////////////////////////////////////////////////////////////////////////////////
@@ -1324,6 +1329,14 @@ gb_stroker_ref_t gb_stroker_init()
         impl->path_other = gb_path_init();
         tb_assert_and_check_break(impl->path_other);
 
+        // account the paths to the stroker
+        gb_path_memory_tag_set(impl->path_outer, GB_MEMORY_TAG_STROKER);
+        gb_path_memory_tag_set(impl->path_inner, GB_MEMORY_TAG_STROKER);
+        gb_path_memory_tag_set(impl->path_other, GB_MEMORY_TAG_STROKER);
+
+        // sync memory
+        gb_memory_sync(GB_MEMORY_TAG_STROKER, impl->memory, sizeof(gb_stroker_impl_t));
+
         // ok
         ok = tb_true;
 
@@ -1358,6 +1371,9 @@ tb_void_t gb_stroker_exit(gb_stroker_ref_t stroker)
     if (impl->path_outer) gb_path_exit(impl->path_outer);
     impl->path_outer = tb_null;
 
+    // exit memory
+    gb_memory_sync(GB_MEMORY_TAG_STROKER, impl->memory, 0);
+
     // exit it
     tb_free(impl);
 }
@@ -1968,6 +1984,9 @@ gb_path_ref_t gb_stroker_done(gb_stroker_ref_t stroker, tb_bool_t convex)
 }
 gb_path_ref_t gb_stroker_done_path(gb_stroker_ref_t stroker, gb_paint_ref_t paint, gb_path_ref_t path)
 {
+    // trace enter
+    gb_trace_enter(span);
+
     // clear the stroker
     gb_stroker_clear(stroker);
 
@@ -1983,10 +2002,19 @@ gb_path_ref_t gb_stroker_done_path(gb_stroker_ref_t stroker, gb_paint_ref_t pain
     }
 
     // done the stroker
-    return gb_stroker_done(stroker, convex);
+    gb_path_ref_t stroked_path = gb_stroker_done(stroker, convex);
+
+    // trace leave
+    gb_trace_leave(span, "gb_stroker_done_path");
+
+    // ok
+    return stroked_path;
 }
 gb_path_ref_t gb_stroker_done_lines(gb_stroker_ref_t stroker, gb_paint_ref_t paint, gb_point_ref_t points, tb_size_t count)
 {
+    // trace enter
+    gb_trace_enter(span);
+
     // clear the stroker
     gb_stroker_clear(stroker);
 
@@ -1997,10 +2025,19 @@ gb_path_ref_t gb_stroker_done_lines(gb_stroker_ref_t stroker, gb_paint_ref_t pai
     gb_stroker_add_lines(stroker, points, count);
 
     // done the stroker
-    return gb_stroker_done(stroker, tb_true);
+    gb_path_ref_t stroked_path = gb_stroker_done(stroker, tb_true);
+
+    // trace leave
+    gb_trace_leave(span, "gb_stroker_done_lines");
+
+    // ok
+    return stroked_path;
 }
 gb_path_ref_t gb_stroker_done_points(gb_stroker_ref_t stroker, gb_paint_ref_t paint, gb_point_ref_t points, tb_size_t count)
 {
+    // trace enter
+    gb_trace_enter(span);
+
     // clear the stroker
     gb_stroker_clear(stroker);
 
@@ -2011,10 +2048,19 @@ gb_path_ref_t gb_stroker_done_points(gb_stroker_ref_t stroker, gb_paint_ref_t pa
     gb_stroker_add_points(stroker, points, count);
 
     // done the stroker
-    return gb_stroker_done(stroker, tb_true);
+    gb_path_ref_t stroked_path = gb_stroker_done(stroker, tb_true);
+
+    // trace leave
+    gb_trace_leave(span, "gb_stroker_done_points");
+
+    // ok
+    return stroked_path;
 }
 gb_path_ref_t gb_stroker_done_polygon(gb_stroker_ref_t stroker, gb_paint_ref_t paint, gb_polygon_ref_t polygon, gb_shape_ref_t hint)
 {
+    // trace enter
+    gb_trace_enter(span);
+
     // clear the stroker
     gb_stroker_clear(stroker);
 
@@ -2030,5 +2076,11 @@ gb_path_ref_t gb_stroker_done_polygon(gb_stroker_ref_t stroker, gb_paint_ref_t p
     }
 
     // done the stroker
-    return gb_stroker_done(stroker, convex);
+    gb_path_ref_t stroked_path = gb_stroker_done(stroker, convex);
+
+    // trace leave
+    gb_trace_leave(span, "gb_stroker_done_polygon");
+
+    // ok
+    return stroked_path;
 }
@@ -0,0 +1,161 @@
+/*!The Graphic Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        memory.c
+ * @ingroup     core
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME            "memory"
+#define TB_TRACE_MODULE_DEBUG           (0)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "memory.h"
+
+#ifdef GB_CONFIG_MEMORY
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the memory tag type
+typedef struct __gb_memory_tag_t
+{
+    // the allocated bytes
+    tb_atomic_t                 size;
+
+    // the high-water mark of the allocated bytes
+    tb_atomic_t                 peak;
+
+    // the living objects count
+    tb_atomic_t                 count;
+
+    // the allocation count
+    tb_atomic_t                 allocs;
+
+    // the free count
+    tb_atomic_t                 frees;
+
+}gb_memory_tag_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * globals
+ */
+
+// the memory tags
+static gb_memory_tag_t          g_tags[GB_MEMORY_TAG_MAXN];
+
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_void_t gb_memory_update(tb_size_t tag, tb_size_t osize, tb_size_t nsize)
+{
+    // check
+    tb_assert_and_check_return(tag < GB_MEMORY_TAG_MAXN);
+
+#ifdef GB_CONFIG_MEMORY
+    // the tag
+    gb_memory_tag_t* memory = &g_tags[tag];
+
+    // update count
+    if (!osize && nsize)
+    {
+        tb_atomic_fetch_and_inc(&memory->count);
+        tb_atomic_fetch_and_inc(&memory->allocs);
+    }
+    else if (osize && !nsize)
+    {
+        tb_atomic_fetch_and_dec(&memory->count);
+        tb_atomic_fetch_and_inc(&memory->frees);
+    }
+    else if (osize != nsize) tb_atomic_fetch_and_inc(&memory->allocs);
+
+    // update size
+    tb_long_t delta = (tb_long_t)nsize - (tb_long_t)osize;
+    tb_long_t size = tb_atomic_fetch_and_add(&memory->size, delta) + delta;
+
+    // update peak
+    tb_long_t peak = tb_atomic_get(&memory->peak);
+    while (size > peak)
+    {
+        tb_long_t prev = tb_atomic_fetch_and_pset(&memory->peak, peak, size);
+        if (prev == peak) break;
+        peak = prev;
+    }
+#else
+    tb_used(&osize);
+    tb_used(&nsize);
+#endif
+}
+tb_size_t gb_memory_vector(tb_vector_ref_t vector)
+{
+    // the bytes of the allocated items
+    return vector? tb_vector_maxn(vector) * tb_iterator_step((tb_iterator_ref_t)vector) : 0;
+}
+tb_bool_t gb_memory_stats(tb_size_t tag, gb_memory_stats_ref_t stats)
+{
+    // check
+    tb_assert_and_check_return_val(tag < GB_MEMORY_TAG_MAXN && stats, tb_false);
+
+#ifdef GB_CONFIG_MEMORY
+    // the tag
+    gb_memory_tag_t* memory = &g_tags[tag];
+
+    // save stats
+    stats->size     = (tb_size_t)tb_atomic_get(&memory->size);
+    stats->peak     = (tb_size_t)tb_atomic_get(&memory->peak);
+    stats->count    = (tb_size_t)tb_atomic_get(&memory->count);
+    stats->allocs   = (tb_size_t)tb_atomic_get(&memory->allocs);
+    stats->frees    = (tb_size_t)tb_atomic_get(&memory->frees);
+
+    // ok
+    return tb_true;
+#else
+    // clear stats
+    tb_memset(stats, 0, sizeof(gb_memory_stats_t));
+    return tb_false;
+#endif
+}
+tb_char_t const* gb_memory_name(tb_size_t tag)
+{
+    // the names
+    static tb_char_t const* s_names[] =
+    {
+        "path"
+    ,   "paint"
+    ,   "stroker"
+    ,   "raster"
+    ,   "device"
+    ,   "tessellator"
+    };
+    tb_assert_static(tb_arrayn(s_names) == GB_MEMORY_TAG_MAXN);
+
+    // check
+    tb_assert_and_check_return_val(tag < GB_MEMORY_TAG_MAXN, tb_null);
+
+    // the name
+    return s_names[tag];
+}
@@ -0,0 +1,164 @@
+/*!The Graphic Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        memory.h
+ * @ingroup     core
+ */
+#ifndef GB_CORE_MEMORY_H
+#define GB_CORE_MEMORY_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+/*! sync the accounted bytes of the object to the memory tag
+ *
+ * the object saves the bytes which have been accounted,
+ * and the tag will be updated only if the allocated bytes of the object have been changed.
+ *
+ * the size expression is only evaluated if GB_CONFIG_MEMORY is enabled, e.g. xmake f --memory=y
+ *
+ * @code
+    gb_memory_sync(GB_MEMORY_TAG_PATH, impl->memory, sizeof(gb_path_impl_t) + gb_memory_vector(impl->points));
+ * @endcode
+ */
+#ifdef GB_CONFIG_MEMORY
+#   define gb_memory_sync(tag, accounted, size) \
+    do \
+    { \
+        tb_size_t __size = (size); \
+        if (__size != (accounted)) \
+        { \
+            gb_memory_update(tag, (accounted), __size); \
+            (accounted) = __size; \
+        } \
+    } while (0)
+#else
+#   define gb_memory_sync(tag, accounted, size)
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+/*! the memory tag enum
+ *
+ * - path:          the codes, points and polygon caches of the paths
+ * - paint:         the paints
+ * - stroker:       the strokers and their output paths
+ * - raster:        the edge pools and tables of the polygon rasters
+ * - device:        the transformed points and counts of the bitmap devices
+ * - tessellator:   the mesh pools, events, outputs and batches of the tessellators
+ */
+typedef enum __gb_memory_tag_e
+{
+    GB_MEMORY_TAG_PATH          = 0
+,   GB_MEMORY_TAG_PAINT         = 1
+,   GB_MEMORY_TAG_STROKER       = 2
+,   GB_MEMORY_TAG_RASTER        = 3
+,   GB_MEMORY_TAG_DEVICE        = 4
+,   GB_MEMORY_TAG_TESSELLATOR   = 5
+,   GB_MEMORY_TAG_MAXN          = 6
+
+}gb_memory_tag_e;
+
+/// the memory stats type
+typedef struct __gb_memory_stats_t
+{
+    /// the allocated bytes
+    tb_size_t                   size;
+
+    /// the high-water mark of the allocated bytes
+    tb_size_t                   peak;
+
+    /// the living objects count
+    tb_size_t                   count;
+
+    /*! the allocation count
+     *
+     * the growing of the allocated objects is also counted,
+     * so it will keep increasing if a scene causes the heap churn for each frame
+     */
+    tb_size_t                   allocs;
+
+    /// the free count
+    tb_size_t                   frees;
+
+}gb_memory_stats_t, *gb_memory_stats_ref_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/*! update the allocated bytes of the memory tag
+ *
+ * - osize == 0: an object has been allocated
+ * - nsize == 0: an object has been freed
+ * - otherwise:  an object has been grown or shrunk
+ *
+ * it is lock-free and is used by gb_memory_sync()
+ *
+ * @param tag       the memory tag
+ * @param osize     the old bytes of the object
+ * @param nsize     the new bytes of the object
+ */
+tb_void_t           gb_memory_update(tb_size_t tag, tb_size_t osize, tb_size_t nsize);
+
+/*! the allocated bytes of the vector, including the unused capacity
+ *
+ * @param vector    the vector, maybe null
+ *
+ * @return          the bytes
+ */
+tb_size_t           gb_memory_vector(tb_vector_ref_t vector);
+
+/*! the memory stats of the given tag
+ *
+ * @param tag       the memory tag
+ * @param stats     the stats
+ *
+ * @return          tb_true or tb_false if GB_CONFIG_MEMORY is disabled
+ */
+tb_bool_t           gb_memory_stats(tb_size_t tag, gb_memory_stats_ref_t stats);
+
+/*! the name of the memory tag
+ *
+ * @param tag       the memory tag
+ *
+ * @return          the name, e.g. "path", "stroker", ...
+ */
+tb_char_t const*    gb_memory_name(tb_size_t tag);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+#endif
@@ -28,6 +28,7 @@
  */
 #include "paint.h"
 #include "shader.h"
+#include "memory.h"
 #include "impl/stroker.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
@@ -89,6 +90,9 @@ typedef struct __gb_paint_impl_t
     // the shader
     gb_shader_ref_t     shader;
 
+    // the accounted bytes of the memory tag
+    tb_size_t           memory;
+
 }gb_paint_impl_t;
 
 /* //////////////////////////////////////////////////////////////////////////////////////
@@ -108,6 +112,9 @@ gb_paint_ref_t gb_paint_init()
         // init paint
         gb_paint_clear((gb_paint_ref_t)impl);
 
+        // sync memory
+        gb_memory_sync(GB_MEMORY_TAG_PAINT, impl->memory, sizeof(gb_paint_impl_t));
+
         // ok
         ok = tb_true;
 
@@ -134,6 +141,9 @@ tb_void_t gb_paint_exit(gb_paint_ref_t paint)
     if (impl->shader) gb_shader_exit(impl->shader);
     impl->shader = tb_null;
 
+    // exit memory
+    gb_memory_sync(GB_MEMORY_TAG_PAINT, impl->memory, 0);
+
     // exit paint
     tb_free(impl);
 }
@@ -36,6 +36,8 @@
 #include "impl/arc.h"
 #include "impl/quad.h"
 #include "impl/cubic.h"
+#include "trace.h"
+#include "memory.h"
 #include "impl/bounds.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
@@ -52,6 +54,9 @@
 // the point step for code
 #define gb_path_point_step(code)    ((code) < 1? 1 : (code) - 1)
 
+// sync the allocated bytes of the path to its memory tag
+#define gb_path_memory_sync(impl)   gb_memory_sync((impl)->memory_tag, (impl)->memory, sizeof(gb_path_impl_t) + gb_memory_vector((impl)->codes) + gb_memory_vector((impl)->points) + gb_memory_vector((impl)->polygon_points) + gb_memory_vector((impl)->polygon_counts))
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * types
  */
@@ -63,7 +68,8 @@ typedef enum __gb_path_flag_e
 ,   GB_PATH_FLAG_DIRTY_BOUNDS           = 2
 ,   GB_PATH_FLAG_DIRTY_POLYGON          = 4
 ,   GB_PATH_FLAG_DIRTY_CONVEX           = 8
-,   GB_PATH_FLAG_DIRTY_ALL              = GB_PATH_FLAG_DIRTY_HINT | GB_PATH_FLAG_DIRTY_BOUNDS | GB_PATH_FLAG_DIRTY_POLYGON | GB_PATH_FLAG_DIRTY_CONVEX
+,   GB_PATH_FLAG_DIRTY_VERSION          = 256
+,   GB_PATH_FLAG_DIRTY_ALL              = GB_PATH_FLAG_DIRTY_HINT | GB_PATH_FLAG_DIRTY_BOUNDS | GB_PATH_FLAG_DIRTY_POLYGON | GB_PATH_FLAG_DIRTY_CONVEX | GB_PATH_FLAG_DIRTY_VERSION
 ,   GB_PATH_FLAG_CURVE                  = 16    //< have curve contour?
 ,   GB_PATH_FLAG_CONVEX                 = 32    //< all contours are convex polygon?
 ,   GB_PATH_FLAG_CLOSED                 = 64    //< the contour is closed now?
@@ -78,7 +84,13 @@ typedef struct __gb_path_impl_t
     tb_iterator_t       itor;
 
     // the flag
-    tb_uint8_t          flag;
+    tb_uint16_t         flag;
+
+    // the version
+    tb_size_t           version;
+
+    // is transient? it is rebuilt for each drawing and need not be cached
+    tb_bool_t           transient;
 
     // the hint shape
     gb_shape_t          hint;
@@ -107,8 +119,21 @@ typedef struct __gb_path_impl_t
     // the polygon counts, gb_uint16_t[]
     tb_vector_ref_t     polygon_counts;
 
+    // the accounted bytes of the memory tag
+    tb_size_t           memory;
+
+    // the memory tag
+    tb_size_t           memory_tag;
+
 }gb_path_impl_t;
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * globals
+ */
+
+// the last path version, the versions of all paths are unique
+static tb_atomic_t  g_path_version = 0;
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * private implementation
  */
@@ -738,6 +763,9 @@ static tb_bool_t gb_path_make_python(gb_path_impl_t* impl)
     // is convex polygon?
     impl->polygon.convex = gb_path_convex((gb_path_ref_t)impl);
 
+    // sync memory
+    gb_path_memory_sync(impl);
+
     // ok
     return tb_true;
 }
@@ -782,6 +810,9 @@ gb_path_ref_t gb_path_init()
         impl->itor.prev = gb_path_itor_prev;
         impl->itor.item = gb_path_itor_item;
 
+        // sync memory
+        gb_path_memory_sync(impl);
+
         // ok
         ok = tb_true;
 
@@ -820,6 +851,9 @@ tb_void_t gb_path_exit(gb_path_ref_t path)
     if (impl->codes) tb_vector_exit(impl->codes);
     impl->codes = tb_null;
 
+    // exit memory
+    gb_memory_sync(impl->memory_tag, impl->memory, 0);
+
     // exit it
     tb_free(impl);
 }
@@ -859,8 +893,11 @@ tb_void_t gb_path_copy(gb_path_ref_t path, gb_path_ref_t copied)
     // copy points
     tb_vector_copy(impl->points, impl_copied->points);
 
+    // sync memory
+    gb_path_memory_sync(impl);
+
     // copy flag
-    impl->flag = impl_copied->flag | GB_PATH_FLAG_DIRTY_POLYGON;
+    impl->flag = impl_copied->flag | GB_PATH_FLAG_DIRTY_POLYGON | GB_PATH_FLAG_DIRTY_VERSION;
 
     // copy hint
     impl->hint = impl_copied->hint;
@@ -994,6 +1031,9 @@ tb_void_t gb_path_convex_set(gb_path_ref_t path, tb_bool_t convex)
 
     // clear dirty
     impl->flag &= ~GB_PATH_FLAG_DIRTY_CONVEX;
+
+    // the polygon may be tessellated differently now
+    impl->flag |= GB_PATH_FLAG_DIRTY_VERSION;
 }
 tb_bool_t gb_path_last(gb_path_ref_t path, gb_point_ref_t point)
 {
@@ -1024,6 +1064,9 @@ tb_void_t gb_path_last_set(gb_path_ref_t path, gb_point_ref_t point)
 
     // save it
     if (last) *last = *point;
+
+    // mark dirty
+    impl->flag |= GB_PATH_FLAG_DIRTY_ALL;
 }
 gb_shape_ref_t gb_path_hint(gb_path_ref_t path)
 {
@@ -1060,7 +1103,10 @@ gb_polygon_ref_t gb_path_polygon(gb_path_ref_t path)
     if (impl->flag & GB_PATH_FLAG_DIRTY_POLYGON)
     {
         // make polygon
-        if (!gb_path_make_python(impl)) return tb_null; 
+        gb_trace_enter(span);
+        tb_bool_t ok = gb_path_make_python(impl);
+        gb_trace_leave(span, "gb_path_polygon");
+        if (!ok) return tb_null; 
 
         // remove dirty
         impl->flag &= ~GB_PATH_FLAG_DIRTY_POLYGON;
@@ -1069,6 +1115,60 @@ gb_polygon_ref_t gb_path_polygon(gb_path_ref_t path)
     // ok?
     return &impl->polygon;
 }
+tb_bool_t gb_path_polygon_dirty(gb_path_ref_t path)
+{
+    // check
+    gb_path_impl_t* impl = (gb_path_impl_t*)path;
+    tb_assert_and_check_return_val(impl, tb_false);
+
+    // the polygon is dirty and it will be made from the curves?
+    return ((impl->flag & GB_PATH_FLAG_DIRTY_POLYGON) && (impl->flag & GB_PATH_FLAG_CURVE))? tb_true : tb_false;
+}
+tb_size_t gb_path_version(gb_path_ref_t path)
+{
+    // check
+    gb_path_impl_t* impl = (gb_path_impl_t*)path;
+    tb_assert_and_check_return_val(impl, 0);
+
+    // the transient path has no version
+    tb_check_return_val(!impl->transient, 0);
+
+    // version dirty? make a new unique version
+    if (impl->flag & GB_PATH_FLAG_DIRTY_VERSION)
+    {
+        // make version
+        impl->version = (tb_size_t)tb_atomic_fetch_and_inc(&g_path_version) + 1;
+
+        // remove dirty
+        impl->flag &= ~GB_PATH_FLAG_DIRTY_VERSION;
+    }
+
+    // ok
+    return impl->version;
+}
+tb_void_t gb_path_transient_set(gb_path_ref_t path, tb_bool_t transient)
+{
+    // check
+    gb_path_impl_t* impl = (gb_path_impl_t*)path;
+    tb_assert_and_check_return(impl);
+
+    // set it
+    impl->transient = transient;
+}
+tb_void_t gb_path_memory_tag_set(gb_path_ref_t path, tb_size_t tag)
+{
+    // check
+    gb_path_impl_t* impl = (gb_path_impl_t*)path;
+    tb_assert_and_check_return(impl && tag < GB_MEMORY_TAG_MAXN);
+
+    // move the accounted bytes to the new tag
+    if (tag != impl->memory_tag)
+    {
+        gb_memory_sync(impl->memory_tag, impl->memory, 0);
+        impl->memory_tag = tag;
+        gb_path_memory_sync(impl);
+    }
+}
 tb_void_t gb_path_apply(gb_path_ref_t path, gb_matrix_ref_t matrix)
 {
     // check
@@ -1084,6 +1184,9 @@ tb_void_t gb_path_apply(gb_path_ref_t path, gb_matrix_ref_t matrix)
         // apply it
         gb_point_apply(point, matrix);
     }
+
+    // mark dirty
+    impl->flag |= GB_PATH_FLAG_DIRTY_ALL;
 }
 tb_void_t gb_path_clos(gb_path_ref_t path)
 {
@@ -1101,6 +1204,9 @@ tb_void_t gb_path_clos(gb_path_ref_t path)
 
         // append code
         tb_vector_insert_tail(impl->codes, (tb_cpointer_t)GB_PATH_CODE_CLOS);
+
+        // sync memory
+        gb_path_memory_sync(impl);
     }
 
     // mark closed
@@ -1129,6 +1235,9 @@ tb_void_t gb_path_move_to(gb_path_ref_t path, gb_point_ref_t point)
 
         // clear single if the contour count > 1
         if (tb_vector_size(impl->codes) > 1) impl->flag &= ~GB_PATH_FLAG_SINGLE;
+
+        // sync memory
+        gb_path_memory_sync(impl);
     }
 
     // save point
@@ -1179,6 +1288,9 @@ tb_void_t gb_path_line_to(gb_path_ref_t path, gb_point_ref_t point)
     // append point
     tb_vector_insert_tail(impl->points, point);
 
+    // sync memory
+    gb_path_memory_sync(impl);
+
     // mark dirty
     impl->flag |= GB_PATH_FLAG_DIRTY_ALL;
 }
@@ -1222,6 +1334,9 @@ tb_void_t gb_path_quad_to(gb_path_ref_t path, gb_point_ref_t ctrl, gb_point_ref_
     tb_vector_insert_tail(impl->points, ctrl);
     tb_vector_insert_tail(impl->points, point);
 
+    // sync memory
+    gb_path_memory_sync(impl);
+
     // mark dirty and curve
     impl->flag |= GB_PATH_FLAG_DIRTY_ALL | GB_PATH_FLAG_CURVE;
 }
@@ -1274,6 +1389,9 @@ tb_void_t gb_path_cubic_to(gb_path_ref_t path, gb_point_ref_t ctrl0, gb_point_re
     tb_vector_insert_tail(impl->points, ctrl1);
     tb_vector_insert_tail(impl->points, point);
 
+    // sync memory
+    gb_path_memory_sync(impl);
+
     // mark dirty and curve
     impl->flag |= GB_PATH_FLAG_DIRTY_ALL | GB_PATH_FLAG_CURVE;
 }
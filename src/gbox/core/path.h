@@ -166,6 +166,47 @@ gb_shape_ref_t      gb_path_hint(gb_path_ref_t path);
  */
 gb_polygon_ref_t    gb_path_polygon(gb_path_ref_t path);
 
+/*! the curves of the path need be flattened again at the next gb_path_polygon()?
+ *
+ * @param path      the path
+ *
+ * @return          tb_true or tb_false
+ */
+tb_bool_t           gb_path_polygon_dirty(gb_path_ref_t path);
+
+/*! the path version
+ *
+ * the version will be changed after the path is modified,
+ * and it is unique for all paths, so it can be used as the key of the caches.
+ *
+ * @param path      the path
+ *
+ * @return          the version, zero if the path is transient
+ */
+tb_size_t           gb_path_version(gb_path_ref_t path);
+
+/*! mark the path as transient
+ *
+ * the transient path is rebuilt for each drawing, e.g. the paths of the canvas path stack,
+ * so it has no version and the devices will not cache its tessellated polygon.
+ *
+ * it is not copied by gb_path_copy()
+ *
+ * @param path      the path
+ * @param transient is transient?
+ */
+tb_void_t           gb_path_transient_set(gb_path_ref_t path, tb_bool_t transient);
+
+/*! set the memory tag of the path
+ *
+ * the allocated bytes of the path are accounted to GB_MEMORY_TAG_PATH by default,
+ * the owner can account its internal paths to its own tag, e.g. GB_MEMORY_TAG_STROKER
+ *
+ * @param path      the path
+ * @param tag       the memory tag
+ */
+tb_void_t           gb_path_memory_tag_set(gb_path_ref_t path, tb_size_t tag);
+
 /*! apply the matrix to the path 
  *
  * @param path      the path
@@ -42,6 +42,7 @@
 #include "pixmap/rgbx4444.h"
 #include "pixmap/rgba8888.h"
 #include "pixmap/rgbx8888.h"
+#include "pixmap/convert.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * globals 
@@ -225,4 +226,67 @@ gb_pixmap_ref_t gb_pixmap(tb_size_t pixfmt, tb_byte_t alpha)
 	// transparent
 	return tb_null;
 }
+tb_bool_t gb_pixmap_converter_init(gb_pixmap_converter_t* converter, tb_size_t dst_pixfmt, tb_size_t src_pixfmt)
+{
+    // check
+    tb_assert_and_check_return_val(converter && GB_PIXFMT_OK(dst_pixfmt) && GB_PIXFMT_OK(src_pixfmt), tb_false);
+
+    // the layout index
+    tb_size_t dst_index = GB_PIXFMT(dst_pixfmt) - 1;
+    tb_size_t src_index = GB_PIXFMT(src_pixfmt) - 1;
+    tb_check_return_val(dst_index < tb_arrayn(g_pixmap_layouts) && src_index < tb_arrayn(g_pixmap_layouts), tb_false);
+
+    // init layouts
+    converter->dst          = g_pixmap_layouts[dst_index];
+    converter->src          = g_pixmap_layouts[src_index];
+    converter->dst.bendian  = GB_PIXFMT_BE(dst_pixfmt)? 1 : 0;
+    converter->src.bendian  = GB_PIXFMT_BE(src_pixfmt)? 1 : 0;
+    tb_check_return_val(converter->dst.btp && converter->src.btp, tb_false);
+
+    // the native argb layout
+    gb_pixmap_layout_t argb = g_pixmap_layouts[GB_PIXFMT(GB_PIXFMT_ARGB8888) - 1];
+    argb.bendian = GB_PIXFMT_BE(GB_PIXFMT_NENDIAN)? 1 : 0;
 
+    // the same pixfmt without the padding bits? copy it directly
+    if (dst_index == src_index && !converter->dst.fill && converter->dst.bendian == converter->src.bendian)
+        converter->convert = gb_pixmap_convert_copy;
+    // the same 16-bits pixfmt with the different endian? swap it
+    else if (dst_index == src_index && !converter->dst.fill && converter->dst.btp == 2)
+        converter->convert = gb_pixmap_convert_swap16;
+    // rgb888 or 8888 => rgb888 or 8888? shuffle bytes directly
+    else if (gb_pixmap_layout_is_bytes(&converter->dst) && gb_pixmap_layout_is_bytes(&converter->src))
+    {
+        gb_pixmap_shuffle_make(converter->shuffle[0], &converter->dst, &converter->src);
+        converter->convert = gb_pixmap_convert_shuffle;
+    }
+    // others? convert it using the native argb
+    else
+    {
+        if (gb_pixmap_layout_is_bytes(&converter->src)) gb_pixmap_shuffle_make(converter->shuffle[0], &argb, &converter->src);
+        if (gb_pixmap_layout_is_bytes(&converter->dst)) gb_pixmap_shuffle_make(converter->shuffle[1], &converter->dst, &argb);
+        converter->convert = gb_pixmap_convert_generic;
+    }
+
+    // ok
+    return tb_true;
+}
+tb_void_t gb_pixmap_converter_done(gb_pixmap_converter_ref_t converter, tb_pointer_t data, tb_cpointer_t source, tb_size_t count)
+{
+    // check
+    tb_assert_and_check_return(converter && converter->convert && data && source);
+
+    // done
+    converter->convert(converter, data, source, count);
+}
+tb_bool_t gb_pixmap_convert_row(tb_size_t dst_pixfmt, tb_size_t src_pixfmt, tb_pointer_t data, tb_cpointer_t source, tb_size_t count)
+{
+    // init converter
+    gb_pixmap_converter_t converter;
+    if (!gb_pixmap_converter_init(&converter, dst_pixfmt, src_pixfmt)) return tb_false;
+
+    // done converter
+    gb_pixmap_converter_done(&converter, data, source, count);
+
+    // ok
+    return tb_true;
+}
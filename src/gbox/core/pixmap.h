@@ -146,6 +146,67 @@ typedef struct __gb_pixmap_t
 /// the pixmap ref type
 typedef gb_pixmap_t const*      gb_pixmap_ref_t;
 
+/// the pixmap converter type
+struct __gb_pixmap_converter_t;
+
+/*! convert the row pixels from the source data to the data
+ *
+ * @param converter     the converter
+ * @param data          the data 
+ * @param source        the source data 
+ * @param count         the pixel count
+ */
+typedef tb_void_t 		(*gb_pixmap_func_convert_t)(struct __gb_pixmap_converter_t const* converter, tb_pointer_t data, tb_cpointer_t source, tb_size_t count);
+
+/*! the pixmap channel layout type
+ *
+ * the channels are indexed as: a, r, g, b
+ */
+typedef struct __gb_pixmap_layout_t
+{
+    /// the bytes per-pixel
+    tb_uint8_t                  btp;
+
+    /// the big endian?
+    tb_uint8_t                  bendian;
+
+    /// the bit position of every channel in the pixel value
+    tb_uint8_t                  pos[4];
+
+    /// the bit count of every channel in the pixel value, no this channel if be zero
+    tb_uint8_t                  bits[4];
+
+    /// the fixed bits for the padding channel, .e.g the x bits of xrgb1555
+    tb_uint32_t                 fill;
+
+}gb_pixmap_layout_t;
+
+/// the pixmap converter type
+typedef struct __gb_pixmap_converter_t
+{
+    /// the source layout
+    gb_pixmap_layout_t          src;
+
+    /// the destination layout
+    gb_pixmap_layout_t          dst;
+
+    /*! the byte shuffles for converting the rgb888 or 8888 pixels of four pixels
+     *
+     * dst[i] = shuffle[i] < 0x80? src[shuffle[i]] : 0xff
+     *
+     * shuffle[0]: source => destination or source => native argb
+     * shuffle[1]: native argb => destination
+     */
+    tb_byte_t                   shuffle[2][16];
+
+    /// convert the row pixels
+    gb_pixmap_func_convert_t    convert;
+
+}gb_pixmap_converter_t;
+
+/// the pixmap converter ref type
+typedef gb_pixmap_converter_t const* gb_pixmap_converter_ref_t;
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * interfaces
  */
@@ -159,6 +220,55 @@ typedef gb_pixmap_t const*      gb_pixmap_ref_t;
  */
 gb_pixmap_ref_t 		gb_pixmap(tb_size_t pixfmt, tb_byte_t alpha);
 
+/*! init the row converter from the source pixel format to the destination pixel format
+ *
+ * the 8888 and 888 reorderings are done by the byte shuffles and the 16-bits formats 
+ * are packed and unpacked by channels, using sse2/ssse3 or neon if be available.
+ *
+ * @code
+ 
+    // init converter
+    gb_pixmap_converter_t converter;
+    if (gb_pixmap_converter_init(&converter, GB_PIXFMT_RGB565, GB_PIXFMT_ARGB8888))
+    {
+        // convert rows
+        gb_pixmap_converter_done(&converter, data, source, width);
+    }
+
+ * @endcode
+ *
+ * @param converter     the converter
+ * @param dst_pixfmt    the destination pixfmt with endian
+ * @param src_pixfmt    the source pixfmt with endian
+ *
+ * @return              tb_true or tb_false, the pal8 is not supported
+ */
+tb_bool_t               gb_pixmap_converter_init(gb_pixmap_converter_t* converter, tb_size_t dst_pixfmt, tb_size_t src_pixfmt);
+
+/*! convert the row pixels using the given converter
+ *
+ * @param converter     the converter
+ * @param data          the destination data
+ * @param source        the source data
+ * @param count         the pixel count
+ */
+tb_void_t               gb_pixmap_converter_done(gb_pixmap_converter_ref_t converter, tb_pointer_t data, tb_cpointer_t source, tb_size_t count);
+
+/*! convert the row pixels from the source pixel format to the destination pixel format
+ *
+ * @note it will init the converter for each calling, 
+ * please use gb_pixmap_converter_init() and gb_pixmap_converter_done() for converting many rows
+ *
+ * @param dst_pixfmt    the destination pixfmt with endian
+ * @param src_pixfmt    the source pixfmt with endian
+ * @param data          the destination data
+ * @param source        the source data
+ * @param count         the pixel count
+ *
+ * @return              tb_true or tb_false
+ */
+tb_bool_t               gb_pixmap_convert_row(tb_size_t dst_pixfmt, tb_size_t src_pixfmt, tb_pointer_t data, tb_cpointer_t source, tb_size_t count);
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
  */
@@ -0,0 +1,732 @@
+/*!The Graphic Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        convert.h
+ * @ingroup     core
+ *
+ */
+#ifndef GB_CORE_PIXMAP_CONVERT_H
+#define GB_CORE_PIXMAP_CONVERT_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+#if defined(TB_ARCH_SSE2) && !defined(TB_WORDS_BIGENDIAN)
+#   include <emmintrin.h>
+#   define GB_PIXMAP_CONVERT_SSE2
+#endif
+#if defined(__SSSE3__) && defined(GB_PIXMAP_CONVERT_SSE2)
+#   include <tmmintrin.h>
+#   define GB_PIXMAP_CONVERT_SSSE3
+#endif
+#if defined(TB_ARCH_ARM_NEON) && !defined(TB_WORDS_BIGENDIAN)
+#   include <arm_neon.h>
+#   define GB_PIXMAP_CONVERT_NEON
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the channel index
+#define GB_PIXMAP_CHANNEL_A             (0)
+#define GB_PIXMAP_CHANNEL_R             (1)
+#define GB_PIXMAP_CHANNEL_G             (2)
+#define GB_PIXMAP_CHANNEL_B             (3)
+
+// the shuffle index for filling 0xff
+#define GB_PIXMAP_SHUFFLE_FILL          (0x80)
+
+// the pixel count of the argb chunk for the generic converter
+#define GB_PIXMAP_CONVERT_CHUNK         (256)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * globals
+ */
+
+/* the channel layouts, the channel order: a, r, g, b
+ *
+ * the layout is same as the pixel macros, .e.g GB_RGB_565() and GB_RGB_565_R()
+ */
+static gb_pixmap_layout_t const g_pixmap_layouts[] =
+{
+    // pal8: not supported
+    { 0, 0, { 0,  0,  0,  0  }, { 0, 0, 0, 0 }, 0           }
+
+    // rgb565
+,   { 2, 0, { 0,  11, 5,  0  }, { 0, 5, 6, 5 }, 0           }
+
+    // rgb888
+,   { 3, 0, { 0,  16, 8,  0  }, { 0, 8, 8, 8 }, 0           }
+
+    // argb1555
+,   { 2, 0, { 15, 10, 5,  0  }, { 1, 5, 5, 5 }, 0           }
+
+    // xrgb1555
+,   { 2, 0, { 15, 10, 5,  0  }, { 0, 5, 5, 5 }, 0x8000      }
+
+    // argb4444
+,   { 2, 0, { 12, 8,  4,  0  }, { 4, 4, 4, 4 }, 0           }
+
+    // xrgb4444
+,   { 2, 0, { 12, 8,  4,  0  }, { 0, 4, 4, 4 }, 0xf000      }
+
+    // argb8888
+,   { 4, 0, { 24, 16, 8,  0  }, { 8, 8, 8, 8 }, 0           }
+
+    // xrgb8888
+,   { 4, 0, { 24, 16, 8,  0  }, { 0, 8, 8, 8 }, 0xff000000  }
+
+    // rgba5551
+,   { 2, 0, { 0,  11, 6,  1  }, { 1, 5, 5, 5 }, 0           }
+
+    // rgbx5551
+,   { 2, 0, { 0,  11, 6,  1  }, { 0, 5, 5, 5 }, 0x0001      }
+
+    // rgba4444
+,   { 2, 0, { 0,  12, 8,  4  }, { 4, 4, 4, 4 }, 0           }
+
+    // rgbx4444
+,   { 2, 0, { 0,  12, 8,  4  }, { 0, 4, 4, 4 }, 0x000f      }
+
+    // rgba8888
+,   { 4, 0, { 0,  24, 16, 8  }, { 8, 8, 8, 8 }, 0           }
+
+    // rgbx8888
+,   { 4, 0, { 0,  24, 16, 8  }, { 0, 8, 8, 8 }, 0x000000ff  }
+};
+
+// the channel positions of the native argb pixel: a r g b
+static tb_uint8_t const g_pixmap_argb_pos[] = { 24, 16, 8, 0 };
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * inlines
+ */
+
+// is byte layout? rgb888 or 8888
+static __tb_inline__ tb_bool_t gb_pixmap_layout_is_bytes(gb_pixmap_layout_t const* layout)
+{
+    return layout->btp >= 3;
+}
+
+// is the native argb layout?
+static __tb_inline__ tb_bool_t gb_pixmap_layout_is_argb(gb_pixmap_layout_t const* layout)
+{
+    return  layout->btp == 4 && layout->bits[GB_PIXMAP_CHANNEL_A] == 8 && layout->pos[GB_PIXMAP_CHANNEL_A] == 24 && layout->pos[GB_PIXMAP_CHANNEL_B] == 0
+        &&  layout->bendian == (GB_PIXFMT_BE(GB_PIXFMT_NENDIAN)? 1 : 0);
+}
+
+// the mask of the low bits, no shift reaches the width of tb_uint32_t
+static __tb_inline__ tb_uint32_t gb_pixmap_mask(tb_size_t bits)
+{
+    return bits >= 32? 0xffffffff : (((tb_uint32_t)1 << bits) - 1);
+}
+
+// get the little-endian u32 pixel, tb_bits_get_u32_le() may shift the promoted byte into the sign bit
+static __tb_inline__ tb_uint32_t gb_pixmap_get_u32_le(tb_byte_t const* p)
+{
+    return (tb_uint32_t)p[0] | ((tb_uint32_t)p[1] << 8) | ((tb_uint32_t)p[2] << 16) | ((tb_uint32_t)p[3] << 24);
+}
+
+// the memory index of the given channel for the byte layout, return GB_PIXMAP_SHUFFLE_FILL if no this channel
+static __tb_inline__ tb_size_t gb_pixmap_layout_index(gb_pixmap_layout_t const* layout, tb_size_t channel)
+{
+    // no this channel?
+    tb_check_return_val(layout->bits[channel], GB_PIXMAP_SHUFFLE_FILL);
+
+    // the byte index
+    tb_size_t index = layout->pos[channel] >> 3;
+    return layout->bendian? (layout->btp - 1 - index) : index;
+}
+
+/* make the byte shuffle from the source byte layout to the destination byte layout for four pixels
+ *
+ * the padding channel and the missing alpha channel will be filled with 0xff
+ */
+static __tb_inline__ tb_void_t gb_pixmap_shuffle_make(tb_byte_t shuffle[16], gb_pixmap_layout_t const* dst, gb_pixmap_layout_t const* src)
+{
+    // init the indices of one pixel
+    tb_size_t i;
+    tb_size_t c;
+    tb_byte_t indices[4] = {GB_PIXMAP_SHUFFLE_FILL, GB_PIXMAP_SHUFFLE_FILL, GB_PIXMAP_SHUFFLE_FILL, GB_PIXMAP_SHUFFLE_FILL};
+    for (c = 0; c < 4; c++)
+    {
+        tb_size_t d = gb_pixmap_layout_index(dst, c);
+        tb_size_t s = gb_pixmap_layout_index(src, c);
+        if (d < dst->btp) indices[d] = (tb_byte_t)s;
+    }
+
+    // make shuffle for four pixels
+    tb_memset(shuffle, GB_PIXMAP_SHUFFLE_FILL, 16);
+    for (i = 0; i < 4; i++)
+    {
+        for (c = 0; c < dst->btp; c++)
+        {
+            tb_byte_t s = indices[c];
+            shuffle[i * dst->btp + c] = (s != GB_PIXMAP_SHUFFLE_FILL)? (tb_byte_t)(i * src->btp + s) : GB_PIXMAP_SHUFFLE_FILL;
+        }
+    }
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * shuffle implementation
+ */
+/* the rotation of the little-endian 32-bits pixel for the 8888 => 8888 shuffle
+ *
+ * 0: none, 1: rotate right 8-bits, 2: rotate 16-bits, 3: rotate left 8-bits, 4: swap bytes, -1: others
+ */
+static __tb_inline__ tb_long_t gb_pixmap_shuffle_rotation(tb_byte_t const* shuffle)
+{
+    tb_size_t i;
+    tb_size_t j;
+    for (i = 0; i < 5; i++)
+    {
+        for (j = 0; j < 4; j++)
+        {
+            tb_size_t index = (i < 4)? ((j + i) & 3) : (3 - j);
+            if (shuffle[j] != GB_PIXMAP_SHUFFLE_FILL && shuffle[j] != index) break;
+        }
+        if (j == 4) return i;
+    }
+    return -1;
+}
+static __tb_inline__ tb_bool_t gb_pixmap_shuffle_done_c_8888(tb_byte_t* d, tb_byte_t const* s, tb_size_t count, tb_byte_t const* shuffle)
+{
+    // the rotation
+    tb_long_t rotation = gb_pixmap_shuffle_rotation(shuffle);
+    tb_check_return_val(rotation >= 0, tb_false);
+
+    // the fill bits
+    tb_size_t   j;
+    tb_uint32_t fill = 0;
+    for (j = 0; j < 4; j++)
+        if (shuffle[j] == GB_PIXMAP_SHUFFLE_FILL) fill |= (tb_uint32_t)0xff << (j << 3);
+
+    // done
+    tb_uint32_t         v;
+    tb_byte_t const*    e = s + (count << 2);
+    for (; s < e; s += 4, d += 4)
+    {
+        v = gb_pixmap_get_u32_le(s);
+        switch (rotation)
+        {
+        case 1: v = (v >> 8) | (v << 24);   break;
+        case 2: v = (v >> 16) | (v << 16);  break;
+        case 3: v = (v << 8) | (v >> 24);   break;
+        case 4: v = tb_bits_swap_u32(v);    break;
+        default:                            break;
+        }
+        tb_bits_set_u32_le(d, v | fill);
+    }
+
+    // ok
+    return tb_true;
+}
+static __tb_inline__ tb_void_t gb_pixmap_shuffle_done_c(tb_byte_t* d, tb_byte_t const* s, tb_size_t count, tb_size_t dbtp, tb_size_t sbtp, tb_byte_t const* shuffle)
+{
+    // 8888 => 8888? done it using the 32-bits rotation
+    if (dbtp == 4 && sbtp == 4 && gb_pixmap_shuffle_done_c_8888(d, s, count, shuffle)) return ;
+
+    // only using the shuffle of the first pixel
+    tb_byte_t const* e = s + count * sbtp;
+    if (dbtp == 4)
+    {
+        tb_size_t i0 = shuffle[0];
+        tb_size_t i1 = shuffle[1];
+        tb_size_t i2 = shuffle[2];
+        tb_size_t i3 = shuffle[3];
+        while (s < e)
+        {
+            d[0] = (i0 != GB_PIXMAP_SHUFFLE_FILL)? s[i0] : 0xff;
+            d[1] = (i1 != GB_PIXMAP_SHUFFLE_FILL)? s[i1] : 0xff;
+            d[2] = (i2 != GB_PIXMAP_SHUFFLE_FILL)? s[i2] : 0xff;
+            d[3] = (i3 != GB_PIXMAP_SHUFFLE_FILL)? s[i3] : 0xff;
+            d += 4;
+            s += sbtp;
+        }
+    }
+    else
+    {
+        // dbtp == 3: all channels of the rgb888 always exist in the source
+        tb_size_t i0 = shuffle[0];
+        tb_size_t i1 = shuffle[1];
+        tb_size_t i2 = shuffle[2];
+        while (s < e)
+        {
+            d[0] = s[i0];
+            d[1] = s[i1];
+            d[2] = s[i2];
+            d += 3;
+            s += sbtp;
+        }
+    }
+}
+#if defined(GB_PIXMAP_CONVERT_SSSE3)
+static __tb_inline__ tb_size_t gb_pixmap_shuffle_done_ssse3(tb_byte_t* d, tb_byte_t const* s, tb_size_t count, tb_size_t dbtp, tb_size_t sbtp, tb_byte_t const* shuffle)
+{
+    // init mask
+    __m128i mask = _mm_loadu_si128((__m128i const*)shuffle);
+    __m128i fill = _mm_cmplt_epi8(mask, _mm_setzero_si128());
+
+    // done, four pixels for each time
+    tb_size_t n = count;
+    if (sbtp == 4 && dbtp == 4)
+    {
+        for (; n >= 4; n -= 4, s += 16, d += 16)
+            _mm_storeu_si128((__m128i*)d, _mm_or_si128(_mm_shuffle_epi8(_mm_loadu_si128((__m128i const*)s), mask), fill));
+    }
+    else if (sbtp == 3 && dbtp == 4)
+    {
+        // loads 16 bytes and uses 12 bytes, so we need keep two pixels at least for the tail
+        for (; n >= 6; n -= 4, s += 12, d += 16)
+            _mm_storeu_si128((__m128i*)d, _mm_or_si128(_mm_shuffle_epi8(_mm_loadu_si128((__m128i const*)s), mask), fill));
+    }
+    else
+    {
+        // dbtp == 3, only store 12 bytes
+        tb_size_t need = sbtp == 3? 6 : 4;
+        for (; n >= need; n -= 4, s += sbtp << 2, d += 12)
+        {
+            __m128i r = _mm_shuffle_epi8(_mm_loadu_si128((__m128i const*)s), mask);
+            _mm_storel_epi64((__m128i*)d, r);
+            tb_bits_set_u32_le(d + 8, (tb_uint32_t)_mm_cvtsi128_si32(_mm_srli_si128(r, 8)));
+        }
+    }
+
+    // the left count
+    return n;
+}
+#elif defined(GB_PIXMAP_CONVERT_NEON)
+static __tb_inline__ uint8x16_t gb_pixmap_shuffle_plane_neon(uint8x16_t const* planes, tb_size_t index)
+{
+    return (index != GB_PIXMAP_SHUFFLE_FILL)? planes[index] : vdupq_n_u8(0xff);
+}
+static __tb_inline__ tb_size_t gb_pixmap_shuffle_done_neon(tb_byte_t* d, tb_byte_t const* s, tb_size_t count, tb_size_t dbtp, tb_size_t sbtp, tb_byte_t const* shuffle)
+{
+    // done, sixteen pixels for each time
+    tb_size_t   n = count;
+    uint8x16_t  planes[4];
+    for (; n >= 16; n -= 16, s += sbtp << 4, d += dbtp << 4)
+    {
+        // load planes
+        if (sbtp == 4)
+        {
+            uint8x16x4_t v = vld4q_u8(s);
+            planes[0] = v.val[0]; planes[1] = v.val[1]; planes[2] = v.val[2]; planes[3] = v.val[3];
+        }
+        else
+        {
+            uint8x16x3_t v = vld3q_u8(s);
+            planes[0] = v.val[0]; planes[1] = v.val[1]; planes[2] = v.val[2];
+        }
+
+        // store planes
+        if (dbtp == 4)
+        {
+            uint8x16x4_t r;
+            r.val[0] = gb_pixmap_shuffle_plane_neon(planes, shuffle[0]);
+            r.val[1] = gb_pixmap_shuffle_plane_neon(planes, shuffle[1]);
+            r.val[2] = gb_pixmap_shuffle_plane_neon(planes, shuffle[2]);
+            r.val[3] = gb_pixmap_shuffle_plane_neon(planes, shuffle[3]);
+            vst4q_u8(d, r);
+        }
+        else
+        {
+            uint8x16x3_t r;
+            r.val[0] = planes[shuffle[0]];
+            r.val[1] = planes[shuffle[1]];
+            r.val[2] = planes[shuffle[2]];
+            vst3q_u8(d, r);
+        }
+    }
+
+    // the left count
+    return n;
+}
+#endif
+static __tb_inline__ tb_void_t gb_pixmap_shuffle_done(tb_byte_t* d, tb_byte_t const* s, tb_size_t count, tb_size_t dbtp, tb_size_t sbtp, tb_byte_t const* shuffle)
+{
+    // done the vectors first
+    tb_size_t left = count;
+#if defined(GB_PIXMAP_CONVERT_SSSE3)
+    left = gb_pixmap_shuffle_done_ssse3(d, s, count, dbtp, sbtp, shuffle);
+#elif defined(GB_PIXMAP_CONVERT_NEON)
+    left = gb_pixmap_shuffle_done_neon(d, s, count, dbtp, sbtp, shuffle);
+#endif
+
+    // done the left pixels
+    if (left)
+    {
+        tb_size_t done = count - left;
+        gb_pixmap_shuffle_done_c(d + done * dbtp, s + done * sbtp, left, dbtp, sbtp, shuffle);
+    }
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * unpack implementation: 16-bits => argb
+ */
+static __tb_inline__ tb_void_t gb_pixmap_unpack16_done_c(tb_uint32_t* d, tb_byte_t const* s, tb_size_t count, gb_pixmap_layout_t const* layout)
+{
+    // init the channel masks and the left and right shifts
+    tb_size_t   c;
+    tb_uint32_t masks[4];
+    tb_size_t   sll[4];
+    tb_size_t   srl[4];
+    tb_uint32_t fill = layout->bits[GB_PIXMAP_CHANNEL_A]? 0 : 0xff000000;
+    for (c = 0; c < 4; c++)
+    {
+        // no this channel? the empty mask need not be shifted
+        tb_size_t bits  = layout->bits[c];
+        tb_long_t shift = bits? (tb_long_t)g_pixmap_argb_pos[c] + 8 - bits - layout->pos[c] : 0;
+        masks[c]    = bits? (gb_pixmap_mask(bits) << layout->pos[c]) : 0;
+        sll[c]      = shift > 0? shift : 0;
+        srl[c]      = shift < 0? -shift : 0;
+    }
+
+    // done
+    tb_uint32_t         p;
+    tb_uint32_t const*  e = d + count;
+    while (d < e)
+    {
+        // get pixel
+        p = layout->bendian? tb_bits_get_u16_be(s) : tb_bits_get_u16_le(s);
+
+        // unpack it
+        *d++ = fill
+            |   (((p & masks[0]) << sll[0]) >> srl[0])
+            |   (((p & masks[1]) << sll[1]) >> srl[1])
+            |   (((p & masks[2]) << sll[2]) >> srl[2])
+            |   (((p & masks[3]) << sll[3]) >> srl[3]);
+        s += 2;
+    }
+}
+#if defined(GB_PIXMAP_CONVERT_SSE2)
+static __tb_inline__ __m128i gb_pixmap_unpack16_lanes_sse2(__m128i v, __m128i const* srl, __m128i const* masks, __m128i const* sll, tb_size_t channels, __m128i fill)
+{
+    tb_size_t c;
+    __m128i   r = fill;
+    for (c = 0; c < channels; c++)
+        r = _mm_or_si128(r, _mm_sll_epi32(_mm_and_si128(_mm_srl_epi32(v, srl[c]), masks[c]), sll[c]));
+    return r;
+}
+static __tb_inline__ tb_size_t gb_pixmap_unpack16_done_sse2(tb_uint32_t* d, tb_byte_t const* s, tb_size_t count, gb_pixmap_layout_t const* layout)
+{
+    // init the channel shifts and masks for the existing channels
+    tb_size_t   c;
+    tb_size_t   n = 0;
+    __m128i     srl[4];
+    __m128i     sll[4];
+    __m128i     masks[4];
+    for (c = 0; c < 4; c++)
+    {
+        tb_size_t bits = layout->bits[c];
+        if (bits)
+        {
+            srl[n]      = _mm_cvtsi32_si128(layout->pos[c]);
+            sll[n]      = _mm_cvtsi32_si128(g_pixmap_argb_pos[c] + 8 - bits);
+            masks[n]    = _mm_set1_epi32((tb_int_t)gb_pixmap_mask(bits));
+            n++;
+        }
+    }
+    __m128i zero = _mm_setzero_si128();
+    __m128i fill = _mm_set1_epi32(layout->bits[GB_PIXMAP_CHANNEL_A]? 0 : (tb_int_t)0xff000000);
+
+    // done, eight pixels for each time
+    tb_size_t left = count;
+    for (; left >= 8; left -= 8, s += 16, d += 8)
+    {
+        // load pixels
+        __m128i v = _mm_loadu_si128((__m128i const*)s);
+        if (layout->bendian) v = _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+
+        // unpack pixels
+        _mm_storeu_si128((__m128i*)d, gb_pixmap_unpack16_lanes_sse2(_mm_unpacklo_epi16(v, zero), srl, masks, sll, n, fill));
+        _mm_storeu_si128((__m128i*)(d + 4), gb_pixmap_unpack16_lanes_sse2(_mm_unpackhi_epi16(v, zero), srl, masks, sll, n, fill));
+    }
+
+    // the left count
+    return left;
+}
+#elif defined(GB_PIXMAP_CONVERT_NEON)
+static __tb_inline__ tb_size_t gb_pixmap_unpack16_done_neon(tb_uint32_t* d, tb_byte_t const* s, tb_size_t count, gb_pixmap_layout_t const* layout)
+{
+    // done, eight pixels for each time
+    tb_size_t left = count;
+    for (; left >= 8; left -= 8, s += 16, d += 8)
+    {
+        // load pixels
+        uint16x8_t v = vld1q_u16((tb_uint16_t const*)s);
+        if (layout->bendian) v = vreinterpretq_u16_u8(vrev16q_u8(vreinterpretq_u8_u16(v)));
+
+        // unpack the channel planes, the native argb order in memory: b g r a
+        tb_size_t   c;
+        uint8x8x4_t r;
+        for (c = 0; c < 4; c++)
+        {
+            tb_size_t bits = layout->bits[c];
+            if (bits)
+            {
+                uint16x8_t t = vandq_u16(vshlq_u16(v, vdupq_n_s16(-(tb_int16_t)layout->pos[c])), vdupq_n_u16((tb_uint16_t)gb_pixmap_mask(bits)));
+                r.val[3 - c] = vmovn_u16(vshlq_u16(t, vdupq_n_s16(8 - bits)));
+            }
+            else r.val[3 - c] = vdup_n_u8(c == GB_PIXMAP_CHANNEL_A? 0xff : 0);
+        }
+
+        // store pixels
+        vst4_u8((tb_byte_t*)d, r);
+    }
+
+    // the left count
+    return left;
+}
+#endif
+static __tb_inline__ tb_void_t gb_pixmap_unpack16_done(tb_uint32_t* d, tb_byte_t const* s, tb_size_t count, gb_pixmap_layout_t const* layout)
+{
+    // done the vectors first
+    tb_size_t left = count;
+#if defined(GB_PIXMAP_CONVERT_SSE2)
+    left = gb_pixmap_unpack16_done_sse2(d, s, count, layout);
+#elif defined(GB_PIXMAP_CONVERT_NEON)
+    left = gb_pixmap_unpack16_done_neon(d, s, count, layout);
+#endif
+
+    // done the left pixels
+    if (left)
+    {
+        tb_size_t done = count - left;
+        gb_pixmap_unpack16_done_c(d + done, s + (done << 1), left, layout);
+    }
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * pack implementation: argb => 16-bits
+ */
+static __tb_inline__ tb_void_t gb_pixmap_pack16_done_c(tb_byte_t* d, tb_uint32_t const* s, tb_size_t count, gb_pixmap_layout_t const* layout)
+{
+    // init the channel masks and the left and right shifts
+    tb_size_t   c;
+    tb_uint32_t masks[4];
+    tb_size_t   sll[4];
+    tb_size_t   srl[4];
+    for (c = 0; c < 4; c++)
+    {
+        // no this channel? the empty mask need not be shifted
+        tb_size_t bits  = layout->bits[c];
+        tb_long_t shift = bits? (tb_long_t)g_pixmap_argb_pos[c] + 8 - bits - layout->pos[c] : 0;
+        masks[c]    = bits? (gb_pixmap_mask(bits) << (g_pixmap_argb_pos[c] + 8 - bits)) : 0;
+        srl[c]      = shift > 0? shift : 0;
+        sll[c]      = shift < 0? -shift : 0;
+    }
+
+    // done
+    tb_uint32_t         p;
+    tb_uint32_t         fill = layout->fill;
+    tb_uint32_t const*  e = s + count;
+    while (s < e)
+    {
+        // pack it
+        p = *s++;
+        p = fill
+            |   (((p & masks[0]) >> srl[0]) << sll[0])
+            |   (((p & masks[1]) >> srl[1]) << sll[1])
+            |   (((p & masks[2]) >> srl[2]) << sll[2])
+            |   (((p & masks[3]) >> srl[3]) << sll[3]);
+
+        // set pixel
+        if (layout->bendian) tb_bits_set_u16_be(d, p);
+        else tb_bits_set_u16_le(d, p);
+        d += 2;
+    }
+}
+#if defined(GB_PIXMAP_CONVERT_SSE2)
+static __tb_inline__ __m128i gb_pixmap_pack16_lanes_sse2(__m128i v, __m128i const* srl, __m128i const* masks, __m128i const* sll, tb_size_t channels, __m128i fill)
+{
+    tb_size_t c;
+    __m128i   r = fill;
+    for (c = 0; c < channels; c++)
+        r = _mm_or_si128(r, _mm_sll_epi32(_mm_and_si128(_mm_srl_epi32(v, srl[c]), masks[c]), sll[c]));
+
+    // sign-extend the low 16-bits for _mm_packs_epi32
+    return _mm_srai_epi32(_mm_slli_epi32(r, 16), 16);
+}
+static __tb_inline__ tb_size_t gb_pixmap_pack16_done_sse2(tb_byte_t* d, tb_uint32_t const* s, tb_size_t count, gb_pixmap_layout_t const* layout)
+{
+    // init the channel shifts and masks for the existing channels
+    tb_size_t   c;
+    tb_size_t   n = 0;
+    __m128i     srl[4];
+    __m128i     sll[4];
+    __m128i     masks[4];
+    for (c = 0; c < 4; c++)
+    {
+        tb_size_t bits = layout->bits[c];
+        if (bits)
+        {
+            srl[n]      = _mm_cvtsi32_si128(g_pixmap_argb_pos[c] + 8 - bits);
+            sll[n]      = _mm_cvtsi32_si128(layout->pos[c]);
+            masks[n]    = _mm_set1_epi32((tb_int_t)gb_pixmap_mask(bits));
+            n++;
+        }
+    }
+    __m128i fill = _mm_set1_epi32((tb_int_t)layout->fill);
+
+    // done, eight pixels for each time
+    tb_size_t left = count;
+    for (; left >= 8; left -= 8, s += 8, d += 16)
+    {
+        // pack pixels
+        __m128i lo = gb_pixmap_pack16_lanes_sse2(_mm_loadu_si128((__m128i const*)s), srl, masks, sll, n, fill);
+        __m128i hi = gb_pixmap_pack16_lanes_sse2(_mm_loadu_si128((__m128i const*)(s + 4)), srl, masks, sll, n, fill);
+        __m128i v = _mm_packs_epi32(lo, hi);
+        if (layout->bendian) v = _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+
+        // store pixels
+        _mm_storeu_si128((__m128i*)d, v);
+    }
+
+    // the left count
+    return left;
+}
+#elif defined(GB_PIXMAP_CONVERT_NEON)
+static __tb_inline__ tb_size_t gb_pixmap_pack16_done_neon(tb_byte_t* d, tb_uint32_t const* s, tb_size_t count, gb_pixmap_layout_t const* layout)
+{
+    // done, eight pixels for each time
+    tb_size_t left = count;
+    for (; left >= 8; left -= 8, s += 8, d += 16)
+    {
+        // load the channel planes, the native argb order in memory: b g r a
+        uint8x8x4_t planes = vld4_u8((tb_byte_t const*)s);
+
+        // pack pixels
+        tb_size_t   c;
+        uint16x8_t  v = vdupq_n_u16((tb_uint16_t)layout->fill);
+        for (c = 0; c < 4; c++)
+        {
+            tb_size_t bits = layout->bits[c];
+            if (bits)
+            {
+                uint16x8_t t = vshlq_u16(vmovl_u8(planes.val[3 - c]), vdupq_n_s16(-(tb_int16_t)(8 - bits)));
+                v = vorrq_u16(v, vshlq_u16(t, vdupq_n_s16(layout->pos[c])));
+            }
+        }
+        if (layout->bendian) v = vreinterpretq_u16_u8(vrev16q_u8(vreinterpretq_u8_u16(v)));
+
+        // store pixels
+        vst1q_u16((tb_uint16_t*)d, v);
+    }
+
+    // the left count
+    return left;
+}
+#endif
+static __tb_inline__ tb_void_t gb_pixmap_pack16_done(tb_byte_t* d, tb_uint32_t const* s, tb_size_t count, gb_pixmap_layout_t const* layout)
+{
+    // done the vectors first
+    tb_size_t left = count;
+#if defined(GB_PIXMAP_CONVERT_SSE2)
+    left = gb_pixmap_pack16_done_sse2(d, s, count, layout);
+#elif defined(GB_PIXMAP_CONVERT_NEON)
+    left = gb_pixmap_pack16_done_neon(d, s, count, layout);
+#endif
+
+    // done the left pixels
+    if (left)
+    {
+        tb_size_t done = count - left;
+        gb_pixmap_pack16_done_c(d + (done << 1), s + done, left, layout);
+    }
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * converters
+ */
+
+// the same layout
+static tb_void_t gb_pixmap_convert_copy(gb_pixmap_converter_t const* converter, tb_pointer_t data, tb_cpointer_t source, tb_size_t count)
+{
+    tb_memcpy(data, source, count * converter->src.btp);
+}
+
+// the same 16-bits layout with the different endian
+static tb_void_t gb_pixmap_convert_swap16(gb_pixmap_converter_t const* converter, tb_pointer_t data, tb_cpointer_t source, tb_size_t count)
+{
+    tb_byte_t*          d = (tb_byte_t*)data;
+    tb_byte_t const*    s = (tb_byte_t const*)source;
+    tb_byte_t const*    e = s + (count << 1);
+    for (; s < e; s += 2, d += 2)
+    {
+        tb_byte_t b = s[0];
+        d[0] = s[1];
+        d[1] = b;
+    }
+}
+
+// rgb888 or 8888 => rgb888 or 8888
+static tb_void_t gb_pixmap_convert_shuffle(gb_pixmap_converter_t const* converter, tb_pointer_t data, tb_cpointer_t source, tb_size_t count)
+{
+    gb_pixmap_shuffle_done((tb_byte_t*)data, (tb_byte_t const*)source, count, converter->dst.btp, converter->src.btp, converter->shuffle[0]);
+}
+
+// others: source => native argb => destination
+static tb_void_t gb_pixmap_convert_generic(gb_pixmap_converter_t const* converter, tb_pointer_t data, tb_cpointer_t source, tb_size_t count)
+{
+    // the native argb => 16-bits? pack it directly
+    if (converter->src.btp == 4 && gb_pixmap_layout_is_argb(&converter->src) && !(((tb_size_t)source) & 3))
+    {
+        gb_pixmap_pack16_done((tb_byte_t*)data, (tb_uint32_t const*)source, count, &converter->dst);
+        return ;
+    }
+
+    // 16-bits => the native argb? unpack it directly
+    if (converter->dst.btp == 4 && gb_pixmap_layout_is_argb(&converter->dst) && !(((tb_size_t)data) & 3))
+    {
+        gb_pixmap_unpack16_done((tb_uint32_t*)data, (tb_byte_t const*)source, count, &converter->src);
+        return ;
+    }
+
+    // done
+    tb_uint32_t         argb[GB_PIXMAP_CONVERT_CHUNK];
+    tb_byte_t*          d = (tb_byte_t*)data;
+    tb_byte_t const*    s = (tb_byte_t const*)source;
+    tb_size_t           dbtp = converter->dst.btp;
+    tb_size_t           sbtp = converter->src.btp;
+    while (count)
+    {
+        // the chunk size
+        tb_size_t n = tb_min(count, GB_PIXMAP_CONVERT_CHUNK);
+
+        // source => argb
+        if (sbtp == 2) gb_pixmap_unpack16_done(argb, s, n, &converter->src);
+        else gb_pixmap_shuffle_done((tb_byte_t*)argb, s, n, 4, sbtp, converter->shuffle[0]);
+
+        // argb => destination
+        if (dbtp == 2) gb_pixmap_pack16_done(d, argb, n, &converter->dst);
+        else gb_pixmap_shuffle_done(d, (tb_byte_t const*)argb, n, dbtp, 4, converter->shuffle[1]);
+
+        // next
+        d       += n * dbtp;
+        s       += n * sbtp;
+        count   -= n;
+    }
+}
+
+#endif
@@ -0,0 +1,288 @@
+/*!The Graphic Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        trace.c
+ * @ingroup     core
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME            "trace"
+#define TB_TRACE_MODULE_DEBUG           (0)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "trace.h"
+
+#ifdef GB_CONFIG_TRACE
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the thread local storage
+#ifdef TB_COMPILER_IS_MSVC
+#   define GB_TRACE_THREAD_LOCAL        __declspec(thread)
+#else
+#   define GB_TRACE_THREAD_LOCAL        __thread
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the trace span type
+typedef struct __gb_trace_span_t
+{
+    // the static name
+    tb_char_t const*            name;
+
+    // the start clock
+    tb_hong_t                   start;
+
+    // the stop clock
+    tb_hong_t                   stop;
+
+}gb_trace_span_t;
+
+/* the trace ring type 
+ *
+ * it is only written by its thread, and the head is published after the span has been written,
+ * so the dumper can read the spans of all threads without locking them.
+ */
+typedef struct __gb_trace_ring_t
+{
+    // the next ring of the ring list
+    struct __gb_trace_ring_t*   next;
+
+    // the thread id
+    tb_size_t                   tid;
+
+    // the written spans count
+    tb_atomic_t                 head;
+
+    // the spans
+    gb_trace_span_t             spans[GB_TRACE_SPANS_MAXN];
+
+}gb_trace_ring_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * globals
+ */
+
+// the ring list of all threads
+static tb_atomic_t                              g_rings = 0;
+
+// the generation of the ring list, all rings will be invalid after exiting the trace
+static tb_atomic_t                              g_generation = 1;
+
+// the ring of the current thread
+static GB_TRACE_THREAD_LOCAL gb_trace_ring_t*   g_ring = tb_null;
+
+// the ring generation of the current thread
+static GB_TRACE_THREAD_LOCAL tb_size_t          g_ring_generation = 0;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static gb_trace_ring_t* gb_trace_ring_init(tb_noarg_t)
+{
+    // the spans count must be a power of 2
+    tb_assert_static(GB_TRACE_SPANS_MAXN > 1 && !(GB_TRACE_SPANS_MAXN & (GB_TRACE_SPANS_MAXN - 1)));
+
+    // make ring
+    gb_trace_ring_t* ring = tb_malloc0_type(gb_trace_ring_t);
+    tb_assert_and_check_return_val(ring, tb_null);
+
+    // init ring
+    ring->tid = tb_thread_self();
+
+    // insert it to the head of the ring list
+    tb_size_t next;
+    do
+    {
+        next = (tb_size_t)tb_atomic_get(&g_rings);
+        ring->next = (gb_trace_ring_t*)next;
+
+    } while ((tb_size_t)tb_atomic_fetch_and_pset(&g_rings, next, (tb_size_t)ring) != next);
+
+    // save it for the current thread
+    g_ring              = ring;
+    g_ring_generation   = (tb_size_t)tb_atomic_get(&g_generation);
+
+    // ok
+    return ring;
+}
+static __tb_inline__ tb_size_t gb_trace_ring_tail(tb_size_t head)
+{
+    /* the first readable span of the ring
+     *
+     * the slot of the span at head - GB_TRACE_SPANS_MAXN may be being overwritten by the next span,
+     * so we only read the last GB_TRACE_SPANS_MAXN - 1 spans
+     */
+    return head >= GB_TRACE_SPANS_MAXN? head - GB_TRACE_SPANS_MAXN + 1 : 0;
+}
+static tb_void_t gb_trace_dump_span(tb_stream_ref_t stream, gb_trace_ring_t* ring, gb_trace_span_t const* span, tb_hong_t base, tb_bool_t first)
+{
+    // check
+    tb_assert(stream && ring && span && span->name);
+
+    // write the complete event
+    tb_stream_printf(stream,    "%s{\"name\":\"%s\",\"cat\":\"gbox\",\"ph\":\"X\",\"pid\":1,\"tid\":%lu,\"ts\":%lld,\"dur\":%lld}"
+                            ,   first? "\n" : ",\n"
+                            ,   span->name
+                            ,   ring->tid
+                            ,   span->start - base
+                            ,   span->stop - span->start);
+}
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_void_t gb_trace_span(tb_char_t const* name, tb_hong_t start, tb_hong_t stop)
+{
+#ifdef GB_CONFIG_TRACE
+    // the ring of the current thread, remake it if the trace has been exited
+    gb_trace_ring_t* ring = g_ring;
+    if (!ring || g_ring_generation != (tb_size_t)tb_atomic_get(&g_generation))
+    {
+        ring = gb_trace_ring_init();
+        tb_check_return(ring);
+    }
+
+    // write span
+    tb_size_t           head = (tb_size_t)ring->head;
+    gb_trace_span_t*    span = &ring->spans[head & (GB_TRACE_SPANS_MAXN - 1)];
+    span->name  = name;
+    span->start = start;
+    span->stop  = stop;
+
+    // publish it
+    tb_atomic_set(&ring->head, head + 1);
+#else
+    tb_used(name);
+    tb_used(&start);
+    tb_used(&stop);
+#endif
+}
+tb_bool_t gb_trace_dump(tb_char_t const* path)
+{
+    // check
+    tb_assert_and_check_return_val(path, tb_false);
+
+#ifdef GB_CONFIG_TRACE
+    // the base clock, the minimal start clock of all spans
+    tb_hong_t           base = 0;
+    gb_trace_ring_t*    ring = (gb_trace_ring_t*)(tb_size_t)tb_atomic_get(&g_rings);
+    for (; ring; ring = ring->next)
+    {
+        tb_size_t head = (tb_size_t)tb_atomic_get(&ring->head);
+        tb_size_t tail = gb_trace_ring_tail(head);
+        if (head > tail)
+        {
+            tb_hong_t start = ring->spans[tail & (GB_TRACE_SPANS_MAXN - 1)].start;
+            if (!base || start < base) base = start;
+        }
+    }
+
+    // done
+    tb_bool_t       ok = tb_false;
+    tb_stream_ref_t stream = tb_null;
+    do
+    {
+        // init stream
+        stream = tb_stream_init_from_file(path, TB_FILE_MODE_RW | TB_FILE_MODE_CREAT | TB_FILE_MODE_TRUNC);
+        tb_assert_and_check_break(stream);
+
+        // open stream
+        if (!tb_stream_open(stream)) break;
+
+        // write head
+        if (tb_stream_printf(stream, "{\"traceEvents\":[") < 0) break;
+
+        // write the spans of all threads
+        tb_bool_t first = tb_true;
+        for (ring = (gb_trace_ring_t*)(tb_size_t)tb_atomic_get(&g_rings); ring; ring = ring->next)
+        {
+            // the written spans
+            tb_size_t head = (tb_size_t)tb_atomic_get(&ring->head);
+            tb_size_t tail = gb_trace_ring_tail(head);
+            for (; tail < head; tail++)
+            {
+                // copy span
+                gb_trace_span_t span = ring->spans[tail & (GB_TRACE_SPANS_MAXN - 1)];
+
+                /* this span has been overwritten by its thread? skip it
+                 *
+                 * the slot of the span at head is being written before the head is published,
+                 * so the span is torn if the written count has reached it
+                 */
+                if ((tb_size_t)tb_atomic_get(&ring->head) - tail >= GB_TRACE_SPANS_MAXN) continue;
+
+                // write span
+                gb_trace_dump_span(stream, ring, &span, base, first);
+                first = tb_false;
+            }
+        }
+
+        // write tail
+        if (tb_stream_printf(stream, "\n],\"displayTimeUnit\":\"ms\"}\n") < 0) break;
+
+        // sync it
+        if (!tb_stream_sync(stream, tb_true)) break;
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // trace
+    tb_trace_d("dump: %s: %s", path, ok? "ok" : "failed");
+
+    // exit stream
+    if (stream) tb_stream_exit(stream);
+
+    // ok?
+    return ok;
+#else
+    // trace
+    tb_trace_e("dump: the trace is disabled, please enable it by xmake f --trace=y");
+    return tb_false;
+#endif
+}
+tb_void_t gb_trace_exit()
+{
+#ifdef GB_CONFIG_TRACE
+    // invalidate the rings of all threads
+    tb_atomic_fetch_and_inc(&g_generation);
+
+    // free all rings
+    gb_trace_ring_t* ring = (gb_trace_ring_t*)(tb_size_t)tb_atomic_fetch_and_set(&g_rings, 0);
+    while (ring)
+    {
+        gb_trace_ring_t* next = ring->next;
+        tb_free(ring);
+        ring = next;
+    }
+#endif
+}
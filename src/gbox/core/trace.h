@@ -0,0 +1,121 @@
+/*!The Graphic Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        trace.h
+ * @ingroup     core
+ */
+#ifndef GB_CORE_TRACE_H
+#define GB_CORE_TRACE_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+/*! enter and leave the scoped trace span
+ *
+ * the spans are only compiled if GB_CONFIG_TRACE is enabled, e.g. xmake f --trace=y
+ *
+ * @code
+    gb_trace_enter(span);
+    // ...
+    gb_trace_leave(span, "gb_canvas_draw_path");
+ * @endcode
+ *
+ * the span name need be a static string, it is saved as the pointer.
+ */
+#ifdef GB_CONFIG_TRACE
+#   define gb_trace_enter(span)             tb_hong_t span = tb_uclock()
+#   define gb_trace_leave(span, name)       gb_trace_span(name, span, tb_uclock())
+#else
+#   define gb_trace_enter(span)             
+#   define gb_trace_leave(span, name)       
+#endif
+
+/* the max spans count of the ring buffer for each thread, it must be a power of 2
+ *
+ * the ring is kept until gb_trace_exit(), e.g. 48KB for each thread on 64-bits if be 1 << 11,
+ * and it can be overridden by -DGB_TRACE_SPANS_MAXN=... if more spans need be dumped
+ */
+#ifndef GB_TRACE_SPANS_MAXN
+#   ifdef __gb_small__
+#       define GB_TRACE_SPANS_MAXN          (1 << 9)
+#   else
+#       define GB_TRACE_SPANS_MAXN          (1 << 11)
+#   endif
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/*! record the trace span to the ring buffer of the current thread
+ *
+ * it is lock-free and the oldest spans will be overwritten if the ring buffer is full.
+ * it is used by gb_trace_leave() and does nothing if GB_CONFIG_TRACE is disabled.
+ *
+ * @param name      the static span name
+ * @param start     the start clock in microseconds
+ * @param stop      the stop clock in microseconds
+ */
+tb_void_t           gb_trace_span(tb_char_t const* name, tb_hong_t start, tb_hong_t stop);
+
+/*! dump the spans of all threads to the chrome trace json file 
+ *
+ * the file can be loaded by chrome://tracing or https://ui.perfetto.dev,
+ * the spans are written as the complete events:
+ *
+ * <pre>
+ * {"traceEvents":[
+ * {"name":"gb_canvas_draw_path","cat":"gbox","ph":"X","pid":1,"tid":1234,"ts":16,"dur":120},
+ * ...
+ * ]}
+ * </pre>
+ *
+ * it is safe to dump it when the other threads are drawing, 
+ * but the spans being overwritten at the same time will be dropped.
+ *
+ * @param path      the json file path
+ *
+ * @return          tb_true or tb_false if failed or GB_CONFIG_TRACE is disabled
+ */
+tb_bool_t           gb_trace_dump(tb_char_t const* path);
+
+/*! exit the trace and free the ring buffers of all threads
+ *
+ * it is called by gb_exit()
+ */
+tb_void_t           gb_trace_exit(tb_noarg_t);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+#endif
@@ -83,6 +83,9 @@ tb_void_t gb_window_impl_draw(gb_window_ref_t window, gb_canvas_ref_t canvas)
 
     // done draw
     impl->info.draw((gb_window_ref_t)impl, canvas, impl->info.priv);
+
+    // flush the pending draws at the end of this frame
+    gb_device_draw_flush(gb_canvas_device(canvas));
 }
 tb_void_t gb_window_impl_event(gb_window_ref_t window, gb_event_ref_t event)
 {
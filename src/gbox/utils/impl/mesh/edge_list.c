@@ -33,6 +33,7 @@
  * includes
  */
 #include "edge_list.h"
+#include "pool.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * macros
@@ -66,7 +67,7 @@ typedef struct __gb_mesh_edge_list_impl_t
     tb_iterator_t                   itor;
 
     // the pool
-    tb_fixed_pool_ref_t             pool;
+    gb_mesh_pool_ref_t              pool;
 
     // the head edge
     gb_mesh_edge_t                  head[2];
@@ -284,7 +285,7 @@ gb_mesh_edge_list_ref_t gb_mesh_edge_list_init(tb_element_t element)
         impl->itor.item = gb_mesh_edge_itor_item;
 
         // init pool, item = (edge + data) + (edge->sym + data)
-        impl->pool = tb_fixed_pool_init(tb_null, GB_MESH_EDGE_LIST_GROW, impl->edge_size << 1, tb_null, gb_mesh_edge_exit, (tb_cpointer_t)impl);
+        impl->pool = gb_mesh_pool_init(GB_MESH_EDGE_LIST_GROW, impl->edge_size << 1, element.free? gb_mesh_edge_exit : tb_null, (tb_cpointer_t)impl);
         tb_assert_and_check_break(impl->pool);
 
         // init head edge
@@ -320,7 +321,7 @@ tb_void_t gb_mesh_edge_list_exit(gb_mesh_edge_list_ref_t list)
     gb_mesh_edge_list_clear(list);
 
     // exit pool
-    if (impl->pool) tb_fixed_pool_exit(impl->pool);
+    if (impl->pool) gb_mesh_pool_exit(impl->pool);
     impl->pool = tb_null;
 
     // exit it
@@ -332,8 +333,19 @@ tb_void_t gb_mesh_edge_list_clear(gb_mesh_edge_list_ref_t list)
     gb_mesh_edge_list_impl_t* impl = (gb_mesh_edge_list_impl_t*)list;
     tb_assert_and_check_return(impl);
    
+    // exit the user data of all edges if it need be freed, the pool will not exit them when clearing it
+    if (impl->element.free)
+    {
+        gb_mesh_edge_ref_t edge = impl->head->next;
+        while (edge && edge != impl->head)
+        {
+            gb_mesh_edge_exit(edge, (tb_cpointer_t)impl);
+            edge = edge->next;
+        }
+    }
+
     // clear pool
-    if (impl->pool) tb_fixed_pool_clear(impl->pool);
+    if (impl->pool) gb_mesh_pool_clear(impl->pool);
 
     // clear list
     gb_mesh_edge_init(impl->head);
@@ -355,13 +367,22 @@ tb_size_t gb_mesh_edge_list_size(gb_mesh_edge_list_ref_t list)
     tb_assert_and_check_return_val(impl && impl->pool, 0);
 
     // the size
-    return tb_fixed_pool_size(impl->pool);
+    return gb_mesh_pool_size(impl->pool);
 }
 tb_size_t gb_mesh_edge_list_maxn(gb_mesh_edge_list_ref_t list)
 {
     // the edge maxn
     return GB_MESH_EDGE_LIST_MAXN;
 }
+tb_size_t gb_mesh_edge_list_capacity(gb_mesh_edge_list_ref_t list)
+{
+    // check
+    gb_mesh_edge_list_impl_t* impl = (gb_mesh_edge_list_impl_t*)list;
+    tb_assert_and_check_return_val(impl && impl->pool, 0);
+
+    // the capacity
+    return sizeof(gb_mesh_edge_list_impl_t) + gb_mesh_pool_capacity(impl->pool);
+}
 gb_mesh_edge_ref_t gb_mesh_edge_list_make(gb_mesh_edge_list_ref_t list)
 {
     // check
@@ -369,7 +390,7 @@ gb_mesh_edge_ref_t gb_mesh_edge_list_make(gb_mesh_edge_list_ref_t list)
     tb_assert_and_check_return_val(impl && impl->pool, tb_null);
 
     // make it
-    gb_mesh_edge_ref_t edge = (gb_mesh_edge_ref_t)tb_fixed_pool_malloc0(impl->pool);
+    gb_mesh_edge_ref_t edge = (gb_mesh_edge_ref_t)gb_mesh_pool_malloc0(impl->pool);
     tb_assert_and_check_return_val(edge, tb_null);
 
     // the sym edge
@@ -417,7 +438,7 @@ gb_mesh_edge_ref_t gb_mesh_edge_list_make_loop(gb_mesh_edge_list_ref_t list, tb_
     tb_assert_and_check_return_val(impl && impl->pool, tb_null);
 
     // make it
-    gb_mesh_edge_ref_t edge = (gb_mesh_edge_ref_t)tb_fixed_pool_malloc0(impl->pool);
+    gb_mesh_edge_ref_t edge = (gb_mesh_edge_ref_t)gb_mesh_pool_malloc0(impl->pool);
     tb_assert_and_check_return_val(edge, tb_null);
 
     // the sym edge
@@ -501,7 +522,7 @@ tb_void_t gb_mesh_edge_list_kill(gb_mesh_edge_list_ref_t list, gb_mesh_edge_ref_
     gb_mesh_edge_remove_done(edge);
 
     // exit it
-    tb_fixed_pool_free(impl->pool, edge);
+    gb_mesh_pool_free(impl->pool, edge);
 }
 tb_cpointer_t gb_mesh_edge_list_data(gb_mesh_edge_list_ref_t list, gb_mesh_edge_ref_t edge)
 {
@@ -91,6 +91,14 @@ tb_size_t                   gb_mesh_edge_list_size(gb_mesh_edge_list_ref_t list)
  */
 tb_size_t                   gb_mesh_edge_list_maxn(gb_mesh_edge_list_ref_t list);
 
+/*! the allocated bytes of the mesh edge list, including the unused items of the pool
+ *
+ * @param list              the list
+ *
+ * @return                  the bytes
+ */
+tb_size_t                   gb_mesh_edge_list_capacity(gb_mesh_edge_list_ref_t list);
+
 /*! make a unconnected edge
  *
  * <pre>
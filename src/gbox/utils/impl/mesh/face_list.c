@@ -33,6 +33,7 @@
  * includes
  */
 #include "face_list.h"
+#include "pool.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * macros
@@ -63,7 +64,7 @@
 typedef struct __gb_mesh_face_list_impl_t
 {
     // the pool
-    tb_fixed_pool_ref_t         pool;
+    gb_mesh_pool_ref_t          pool;
 
     // the head
     tb_list_entry_head_t        head;
@@ -115,7 +116,7 @@ gb_mesh_face_list_ref_t gb_mesh_face_list_init(tb_element_t element)
         impl->element = element;
 
         // init pool, item = face + data
-        impl->pool = tb_fixed_pool_init(tb_null, GB_MESH_FACE_LIST_GROW, sizeof(gb_mesh_face_t) + element.size, tb_null, gb_mesh_face_exit, (tb_cpointer_t)impl);
+        impl->pool = gb_mesh_pool_init(GB_MESH_FACE_LIST_GROW, sizeof(gb_mesh_face_t) + element.size, element.free? gb_mesh_face_exit : tb_null, (tb_cpointer_t)impl);
         tb_assert_and_check_break(impl->pool);
 
         // init head
@@ -150,7 +151,7 @@ tb_void_t gb_mesh_face_list_exit(gb_mesh_face_list_ref_t list)
     gb_mesh_face_list_clear(list);
 
     // exit pool
-    if (impl->pool) tb_fixed_pool_exit(impl->pool);
+    if (impl->pool) gb_mesh_pool_exit(impl->pool);
     impl->pool = tb_null;
 
     // exit it
@@ -162,8 +163,20 @@ tb_void_t gb_mesh_face_list_clear(gb_mesh_face_list_ref_t list)
     gb_mesh_face_list_impl_t* impl = (gb_mesh_face_list_impl_t*)list;
     tb_assert_and_check_return(impl);
    
+    // exit the user data of all faces if it need be freed, the pool will not exit them when clearing it
+    if (impl->element.free)
+    {
+        tb_list_entry_ref_t entry = tb_list_entry_head(&impl->head);
+        tb_list_entry_ref_t tail  = tb_list_entry_tail(&impl->head);
+        while (entry && entry != tail)
+        {
+            gb_mesh_face_exit((tb_pointer_t)tb_list_entry(&impl->head, entry), (tb_cpointer_t)impl);
+            entry = entry->next;
+        }
+    }
+
     // clear pool
-    if (impl->pool) tb_fixed_pool_clear(impl->pool);
+    if (impl->pool) gb_mesh_pool_clear(impl->pool);
 
     // clear head
     tb_list_entry_clear(&impl->head);
@@ -187,7 +200,7 @@ tb_size_t gb_mesh_face_list_size(gb_mesh_face_list_ref_t list)
     // check
     gb_mesh_face_list_impl_t* impl = (gb_mesh_face_list_impl_t*)list;
     tb_assert_and_check_return_val(impl && impl->pool, 0);
-    tb_assert(tb_list_entry_size(&impl->head) == tb_fixed_pool_size(impl->pool));
+    tb_assert(tb_list_entry_size(&impl->head) == gb_mesh_pool_size(impl->pool));
 
     // the size
     return tb_list_entry_size(&impl->head);
@@ -197,6 +210,15 @@ tb_size_t gb_mesh_face_list_maxn(gb_mesh_face_list_ref_t list)
     // the face maxn
     return GB_MESH_FACE_LIST_MAXN;
 }
+tb_size_t gb_mesh_face_list_capacity(gb_mesh_face_list_ref_t list)
+{
+    // check
+    gb_mesh_face_list_impl_t* impl = (gb_mesh_face_list_impl_t*)list;
+    tb_assert_and_check_return_val(impl && impl->pool, 0);
+
+    // the capacity
+    return sizeof(gb_mesh_face_list_impl_t) + gb_mesh_pool_capacity(impl->pool);
+}
 gb_mesh_face_ref_t gb_mesh_face_list_make(gb_mesh_face_list_ref_t list)
 {
     // check
@@ -204,7 +226,7 @@ gb_mesh_face_ref_t gb_mesh_face_list_make(gb_mesh_face_list_ref_t list)
     tb_assert_and_check_return_val(impl && impl->pool, tb_null);
 
     // make it
-    gb_mesh_face_ref_t face = (gb_mesh_face_ref_t)tb_fixed_pool_malloc0(impl->pool);
+    gb_mesh_face_ref_t face = (gb_mesh_face_ref_t)gb_mesh_pool_malloc0(impl->pool);
     tb_assert_and_check_return_val(face, tb_null);
 
 #ifdef __gb_debug__
@@ -261,7 +283,7 @@ tb_void_t gb_mesh_face_list_kill(gb_mesh_face_list_ref_t list, gb_mesh_face_ref_
     tb_list_entry_remove(&impl->head, &face->entry);
 
     // exit it
-    tb_fixed_pool_free(impl->pool, face);
+    gb_mesh_pool_free(impl->pool, face);
 }
 tb_cpointer_t gb_mesh_face_list_data(gb_mesh_face_list_ref_t list, gb_mesh_face_ref_t face)
 {
@@ -91,6 +91,14 @@ tb_size_t                   gb_mesh_face_list_size(gb_mesh_face_list_ref_t list)
  */
 tb_size_t                   gb_mesh_face_list_maxn(gb_mesh_face_list_ref_t list);
 
+/*! the allocated bytes of the mesh face list, including the unused items of the pool
+ *
+ * @param list              the list
+ *
+ * @return                  the bytes
+ */
+tb_size_t                   gb_mesh_face_list_capacity(gb_mesh_face_list_ref_t list);
+
 /*! make a bare face without faces
  *
  * @param list              the list
@@ -0,0 +1,212 @@
+/*!The Graphic Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        pool.c
+ * @ingroup     utils
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME                "mesh_pool"
+#define TB_TRACE_MODULE_DEBUG               (1)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "pool.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the chunk maxn, the maximum item count is grow << chunk maxn
+#define GB_MESH_POOL_CHUNK_MAXN                 (24)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the mesh pool impl type
+typedef struct __gb_mesh_pool_impl_t
+{
+    // the chunks
+    tb_byte_t*                          chunks[GB_MESH_POOL_CHUNK_MAXN];
+
+    // the chunk count
+    tb_size_t                           chunk_count;
+
+    // the current chunk index
+    tb_size_t                           chunk_index;
+
+    // the allocated item count of the current chunk
+    tb_size_t                           chunk_used;
+
+    // the free items 
+    tb_pointer_t                        frees;
+
+    // the living item count
+    tb_size_t                           size;
+
+    // the item count of the first chunk
+    tb_size_t                           grow;
+
+    // the item size
+    tb_size_t                           item_size;
+
+    // the item exit func
+    tb_fixed_pool_item_exit_func_t      item_exit;
+
+    // the private data of the item exit func
+    tb_cpointer_t                       priv;
+
+}gb_mesh_pool_impl_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+gb_mesh_pool_ref_t gb_mesh_pool_init(tb_size_t grow, tb_size_t item_size, tb_fixed_pool_item_exit_func_t item_exit, tb_cpointer_t priv)
+{
+    // check
+    tb_assert_and_check_return_val(grow && item_size, tb_null);
+
+    // make pool
+    gb_mesh_pool_impl_t* impl = tb_malloc0_type(gb_mesh_pool_impl_t);
+    tb_assert_and_check_return_val(impl, tb_null);
+
+    // init pool, the free item need store the next pointer
+    impl->grow      = grow;
+    impl->item_size = tb_align_cpu(tb_max(item_size, sizeof(tb_pointer_t)));
+    impl->item_exit = item_exit;
+    impl->priv      = priv;
+
+    // ok
+    return (gb_mesh_pool_ref_t)impl;
+}
+tb_void_t gb_mesh_pool_exit(gb_mesh_pool_ref_t pool)
+{
+    // check
+    gb_mesh_pool_impl_t* impl = (gb_mesh_pool_impl_t*)pool;
+    tb_assert_and_check_return(impl);
+
+    // exit chunks
+    tb_size_t i = 0;
+    for (i = 0; i < impl->chunk_count; i++) 
+    {
+        if (impl->chunks[i]) tb_free(impl->chunks[i]);
+        impl->chunks[i] = tb_null;
+    }
+
+    // exit it
+    tb_free(impl);
+}
+tb_void_t gb_mesh_pool_clear(gb_mesh_pool_ref_t pool)
+{
+    // check
+    gb_mesh_pool_impl_t* impl = (gb_mesh_pool_impl_t*)pool;
+    tb_assert_and_check_return(impl);
+
+    // allocate items from the first chunk again
+    impl->chunk_index   = 0;
+    impl->chunk_used    = 0;
+    impl->frees         = tb_null;
+    impl->size          = 0;
+}
+tb_size_t gb_mesh_pool_size(gb_mesh_pool_ref_t pool)
+{
+    // check
+    gb_mesh_pool_impl_t* impl = (gb_mesh_pool_impl_t*)pool;
+    tb_assert_and_check_return_val(impl, 0);
+
+    // the size
+    return impl->size;
+}
+tb_size_t gb_mesh_pool_capacity(gb_mesh_pool_ref_t pool)
+{
+    // check
+    gb_mesh_pool_impl_t* impl = (gb_mesh_pool_impl_t*)pool;
+    tb_assert_and_check_return_val(impl, 0);
+
+    // the capacity, (grow << 0) + (grow << 1) + ... + (grow << (count - 1))
+    return ((impl->grow << impl->chunk_count) - impl->grow) * impl->item_size;
+}
+tb_pointer_t gb_mesh_pool_malloc0(gb_mesh_pool_ref_t pool)
+{
+    // check
+    gb_mesh_pool_impl_t* impl = (gb_mesh_pool_impl_t*)pool;
+    tb_assert_and_check_return_val(impl, tb_null);
+
+    // reuse the last freed item first
+    tb_byte_t* item = (tb_byte_t*)impl->frees;
+    if (item) impl->frees = *((tb_pointer_t*)item);
+    else
+    {
+        // the current chunk is full? switch to the next chunk
+        if (impl->chunk_count && impl->chunk_used >= (impl->grow << impl->chunk_index))
+        {
+            impl->chunk_index++;
+            impl->chunk_used = 0;
+        }
+
+        // make the new chunk if not exists
+        if (impl->chunk_index >= impl->chunk_count)
+        {
+            // too many items?
+            tb_assert_and_check_return_val(impl->chunk_count < GB_MESH_POOL_CHUNK_MAXN, tb_null);
+
+            // make chunk
+            tb_byte_t* chunk = (tb_byte_t*)tb_malloc_bytes((impl->grow << impl->chunk_count) * impl->item_size);
+            tb_assert_and_check_return_val(chunk, tb_null);
+
+            // save chunk
+            impl->chunks[impl->chunk_count++] = chunk;
+        }
+
+        // make item
+        item = impl->chunks[impl->chunk_index] + impl->chunk_used * impl->item_size;
+        impl->chunk_used++;
+    }
+
+    // update size
+    impl->size++;
+
+    // clear it
+    tb_memset(item, 0, impl->item_size);
+
+    // ok
+    return item;
+}
+tb_void_t gb_mesh_pool_free(gb_mesh_pool_ref_t pool, tb_pointer_t item)
+{
+    // check
+    gb_mesh_pool_impl_t* impl = (gb_mesh_pool_impl_t*)pool;
+    tb_assert_and_check_return(impl && item && impl->size);
+
+    // exit item
+    if (impl->item_exit) impl->item_exit(item, impl->priv);
+
+    // append it to the free items
+    *((tb_pointer_t*)item)  = impl->frees;
+    impl->frees             = item;
+
+    // update size
+    impl->size--;
+}
@@ -0,0 +1,124 @@
+/*!The Graphic Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        pool.h
+ * @ingroup     utils
+ *
+ */
+#ifndef GB_UTILS_IMPL_MESH_POOL_H
+#define GB_UTILS_IMPL_MESH_POOL_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+/*! the mesh pool type
+ *
+ * the items are allocated from the contiguous chunks with the geometric growth 
+ * and in the allocation order, so the topology walks of the mesh will be more cache-friendly.
+ *
+ * <pre>
+ * chunks: [grow items] [grow * 2 items] [grow * 4 items] ...
+ * </pre>
+ *
+ * the chunks are not freed when clearing the pool and the new items will be allocated
+ * from the first chunk again, so the reused mesh keeps the sequential layout.
+ */
+typedef struct{}*           gb_mesh_pool_ref_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/* init the mesh pool
+ *
+ * @param grow              the item count of the first chunk
+ * @param item_size         the item size
+ * @param item_exit         the item exit func which will be called when the item is freed
+ * @param priv              the private data of the item exit func
+ *
+ * @return                  the pool
+ */
+gb_mesh_pool_ref_t          gb_mesh_pool_init(tb_size_t grow, tb_size_t item_size, tb_fixed_pool_item_exit_func_t item_exit, tb_cpointer_t priv);
+
+/* exit the mesh pool
+ *
+ * @param pool              the pool
+ */
+tb_void_t                   gb_mesh_pool_exit(gb_mesh_pool_ref_t pool);
+
+/* clear the mesh pool
+ *
+ * the item exit func will not be called here and the caller need exit the living items first
+ *
+ * @param pool              the pool
+ */
+tb_void_t                   gb_mesh_pool_clear(gb_mesh_pool_ref_t pool);
+
+/* the living item count
+ *
+ * @param pool              the pool
+ *
+ * @return                  the item count
+ */
+tb_size_t                   gb_mesh_pool_size(gb_mesh_pool_ref_t pool);
+
+/* the allocated bytes of all chunks
+ *
+ * @param pool              the pool
+ *
+ * @return                  the bytes
+ */
+tb_size_t                   gb_mesh_pool_capacity(gb_mesh_pool_ref_t pool);
+
+/* make a zeroed item
+ *
+ * @param pool              the pool
+ *
+ * @return                  the item
+ */
+tb_pointer_t                gb_mesh_pool_malloc0(gb_mesh_pool_ref_t pool);
+
+/* free the item
+ *
+ * @param pool              the pool
+ * @param item              the item
+ */
+tb_void_t                   gb_mesh_pool_free(gb_mesh_pool_ref_t pool, tb_pointer_t item);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+
+#endif
+
+
@@ -95,6 +95,14 @@ tb_size_t                   gb_mesh_vertex_list_size(gb_mesh_vertex_list_ref_t l
  */
 tb_size_t                   gb_mesh_vertex_list_maxn(gb_mesh_vertex_list_ref_t list);
 
+/*! the allocated bytes of the mesh vertex list, including the unused items of the pool
+ *
+ * @param list              the list
+ *
+ * @return                  the bytes
+ */
+tb_size_t                   gb_mesh_vertex_list_capacity(gb_mesh_vertex_list_ref_t list);
+
 /*! make a bare vertex without edges
  *
  * @param list              the list
@@ -43,6 +43,13 @@
 // enable test?
 #define GB_ACTIVE_REGION_TEST_ENABLE    (0)
 
+// the active regions grow
+#ifdef __gb_small__
+#   define GB_ACTIVE_REGIONS_GROW       (32)
+#else
+#   define GB_ACTIVE_REGIONS_GROW       (64)
+#endif
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * private implementation
  */
@@ -202,25 +209,7 @@ static tb_bool_t gb_tessellator_active_region_leq(gb_tessellator_active_region_r
     tb_assert(0);
     return 0;
 }
-static tb_long_t gb_tessellator_active_region_comp(tb_element_ref_t element, tb_cpointer_t ldata, tb_cpointer_t rdata)
-{
-    // lregion <= rregion ? -1 : 1
-    return (!gb_tessellator_active_region_leq((gb_tessellator_active_region_ref_t)ldata, (gb_tessellator_active_region_ref_t)rdata) << 1) - 1;
-}
 #ifdef __gb_debug__
-static tb_char_t const* gb_tessellator_active_region_cstr(tb_element_ref_t element, tb_cpointer_t data, tb_char_t* cstr, tb_size_t maxn)
-{
-    // check
-    gb_tessellator_active_region_ref_t region = (gb_tessellator_active_region_ref_t)data;
-    tb_assert_and_check_return_val(region, tb_null);
-
-    // make info
-    tb_long_t size = tb_snprintf(cstr, maxn, "%{tess_region}.%{mesh_edge}", region, region->edge);
-    if (size >= 0) cstr[size] = '\0';
-
-    // ok?
-    return cstr;
-}
 static tb_long_t gb_tessellator_active_region_printf(tb_cpointer_t object, tb_char_t* cstr, tb_size_t maxn)
 {
     // check
@@ -245,7 +234,7 @@ static tb_long_t gb_tessellator_active_region_printf(tb_cpointer_t object, tb_ch
                     ,   region->inside);
 }
 #endif
-/* insert region in ascending order and save the region position
+/* insert region in ascending order and make the real region from the pool
  *
  * r0 ----> r1 ------> r2 -------> r3 ---> ... ---->
  *                 region_prev
@@ -253,10 +242,10 @@ static tb_long_t gb_tessellator_active_region_printf(tb_cpointer_t object, tb_ch
  *                           insert
  *
  */
-static gb_tessellator_active_region_ref_t gb_tessellator_active_regions_insert_done(gb_tessellator_impl_t* impl, tb_size_t prev, gb_tessellator_active_region_ref_t region)
+static gb_tessellator_active_region_ref_t gb_tessellator_active_regions_insert_done(gb_tessellator_impl_t* impl, tb_list_entry_ref_t prev, gb_tessellator_active_region_ref_t region)
 {
     // check
-    tb_assert(impl && impl->active_regions && region && region->edge);
+    tb_assert(impl && impl->active_regions_pool && prev && region && region->edge);
 
     // the edge must go up
     tb_assertf_abort(gb_tessellator_edge_go_up(region->edge), "%{mesh_edge}", region->edge);
@@ -264,22 +253,22 @@ static gb_tessellator_active_region_ref_t gb_tessellator_active_regions_insert_d
     // trace
     tb_trace_d("insert: %{mesh_edge}", region->edge);
 
-    // reverse to find the inserted position
-    tb_size_t itor = tb_find_if(impl->active_regions, prev, tb_iterator_tail(impl->active_regions), tb_predicate_beq, region);
-
-    // trace
-    tb_trace_d("insert: find count: %lu", tb_distance(impl->active_regions, prev, itor));
+    // find the inserted position, the first region which is not in the left of the given region
+    tb_list_entry_ref_t next = prev;
+    tb_list_entry_ref_t tail = tb_list_entry_tail(&impl->active_regions);
+    while (next != tail && gb_tessellator_active_region_leq((gb_tessellator_active_region_ref_t)tb_list_entry(&impl->active_regions, next), region))
+        next = next->next;
 
-    // insert the region to the next position
-    itor = tb_list_insert_prev(impl->active_regions, itor, region);
-    tb_assert(itor != tb_iterator_tail(impl->active_regions));
+    // make the real region from the pool
+    gb_tessellator_active_region_ref_t region_new = (gb_tessellator_active_region_ref_t)gb_mesh_pool_malloc0(impl->active_regions_pool);
+    tb_assert_and_check_return_val(region_new, tb_null);
 
-    // get the real region reference 
-    region = (gb_tessellator_active_region_ref_t)tb_iterator_item(impl->active_regions, itor);
-    tb_assert(region);
+    // init it
+    *region_new = *region;
+    region = region_new;
 
-    // save the region position
-    region->position = itor;
+    // insert the region to the previous position
+    tb_list_entry_insert_prev(&impl->active_regions, next, &region->entry);
 
     // save the region reference to the edge
     gb_tessellator_edge_region_set(region->edge, region);
@@ -298,7 +287,7 @@ static gb_tessellator_active_region_ref_t gb_tessellator_active_regions_insert_d
 static tb_void_t gb_tessellator_active_regions_insert_bounds(gb_tessellator_impl_t* impl, gb_float_t x, gb_float_t y_org, gb_float_t y_dst)
 {
     // check
-    tb_assert(impl && impl->mesh && impl->active_regions);
+    tb_assert(impl && impl->mesh && impl->active_regions_pool);
 
     // init two points of the new edge
     gb_point_t org;
@@ -318,6 +307,7 @@ static tb_void_t gb_tessellator_active_regions_insert_bounds(gb_tessellator_impl
     region.edge     = edge;
     region.winding  = 0;
     region.inside   = 0;
+    region.dirty    = 0;
     region.fixedge  = 0;
     region.bounds   = 1;
 
@@ -328,7 +318,7 @@ static tb_void_t gb_tessellator_active_regions_insert_bounds(gb_tessellator_impl
 static tb_void_t gb_tessellator_active_regions_test_insert(gb_tessellator_impl_t* impl, gb_float_t sweep_xb, gb_float_t sweep_xe, gb_float_t sweep_y)
 {
     // check
-    tb_assert(impl && impl->mesh && impl->active_regions);
+    tb_assert(impl && impl->mesh && impl->active_regions_pool);
 
     // init coordinates
     tb_long_t xb = tb_random_range(tb_null, gb_float_to_long(sweep_xb), gb_float_to_long(sweep_xe));
@@ -359,7 +349,7 @@ static tb_void_t gb_tessellator_active_regions_test_insert(gb_tessellator_impl_t
 static tb_void_t gb_tessellator_active_regions_test(gb_tessellator_impl_t* impl, gb_float_t sweep_xb, gb_float_t sweep_xe, gb_float_t sweep_y)
 {
     // check
-    tb_assert(impl && impl->active_regions);
+    tb_assert(impl && impl->active_regions_pool);
 
     // make the current sweep event point
     gb_point_t point;
@@ -379,7 +369,7 @@ static tb_void_t gb_tessellator_active_regions_test(gb_tessellator_impl_t* impl,
 
     // dump the codes for drawing
     tb_size_t index = 1;
-    tb_for_all_if (gb_tessellator_active_region_ref_t, region, impl->active_regions, region)
+    tb_for_all_if (gb_tessellator_active_region_ref_t, region, tb_list_entry_itor(&impl->active_regions), region)
     {
         // the edge
         gb_mesh_edge_ref_t edge = region->edge;
@@ -408,37 +398,32 @@ tb_bool_t gb_tessellator_active_regions_make(gb_tessellator_impl_t* impl, gb_rec
     tb_assert(impl && bounds && bounds->w > 0 && bounds->h > 0);
 
     // init active regions
-    if (!impl->active_regions) 
+    if (!impl->active_regions_pool) 
     {
-        // make active region element
-        tb_element_t element = tb_element_mem(sizeof(gb_tessellator_active_region_t), tb_null, tb_null);
-
-        // init the comparator 
-        element.comp = gb_tessellator_active_region_comp;
-
 #ifdef __gb_debug__
-        // init the c-string function for tb_list_dump
-        element.cstr = gb_tessellator_active_region_cstr;
-
         // register printf("%{tess_region}", region);
-        static tb_bool_t s_is_registered = tb_false;
-        if (!s_is_registered)
+        static tb_atomic_t s_is_registered = 0;
+        if (!tb_atomic_fetch_and_pset(&s_is_registered, 0, 1))
         {
             // register it
             tb_printf_object_register("tess_region", gb_tessellator_active_region_printf);
-
-            // ok
-            s_is_registered = tb_true;
         }
 #endif
 
-        // make active regions
-        impl->active_regions = tb_list_init(0, element);
+        // make the pool of the active regions
+        impl->active_regions_pool = gb_mesh_pool_init(GB_ACTIVE_REGIONS_GROW, sizeof(gb_tessellator_active_region_t), tb_null, tb_null);
+
+        // init the active regions
+        tb_list_entry_init(&impl->active_regions, gb_tessellator_active_region_t, entry, tb_null);
     }
-    tb_assert_abort_and_check_return_val(impl->active_regions, tb_false);
+    tb_assert_abort_and_check_return_val(impl->active_regions_pool, tb_false);
 
-    // clear active regions first
-    tb_list_clear(impl->active_regions);
+    /* clear active regions first
+     *
+     * the regions are plain values, so we only rewind the pool wholesale
+     */
+    gb_mesh_pool_clear(impl->active_regions_pool);
+    tb_list_entry_clear(&impl->active_regions);
 
     /* insert two regions for the bounds to avoid special cases
      *
@@ -463,12 +448,12 @@ tb_bool_t gb_tessellator_active_regions_make(gb_tessellator_impl_t* impl, gb_rec
 #endif
 
     // ok
-    return tb_list_size(impl->active_regions);
+    return tb_list_entry_size(&impl->active_regions);
 }
 gb_tessellator_active_region_ref_t gb_tessellator_active_regions_find(gb_tessellator_impl_t* impl, gb_mesh_edge_ref_t edge)
 {
     // check
-    tb_assert(impl && impl->active_regions && edge);
+    tb_assert(impl && impl->active_regions_pool && edge);
 
     // make a temporary region with the given edge for finding the real region containing it
     gb_tessellator_active_region_t region_temp;
@@ -493,40 +478,48 @@ gb_tessellator_active_region_ref_t gb_tessellator_active_regions_find(gb_tessell
      *
      *
      */
-    tb_size_t itor = tb_rfind_all_if(impl->active_regions, tb_predicate_le, &region_temp);
+    tb_list_entry_ref_t entry = tb_list_entry_last(&impl->active_regions);
+    tb_list_entry_ref_t tail  = tb_list_entry_tail(&impl->active_regions);
+    while (entry != tail)
+    {
+        // found?
+        gb_tessellator_active_region_ref_t region = (gb_tessellator_active_region_ref_t)tb_list_entry(&impl->active_regions, entry);
+        if (gb_tessellator_active_region_leq(region, &region_temp)) return region;
 
-    // get the found item
-    return (itor != tb_iterator_tail(impl->active_regions))? (gb_tessellator_active_region_ref_t)tb_iterator_item(impl->active_regions, itor) : tb_null;
+        // the previous region
+        entry = entry->prev;
+    }
+
+    // not found
+    return tb_null;
 }
 gb_tessellator_active_region_ref_t gb_tessellator_active_regions_left(gb_tessellator_impl_t* impl, gb_tessellator_active_region_ref_t region)
 {
     // check
-    tb_assert(impl && impl->active_regions);
-    tb_assert(region && region->position != tb_iterator_tail(impl->active_regions));
+    tb_assert(impl && impl->active_regions_pool && region);
     
-    // get the prev position
-    tb_size_t position = tb_iterator_prev(impl->active_regions, region->position);
+    // get the prev entry
+    tb_list_entry_ref_t entry = region->entry.prev;
 
     // no left region?
-    tb_check_return_val(position != tb_iterator_tail(impl->active_regions), tb_null);
+    tb_check_return_val(entry != tb_list_entry_tail(&impl->active_regions), tb_null);
 
     // ok
-    return (gb_tessellator_active_region_ref_t)tb_iterator_item(impl->active_regions, position);
+    return (gb_tessellator_active_region_ref_t)tb_list_entry(&impl->active_regions, entry);
 }
 gb_tessellator_active_region_ref_t gb_tessellator_active_regions_right(gb_tessellator_impl_t* impl, gb_tessellator_active_region_ref_t region)
 {
     // check
-    tb_assert(impl && impl->active_regions);
-    tb_assert(region && region->position != tb_iterator_tail(impl->active_regions));
+    tb_assert(impl && impl->active_regions_pool && region);
     
-    // get the next position
-    tb_size_t position = tb_iterator_next(impl->active_regions, region->position);
+    // get the next entry
+    tb_list_entry_ref_t entry = region->entry.next;
 
     // no right region?
-    tb_check_return_val(position != tb_iterator_tail(impl->active_regions), tb_null);
+    tb_check_return_val(entry != tb_list_entry_tail(&impl->active_regions), tb_null);
 
     // ok
-    return (gb_tessellator_active_region_ref_t)tb_iterator_item(impl->active_regions, position);
+    return (gb_tessellator_active_region_ref_t)tb_list_entry(&impl->active_regions, entry);
 }
 tb_bool_t gb_tessellator_active_regions_in_left(gb_tessellator_impl_t* impl, gb_tessellator_active_region_ref_t region1, gb_tessellator_active_region_ref_t region2)
 {
@@ -536,8 +529,7 @@ tb_bool_t gb_tessellator_active_regions_in_left(gb_tessellator_impl_t* impl, gb_
 tb_void_t gb_tessellator_active_regions_remove(gb_tessellator_impl_t* impl, gb_tessellator_active_region_ref_t region)
 {
     // check
-    tb_assert(impl && impl->active_regions && region && region->edge);
-    tb_assert(region->position != tb_iterator_tail(impl->active_regions));
+    tb_assert(impl && impl->active_regions_pool && region && region->edge);
 
     // it can not be a real edge if the left edge need fix, then we will remove it 
     tb_assert(!region->fixedge || !gb_tessellator_edge_winding(region->edge));
@@ -546,51 +538,54 @@ tb_void_t gb_tessellator_active_regions_remove(gb_tessellator_impl_t* impl, gb_t
     gb_tessellator_edge_region_set(region->edge, tb_null);
 
     // remove it
-    tb_list_remove(impl->active_regions, region->position);
+    tb_list_entry_remove(&impl->active_regions, &region->entry);
+
+    // free it
+    gb_mesh_pool_free(impl->active_regions_pool, region);
 }
 gb_tessellator_active_region_ref_t gb_tessellator_active_regions_insert(gb_tessellator_impl_t* impl, gb_tessellator_active_region_ref_t region)
 {
     // check
-    tb_assert(impl && impl->active_regions && region);
+    tb_assert(impl && impl->active_regions_pool && region);
 
     // insert it
-    return gb_tessellator_active_regions_insert_done(impl, tb_iterator_head(impl->active_regions), region);
+    return gb_tessellator_active_regions_insert_done(impl, tb_list_entry_head(&impl->active_regions), region);
 }
 gb_tessellator_active_region_ref_t gb_tessellator_active_regions_insert_after(gb_tessellator_impl_t* impl, gb_tessellator_active_region_ref_t region_prev, gb_tessellator_active_region_ref_t region)
 {
     // check
-    tb_assert(impl && impl->active_regions && region_prev && region);
-    tb_assert(region_prev->position != tb_iterator_tail(impl->active_regions));
+    tb_assert(impl && impl->active_regions_pool && region_prev && region);
 
     // region_prev <= region
-    tb_assert(tb_iterator_comp(impl->active_regions, region_prev, region) <= 0);
+    tb_assert(gb_tessellator_active_region_leq(region_prev, region));
 
     // insert it
-    return gb_tessellator_active_regions_insert_done(impl, region_prev->position, region);
+    return gb_tessellator_active_regions_insert_done(impl, &region_prev->entry, region);
 }
 #ifdef __gb_debug__
 tb_void_t gb_tessellator_active_regions_check(gb_tessellator_impl_t* impl)
 {
     // check
-    tb_assert(impl && impl->active_regions);
+    tb_assert(impl && impl->active_regions_pool);
 
     // done
     gb_tessellator_active_region_ref_t region_prev = tb_null;
-    tb_for_all_if (gb_tessellator_active_region_ref_t, region, impl->active_regions, region)
+    tb_for_all_if (gb_tessellator_active_region_ref_t, region, tb_list_entry_itor(&impl->active_regions), region)
     {
         // check order
         if (region_prev)
         {
             // the order is error?
-            if (tb_iterator_comp(impl->active_regions, region_prev, region) > 0)
+            if (!gb_tessellator_active_region_leq(region_prev, region))
             {
                 // trace
                 tb_trace_i("the order of the active regions is error with event: %{mesh_vertex}", impl->event);
 
                 // dump it
-#           ifdef __tb_debug__
-                tb_list_dump(impl->active_regions);
-#           endif
+                tb_for_all_if (gb_tessellator_active_region_ref_t, region_dump, tb_list_entry_itor(&impl->active_regions), region_dump)
+                {
+                    tb_trace_i("    %{tess_region}.%{mesh_edge}", region_dump, region_dump->edge);
+                }
 
                 // trace
                 tb_trace_i("%{mesh_edge}", region_prev->edge);
@@ -0,0 +1,436 @@
+/*!The Graphic Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        batch.c
+ * @ingroup     utils
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME            "batch"
+#define TB_TRACE_MODULE_DEBUG           (0)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "batch.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the output points grow of the job
+#ifdef __gb_small__
+#   define GB_TESSELLATOR_BATCH_POINTS_GROW     (256)
+#else
+#   define GB_TESSELLATOR_BATCH_POINTS_GROW     (1024)
+#endif
+
+// the output contours grow of the job
+#ifdef __gb_small__
+#   define GB_TESSELLATOR_BATCH_COUNTS_GROW     (64)
+#else
+#   define GB_TESSELLATOR_BATCH_COUNTS_GROW     (256)
+#endif
+
+// sync the allocated bytes of the items and the job outputs to the memory tag, the job tessellators are accounted by themselves
+#define gb_tessellator_batch_memory_sync(batch) gb_memory_sync(GB_MEMORY_TAG_TESSELLATOR, (batch)->memory, gb_tessellator_batch_memory(batch))
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the tessellator batch item type
+typedef struct __gb_tessellator_batch_item_t
+{
+    // the polygon of the path
+    gb_polygon_ref_t                    polygon;
+
+    // the bounds of the path
+    gb_rect_ref_t                       bounds;
+
+    // the index of the job which has done this item
+    tb_uint32_t                         job;
+
+    // the first output point in the job
+    tb_uint32_t                         points;
+
+    // the first output contour in the job
+    tb_uint32_t                         contours;
+
+    // the output contours count
+    tb_uint32_t                         size;
+
+}gb_tessellator_batch_item_t, *gb_tessellator_batch_item_ref_t;
+
+// the tessellator batch job type
+typedef struct __gb_tessellator_batch_job_t
+{
+    // the batch
+    struct __gb_tessellator_batch_impl_t*   batch;
+
+    // the tessellator, the first job uses the given tessellator
+    gb_tessellator_ref_t                tessellator;
+
+    // the output points
+    tb_vector_ref_t                     points;
+
+    // the output contour counts
+    tb_vector_ref_t                     counts;
+
+    // the current item
+    gb_tessellator_batch_item_ref_t     item;
+
+    // the task of the thread pool
+    tb_thread_pool_task_ref_t           task;
+
+    // the job index
+    tb_size_t                           index;
+
+}gb_tessellator_batch_job_t, *gb_tessellator_batch_job_ref_t;
+
+// the tessellator batch impl type
+typedef struct __gb_tessellator_batch_impl_t
+{
+    // the jobs
+    gb_tessellator_batch_job_t          jobs[GB_TESSELLATOR_BATCH_JOB_MAXN];
+
+    // the items
+    gb_tessellator_batch_item_ref_t     items;
+
+    // the items count
+    tb_size_t                           items_size;
+
+    // the items maxn
+    tb_size_t                           items_maxn;
+
+    // the next pending item
+    tb_atomic_t                         next;
+
+    // the accounted bytes of the memory tag
+    tb_size_t                           memory;
+
+}gb_tessellator_batch_impl_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+#ifdef GB_CONFIG_MEMORY
+static tb_size_t gb_tessellator_batch_memory(gb_tessellator_batch_impl_t* batch)
+{
+    // check
+    tb_assert(batch);
+
+    // the bytes of the batch and items
+    tb_size_t size = sizeof(gb_tessellator_batch_impl_t) + batch->items_maxn * sizeof(gb_tessellator_batch_item_t);
+
+    // the bytes of the job outputs
+    tb_size_t index = 0;
+    for (index = 0; index < GB_TESSELLATOR_BATCH_JOB_MAXN; index++)
+        size += gb_memory_vector(batch->jobs[index].points) + gb_memory_vector(batch->jobs[index].counts);
+
+    // ok
+    return size;
+}
+#endif
+static tb_void_t gb_tessellator_batch_job_output(gb_point_ref_t points, tb_uint16_t count, tb_cpointer_t priv)
+{
+    // check
+    gb_tessellator_batch_job_ref_t job = (gb_tessellator_batch_job_ref_t)priv;
+    tb_assert(job && job->item && job->points && job->counts && points && count);
+
+    // save points
+    tb_uint16_t index = 0;
+    for (index = 0; index < count; index++) tb_vector_insert_tail(job->points, points + index);
+
+    // save count
+    tb_vector_insert_tail(job->counts, (tb_cpointer_t)(tb_size_t)count);
+
+    // update the contours count of the current item
+    job->item->size++;
+}
+static tb_void_t gb_tessellator_batch_job_done(gb_tessellator_batch_job_ref_t job)
+{
+    // check
+    tb_assert(job && job->batch && job->tessellator && job->points && job->counts);
+
+    // done all pending items
+    tb_size_t                       index;
+    gb_tessellator_batch_impl_t*    batch = job->batch;
+    while ((index = (tb_size_t)tb_atomic_fetch_and_inc(&batch->next)) < batch->items_size)
+    {
+        // init item
+        gb_tessellator_batch_item_ref_t item = batch->items + index;
+        item->job       = (tb_uint32_t)job->index;
+        item->points    = (tb_uint32_t)tb_vector_size(job->points);
+        item->contours  = (tb_uint32_t)tb_vector_size(job->counts);
+        item->size      = 0;
+
+        // null path? 
+        tb_check_continue(item->polygon && item->bounds);
+
+        // done tessellator
+        job->item = item;
+        gb_tessellator_done(job->tessellator, item->polygon, item->bounds);
+        job->item = tb_null;
+    }
+}
+static tb_void_t gb_tessellator_batch_worker_done(tb_thread_pool_worker_ref_t worker, tb_cpointer_t priv)
+{
+    // done job
+    gb_tessellator_batch_job_done((gb_tessellator_batch_job_ref_t)priv);
+}
+static tb_void_t gb_tessellator_batch_stats_merge(gb_tessellator_stats_ref_t stats, gb_tessellator_ref_t tessellator)
+{
+    // check
+    tb_assert(stats && tessellator);
+
+    // get the stats of this tessellator
+    gb_tessellator_stats_t job_stats;
+    if (!gb_tessellator_stats(tessellator, &job_stats)) return ;
+
+    // merge it
+    stats->polygons             += job_stats.polygons;
+    stats->vertices             += job_stats.vertices;
+    stats->edges                += job_stats.edges;
+    stats->intersections        += job_stats.intersections;
+    stats->degenerates          += job_stats.degenerates;
+    stats->faces                += job_stats.faces;
+    stats->mesh_time            += job_stats.mesh_time;
+    stats->event_queue_time     += job_stats.event_queue_time;
+    stats->sweep_time           += job_stats.sweep_time;
+    stats->intersection_time    += job_stats.intersection_time;
+    stats->triangulation_time   += job_stats.triangulation_time;
+    stats->convex_time          += job_stats.convex_time;
+
+    // clear it for the next batch
+    gb_tessellator_stats_clear(tessellator);
+}
+static tb_bool_t gb_tessellator_batch_job_init(gb_tessellator_batch_job_ref_t job)
+{
+    // check
+    tb_assert(job);
+
+    // init tessellator
+    if (!job->tessellator) job->tessellator = gb_tessellator_init();
+    tb_assert_and_check_return_val(job->tessellator, tb_false);
+
+    // init points
+    if (!job->points) job->points = tb_vector_init(GB_TESSELLATOR_BATCH_POINTS_GROW, tb_element_mem(sizeof(gb_point_t), tb_null, tb_null));
+    tb_assert_and_check_return_val(job->points, tb_false);
+
+    // init counts
+    if (!job->counts) job->counts = tb_vector_init(GB_TESSELLATOR_BATCH_COUNTS_GROW, tb_element_uint16());
+    tb_assert_and_check_return_val(job->counts, tb_false);
+
+    // clear outputs
+    tb_vector_clear(job->points);
+    tb_vector_clear(job->counts);
+
+    // ok
+    return tb_true;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_bool_t gb_tessellator_batch_done(gb_tessellator_impl_t* impl, gb_path_ref_t const* paths, tb_size_t count, tb_thread_pool_ref_t pool, gb_tessellator_many_func_t func, tb_cpointer_t priv)
+{
+    // check
+    tb_assert_and_check_return_val(impl && paths && func, tb_false);
+
+    // no paths?
+    tb_check_return_val(count, tb_true);
+
+    // init batch
+    if (!impl->batch) impl->batch = (gb_tessellator_batch_ref_t)tb_malloc0_type(gb_tessellator_batch_impl_t);
+    tb_assert_and_check_return_val(impl->batch, tb_false);
+
+    // the batch
+    gb_tessellator_batch_impl_t* batch = (gb_tessellator_batch_impl_t*)impl->batch;
+
+    // grow items
+    if (count > batch->items_maxn)
+    {
+        batch->items_maxn = tb_align8(count);
+        batch->items = (gb_tessellator_batch_item_ref_t)tb_ralloc(batch->items, batch->items_maxn * sizeof(gb_tessellator_batch_item_t));
+        tb_assert_and_check_return_val(batch->items, tb_false);
+    }
+
+    /* make the polygons and bounds of all paths on the current thread first
+     *
+     * they are cached in the paths and will be made lazily, so we cannot make them in the jobs
+     */
+    tb_size_t index = 0;
+    for (index = 0; index < count; index++)
+    {
+        gb_path_ref_t                   path = paths[index];
+        gb_tessellator_batch_item_ref_t item = batch->items + index;
+        item->polygon   = path? gb_path_polygon(path) : tb_null;
+        item->bounds    = item->polygon? gb_path_bounds(path) : tb_null;
+        item->size      = 0;
+    }
+    batch->items_size = count;
+    tb_atomic_set(&batch->next, 0);
+
+    // the jobs count, only one job on the current thread if no thread pool
+    tb_size_t jobs_count = pool? tb_min(count, GB_TESSELLATOR_BATCH_JOB_MAXN) : 1;
+
+    // init jobs
+    gb_tessellator_func_t   func_saved = impl->func;
+    tb_cpointer_t           priv_saved = impl->priv;
+    for (index = 0; index < jobs_count; index++)
+    {
+        // init job
+        gb_tessellator_batch_job_ref_t job = batch->jobs + index;
+        job->batch = batch;
+        job->index = index;
+        job->item  = tb_null;
+        job->task  = tb_null;
+
+        // the first job uses the given tessellator
+        if (!index) job->tessellator = (gb_tessellator_ref_t)impl;
+
+        // init it
+        if (!gb_tessellator_batch_job_init(job)) 
+        {
+            jobs_count = index;
+            break;
+        }
+
+        // init the tessellator with the same mode and rule
+        gb_tessellator_mode_set(job->tessellator, impl->mode);
+        gb_tessellator_rule_set(job->tessellator, impl->rule);
+        gb_tessellator_func_set(job->tessellator, gb_tessellator_batch_job_output, job);
+
+        // enable the stats of the other tessellators if the given tessellator is enabled
+        if (index) gb_tessellator_stats_enable(job->tessellator, impl->stats != tb_null);
+
+        // post the other jobs to the thread pool
+        if (index) job->task = tb_thread_pool_task_init(pool, "tessellator", gb_tessellator_batch_worker_done, tb_null, job, tb_false);
+    }
+
+    // done the first job on the current thread
+    if (jobs_count) gb_tessellator_batch_job_done(batch->jobs);
+
+    /* wait the other jobs
+     *
+     * all items have been taken now, so we kill the pending jobs which have not been started 
+     */
+    for (index = 1; index < jobs_count; index++)
+    {
+        // the job
+        gb_tessellator_batch_job_ref_t job = batch->jobs + index;
+        tb_check_continue(job->task);
+
+        // kill it if it has not been started
+        tb_thread_pool_task_kill(pool, job->task);
+
+        // wait it
+        tb_thread_pool_task_wait(pool, job->task, -1);
+
+        // exit it
+        tb_thread_pool_task_exit(pool, job->task);
+        job->task = tb_null;
+
+        // merge the stats of this job to the given tessellator
+        if (impl->stats) gb_tessellator_batch_stats_merge(impl->stats, job->tessellator);
+    }
+
+    // restore the func of the given tessellator
+    impl->func = func_saved;
+    impl->priv = priv_saved;
+
+    // sync memory
+    gb_tessellator_batch_memory_sync(batch);
+
+    // all items have been done? 
+    tb_assert_and_check_return_val(jobs_count && (tb_size_t)tb_atomic_get(&batch->next) >= count, tb_false);
+
+    // output all contours in the input order
+    for (index = 0; index < count; index++)
+    {
+        // the item
+        gb_tessellator_batch_item_ref_t item = batch->items + index;
+        tb_check_continue(item->size);
+
+        // the job
+        gb_tessellator_batch_job_ref_t job = batch->jobs + item->job;
+        tb_assert(item->job < jobs_count);
+
+        // the outputs
+        gb_point_ref_t      points = (gb_point_ref_t)tb_vector_data(job->points) + item->points;
+        tb_uint16_t const*  counts = (tb_uint16_t const*)tb_vector_data(job->counts) + item->contours;
+        tb_assert(points && counts);
+
+        // done func
+        tb_size_t contour = 0;
+        for (contour = 0; contour < item->size; contour++)
+        {
+            func(index, points, counts[contour], priv);
+            points += counts[contour];
+        }
+    }
+
+    // ok
+    return tb_true;
+}
+tb_void_t gb_tessellator_batch_exit(gb_tessellator_impl_t* impl)
+{
+    // check
+    tb_assert_and_check_return(impl);
+
+    // the batch
+    gb_tessellator_batch_impl_t* batch = (gb_tessellator_batch_impl_t*)impl->batch;
+    tb_check_return(batch);
+
+    // exit jobs
+    tb_size_t index = 0;
+    for (index = 0; index < GB_TESSELLATOR_BATCH_JOB_MAXN; index++)
+    {
+        // the job
+        gb_tessellator_batch_job_ref_t job = batch->jobs + index;
+
+        // exit tessellator, the first job uses the given tessellator
+        if (index && job->tessellator) gb_tessellator_exit(job->tessellator);
+        job->tessellator = tb_null;
+
+        // exit points
+        if (job->points) tb_vector_exit(job->points);
+        job->points = tb_null;
+
+        // exit counts
+        if (job->counts) tb_vector_exit(job->counts);
+        job->counts = tb_null;
+    }
+
+    // exit items
+    if (batch->items) tb_free(batch->items);
+    batch->items = tb_null;
+
+    // exit memory
+    gb_memory_sync(GB_MEMORY_TAG_TESSELLATOR, batch->memory, 0);
+
+    // exit it
+    tb_free(batch);
+    impl->batch = tb_null;
+}
@@ -0,0 +1,86 @@
+/*!The Graphic Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        batch.h
+ * @ingroup     utils
+ */
+#ifndef GB_UTILS_IMPL_TESSELLATOR_BATCH_H
+#define GB_UTILS_IMPL_TESSELLATOR_BATCH_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the maximum job count of the batch
+#ifdef __gb_small__
+#   define GB_TESSELLATOR_BATCH_JOB_MAXN        (4)
+#else
+#   define GB_TESSELLATOR_BATCH_JOB_MAXN        (8)
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/* done the tessellator for the paths and output them in the input order
+ *
+ * the polygons and bounds of all paths are made on the current thread first, 
+ * then each job tessellates the next pending path by its own tessellator 
+ * and saves the outputs to its own buffers. 
+ *
+ * the first job is done on the current thread by the given tessellator 
+ * and the other jobs are posted to the thread pool.
+ *
+ * @param impl      the tessellator impl
+ * @param paths     the paths
+ * @param count     the paths count
+ * @param pool      the thread pool, done all paths on the current thread if be null
+ * @param func      the batch func
+ * @param priv      the user private data
+ *
+ * @return          tb_true or tb_false
+ */
+tb_bool_t           gb_tessellator_batch_done(gb_tessellator_impl_t* impl, gb_path_ref_t const* paths, tb_size_t count, tb_thread_pool_ref_t pool, gb_tessellator_many_func_t func, tb_cpointer_t priv);
+
+/* exit the batch of the tessellator
+ *
+ * @param impl      the tessellator impl
+ */
+tb_void_t           gb_tessellator_batch_exit(gb_tessellator_impl_t* impl);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+
+#endif
+
+
@@ -133,6 +133,9 @@ tb_void_t gb_tessellator_convex_make(gb_tessellator_impl_t* impl)
     // check
     tb_assert(impl && impl->mesh);
 
+    // the clock for the stats
+    tb_hong_t clock = gb_tessellator_stats_clock(impl);
+
     // done
     tb_for_all_if (gb_mesh_face_ref_t, face, gb_mesh_face_itor(impl->mesh), face)
     {
@@ -143,6 +146,9 @@ tb_void_t gb_tessellator_convex_make(gb_tessellator_impl_t* impl)
         gb_tessellator_convex_make_face(impl, face);
     }
 
+    // update stats
+    gb_tessellator_stats_clock_add(impl, convex_time, clock);
+
 #ifdef __gb_debug__
     // check mesh
     gb_mesh_check(impl->mesh);
@@ -35,9 +35,123 @@
 #include "event_queue.h"
 #include "geometry.h"
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the sorted events grow
+#ifdef __gb_small__
+#   define GB_TESSELLATOR_EVENTS_GROW           (64)
+#else
+#   define GB_TESSELLATOR_EVENTS_GROW           (256)
+#endif
+
+// the range size for using the insertion sort
+#define GB_TESSELLATOR_EVENTS_SORT_SMALL        (16)
+
+// swap two events
+#define gb_tessellator_event_swap(a, b)         do { gb_mesh_vertex_ref_t __t = (a); (a) = (b); (b) = __t; } while (0)
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * private implementation
  */
+static tb_void_t gb_tessellator_event_queue_sort_insert(gb_mesh_vertex_ref_t* events, tb_size_t head, tb_size_t tail)
+{
+    // done
+    tb_size_t i = 0;
+    tb_size_t j = 0;
+    for (i = head + 1; i < tail; i++)
+    {
+        // insert this event to the sorted range
+        gb_mesh_vertex_ref_t event = events[i];
+        for (j = i; j > head && gb_tessellator_vertex_le(event, events[j - 1]); j--) events[j] = events[j - 1];
+        events[j] = event;
+    }
+}
+static tb_void_t gb_tessellator_event_queue_sort_heap(gb_mesh_vertex_ref_t* events, tb_size_t count)
+{
+    // make the max-heap
+    tb_size_t i = count >> 1;
+    tb_size_t n = count;
+    while (n > 1)
+    {
+        // the root
+        tb_size_t root;
+        if (i) root = --i;
+        else
+        {
+            // move the maximum event to the tail
+            n--;
+            gb_tessellator_event_swap(events[0], events[n]);
+            root = 0;
+        }
+
+        // shift down the root
+        tb_size_t child;
+        while ((child = (root << 1) + 1) < n)
+        {
+            if (child + 1 < n && gb_tessellator_vertex_le(events[child], events[child + 1])) child++;
+            if (!gb_tessellator_vertex_le(events[root], events[child])) break;
+            gb_tessellator_event_swap(events[root], events[child]);
+            root = child;
+        }
+    }
+}
+/* sort the events by (y, x) using the introsort
+ *
+ * the comparison is inlined here and it is much faster than the generic sort with the iterator
+ */
+static tb_void_t gb_tessellator_event_queue_sort(gb_mesh_vertex_ref_t* events, tb_size_t head, tb_size_t tail, tb_size_t depth)
+{
+    while (tail - head > GB_TESSELLATOR_EVENTS_SORT_SMALL)
+    {
+        // too deep? using the heap sort for the worst case
+        if (!depth--) 
+        {
+            gb_tessellator_event_queue_sort_heap(events + head, tail - head);
+            return ;
+        }
+
+        // sort the head, middle and last events, the middle event will be the pivot
+        tb_size_t mid = head + ((tail - head) >> 1);
+        tb_size_t last = tail - 1;
+        if (gb_tessellator_vertex_le(events[mid], events[head])) gb_tessellator_event_swap(events[mid], events[head]);
+        if (gb_tessellator_vertex_le(events[last], events[mid])) 
+        {
+            gb_tessellator_event_swap(events[last], events[mid]);
+            if (gb_tessellator_vertex_le(events[mid], events[head])) gb_tessellator_event_swap(events[mid], events[head]);
+        }
+        gb_mesh_vertex_ref_t pivot = events[mid];
+
+        // partition: [head, j] <= pivot <= [j + 1, tail)
+        tb_size_t i = head;
+        tb_size_t j = last;
+        while (1)
+        {
+            while (gb_tessellator_vertex_le(events[i], pivot)) i++;
+            while (gb_tessellator_vertex_le(pivot, events[j])) j--;
+            if (i >= j) break;
+            gb_tessellator_event_swap(events[i], events[j]);
+            i++;
+            j--;
+        }
+
+        // sort the smaller part recursively and the larger part iteratively
+        if (j + 1 - head < tail - j - 1)
+        {
+            gb_tessellator_event_queue_sort(events, head, j + 1, depth);
+            head = j + 1;
+        }
+        else
+        {
+            gb_tessellator_event_queue_sort(events, j + 1, tail, depth);
+            tail = j + 1;
+        }
+    }
+
+    // sort the small range
+    gb_tessellator_event_queue_sort_insert(events, head, tail);
+}
 static tb_long_t gb_tessellator_event_queue_comp(tb_element_ref_t element, tb_cpointer_t ldata, tb_cpointer_t rdata)
 {
 #if 0
@@ -107,22 +221,80 @@ tb_bool_t gb_tessellator_event_queue_make(gb_tessellator_impl_t* impl)
     // clear event queue first
     tb_priority_queue_clear(impl->event_queue);
 
-    // done
+    // grow the sorted events
+    tb_size_t count = tb_iterator_size(gb_mesh_vertex_itor(mesh));
+    if (count > impl->events_maxn)
+    {
+        impl->events_maxn   = tb_align(count + GB_TESSELLATOR_EVENTS_GROW, GB_TESSELLATOR_EVENTS_GROW);
+        impl->events        = (gb_mesh_vertex_ref_t*)tb_ralloc(impl->events, impl->events_maxn * sizeof(gb_mesh_vertex_ref_t));
+    }
+    tb_assert_abort_and_check_return_val(impl->events, tb_false);
+
+    // put all vertex events to the array
+    tb_size_t               size = 0;
+    gb_mesh_vertex_ref_t*   events = impl->events;
     tb_for_all_if (gb_mesh_vertex_ref_t, vertex, gb_mesh_vertex_itor(mesh), vertex)
     {
-        // put vertex event to the queue
-        tb_priority_queue_put(impl->event_queue, vertex);
+        tb_assert_and_check_break(size < count);
+        events[size++] = vertex;
     }
 
+    // sort them once, the maximum depth is 2 * log2(size)
+    tb_size_t depth = 0;
+    tb_size_t n     = size;
+    while (n >>= 1) depth += 2;
+    gb_tessellator_event_queue_sort(events, 0, size, depth);
+
+    // save the event positions for removing them
+    tb_size_t i = 0;
+    for (i = 0; i < size; i++) gb_tessellator_vertex(events[i])->event = (tb_uint32_t)i;
+
+    // init the sorted events
+    impl->events_size = size;
+    impl->events_head = 0;
+
     // ok
-    return tb_priority_queue_size(impl->event_queue);
+    return size;
+}
+gb_mesh_vertex_ref_t gb_tessellator_event_queue_top(gb_tessellator_impl_t* impl)
+{
+    // check
+    tb_assert(impl && impl->event_queue);
+
+    // skip the removed events
+    while (impl->events_head < impl->events_size && !impl->events[impl->events_head]) impl->events_head++;
+
+    // the minimum sorted event and the minimum new event
+    gb_mesh_vertex_ref_t sorted = impl->events_head < impl->events_size? impl->events[impl->events_head] : tb_null;
+    gb_mesh_vertex_ref_t heaped = tb_priority_queue_size(impl->event_queue)? (gb_mesh_vertex_ref_t)tb_priority_queue_get(impl->event_queue) : tb_null;
+
+    // merge them
+    if (!sorted) return heaped;
+    if (!heaped) return sorted;
+    return gb_tessellator_vertex_leq(sorted, heaped)? sorted : heaped;
+}
+gb_mesh_vertex_ref_t gb_tessellator_event_queue_pop(gb_tessellator_impl_t* impl)
+{
+    // the minimum event
+    gb_mesh_vertex_ref_t event = gb_tessellator_event_queue_top(impl);
+    tb_check_return_val(event, tb_null);
+
+    // pop it
+    if (impl->events_head < impl->events_size && impl->events[impl->events_head] == event) impl->events_head++;
+    else tb_priority_queue_pop(impl->event_queue);
+
+    // ok
+    return event;
 }
 tb_void_t gb_tessellator_event_queue_insert(gb_tessellator_impl_t* impl, gb_mesh_vertex_ref_t event)
 {
     // check
     tb_assert(impl && impl->event_queue && event);
 
-    // insert this event
+    // not in the sorted events
+    gb_tessellator_vertex(event)->event = (tb_uint32_t)-1;
+
+    // insert this event to the heap
     tb_priority_queue_put(impl->event_queue, event);
 }
 tb_void_t gb_tessellator_event_queue_remove(gb_tessellator_impl_t* impl, gb_mesh_vertex_ref_t event)
@@ -130,7 +302,15 @@ tb_void_t gb_tessellator_event_queue_remove(gb_tessellator_impl_t* impl, gb_mesh
     // check
     tb_assert(impl && impl->event_queue && event);
 
-    // find it
+    // in the sorted events? remove it directly
+    tb_size_t position = gb_tessellator_vertex(event)->event;
+    if (position >= impl->events_head && position < impl->events_size && impl->events[position] == event)
+    {
+        impl->events[position] = tb_null;
+        return ;
+    }
+
+    // find it from the heap
     tb_size_t itor = tb_find_all_if(impl->event_queue, gb_tessellator_event_queue_find, event);
     if (itor != tb_iterator_tail(impl->event_queue))
     {
@@ -40,6 +40,9 @@ __tb_extern_c_enter__
  */
 
 /* make the vertex event queue and all events are sorted
+ *
+ * the mesh vertices are sorted once into the contiguous event array 
+ * and only the new vertices (e.g. intersections) will be inserted into the small heap later
  *   
  * @param impl      the tessellator impl
  *
@@ -47,6 +50,22 @@ __tb_extern_c_enter__
  */
 tb_bool_t           gb_tessellator_event_queue_make(gb_tessellator_impl_t* impl);
 
+/* get the minimum vertex event
+ *
+ * @param impl      the tessellator impl
+ *
+ * @return          the vertex event, null if the queue is empty
+ */
+gb_mesh_vertex_ref_t gb_tessellator_event_queue_top(gb_tessellator_impl_t* impl);
+
+/* pop the minimum vertex event
+ *
+ * @param impl      the tessellator impl
+ *
+ * @return          the vertex event, null if the queue is empty
+ */
+gb_mesh_vertex_ref_t gb_tessellator_event_queue_pop(gb_tessellator_impl_t* impl);
+
 /* insert the vertex event to queue
  *
  * @param impl      the tessellator impl
@@ -145,6 +145,14 @@ tb_bool_t gb_tessellator_mesh_make(gb_tessellator_impl_t* impl, gb_polygon_ref_t
         tb_element_t face_element    = tb_element_mem(sizeof(gb_tessellator_face_t), tb_null, tb_null);
         tb_element_t vertex_element  = tb_element_mem(sizeof(gb_tessellator_vertex_t), tb_null, tb_null);
 
+        /* the tessellator data are plain values, so we need not free them
+         *
+         * the mesh will be rewound wholesale for the next polygon without exiting all elements
+         */
+        edge_element.free       = tb_null;
+        face_element.free       = tb_null;
+        vertex_element.free     = tb_null;
+
 #ifdef __gb_debug__
         // init func cstr for gb_mesh_dump
         edge_element.cstr      = gb_tessellator_edge_cstr;
@@ -172,6 +180,9 @@ tb_bool_t gb_tessellator_mesh_make(gb_tessellator_impl_t* impl, gb_polygon_ref_t
     gb_mesh_ref_t mesh = impl->mesh;
     tb_assert_abort_and_check_return_val(mesh, tb_false);
 
+    // the clock for the stats
+    tb_hong_t clock = gb_tessellator_stats_clock(impl);
+
     // clear mesh first
     gb_mesh_clear(mesh);
 
@@ -183,6 +194,14 @@ tb_bool_t gb_tessellator_mesh_make(gb_tessellator_impl_t* impl, gb_polygon_ref_t
     gb_mesh_edge_ref_t  edge_first  = tb_null;
     while (index < count)
     {
+        // skip the degenerated contour without edges, e.g. move-to and close
+        if (!index && count < 3)
+        {
+            points += count;
+            count = *counts++;
+            continue;
+        }
+
         // the point
         point = points++;
 
@@ -267,6 +286,14 @@ tb_bool_t gb_tessellator_mesh_make(gb_tessellator_impl_t* impl, gb_polygon_ref_t
     gb_mesh_check(mesh);
 #endif
 
+    // update stats
+    if (impl->stats)
+    {
+        gb_tessellator_stats_clock_add(impl, mesh_time, clock);
+        gb_tessellator_stats_count_add(impl, vertices, tb_iterator_size(gb_mesh_vertex_itor(mesh)));
+        gb_tessellator_stats_count_add(impl, edges, tb_iterator_size(gb_mesh_edge_itor(mesh)));
+    }
+
     // ok?
     return !gb_mesh_is_empty(mesh);
 }
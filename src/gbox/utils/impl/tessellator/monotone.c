@@ -1063,6 +1063,9 @@ static tb_bool_t gb_tessellator_fix_region_intersection_errors(gb_tessellator_im
     // check
     tb_assert(impl && impl->mesh && region_left && region_right && intersection);
 
+    // update stats
+    gb_tessellator_stats_count_add(impl, degenerates, 1);
+
     // the event
     gb_mesh_vertex_ref_t event = impl->event;
     tb_assert(event);
@@ -1675,7 +1678,7 @@ static tb_bool_t gb_tessellator_fix_region_intersection_errors(gb_tessellator_im
  *                 .     .
  *              .          .
  */
-static tb_bool_t gb_tessellator_fix_region_intersection(gb_tessellator_impl_t* impl, gb_tessellator_active_region_ref_t region_left)
+static tb_bool_t gb_tessellator_fix_region_intersection_done(gb_tessellator_impl_t* impl, gb_tessellator_active_region_ref_t region_left)
 {
     // check
     tb_assert(impl && impl->mesh && region_left);
@@ -2084,12 +2087,15 @@ static tb_bool_t gb_tessellator_fix_region_intersection(gb_tessellator_impl_t* i
 
         // add intersection to the profiler
 #ifdef GB_TESSELLATOR_PROFILER_ENABLE
-        gb_tessellator_profiler_add_inter(gb_mesh_edge_org(edge_right));
+        gb_tessellator_profiler_add_inter(impl, gb_mesh_edge_org(edge_right));
 #endif
 
         // insert the new intersection vertex to the event queue
         gb_tessellator_event_queue_insert(impl, gb_mesh_edge_org(edge_right));
 
+        // update stats
+        gb_tessellator_stats_count_add(impl, intersections, 1);
+
         /* the left and right edge will be split, so we need mark them and their left edge as "dirty"
          *
          *      fix_all_dirty_regions()
@@ -2116,6 +2122,24 @@ static tb_bool_t gb_tessellator_fix_region_intersection(gb_tessellator_impl_t* i
     // no recursion
     return tb_false;
 }
+/* fix the region intersection and update the stats
+ *
+ * it may be called recursively from insert_down_going_edges(), 
+ * so we only count the time of the outermost call.
+ */
+static tb_bool_t gb_tessellator_fix_region_intersection(gb_tessellator_impl_t* impl, gb_tessellator_active_region_ref_t region_left)
+{
+    // the stats is disabled? done it directly
+    if (!impl->stats) return gb_tessellator_fix_region_intersection_done(impl, region_left);
+
+    // done it
+    tb_hong_t clock = impl->stats_fixing++? 0 : tb_uclock();
+    tb_bool_t ok = gb_tessellator_fix_region_intersection_done(impl, region_left);
+    if (!--impl->stats_fixing) gb_tessellator_stats_clock_add(impl, intersection_time, clock);
+
+    // ok?
+    return ok;
+}
 /* fix all dirty regions which order have been violated
  * and some new dirty regions may be created when we are fixing.
  *
@@ -2584,6 +2608,7 @@ static gb_tessellator_active_region_ref_t gb_tessellator_insert_region_at_right(
     region.edge     = edge_new;
     region.winding  = 0;
     region.inside   = 0;
+    region.dirty    = 0;
     region.bounds   = 0;
     region.fixedge  = 0;
 
@@ -2642,7 +2667,7 @@ static tb_void_t gb_tessellator_insert_down_going_edges(gb_tessellator_impl_t* i
 
         // add edge to the profiler
 #ifdef GB_TESSELLATOR_PROFILER_ENABLE
-        gb_tessellator_profiler_add_edge(edge);
+        gb_tessellator_profiler_add_edge(impl, edge);
 #endif
 
         // insert a new region with the new edge at the right of the left region
@@ -2858,6 +2883,9 @@ static tb_void_t gb_tessellator_remove_degenerate_edges(gb_tessellator_impl_t* i
             // trace
             tb_trace_d("remove degenerate edge");
 
+            // update stats
+            gb_tessellator_stats_count_add(impl, degenerates, 1);
+
             /* remove this edge
              *
              * before:
@@ -2884,6 +2912,9 @@ static tb_void_t gb_tessellator_remove_degenerate_edges(gb_tessellator_impl_t* i
             // trace
             tb_trace_d("remove degenerate contour");
 
+            // update stats
+            gb_tessellator_stats_count_add(impl, degenerates, 1);
+
             // two edges?
             if (edge_lnext != edge) 
             {
@@ -2938,6 +2969,9 @@ static tb_void_t gb_tessellator_remove_degenerate_faces(gb_tessellator_impl_t* i
             // trace
             tb_trace_d("remove degenerate face");
 
+            // update stats
+            gb_tessellator_stats_count_add(impl, degenerates, 1);
+
             // only clear inside
             gb_tessellator_face_inside_set(face, 0);
         }
@@ -2965,7 +2999,7 @@ static tb_void_t gb_tessellator_finish_top_region(gb_tessellator_impl_t* impl, g
 
     // finish region to the profiler
 #ifdef GB_TESSELLATOR_PROFILER_ENABLE
-    gb_tessellator_profiler_finish_region(region);
+    gb_tessellator_profiler_finish_region(impl, region);
 #endif
 
     // get the edge of this region
@@ -3237,6 +3271,9 @@ static tb_void_t gb_tessellator_connect_top_event_degenerate(gb_tessellator_impl
     // trace
     tb_trace_d("connect degenerate top event: %{point}", gb_tessellator_vertex_point(event));
 
+    // update stats
+    gb_tessellator_stats_count_add(impl, degenerates, 1);
+
     // the left edge of the region
     gb_mesh_edge_ref_t edge = region->edge;
     tb_assert(edge);
@@ -3763,7 +3800,7 @@ static tb_void_t gb_tessellator_connect_top_event(gb_tessellator_impl_t* impl, g
 
         // add split to the profiler
 #ifdef GB_TESSELLATOR_PROFILER_ENABLE
-        gb_tessellator_profiler_add_split(edge_new);
+        gb_tessellator_profiler_add_split(impl, edge_new);
 #endif
 
         // continue to sweep this event for the new region
@@ -4219,7 +4256,7 @@ static tb_void_t gb_tessellator_connect_bottom_event(gb_tessellator_impl_t* impl
 
     // add patch to the profiler
 #ifdef GB_TESSELLATOR_PROFILER_ENABLE
-    gb_tessellator_profiler_add_patch(edge_new);
+    gb_tessellator_profiler_add_patch(impl, edge_new);
 #endif
 
     // trace
@@ -4361,7 +4398,7 @@ tb_void_t gb_tessellator_monotone_make(gb_tessellator_impl_t* impl, gb_rect_ref_
 
     // init profiler
 #ifdef GB_TESSELLATOR_PROFILER_ENABLE
-    gb_tessellator_profiler_init(bounds);
+    gb_tessellator_profiler_init(impl, bounds);
 #endif
 
     // the mesh
@@ -4372,37 +4409,27 @@ tb_void_t gb_tessellator_monotone_make(gb_tessellator_impl_t* impl, gb_rect_ref_
     gb_tessellator_remove_degenerate_edges(impl);
 
     // make event queue
+    tb_hong_t clock = gb_tessellator_stats_clock(impl);
     if (!gb_tessellator_event_queue_make(impl)) return ;
+    gb_tessellator_stats_clock_add(impl, event_queue_time, clock);
 
     // make active regions
     if (!gb_tessellator_active_regions_make(impl, bounds)) return ;
 
-    // the event queue
-    tb_priority_queue_ref_t event_queue = impl->event_queue;
-    tb_assert(event_queue);
-
     // done
-    while (tb_priority_queue_size(event_queue))
+    clock = gb_tessellator_stats_clock(impl);
+    gb_mesh_vertex_ref_t event = tb_null;
+    while ((event = gb_tessellator_event_queue_pop(impl)))
     {
-        // get the minimum vertex event
-        gb_mesh_vertex_ref_t event = (gb_mesh_vertex_ref_t)tb_priority_queue_get(event_queue);
-        tb_assert(event);
-
-        // pop it from the event queue first
-        tb_priority_queue_pop(event_queue);
-
         // attempt to merge all vertices at same position as mush as possible
-        while (tb_priority_queue_size(event_queue))
+        gb_mesh_vertex_ref_t event_next = tb_null;
+        while ((event_next = gb_tessellator_event_queue_top(impl)))
         {
-            // get the next vertex event
-            gb_mesh_vertex_ref_t event_next = (gb_mesh_vertex_ref_t)tb_priority_queue_get(event_queue);
-            tb_assert(event_next);
-
             // two vertices are exactly same?
             tb_check_break(gb_tessellator_vertex_eq(event, event_next));
 
             // pop the next event from the event queue
-            tb_priority_queue_pop(event_queue);
+            gb_tessellator_event_queue_pop(impl);
 
             // trace
             tb_trace_d("event: merge: %{point}", gb_tessellator_vertex_point(event));
@@ -4428,13 +4455,14 @@ tb_void_t gb_tessellator_monotone_make(gb_tessellator_impl_t* impl, gb_rect_ref_
         // sweep this event
         gb_tessellator_sweep_event(impl, event);
     }
+    gb_tessellator_stats_clock_add(impl, sweep_time, clock);
 
     // remove degenerate faces
     gb_tessellator_remove_degenerate_faces(impl);
 
     // exit profiler
 #ifdef GB_TESSELLATOR_PROFILER_ENABLE
-    gb_tessellator_profiler_exit();
+    gb_tessellator_profiler_exit(impl);
 #endif
 
 #ifdef __gb_debug__
@@ -29,6 +29,7 @@
  * includes
  */
 #include "../prefix.h"
+#include "../mesh/pool.h"
 #include "../../mesh.h"
 #include "../../tessellator.h"
 
@@ -69,6 +70,12 @@
 // set the tessellator face inside
 #define gb_tessellator_face_inside_set(face, val)       do { gb_tessellator_face(face)->inside = (val); } while (0)
 
+// the tessellator face visited
+#define gb_tessellator_face_visited(face)               (gb_tessellator_face(face)->visited)
+
+// set the tessellator face visited
+#define gb_tessellator_face_visited_set(face, val)      do { gb_tessellator_face(face)->visited = (val); } while (0)
+
 // the tessellator vertex
 #define gb_tessellator_vertex(vertex)                   ((gb_tessellator_vertex_ref_t)gb_mesh_vertex_data_fastly(vertex))
 
@@ -83,6 +90,15 @@
     tb_byte_t __name##_data[sizeof(gb_mesh_vertex_t) + sizeof(gb_tessellator_vertex_t)]; \
     gb_mesh_vertex_ref_t name = (gb_mesh_vertex_ref_t)__name##_data;
 
+// the current clock for the stats, it is zero if the stats is disabled
+#define gb_tessellator_stats_clock(impl)                ((impl)->stats? tb_uclock() : 0)
+
+// add the spent time since the given clock to the stats 
+#define gb_tessellator_stats_clock_add(impl, name, clock) do { if ((impl)->stats) (impl)->stats->name += tb_uclock() - (clock); } while (0)
+
+// add the count to the stats
+#define gb_tessellator_stats_count_add(impl, name, val) do { if ((impl)->stats) (impl)->stats->name += (val); } while (0)
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * types
  */
@@ -103,8 +119,8 @@
  */
 typedef struct __gb_tessellator_active_region_t
 {
-    // the region position
-    tb_size_t                           position;
+    // the list entry of the active regions
+    tb_list_entry_t                     entry;
 
     // the left edge and it goes up
     gb_mesh_edge_ref_t                  edge;
@@ -129,6 +145,9 @@ typedef struct __gb_tessellator_active_region_t
 
 }gb_tessellator_active_region_t, *gb_tessellator_active_region_ref_t;
 
+// the tessellator batch ref type
+typedef struct{}*                       gb_tessellator_batch_ref_t;
+
 // the tessellator edge type
 typedef struct __gb_tessellator_edge_t
 {
@@ -146,6 +165,9 @@ typedef struct __gb_tessellator_face_t
     // is inside?
     tb_uint8_t                          inside      : 1;
 
+    // has been stitched into the triangle strip?
+    tb_uint8_t                          visited     : 1;
+
 } gb_tessellator_face_t, *gb_tessellator_face_ref_t;
 
 // the tessellator vertex type
@@ -154,6 +176,12 @@ typedef struct __gb_tessellator_vertex_t
     // the point
     gb_point_t                          point;
 
+    // the output index for the indexed triangles
+    tb_uint32_t                         index;
+
+    // the position in the sorted events, only valid if events[event] == vertex
+    tb_uint32_t                         event;
+
 } gb_tessellator_vertex_t, *gb_tessellator_vertex_ref_t;
 
 // the tessellator impl type
@@ -180,11 +208,46 @@ typedef struct __gb_tessellator_impl_t
     // the output points
     tb_vector_ref_t                     outputs;
 
-    // the event queue for vertex
+    // the output triangle indices
+    tb_vector_ref_t                     indices;
+
+    // the sorted vertex events
+    gb_mesh_vertex_ref_t*               events;
+
+    // the sorted events count
+    tb_size_t                           events_size;
+
+    // the sorted events maxn
+    tb_size_t                           events_maxn;
+
+    // the head of the sorted events, the events before it have been popped
+    tb_size_t                           events_head;
+
+    // the event queue for the new vertices, e.g. the intersections
     tb_priority_queue_ref_t             event_queue;
 
+    // the pool of the active regions, it will be rewound wholesale for the next polygon
+    gb_mesh_pool_ref_t                  active_regions_pool;
+
     // the active regions
-    tb_list_ref_t                       active_regions;
+    tb_list_entry_head_t                active_regions;
+
+    // the batch for gb_tessellator_done_many
+    gb_tessellator_batch_ref_t          batch;
+
+    // the stats, it is null if the stats is disabled
+    gb_tessellator_stats_ref_t          stats;
+
+    // the nested depth of fixing the region intersection for the stats
+    tb_size_t                           stats_fixing;
+
+    // the accounted bytes of the memory tag
+    tb_size_t                           memory;
+
+#ifdef __gb_debug__
+    // the profiler stream
+    tb_stream_ref_t                     profiler;
+#endif
 
 }gb_tessellator_impl_t;
 
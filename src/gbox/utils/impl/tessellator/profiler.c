@@ -38,9 +38,6 @@
  * globals
  */
 
-// the profiler 
-static tb_stream_ref_t  g_profiler = tb_null;
-
 // the head
 static tb_char_t const* g_head = "\
 <!DOCTYPE html>\n\
@@ -145,10 +142,10 @@ static tb_char_t const* g_tail = "\
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
  */
-tb_bool_t gb_tessellator_profiler_init(gb_rect_ref_t bounds)
+tb_bool_t gb_tessellator_profiler_init(gb_tessellator_impl_t* impl, gb_rect_ref_t bounds)
 {
     // check
-    tb_assert_and_check_return_val(bounds, tb_false);
+    tb_assert_and_check_return_val(impl && bounds, tb_false);
 
     // done
     tb_bool_t   ok = tb_false;
@@ -157,10 +154,10 @@ tb_bool_t gb_tessellator_profiler_init(gb_rect_ref_t bounds)
     do
     {
         // check
-        tb_assert(!g_profiler);
+        tb_assert(!impl->profiler);
 
-        // init sequence
-        static tb_size_t s_sequence = 0;
+        // init sequence, the tessellators may be done on the different threads
+        static tb_atomic_t s_sequence = 0;
 
         // get the temporary directory
         tb_char_t temp[TB_PATH_MAXN];
@@ -168,14 +165,14 @@ tb_bool_t gb_tessellator_profiler_init(gb_rect_ref_t bounds)
         tb_assert_and_check_break(size);
 
         // make the profiler file path
-        tb_snprintf(temp + size, sizeof(temp) - size, "/profiler_%lu.html", s_sequence++);
+        tb_snprintf(temp + size, sizeof(temp) - size, "/profiler_%lu.html", (tb_size_t)tb_atomic_fetch_and_inc(&s_sequence));
 
         // make profiler
-        g_profiler = tb_stream_init_from_file(temp, TB_FILE_MODE_RW | TB_FILE_MODE_CREAT | TB_FILE_MODE_TRUNC);
-        tb_assert_and_check_break(g_profiler);
+        impl->profiler = tb_stream_init_from_file(temp, TB_FILE_MODE_RW | TB_FILE_MODE_CREAT | TB_FILE_MODE_TRUNC);
+        tb_assert_and_check_break(impl->profiler);
 
         // open profiler
-        if (!tb_stream_open(g_profiler)) break;
+        if (!tb_stream_open(impl->profiler)) break;
 
         // make head
         head = (tb_char_t*)tb_malloc0(head_maxn);
@@ -208,7 +205,7 @@ tb_bool_t gb_tessellator_profiler_init(gb_rect_ref_t bounds)
                                         ,   &rx1, &ry1, &rx2, &ry2);
 
         // write head 
-        if (!tb_stream_bwrit(g_profiler, (tb_byte_t const*)head, head_size)) break;
+        if (!tb_stream_bwrit(impl->profiler, (tb_byte_t const*)head, head_size)) break;
 
         // ok
         ok = tb_true;
@@ -219,8 +216,8 @@ tb_bool_t gb_tessellator_profiler_init(gb_rect_ref_t bounds)
     if (!ok)
     {
         // exit it
-        if (g_profiler) tb_stream_exit(g_profiler);
-        g_profiler = tb_null;
+        if (impl->profiler) tb_stream_exit(impl->profiler);
+        impl->profiler = tb_null;
     }
 
     // exit head
@@ -230,22 +227,22 @@ tb_bool_t gb_tessellator_profiler_init(gb_rect_ref_t bounds)
     // ok?
     return ok;
 }
-tb_void_t gb_tessellator_profiler_exit()
+tb_void_t gb_tessellator_profiler_exit(gb_tessellator_impl_t* impl)
 {
     // check
-    tb_assert_and_check_return(g_profiler);
+    tb_assert_and_check_return(impl && impl->profiler);
 
     // write the tail
-    tb_stream_bwrit(g_profiler, (tb_byte_t const*)g_tail, tb_strlen(g_tail));
+    tb_stream_bwrit(impl->profiler, (tb_byte_t const*)g_tail, tb_strlen(g_tail));
 
     // exit it
-    tb_stream_exit(g_profiler);
-    g_profiler = tb_null;
+    tb_stream_exit(impl->profiler);
+    impl->profiler = tb_null;
 }
-tb_void_t gb_tessellator_profiler_add_edge(gb_mesh_edge_ref_t edge)
+tb_void_t gb_tessellator_profiler_add_edge(gb_tessellator_impl_t* impl, gb_mesh_edge_ref_t edge)
 {
     // check
-    tb_assert_and_check_return(g_profiler && edge);
+    tb_assert_and_check_return(impl && impl->profiler && edge);
 
     // the vertices
     gb_mesh_vertex_ref_t org = gb_mesh_edge_org(edge);
@@ -261,12 +258,12 @@ tb_void_t gb_tessellator_profiler_add_edge(gb_mesh_edge_ref_t edge)
     tb_assert_and_check_return(size > 0);
 
     // write line
-    tb_stream_bwrit(g_profiler, (tb_byte_t const*)line, size);
+    tb_stream_bwrit(impl->profiler, (tb_byte_t const*)line, size);
 }
-tb_void_t gb_tessellator_profiler_add_split(gb_mesh_edge_ref_t edge)
+tb_void_t gb_tessellator_profiler_add_split(gb_tessellator_impl_t* impl, gb_mesh_edge_ref_t edge)
 {
     // check
-    tb_assert_and_check_return(g_profiler && edge);
+    tb_assert_and_check_return(impl && impl->profiler && edge);
 
     // the vertices
     gb_mesh_vertex_ref_t org = gb_mesh_edge_org(edge);
@@ -282,12 +279,12 @@ tb_void_t gb_tessellator_profiler_add_split(gb_mesh_edge_ref_t edge)
     tb_assert_and_check_return(size > 0);
 
     // write line
-    tb_stream_bwrit(g_profiler, (tb_byte_t const*)line, size);
+    tb_stream_bwrit(impl->profiler, (tb_byte_t const*)line, size);
 }
-tb_void_t gb_tessellator_profiler_add_patch(gb_mesh_edge_ref_t edge)
+tb_void_t gb_tessellator_profiler_add_patch(gb_tessellator_impl_t* impl, gb_mesh_edge_ref_t edge)
 {
     // check
-    tb_assert_and_check_return(g_profiler && edge);
+    tb_assert_and_check_return(impl && impl->profiler && edge);
 
     // the vertices
     gb_mesh_vertex_ref_t org = gb_mesh_edge_org(edge);
@@ -303,12 +300,12 @@ tb_void_t gb_tessellator_profiler_add_patch(gb_mesh_edge_ref_t edge)
     tb_assert_and_check_return(size > 0);
 
     // write line
-    tb_stream_bwrit(g_profiler, (tb_byte_t const*)line, size);
+    tb_stream_bwrit(impl->profiler, (tb_byte_t const*)line, size);
 }
-tb_void_t gb_tessellator_profiler_add_inter(gb_mesh_vertex_ref_t inter)
+tb_void_t gb_tessellator_profiler_add_inter(gb_tessellator_impl_t* impl, gb_mesh_vertex_ref_t inter)
 {
     // check
-    tb_assert_and_check_return(g_profiler && inter);
+    tb_assert_and_check_return(impl && impl->profiler && inter);
 
     // the point
     gb_point_ref_t point = gb_tessellator_vertex_point(inter);
@@ -319,12 +316,12 @@ tb_void_t gb_tessellator_profiler_add_inter(gb_mesh_vertex_ref_t inter)
     tb_assert_and_check_return(size > 0);
 
     // write line
-    tb_stream_bwrit(g_profiler, (tb_byte_t const*)line, size);
+    tb_stream_bwrit(impl->profiler, (tb_byte_t const*)line, size);
 }
-tb_void_t gb_tessellator_profiler_finish_region(gb_tessellator_active_region_ref_t region)
+tb_void_t gb_tessellator_profiler_finish_region(gb_tessellator_impl_t* impl, gb_tessellator_active_region_ref_t region)
 {
     // check
-    tb_assert_and_check_return(g_profiler && region);
+    tb_assert_and_check_return(impl && impl->profiler && region);
 
     // the region is inside?
     tb_check_return(region->inside);
@@ -347,6 +344,6 @@ tb_void_t gb_tessellator_profiler_finish_region(gb_tessellator_active_region_ref
     tb_assert_and_check_return(size > 0);
 
     // write line
-    tb_stream_bwrit(g_profiler, (tb_byte_t const*)line, size);
+    tb_stream_bwrit(impl->profiler, (tb_byte_t const*)line, size);
 }
 
@@ -0,0 +1,366 @@
+/*!The Graphic Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        simple.c
+ * @ingroup     utils
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME            "simple"
+#define TB_TRACE_MODULE_DEBUG           (0)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "simple.h"
+#include "mesh.h"
+#include "geometry.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+/* the maximum point count of the simple polygon
+ *
+ * the simple checking and the ear clipping are O(n^2), 
+ * so we only use it for the small polygons
+ */
+#ifdef __gb_small__
+#   define GB_TESSELLATOR_SIMPLE_MAXN           (64)
+#else
+#   define GB_TESSELLATOR_SIMPLE_MAXN           (128)
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+
+/* the sign of the cross value of the vectors (p1, p0) and (p1, p2)
+ *
+ * > 0: counter-clockwise, same as gb_points_is_ccw()
+ * = 0: collinear
+ * < 0: clockwise
+ */
+static tb_long_t gb_tessellator_simple_ccw(gb_point_ref_t p0, gb_point_ref_t p1, gb_point_ref_t p2)
+{
+    // the coordinates
+    tb_fixed_t x0 = gb_float_to_fixed(p0->x);
+    tb_fixed_t y0 = gb_float_to_fixed(p0->y);
+    tb_fixed_t x1 = gb_float_to_fixed(p1->x);
+    tb_fixed_t y1 = gb_float_to_fixed(p1->y);
+    tb_fixed_t x2 = gb_float_to_fixed(p2->x);
+    tb_fixed_t y2 = gb_float_to_fixed(p2->y);
+
+    // compute the cross value, the differences may overflow the fixed type
+    tb_hong_t cross = ((tb_hong_t)x0 - x1) * ((tb_hong_t)y2 - y1) - ((tb_hong_t)y0 - y1) * ((tb_hong_t)x2 - x1);
+    return cross > 0? 1 : (cross < 0? -1 : 0);
+}
+// the collinear point p is on the segment(a, b)?
+static __tb_inline__ tb_bool_t gb_tessellator_simple_on_segment(gb_point_ref_t p, gb_point_ref_t a, gb_point_ref_t b)
+{
+    return      p->x >= tb_min(a->x, b->x) && p->x <= tb_max(a->x, b->x)
+            &&  p->y >= tb_min(a->y, b->y) && p->y <= tb_max(a->y, b->y);
+}
+// the segment(a, b) and segment(c, d) are intersecting or touching?
+static tb_bool_t gb_tessellator_simple_intersecting(gb_point_ref_t a, gb_point_ref_t b, gb_point_ref_t c, gb_point_ref_t d)
+{
+    // the bounds are not intersecting?
+    if (    tb_max(a->x, b->x) < tb_min(c->x, d->x) || tb_max(c->x, d->x) < tb_min(a->x, b->x)
+        ||  tb_max(a->y, b->y) < tb_min(c->y, d->y) || tb_max(c->y, d->y) < tb_min(a->y, b->y))
+        return tb_false;
+
+    // compute the sides
+    tb_long_t abc = gb_tessellator_simple_ccw(a, b, c);
+    tb_long_t abd = gb_tessellator_simple_ccw(a, b, d);
+    tb_long_t cda = gb_tessellator_simple_ccw(c, d, a);
+    tb_long_t cdb = gb_tessellator_simple_ccw(c, d, b);
+
+    // crossing?
+    if (abc * abd < 0 && cda * cdb < 0) return tb_true;
+
+    // touching?
+    return      (!abc && gb_tessellator_simple_on_segment(c, a, b))
+            ||  (!abd && gb_tessellator_simple_on_segment(d, a, b))
+            ||  (!cda && gb_tessellator_simple_on_segment(a, c, d))
+            ||  (!cdb && gb_tessellator_simple_on_segment(b, c, d));
+}
+/* the point is inside the contour? 
+ *
+ * using the winding number, the point must be not on the contour
+ */
+static tb_bool_t gb_tessellator_simple_inside(gb_point_ref_t point, gb_point_ref_t points, tb_size_t count)
+{
+    // done
+    tb_long_t   winding = 0;
+    tb_size_t   index   = 0;
+    for (index = 0; index + 1 < count; index++)
+    {
+        // the edge
+        gb_point_ref_t org = points + index;
+        gb_point_ref_t dst = org + 1;
+
+        // the upward edge crosses the horizontal line of the point and the point is in the edge left?
+        if (org->y <= point->y)
+        {
+            if (dst->y > point->y && gb_tessellator_simple_ccw(org, dst, point) < 0) winding++;
+        }
+        // the downward edge crosses the horizontal line of the point and the point is in the edge right?
+        else if (dst->y <= point->y && gb_tessellator_simple_ccw(org, dst, point) > 0) winding--;
+    }
+
+    // inside?
+    return winding != 0;
+}
+/* the polygon is simple?
+ *
+ * - the point count is not too large 
+ * - all contours are not self-intersecting and not intersecting each other
+ * - all contours are not nested
+ */
+static tb_bool_t gb_tessellator_simple_check(gb_polygon_ref_t polygon)
+{
+    // check
+    tb_assert(polygon && polygon->points && polygon->counts);
+
+    // the points
+    gb_point_ref_t      points = polygon->points;
+    tb_uint16_t const*  counts = polygon->counts;
+
+    // compute the total edge count and check the edges
+    tb_size_t   total = 0;
+    tb_uint16_t count = 0;
+    while ((count = *counts++))
+    {
+        // the contour must be closed and has three points at least
+        if (count < 4 || !gb_point_eq(points + total, points + total + count - 1)) return tb_false;
+
+        // too many points?
+        total += count;
+        if (total > GB_TESSELLATOR_SIMPLE_MAXN) return tb_false;
+    }
+
+    // check all edges
+    tb_size_t contour_i = 0;
+    tb_size_t contour_j = 0;
+    tb_size_t head_i    = 0;
+    tb_size_t head_j    = 0;
+    tb_size_t i         = 0;
+    tb_size_t j         = 0;
+    for (counts = polygon->counts; (count = counts[contour_i]); contour_i++, head_i += count)
+    {
+        for (i = head_i; i + 1 < head_i + count; i++)
+        {
+            // the edge(i)
+            gb_point_ref_t a = points + i;
+            gb_point_ref_t b = a + 1;
+
+            // the degenerated edge?
+            if (gb_point_eq(a, b)) return tb_false;
+
+            // the next edge in this contour, it is not overlapping with the edge(i)?
+            gb_point_ref_t c = (i + 2 < head_i + count)? b + 1 : points + head_i + 1;
+            if (!gb_tessellator_simple_ccw(a, b, c) && (gb_tessellator_simple_on_segment(c, a, b) || gb_tessellator_simple_on_segment(a, b, c))) return tb_false;
+
+            // the other edges in this contour, not intersecting with the edge(i)?
+            for (j = i + 2; j + 1 < head_i + count; j++)
+            {
+                // skip the adjacent edge of the first edge
+                if (i == head_i && j + 2 == head_i + count) continue;
+
+                // intersecting?
+                if (gb_tessellator_simple_intersecting(a, b, points + j, points + j + 1)) return tb_false;
+            }
+
+            // the edges in the next contours, not intersecting with the edge(i)?
+            head_j = head_i + count;
+            for (contour_j = contour_i + 1; counts[contour_j]; head_j += counts[contour_j++])
+            {
+                for (j = head_j; j + 1 < head_j + counts[contour_j]; j++)
+                {
+                    if (gb_tessellator_simple_intersecting(a, b, points + j, points + j + 1)) return tb_false;
+                }
+            }
+        }
+    }
+
+    // check nested contours if exists many contours
+    if (polygon->counts[1])
+    {
+        for (contour_i = 0, head_i = 0; (count = counts[contour_i]); head_i += counts[contour_i++])
+        {
+            for (contour_j = 0, head_j = 0; counts[contour_j]; head_j += counts[contour_j++])
+            {
+                // the contour(i) is inside the contour(j)?
+                if (contour_i != contour_j && gb_tessellator_simple_inside(points + head_i, points + head_j, counts[contour_j])) 
+                    return tb_false;
+            }
+        }
+    }
+
+    // ok
+    return tb_true;
+}
+/* make triangulation region for the simple face by ear clipping
+ *
+ *         d . . . . c
+ *          .       . .  
+ *           .    .    . 
+ *            . .       .
+ *             a ------> b
+ *                 edge
+ *
+ * the triangle(a, b, c) is an ear if it is convex and contains no other vertices,
+ * then we connect(c, a) to cut it and the remaining face will be (a, c, d, ...)
+ */
+static tb_bool_t gb_tessellator_simple_make_face(gb_tessellator_impl_t* impl, gb_mesh_edge_ref_t edge, tb_size_t count)
+{
+    // check
+    tb_assert(impl && impl->mesh && edge);
+
+    // done
+    tb_size_t miss = 0;
+    while (count > 3)
+    {
+        // the triangle(a, b, c)
+        gb_mesh_vertex_ref_t a = gb_mesh_edge_org(edge);
+        gb_mesh_vertex_ref_t b = gb_mesh_edge_dst(edge);
+        gb_mesh_vertex_ref_t c = gb_mesh_edge_dst(gb_mesh_edge_lnext(edge));
+
+        // is convex?
+        tb_bool_t is_ear = gb_tessellator_simple_ccw(gb_tessellator_vertex_point(a), gb_tessellator_vertex_point(b), gb_tessellator_vertex_point(c)) > 0;
+
+        // contains other vertices? (d, ...)
+        if (is_ear)
+        {
+            gb_mesh_edge_ref_t other = gb_mesh_edge_lnext(gb_mesh_edge_lnext(gb_mesh_edge_lnext(edge)));
+            while (other != edge)
+            {
+                // the vertex is inside or on the triangle?
+                gb_point_ref_t point = gb_tessellator_vertex_point(gb_mesh_edge_org(other));
+                if (    gb_tessellator_simple_ccw(gb_tessellator_vertex_point(a), gb_tessellator_vertex_point(b), point) >= 0
+                    &&  gb_tessellator_simple_ccw(gb_tessellator_vertex_point(b), gb_tessellator_vertex_point(c), point) >= 0
+                    &&  gb_tessellator_simple_ccw(gb_tessellator_vertex_point(c), gb_tessellator_vertex_point(a), point) >= 0)
+                {
+                    is_ear = tb_false;
+                    break;
+                }
+
+                // the next vertex
+                other = gb_mesh_edge_lnext(other);
+            }
+        }
+
+        // is ear?
+        if (is_ear)
+        {
+            // cut it, the new face of triangle(a, b, c) will inherit the inside attribute
+            gb_mesh_edge_ref_t edge_new = gb_mesh_edge_connect(impl->mesh, gb_mesh_edge_lnext(edge), edge);
+            tb_assert_and_check_return_val(edge_new, tb_false);
+
+            // the remaining face: (a, c, d, ...)
+            edge = gb_mesh_edge_sym(edge_new);
+            count--;
+            miss = 0;
+        }
+        else 
+        {
+            // no ears for the degenerated face? 
+            if (++miss > count) return tb_false;
+
+            // the next edge
+            edge = gb_mesh_edge_lnext(edge);
+        }
+    }
+
+    // ok
+    return tb_true;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_bool_t gb_tessellator_simple_make(gb_tessellator_impl_t* impl, gb_polygon_ref_t polygon)
+{
+    // check
+    tb_assert(impl && polygon);
+
+    // is simple polygon?
+    if (!gb_tessellator_simple_check(polygon)) return tb_false;
+
+    // make mesh
+    if (!gb_tessellator_mesh_make(impl, polygon)) return tb_false;
+
+    // the clock for the stats
+    tb_hong_t clock = gb_tessellator_stats_clock(impl);
+
+    /* make triangulation region for the counter-clockwise face of each contour
+     *
+     * @note the new faces will be inserted to the head of list and will not be iterated
+     */
+    tb_for_all_if (gb_mesh_face_ref_t, face, gb_mesh_face_itor(impl->mesh), face)
+    {
+        // find the leftmost vertex of the topmost vertices, it must be convex
+        tb_size_t           count       = 0;
+        gb_mesh_edge_ref_t  head        = gb_mesh_face_edge(face);
+        gb_mesh_edge_ref_t  edge        = head;
+        gb_mesh_edge_ref_t  edge_top = head;
+        do
+        {
+            // the topmost and leftmost vertex?
+            if (gb_tessellator_vertex_le(gb_mesh_edge_org(edge), gb_mesh_edge_org(edge_top))) edge_top = edge;
+
+            // the next edge
+            edge = gb_mesh_edge_lnext(edge);
+            count++;
+
+        } while (edge != head);
+
+        // the face orientation
+        tb_long_t ccw = gb_tessellator_simple_ccw( gb_tessellator_vertex_point(gb_mesh_edge_org(gb_mesh_edge_lprev(edge_top)))
+                                                 , gb_tessellator_vertex_point(gb_mesh_edge_org(edge_top))
+                                                 , gb_tessellator_vertex_point(gb_mesh_edge_dst(edge_top)));
+
+        // degenerated?
+        if (!ccw) return tb_false;
+
+        // the clockwise face is outside
+        tb_check_continue(ccw > 0);
+
+        // the counter-clockwise face is inside
+        gb_tessellator_face_inside_set(face, 1);
+
+        // make triangulation region
+        if (!gb_tessellator_simple_make_face(impl, edge_top, count)) return tb_false;
+    }
+
+    // update stats
+    gb_tessellator_stats_clock_add(impl, triangulation_time, clock);
+
+#ifdef __gb_debug__
+    // check mesh
+    gb_mesh_check(impl->mesh);
+#endif
+
+    // ok
+    return tb_true;
+}
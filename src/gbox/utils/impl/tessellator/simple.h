@@ -0,0 +1,64 @@
+/*!The Graphic Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        simple.h
+ * @ingroup     utils
+ */
+#ifndef GB_UTILS_IMPL_TESSELLATOR_SIMPLE_H
+#define GB_UTILS_IMPL_TESSELLATOR_SIMPLE_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/* make triangulation region for the simple polygon directly by ear clipping
+ *
+ * the polygon is simple if all contours are not self-intersecting, not intersecting 
+ * each other and not nested, so the result is same for all winding rules 
+ * and we need not make the horizontal monotone region by the sweep line.
+ *
+ * the inside faces of the mesh will be triangles if ok
+ *
+ * @param impl      the tessellator impl
+ * @param polygon   the polygon
+ *
+ * @return          tb_true or tb_false if the polygon is not simple or too large
+ */
+tb_bool_t           gb_tessellator_simple_make(gb_tessellator_impl_t* impl, gb_polygon_ref_t polygon);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+
+#endif
+
+
@@ -0,0 +1,242 @@
+/*!The Graphic Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        strip.c
+ * @ingroup     utils
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME            "strip"
+#define TB_TRACE_MODULE_DEBUG           (1)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "strip.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the strip points grow
+#ifdef __gb_small__
+#   define GB_TESSELLATOR_STRIP_GROW            (64)
+#else
+#   define GB_TESSELLATOR_STRIP_GROW            (256)
+#endif
+
+// the maximum points count of the triangle strip for each func call
+#define GB_TESSELLATOR_STRIP_MAXN               (TB_MAXU16)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static tb_void_t gb_tessellator_strip_flush(gb_tessellator_impl_t* impl)
+{
+    // check
+    tb_assert(impl && impl->func && impl->outputs);
+
+    // exists triangle?
+    tb_size_t count = tb_vector_size(impl->outputs);
+    if (count > 2)
+    {
+        // done it
+        impl->func((gb_point_ref_t)tb_vector_data(impl->outputs), (tb_uint16_t)count, impl->priv);
+
+        // update stats
+        gb_tessellator_stats_count_add(impl, faces, 1);
+    }
+
+    // clear it
+    tb_vector_clear(impl->outputs);
+}
+static tb_void_t gb_tessellator_strip_append(gb_tessellator_impl_t* impl, gb_point_ref_t point)
+{
+    // check
+    tb_assert(impl && impl->outputs && point);
+
+    // the strip is full? 
+    tb_vector_ref_t outputs = impl->outputs;
+    if (tb_vector_size(outputs) >= GB_TESSELLATOR_STRIP_MAXN)
+    {
+        // save the last edge
+        gb_point_ref_t  data = (gb_point_ref_t)tb_vector_data(outputs) + tb_vector_size(outputs);
+        gb_point_t      prev = data[-2];
+        gb_point_t      last = data[-1];
+
+        // flush it
+        gb_tessellator_strip_flush(impl);
+
+        // continue the current strip from the last edge for the next func call
+        tb_vector_insert_tail(outputs, &prev);
+        tb_vector_insert_tail(outputs, &last);
+    }
+
+    // append point
+    tb_vector_insert_tail(outputs, point);
+}
+static tb_void_t gb_tessellator_strip_enter(gb_tessellator_impl_t* impl, gb_point_ref_t point)
+{
+    // check
+    tb_assert(impl && impl->outputs && point);
+
+    /* join the previous strip by the degenerate triangles
+     *
+     * a, b, c, c, d, d, e, f
+     *          ^  ^
+     */
+    if (tb_vector_size(impl->outputs))
+    {
+        gb_point_t last = *((gb_point_ref_t)tb_vector_data(impl->outputs) + tb_vector_size(impl->outputs) - 1);
+        gb_tessellator_strip_append(impl, &last);
+        gb_tessellator_strip_append(impl, point);
+    }
+
+    // append the first point of the new strip
+    gb_tessellator_strip_append(impl, point);
+}
+static gb_mesh_face_ref_t gb_tessellator_strip_next(gb_mesh_edge_ref_t edge)
+{
+    // the face on the other side of this edge
+    gb_mesh_face_ref_t face = gb_mesh_edge_rface(edge);
+    tb_assert(face);
+
+    // this face has not been stitched into the strip?
+    return (gb_tessellator_face_inside(face) && !gb_tessellator_face_visited(face))? face : tb_null;
+}
+static tb_void_t gb_tessellator_strip_make_face(gb_tessellator_impl_t* impl, gb_mesh_face_ref_t face)
+{
+    // check
+    tb_assert(impl && face);
+
+    // the face must be triangle
+    gb_mesh_edge_ref_t edge = gb_mesh_face_edge(face);
+    tb_assert(edge && gb_mesh_edge_lnext(gb_mesh_edge_lnext(gb_mesh_edge_lnext(edge))) == edge);
+
+    /* find the start edge which the strip can be continued from it
+     *
+     *         c
+     *        / \
+     *       /   \ <- the next edge: b => c
+     *      /     \
+     *     a ----- b
+     *      the start edge
+     */
+    tb_size_t n = 3;
+    while (n-- && !gb_tessellator_strip_next(gb_mesh_edge_lnext(edge))) edge = gb_mesh_edge_lnext(edge);
+
+    // append this triangle to the new strip: a, b, c
+    gb_tessellator_face_visited_set(face, 1);
+    gb_tessellator_strip_enter(impl, gb_tessellator_vertex_point(gb_mesh_edge_org(edge)));
+    gb_tessellator_strip_append(impl, gb_tessellator_vertex_point(gb_mesh_edge_dst(edge)));
+    edge = gb_mesh_edge_lnext(edge);
+    gb_tessellator_strip_append(impl, gb_tessellator_vertex_point(gb_mesh_edge_dst(edge)));
+
+    /* continue the strip to the adjacent triangles
+     *
+     * the edge connects the last two points of the strip: (p, q), 
+     * the next triangle contains the sym edge and the new point t will be appended, 
+     * then we get the next edge (q, t) in the next triangle.
+     */
+    gb_mesh_vertex_ref_t    last = gb_mesh_edge_dst(edge);
+    gb_mesh_face_ref_t      next = tb_null;
+    while ((next = gb_tessellator_strip_next(edge)))
+    {
+        // the face must be triangle
+        gb_mesh_edge_ref_t edge_sym = gb_mesh_edge_sym(edge);
+        tb_assert(gb_mesh_edge_lnext(gb_mesh_edge_lnext(gb_mesh_edge_lnext(edge_sym))) == edge_sym);
+
+        // the new point
+        gb_mesh_vertex_ref_t vertex = gb_mesh_edge_dst(gb_mesh_edge_lnext(edge_sym));
+
+        // append it
+        gb_tessellator_face_visited_set(next, 1);
+        gb_tessellator_strip_append(impl, gb_tessellator_vertex_point(vertex));
+
+        // the next edge: (last, vertex)
+        edge = gb_mesh_edge_org(edge_sym) == last? gb_mesh_edge_lprev(edge_sym) : gb_mesh_edge_lnext(edge_sym);
+        last = vertex;
+    }
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_bool_t gb_tessellator_strip_init(gb_tessellator_impl_t* impl)
+{
+    // check
+    tb_assert(impl);
+
+    // init outputs
+    if (!impl->outputs) impl->outputs = tb_vector_init(GB_TESSELLATOR_STRIP_GROW, tb_element_mem(sizeof(gb_point_t), tb_null, tb_null));
+    tb_assert_and_check_return_val(impl->outputs, tb_false);
+
+    // clear it
+    tb_vector_clear(impl->outputs);
+
+    // ok
+    return tb_true;
+}
+tb_void_t gb_tessellator_strip_convex(gb_tessellator_impl_t* impl, gb_point_ref_t points, tb_uint16_t count)
+{
+    // check
+    tb_assert(impl && impl->outputs && points);
+
+    // the vertices count, the contour is closed and the last point is the first point
+    tb_check_return(count > 3);
+    count--;
+
+    /* make the zigzag strip for the convex contour
+     *
+     * 0, 1, n - 1, 2, n - 2, 3, ...
+     */
+    tb_size_t l = 0;
+    tb_size_t r = count - 1;
+    gb_tessellator_strip_enter(impl, points + l++);
+    while (l <= r)
+    {
+        gb_tessellator_strip_append(impl, points + l++);
+        if (l <= r) gb_tessellator_strip_append(impl, points + r--);
+    }
+}
+tb_void_t gb_tessellator_strip_make(gb_tessellator_impl_t* impl)
+{
+    // check
+    tb_assert(impl && impl->mesh && impl->outputs);
+
+    // done
+    tb_for_all_if (gb_mesh_face_ref_t, face, gb_mesh_face_itor(impl->mesh), face)
+    {
+        // make the new strip from this triangle if it has not been stitched
+        if (gb_tessellator_face_inside(face) && !gb_tessellator_face_visited(face))
+            gb_tessellator_strip_make_face(impl, face);
+    }
+}
+tb_void_t gb_tessellator_strip_done(gb_tessellator_impl_t* impl)
+{
+    // check
+    tb_assert(impl && impl->outputs);
+
+    // flush the left points
+    gb_tessellator_strip_flush(impl);
+}
@@ -0,0 +1,77 @@
+/*!The Graphic Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        strip.h
+ * @ingroup     utils
+ */
+#ifndef GB_UTILS_IMPL_TESSELLATOR_STRIP_H
+#define GB_UTILS_IMPL_TESSELLATOR_STRIP_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/* init the triangle strip for the new polygon
+ *   
+ * @param impl      the tessellator impl
+ *
+ * @return          tb_true or tb_false
+ */
+tb_bool_t           gb_tessellator_strip_init(gb_tessellator_impl_t* impl);
+
+/* append the convex contour to the triangle strip
+ *   
+ * @param impl      the tessellator impl
+ * @param points    the points of the closed contour
+ * @param count     the points count of the closed contour
+ */
+tb_void_t           gb_tessellator_strip_convex(gb_tessellator_impl_t* impl, gb_point_ref_t points, tb_uint16_t count);
+
+/* stitch the inside triangles of mesh into the triangle strip after triangulation
+ *   
+ * @param impl      the tessellator impl
+ */
+tb_void_t           gb_tessellator_strip_make(gb_tessellator_impl_t* impl);
+
+/* done the func with the triangle strip of the polygon
+ *   
+ * @param impl      the tessellator impl
+ */
+tb_void_t           gb_tessellator_strip_done(gb_tessellator_impl_t* impl);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+
+#endif
+
+
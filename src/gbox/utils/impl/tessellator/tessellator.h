@@ -29,9 +29,12 @@
  * includes
  */
 #include "mesh.h"
+#include "batch.h"
 #include "convex.h"
 #include "geometry.h"
 #include "monotone.h"
+#include "simple.h"
+#include "strip.h"
 #include "triangulation.h"
 
 #endif
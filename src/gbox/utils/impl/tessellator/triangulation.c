@@ -348,6 +348,9 @@ tb_void_t gb_tessellator_triangulation_make(gb_tessellator_impl_t* impl)
     // the new face must be inserted to the head of faces
     tb_assert(gb_mesh_face_order(impl->mesh) == GB_MESH_ORDER_INSERT_HEAD);
 
+    // the clock for the stats
+    tb_hong_t clock = gb_tessellator_stats_clock(impl);
+
     // the iterator
     tb_iterator_ref_t iterator = gb_mesh_face_itor(impl->mesh);
     tb_assert(iterator);
@@ -376,6 +379,9 @@ tb_void_t gb_tessellator_triangulation_make(gb_tessellator_impl_t* impl)
         }
     }
 
+    // update stats
+    gb_tessellator_stats_clock_add(impl, triangulation_time, clock);
+
 #ifdef __gb_debug__
     // check mesh
     gb_mesh_check(impl->mesh);
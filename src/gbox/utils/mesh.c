@@ -463,16 +463,13 @@ gb_mesh_ref_t gb_mesh_init(tb_element_t edge_element, tb_element_t face_element,
          * register printf("%{mesh_edge}",      edge);
          * register printf("%{mesh_vertex}",    vertex);
          */
-        static tb_bool_t s_is_registered = tb_false;
-        if (!s_is_registered)
+        static tb_atomic_t s_is_registered = 0;
+        if (!tb_atomic_fetch_and_pset(&s_is_registered, 0, 1))
         {
             // register them
             tb_printf_object_register("mesh_edge",      gb_mesh_printf_edge);
             tb_printf_object_register("mesh_face",      gb_mesh_printf_face);
             tb_printf_object_register("mesh_vertex",    gb_mesh_printf_vertex);
-
-            // ok
-            s_is_registered = tb_true;
         }
 #endif
 
@@ -542,6 +539,18 @@ tb_bool_t gb_mesh_is_empty(gb_mesh_ref_t mesh)
     // is empty
     return tb_true;
 }
+tb_size_t gb_mesh_capacity(gb_mesh_ref_t mesh)
+{
+    // check
+    gb_mesh_impl_t* impl = (gb_mesh_impl_t*)mesh;
+    tb_assert_and_check_return_val(impl && impl->edges && impl->faces && impl->vertices, 0);
+
+    // the capacity
+    return  sizeof(gb_mesh_impl_t)
+        +   gb_mesh_edge_list_capacity(impl->edges)
+        +   gb_mesh_face_list_capacity(impl->faces)
+        +   gb_mesh_vertex_list_capacity(impl->vertices);
+}
 tb_void_t gb_mesh_listener_set(gb_mesh_ref_t mesh, gb_mesh_listener_t listener, tb_cpointer_t priv)
 {
     // check
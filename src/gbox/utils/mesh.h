@@ -364,6 +364,9 @@ typedef struct{}*               gb_mesh_ref_t;
  */
 
 /*! init the mesh 
+ *
+ * the user data of the trivial element without the free func (element.free == tb_null)
+ * will not be exited one by one when the mesh is cleared or the element is killed
  *
  * @param edge_element          the edge element
  * @param face_element          the face element
@@ -393,6 +396,14 @@ tb_void_t                       gb_mesh_clear(gb_mesh_ref_t mesh);
  */
 tb_bool_t                       gb_mesh_is_empty(gb_mesh_ref_t mesh);
 
+/*! the allocated bytes of the mesh, including the unused items of the edge, face and vertex pools
+ *
+ * @param mesh                  the mesh
+ *
+ * @return                      the bytes
+ */
+tb_size_t                       gb_mesh_capacity(gb_mesh_ref_t mesh);
+
 /*! set the mesh listener
  *
  * @param mesh                  the mesh
@@ -46,9 +46,29 @@
 #   define GB_TESSELLATOR_OUTPUTS_GROW                          (64)
 #endif
 
+// sync the allocated bytes of the mesh, outputs and events to the memory tag
+#define gb_tessellator_memory_sync(impl)                        gb_memory_sync(GB_MEMORY_TAG_TESSELLATOR, (impl)->memory, gb_tessellator_memory(impl))
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * private implementation
  */
+#ifdef GB_CONFIG_MEMORY
+static tb_size_t gb_tessellator_memory(gb_tessellator_impl_t* impl)
+{
+    // check
+    tb_assert(impl);
+
+    // the bytes of the tessellator, outputs and sorted events
+    tb_size_t size = sizeof(gb_tessellator_impl_t) + gb_memory_vector(impl->outputs) + gb_memory_vector(impl->indices) + impl->events_maxn * sizeof(gb_mesh_vertex_ref_t);
+
+    // the bytes of the mesh and active regions, the mesh pools are not accounted by themselves
+    if (impl->mesh) size += gb_mesh_capacity(impl->mesh);
+    if (impl->active_regions_pool) size += gb_mesh_pool_capacity(impl->active_regions_pool);
+
+    // ok
+    return size;
+}
+#endif
 static tb_void_t gb_tessellator_done_output(gb_tessellator_impl_t* impl)
 {
     // check
@@ -103,6 +123,93 @@ static tb_void_t gb_tessellator_done_output(gb_tessellator_impl_t* impl)
 
                 // done it
                 impl->func((gb_point_ref_t)tb_vector_data(outputs), (tb_uint16_t)tb_vector_size(outputs), impl->priv);
+
+                // update stats
+                gb_tessellator_stats_count_add(impl, faces, 1);
+            }
+        }
+    }
+}
+static tb_bool_t gb_tessellator_done_indexed_init(gb_tessellator_impl_t* impl)
+{
+    // check
+    tb_assert(impl);
+
+    // init outputs
+    if (!impl->outputs) impl->outputs = tb_vector_init(GB_TESSELLATOR_OUTPUTS_GROW, tb_element_mem(sizeof(gb_point_t), tb_null, tb_null));
+    tb_assert_and_check_return_val(impl->outputs, tb_false);
+
+    // init indices
+    if (!impl->indices) impl->indices = tb_vector_init(GB_TESSELLATOR_OUTPUTS_GROW * 3, tb_element_uint32());
+    tb_assert_and_check_return_val(impl->indices, tb_false);
+
+    // clear them
+    tb_vector_clear(impl->outputs);
+    tb_vector_clear(impl->indices);
+
+    // ok
+    return tb_true;
+}
+static tb_void_t gb_tessellator_done_indexed_convex(gb_tessellator_impl_t* impl, gb_point_ref_t points, tb_uint16_t count)
+{
+    // check
+    tb_assert(impl && impl->outputs && impl->indices && points);
+
+    // the vertices count, the contour is closed and the last point is the first point
+    tb_check_return(count > 3);
+    count--;
+
+    // append vertices
+    tb_size_t base = tb_vector_size(impl->outputs);
+    tb_size_t index = 0;
+    for (index = 0; index < count; index++) tb_vector_insert_tail(impl->outputs, points + index);
+
+    // append the triangle fan for the convex contour
+    for (index = 1; index + 1 < count; index++)
+    {
+        tb_vector_insert_tail(impl->indices, (tb_cpointer_t)(base));
+        tb_vector_insert_tail(impl->indices, (tb_cpointer_t)(base + index));
+        tb_vector_insert_tail(impl->indices, (tb_cpointer_t)(base + index + 1));
+    }
+}
+static tb_void_t gb_tessellator_done_indexed_output(gb_tessellator_impl_t* impl)
+{
+    // check
+    tb_assert(impl && impl->mesh && impl->outputs && impl->indices);
+
+    // append vertices in the mesh vertex order
+    tb_size_t index = tb_vector_size(impl->outputs);
+    tb_for_all_if (gb_mesh_vertex_ref_t, vertex, gb_mesh_vertex_itor(impl->mesh), vertex)
+    {
+        // save the output index
+        gb_tessellator_vertex(vertex)->index = (tb_uint32_t)index++;
+
+        // append point
+        tb_vector_insert_tail(impl->outputs, gb_tessellator_vertex_point(vertex));
+    }
+
+    // append triangles
+    tb_for_all_if (gb_mesh_face_ref_t, face, gb_mesh_face_itor(impl->mesh), face)
+    {
+        // the face is inside?
+        if (gb_tessellator_face_inside(face)) 
+        {
+            /* make the triangle fan for this region
+             *
+             * the triangulated region is only one triangle, 
+             * but we also process the convex region here for safety
+             */
+            gb_mesh_edge_ref_t  head    = gb_mesh_face_edge(face);
+            gb_mesh_edge_ref_t  edge    = gb_mesh_edge_lnext(head);
+            tb_size_t           first   = gb_tessellator_vertex(gb_mesh_edge_org(head))->index;
+            while (gb_mesh_edge_lnext(edge) != head)
+            {
+                tb_vector_insert_tail(impl->indices, (tb_cpointer_t)first);
+                tb_vector_insert_tail(impl->indices, (tb_cpointer_t)(tb_size_t)gb_tessellator_vertex(gb_mesh_edge_org(edge))->index);
+                tb_vector_insert_tail(impl->indices, (tb_cpointer_t)(tb_size_t)gb_tessellator_vertex(gb_mesh_edge_dst(edge))->index);
+
+                // the next edge
+                edge = gb_mesh_edge_lnext(edge);
             }
         }
     }
@@ -115,12 +222,28 @@ static tb_void_t gb_tessellator_done_convex(gb_tessellator_impl_t* impl, gb_poly
     // only one convex contour
     tb_assert(polygon->convex && polygon->counts && !polygon->counts[1]);
 
+    // the degenerated contour without any area? e.g. a => b => a
+    tb_check_return(polygon->counts[0] > 3);
+
+    // make strip? append it to the triangle strip directly
+    if (impl->mode == GB_TESSELLATOR_MODE_STRIP)
+    {
+        // append it
+        gb_tessellator_strip_convex(impl, polygon->points, polygon->counts[0]);
+
+        // ok
+        return ;
+    }
+
     // make convex or monotone? done it directly
     if (impl->mode == GB_TESSELLATOR_MODE_CONVEX || impl->mode == GB_TESSELLATOR_MODE_MONOTONE)
     {
         // done it
         impl->func(polygon->points, polygon->counts[0], impl->priv);
 
+        // update stats
+        gb_tessellator_stats_count_add(impl, faces, 1);
+
         // ok
         return ;
     }
@@ -149,14 +272,34 @@ static tb_void_t gb_tessellator_done_concave(gb_tessellator_impl_t* impl, gb_pol
     // check
     tb_assert(impl && polygon && !polygon->convex && bounds);
 
+    /* is simple polygon? make triangulation region directly, will be faster
+     *
+     * we need not it for the monotone mode, the sweep line will make fewer monotone regions
+     */
+    if (impl->mode != GB_TESSELLATOR_MODE_MONOTONE && gb_tessellator_simple_make(impl, polygon))
+    {
+        // make convex? 
+        if (impl->mode == GB_TESSELLATOR_MODE_CONVEX)
+        {
+            // merge triangles to the convex polygon
+            gb_tessellator_convex_make(impl);
+        }
+
+        // make strip?
+        if (impl->mode == GB_TESSELLATOR_MODE_STRIP) gb_tessellator_strip_make(impl);
+        // done output
+        else gb_tessellator_done_output(impl);
+        return ;
+    }
+
     // make mesh
     if (!gb_tessellator_mesh_make(impl, polygon)) return ;
 
     // make horizontal monotone region
     gb_tessellator_monotone_make(impl, bounds);
 
-    // need make convex or triangulation polygon?
-    if (impl->mode == GB_TESSELLATOR_MODE_CONVEX || impl->mode == GB_TESSELLATOR_MODE_TRIANGULATION)
+    // need make convex, triangulation or strip polygon?
+    if (impl->mode != GB_TESSELLATOR_MODE_MONOTONE)
     {
         // make triangulation region for each horizontal monotone region
         gb_tessellator_triangulation_make(impl);
@@ -169,8 +312,10 @@ static tb_void_t gb_tessellator_done_concave(gb_tessellator_impl_t* impl, gb_pol
         }
     }
 
+    // make strip?
+    if (impl->mode == GB_TESSELLATOR_MODE_STRIP) gb_tessellator_strip_make(impl);
     // done output
-    gb_tessellator_done_output(impl);
+    else gb_tessellator_done_output(impl);
 }
 
 /* //////////////////////////////////////////////////////////////////////////////////////
@@ -178,8 +323,15 @@ static tb_void_t gb_tessellator_done_concave(gb_tessellator_impl_t* impl, gb_pol
  */
 gb_tessellator_ref_t gb_tessellator_init()
 {
-    // init it
-    return (gb_tessellator_ref_t)tb_malloc0_type(gb_tessellator_impl_t);
+    // make tessellator
+    gb_tessellator_impl_t* impl = tb_malloc0_type(gb_tessellator_impl_t);
+    tb_assert_and_check_return_val(impl, tb_null);
+
+    // sync memory
+    gb_tessellator_memory_sync(impl);
+
+    // ok
+    return (gb_tessellator_ref_t)impl;
 }
 tb_void_t gb_tessellator_exit(gb_tessellator_ref_t tessellator)
 {
@@ -195,13 +347,39 @@ tb_void_t gb_tessellator_exit(gb_tessellator_ref_t tessellator)
     if (impl->outputs) tb_vector_exit(impl->outputs);
     impl->outputs = tb_null;
 
+    // exit indices
+    if (impl->indices) tb_vector_exit(impl->indices);
+    impl->indices = tb_null;
+
     // exit event queue
     if (impl->event_queue) tb_priority_queue_exit(impl->event_queue);
     impl->event_queue = tb_null;
 
+    // exit the sorted events
+    if (impl->events) tb_free(impl->events);
+    impl->events        = tb_null;
+    impl->events_size   = 0;
+    impl->events_maxn   = 0;
+
     // exit active regions
-    if (impl->active_regions) tb_list_exit(impl->active_regions);
-    impl->active_regions = tb_null;
+    if (impl->active_regions_pool) gb_mesh_pool_exit(impl->active_regions_pool);
+    impl->active_regions_pool = tb_null;
+
+    // exit batch
+    gb_tessellator_batch_exit(impl);
+
+    // exit stats
+    if (impl->stats) tb_free(impl->stats);
+    impl->stats = tb_null;
+
+#ifdef __gb_debug__
+    // exit profiler
+    if (impl->profiler) tb_stream_exit(impl->profiler);
+    impl->profiler = tb_null;
+#endif
+
+    // exit memory
+    gb_memory_sync(GB_MEMORY_TAG_TESSELLATOR, impl->memory, 0);
 
     // exit it
     tb_free(impl);
@@ -234,12 +412,64 @@ tb_void_t gb_tessellator_func_set(gb_tessellator_ref_t tessellator, gb_tessellat
     impl->func = func;
     impl->priv = priv;
 }
+tb_void_t gb_tessellator_stats_enable(gb_tessellator_ref_t tessellator, tb_bool_t enabled)
+{
+    // check
+    gb_tessellator_impl_t* impl = (gb_tessellator_impl_t*)tessellator;
+    tb_assert_and_check_return(impl);
+
+    // enable stats?
+    if (enabled)
+    {
+        // init stats
+        if (!impl->stats) impl->stats = tb_malloc0_type(gb_tessellator_stats_t);
+    }
+    else
+    {
+        // exit stats
+        if (impl->stats) tb_free(impl->stats);
+        impl->stats = tb_null;
+    }
+}
+tb_bool_t gb_tessellator_stats(gb_tessellator_ref_t tessellator, gb_tessellator_stats_ref_t stats)
+{
+    // check
+    gb_tessellator_impl_t* impl = (gb_tessellator_impl_t*)tessellator;
+    tb_assert_and_check_return_val(impl && stats, tb_false);
+
+    // the stats is disabled?
+    tb_check_return_val(impl->stats, tb_false);
+
+    // save stats
+    *stats = *impl->stats;
+
+    // ok
+    return tb_true;
+}
+tb_void_t gb_tessellator_stats_clear(gb_tessellator_ref_t tessellator)
+{
+    // check
+    gb_tessellator_impl_t* impl = (gb_tessellator_impl_t*)tessellator;
+    tb_assert_and_check_return(impl);
+
+    // clear stats
+    if (impl->stats) tb_memset(impl->stats, 0, sizeof(gb_tessellator_stats_t));
+}
 tb_void_t gb_tessellator_done(gb_tessellator_ref_t tessellator, gb_polygon_ref_t polygon, gb_rect_ref_t bounds)
 {
     // check
     gb_tessellator_impl_t* impl = (gb_tessellator_impl_t*)tessellator;
     tb_assert_abort_and_check_return(impl && impl->func && polygon && polygon->points && polygon->counts && bounds);
 
+    // update stats
+    gb_tessellator_stats_count_add(impl, polygons, 1);
+
+    // init the triangle strip for the strip mode
+    if (impl->mode == GB_TESSELLATOR_MODE_STRIP && !gb_tessellator_strip_init(impl)) return ;
+
+    // trace enter
+    gb_trace_enter(span);
+
     // is convex polygon for each contour?
     if (polygon->convex)
     {
@@ -266,4 +496,91 @@ tb_void_t gb_tessellator_done(gb_tessellator_ref_t tessellator, gb_polygon_ref_t
         // done tessellator for the concave polygon
         gb_tessellator_done_concave(impl, polygon, bounds);
     }
+
+    // done the triangle strip of this polygon for the strip mode
+    if (impl->mode == GB_TESSELLATOR_MODE_STRIP) gb_tessellator_strip_done(impl);
+
+    // sync memory
+    gb_tessellator_memory_sync(impl);
+
+    // trace leave
+    gb_trace_leave(span, "gb_tessellator_done");
+}
+tb_bool_t gb_tessellator_done_indexed(gb_tessellator_ref_t tessellator, gb_polygon_ref_t polygon, gb_rect_ref_t bounds, gb_point_ref_t* pvertices, tb_size_t* pvcount, tb_uint32_t const** pindices, tb_size_t* picount)
+{
+    // check
+    gb_tessellator_impl_t* impl = (gb_tessellator_impl_t*)tessellator;
+    tb_assert_abort_and_check_return_val(impl && polygon && polygon->points && polygon->counts && bounds, tb_false);
+    tb_assert_and_check_return_val(pvertices && pvcount && pindices && picount, tb_false);
+
+    // init outputs
+    if (!gb_tessellator_done_indexed_init(impl)) return tb_false;
+
+    // trace enter
+    gb_trace_enter(span);
+
+    // update stats
+    gb_tessellator_stats_count_add(impl, polygons, 1);
+
+    // is convex polygon for each contour?
+    if (polygon->convex)
+    {
+        // make the triangle fan for each contour directly, will be faster
+        tb_uint16_t     count;
+        gb_point_ref_t  points = polygon->points;
+        tb_uint16_t*    counts = polygon->counts;
+        while ((count = *counts++))
+        {
+            // done it
+            gb_tessellator_done_indexed_convex(impl, points, count);
+
+            // the next contour
+            points += count;
+        }
+    }
+    // is simple polygon? make triangulation region directly, will be faster
+    else if (gb_tessellator_simple_make(impl, polygon))
+    {
+        // done output
+        gb_tessellator_done_indexed_output(impl);
+    }
+    // make mesh
+    else if (gb_tessellator_mesh_make(impl, polygon))
+    {
+        // make horizontal monotone region
+        gb_tessellator_monotone_make(impl, bounds);
+
+        // make triangulation region for each horizontal monotone region
+        gb_tessellator_triangulation_make(impl);
+
+        // done output
+        gb_tessellator_done_indexed_output(impl);
+    }
+
+    // save outputs
+    *pvertices  = (gb_point_ref_t)tb_vector_data(impl->outputs);
+    *pvcount    = tb_vector_size(impl->outputs);
+    *pindices   = (tb_uint32_t const*)tb_vector_data(impl->indices);
+    *picount    = tb_vector_size(impl->indices);
+
+    // update stats
+    gb_tessellator_stats_count_add(impl, faces, *picount / 3);
+
+    // sync memory
+    gb_tessellator_memory_sync(impl);
+
+    // trace leave
+    gb_trace_leave(span, "gb_tessellator_done_indexed");
+
+    // ok?
+    return *picount? tb_true : tb_false;
+}
+tb_bool_t gb_tessellator_done_many(gb_tessellator_ref_t tessellator, gb_path_ref_t const* paths, tb_size_t count, tb_thread_pool_ref_t pool, gb_tessellator_many_func_t func, tb_cpointer_t priv)
+{
+    // check
+    gb_tessellator_impl_t* impl = (gb_tessellator_impl_t*)tessellator;
+    tb_assert_and_check_return_val(impl && paths && func, tb_false);
+
+    // done batch
+    return gb_tessellator_batch_done(impl, paths, count, pool, func, priv);
 }
@@ -98,12 +98,18 @@ __tb_extern_c_enter__
 /*! the polygon tessellator mode enum
  *
  * monotone > convex > triangulation
+ *
+ * the strip mode stitches all triangles of the polygon into the triangle strips 
+ * and joins them by the degenerate triangles, so the func will be called only once 
+ * for each polygon with the points of the triangle strip (split if the points are too many),
+ * but the windings of the output triangles are not consistent.
  */
 typedef enum __gb_tessellator_mode_e
 {
     GB_TESSELLATOR_MODE_CONVEX          = 0     //!< make convex polygon
 ,   GB_TESSELLATOR_MODE_MONOTONE        = 1     //!< make monotone polygon
 ,   GB_TESSELLATOR_MODE_TRIANGULATION   = 2     //!< make triangle 
+,   GB_TESSELLATOR_MODE_STRIP           = 3     //!< make triangle strip
 
 }gb_tessellator_mode_e;
 
@@ -115,10 +121,53 @@ typedef enum __gb_tessellator_rule_e
 
 }gb_tessellator_rule_e;
 
+/// the polygon tessellator stats type, all times are in microseconds
+typedef struct __gb_tessellator_stats_t
+{
+    /// the done polygons count
+    tb_size_t           polygons;
+
+    /// the vertices count of the built meshes
+    tb_size_t           vertices;
+
+    /// the edges count of the built meshes
+    tb_size_t           edges;
+
+    /// the inserted intersections count
+    tb_size_t           intersections;
+
+    /// the fixed degenerate cases count, e.g. the degenerate edges, faces and intersection errors
+    tb_size_t           degenerates;
+
+    /// the output faces count, each contour, triangle or triangle strip is one face
+    tb_size_t           faces;
+
+    /// the time of building the meshes
+    tb_hong_t           mesh_time;
+
+    /// the time of building the event queues
+    tb_hong_t           event_queue_time;
+
+    /// the time of sweeping the events, the intersection time is included
+    tb_hong_t           sweep_time;
+
+    /// the time of fixing the region intersections
+    tb_hong_t           intersection_time;
+
+    /// the time of triangulating the regions
+    tb_hong_t           triangulation_time;
+
+    /// the time of merging the triangles into the convex polygons
+    tb_hong_t           convex_time;
+
+}gb_tessellator_stats_t, *gb_tessellator_stats_ref_t;
+
 /// the polygon tessellator ref type 
 typedef struct{}*       gb_tessellator_ref_t;
 
 /*! the polygon tessellator func type
+ *
+ * the points are the triangle strip instead of the contour for the strip mode
  *
  * @param points        the points of the contour
  * @param count         the points count of the contour
@@ -126,6 +175,15 @@ typedef struct{}*       gb_tessellator_ref_t;
  */
 typedef tb_void_t       (*gb_tessellator_func_t)(gb_point_ref_t points, tb_uint16_t count, tb_cpointer_t priv);
 
+/*! the polygon tessellator func type for the batch of paths
+ *
+ * @param index         the index of the path in the batch
+ * @param points        the points of the contour
+ * @param count         the points count of the contour
+ * @param priv          the user private data
+ */
+typedef tb_void_t       (*gb_tessellator_many_func_t)(tb_size_t index, gb_point_ref_t points, tb_uint16_t count, tb_cpointer_t priv);
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * interfaces
  */
@@ -164,6 +222,33 @@ tb_void_t               gb_tessellator_rule_set(gb_tessellator_ref_t tessellator
  */
 tb_void_t               gb_tessellator_func_set(gb_tessellator_ref_t tessellator, gb_tessellator_func_t func, tb_cpointer_t priv);
 
+/*! enable or disable the tessellator stats
+ *
+ * the stats is disabled by default and it costs only one branch for each stage if disabled,
+ * so we can enable it in the release build for finding the pathological polygons.
+ *
+ * the stats will be cleared if it is disabled
+ *
+ * @param tessellator   the tessellator
+ * @param enabled       is enabled?
+ */
+tb_void_t               gb_tessellator_stats_enable(gb_tessellator_ref_t tessellator, tb_bool_t enabled);
+
+/*! the accumulated tessellator stats since it was enabled or cleared
+ *
+ * @param tessellator   the tessellator
+ * @param stats         the stats
+ *
+ * @return              tb_true or tb_false if the stats is disabled
+ */
+tb_bool_t               gb_tessellator_stats(gb_tessellator_ref_t tessellator, gb_tessellator_stats_ref_t stats);
+
+/*! clear the tessellator stats
+ *
+ * @param tessellator   the tessellator
+ */
+tb_void_t               gb_tessellator_stats_clear(gb_tessellator_ref_t tessellator);
+
 /*! done the tessellator
  *
  * @param tessellator   the tessellator
@@ -172,6 +257,70 @@ tb_void_t               gb_tessellator_func_set(gb_tessellator_ref_t tessellator
  */
 tb_void_t               gb_tessellator_done(gb_tessellator_ref_t tessellator, gb_polygon_ref_t polygon, gb_rect_ref_t bounds);
 
+/*! done the tessellator and output the indexed triangle list
+ *
+ * all contours are triangulated into one shared vertex array (in the mesh vertex order) 
+ * and the 32-bits triangle indices, so the whole polygon can be submitted in one batch.
+ *
+ * the mode and func of the tessellator are not used here and the outputs 
+ * are valid until the tessellator is done again or exited.
+ *
+ * @code
+    gb_point_ref_t      vertices = tb_null;
+    tb_uint32_t const*  indices = tb_null;
+    tb_size_t           vcount = 0;
+    tb_size_t           icount = 0;
+    if (gb_tessellator_done_indexed(tessellator, polygon, bounds, &vertices, &vcount, &indices, &icount))
+    {
+        // draw triangles: (vertices[indices[i]], vertices[indices[i + 1]], vertices[indices[i + 2]])
+        // ...
+    }
+ * @endcode
+ *
+ * @param tessellator   the tessellator
+ * @param polygon       the polygon
+ * @param bounds        the polygon bounds
+ * @param pvertices     the output vertices
+ * @param pvcount       the output vertices count
+ * @param pindices      the output triangle indices, three indices for each triangle
+ * @param picount       the output indices count
+ *
+ * @return              tb_true or tb_false if no triangles
+ */
+tb_bool_t               gb_tessellator_done_indexed(gb_tessellator_ref_t tessellator, gb_polygon_ref_t polygon, gb_rect_ref_t bounds, gb_point_ref_t* pvertices, tb_size_t* pvcount, tb_uint32_t const** pindices, tb_size_t* picount);
+
+/*! done the tessellator for a batch of independent paths in parallel
+ *
+ * the paths are tessellated by the tessellator and some temporary tessellators 
+ * with the same mode and rule on the current thread and the thread pool.
+ *
+ * all contours are output on the current thread after all paths have been done, 
+ * they are ordered by the input paths, so the result is deterministic.
+ *
+ * the different tessellators can be done on the different threads at the same time, 
+ * but the paths must not be modified until this function returns.
+ *
+ * @code
+    static tb_void_t on_contour(tb_size_t index, gb_point_ref_t points, tb_uint16_t count, tb_cpointer_t priv)
+    {
+        // the contour of paths[index]
+        // ...
+    }
+
+    gb_tessellator_done_many(tessellator, paths, count, tb_thread_pool(), on_contour, tb_null);
+ * @endcode
+ *
+ * @param tessellator   the tessellator
+ * @param paths         the paths, the null path will be ignored
+ * @param count         the paths count
+ * @param pool          the thread pool, done all paths on the current thread if be null
+ * @param func          the func
+ * @param priv          the user private data
+ *
+ * @return              tb_true or tb_false
+ */
+tb_bool_t               gb_tessellator_done_many(gb_tessellator_ref_t tessellator, gb_path_ref_t const* paths, tb_size_t count, tb_thread_pool_ref_t pool, gb_tessellator_many_func_t func, tb_cpointer_t priv);
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
  */
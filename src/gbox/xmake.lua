@@ -15,6 +15,22 @@ option("bitmap")
     set_description("Enable or disable the bitmap device")
     add_defines_h_if_ok("$(prefix)_DEVICE_HAVE_BITMAP")
 
+-- add option: trace
+option("trace")
+    set_enable(false)
+    set_showmenu(true)
+    set_category("option")
+    set_description("Enable or disable the chrome trace spans of the canvas and device calls")
+    add_defines_h_if_ok("$(prefix)_TRACE")
+
+-- add option: memory
+option("memory")
+    set_enable(false)
+    set_showmenu(true)
+    set_category("option")
+    set_description("Enable or disable the tagged allocation accounting of the path, paint, stroker, raster, device and tessellator")
+    add_defines_h_if_ok("$(prefix)_MEMORY")
+
 -- add option: smallest
 option("smallest")
     set_enable(false)
@@ -47,7 +63,7 @@ target("gbox")
     add_headers("../(gbox/**.h)|**/impl/**.h")
 
     -- add is_option
-    add_options("bitmap", "fixed")
+    add_options("bitmap", "fixed", "trace", "memory")
 
     -- add packages for window
     if is_os("ios", "android") then 
@@ -61,7 +77,7 @@ target("gbox")
 
     -- add the common source files
     add_files("*.c")
-    add_files("core/**.c|device/**.c")
+    add_files("core/**.c|device/**.c|bitmap/decoder/png.c|bitmap/decoder/jpg.c")
     add_files("platform/*.c")
     add_files("platform/impl/*.c")
     add_files("utils/**.c|impl/tessellator/profiler.c")
@@ -69,6 +85,10 @@ target("gbox")
     -- add the source files for debug
     if is_mode("debug") then add_files("utils/impl/tessellator/profiler.c") end
 
+    -- add the source files for bitmap decoder
+    if is_option("png") then add_files("core/bitmap/decoder/png.c") end
+    if is_option("jpeg") then add_files("core/bitmap/decoder/jpg.c") end
+
     -- add the source files for device
     if is_option("opengl") then add_files("core/device/gl.c", "core/device/gl/**.c") end
     if is_option("bitmap") then add_files("core/device/bitmap.c", "core/device/bitmap/**.c") end